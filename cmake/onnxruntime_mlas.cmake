@@ -13,9 +13,12 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/threading.cpp
   ${MLAS_SRC_DIR}/sgemm.cpp
   ${MLAS_SRC_DIR}/halfgemm.cpp
+  ${MLAS_SRC_DIR}/bf16gemm.cpp
   ${MLAS_SRC_DIR}/qgemm.cpp
   ${MLAS_SRC_DIR}/qdwconv.cpp
   ${MLAS_SRC_DIR}/convolve.cpp
+  ${MLAS_SRC_DIR}/convwinograd.cpp
+  ${MLAS_SRC_DIR}/snhwc.cpp
   ${MLAS_SRC_DIR}/convsym.cpp
   ${MLAS_SRC_DIR}/pooling.cpp
   ${MLAS_SRC_DIR}/transpose.cpp
@@ -25,6 +28,9 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/logistic.cpp
   ${MLAS_SRC_DIR}/tanh.cpp
   ${MLAS_SRC_DIR}/erf.cpp
+  ${MLAS_SRC_DIR}/flashattn.cpp
+  ${MLAS_SRC_DIR}/norm.cpp
+  ${MLAS_SRC_DIR}/gelu.cpp
   ${MLAS_SRC_DIR}/compute.cpp
   ${MLAS_SRC_DIR}/quantize.cpp
   ${MLAS_SRC_DIR}/qgemm_kernel_default.cpp
@@ -39,6 +45,7 @@ if (NOT onnxruntime_ORT_MINIMAL_BUILD)
   target_sources(onnxruntime_mlas PRIVATE
     ${MLAS_SRC_DIR}/q4_dq.cpp
     ${MLAS_SRC_DIR}/q4gemm.cpp
+    ${MLAS_SRC_DIR}/sqnbitgemm.cpp
   )
 endif()
 
@@ -154,9 +161,14 @@ function(setup_mlas_source_for_windows)
       ${mlas_platform_srcs_avx2}
       ${MLAS_SRC_DIR}/qgemm_kernel_amx.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_avx2.cpp
+      ${MLAS_SRC_DIR}/bf16gemm_kernel_avx512bf16.cpp
+      ${MLAS_SRC_DIR}/bf16gemm_kernel_amx.cpp
+      ${MLAS_SRC_DIR}/halfgemm_kernel_f16c.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_sse.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_sse41.cpp
       ${MLAS_SRC_DIR}/intrinsics/avx512/quantize_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/norm_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/gelu_avx512f.cpp
       ${MLAS_SRC_DIR}/amd64/QgemmU8S8KernelAmx.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8S8KernelAvx2.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8U8KernelAvx2.asm
@@ -193,9 +205,18 @@ function(setup_mlas_source_for_windows)
       ${MLAS_SRC_DIR}/amd64/TanhKernelFma3.asm
       ${MLAS_SRC_DIR}/amd64/ErfKernelFma3.asm
     )
+    set_property(SOURCE ${MLAS_SRC_DIR}/platform.cpp APPEND PROPERTY COMPILE_DEFINITIONS MLAS_AVX512BF16_SUPPORTED)
     if (NOT onnxruntime_ORT_MINIMAL_BUILD)
+      set_source_files_properties(${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx2.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+      set_source_files_properties(${MLAS_SRC_DIR}/sqnbitgemm_kernel_avxvnni.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+      set_source_files_properties(${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx512vnni.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX512")
+      set_property(SOURCE ${MLAS_SRC_DIR}/platform.cpp APPEND PROPERTY COMPILE_DEFINITIONS MLAS_AVXVNNI_SUPPORTED)
+
       target_sources(onnxruntime_mlas PRIVATE
         ${MLAS_SRC_DIR}/q4gemm_avx512.cpp
+        ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx2.cpp
+        ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avxvnni.cpp
+        ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx512vnni.cpp
       )
     endif()
 
@@ -505,6 +526,8 @@ else()
           ${MLAS_SRC_DIR}/x86_64/ErfKernelFma3.S
           ${MLAS_SRC_DIR}/intrinsics/avx2/qladd_avx2.cpp
           ${MLAS_SRC_DIR}/intrinsics/avx2/qdwconv_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/norm_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/gelu_avx2.cpp
         )
         set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
 
@@ -515,6 +538,8 @@ else()
           ${MLAS_SRC_DIR}/x86_64/SpoolKernelAvx512F.S
           ${MLAS_SRC_DIR}/x86_64/TransKernelAvx512F.S
           ${MLAS_SRC_DIR}/intrinsics/avx512/quantize_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/norm_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/gelu_avx512f.cpp
         )
         set_source_files_properties(${mlas_platform_srcs_avx512f} PROPERTIES COMPILE_FLAGS "-mavx512f")
 
@@ -526,10 +551,13 @@ else()
         )
         set_source_files_properties(${mlas_platform_srcs_avx512core} PROPERTIES COMPILE_FLAGS "-mavx512bw -mavx512dq -mavx512vl")
 
+        set_source_files_properties(${MLAS_SRC_DIR}/halfgemm_kernel_f16c.cpp PROPERTIES COMPILE_FLAGS "-mavx -mf16c")
+
         set(mlas_platform_srcs
           ${MLAS_SRC_DIR}/activate_fp16.cpp
           ${MLAS_SRC_DIR}/dwconv.cpp
           ${MLAS_SRC_DIR}/dgemm.cpp
+          ${MLAS_SRC_DIR}/halfgemm_kernel_f16c.cpp
           ${MLAS_SRC_DIR}/pooling_fp16.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_avx2.cpp
           ${mlas_platform_srcs_sse2}
@@ -539,12 +567,44 @@ else()
           ${mlas_platform_srcs_avx512core}
         )
 
+        check_cxx_compiler_flag("-mavx512bf16" HAS_AVX512BF16)
+        if(HAS_AVX512BF16)
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${MLAS_SRC_DIR}/bf16gemm_kernel_avx512bf16.cpp
+          )
+          set_source_files_properties(${MLAS_SRC_DIR}/bf16gemm_kernel_avx512bf16.cpp PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512bw -mavx512vl -mavx512bf16")
+          set_property(SOURCE ${MLAS_SRC_DIR}/platform.cpp APPEND PROPERTY COMPILE_DEFINITIONS MLAS_AVX512BF16_SUPPORTED)
+        endif()
+
         if (NOT onnxruntime_ORT_MINIMAL_BUILD)
           set(mlas_platform_srcs
             ${mlas_platform_srcs}
             ${MLAS_SRC_DIR}/q4gemm_avx512.cpp
+            ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx2.cpp
+            ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx512vnni.cpp
           )
           set_source_files_properties(${MLAS_SRC_DIR}/q4gemm_avx512.cpp PROPERTIES COMPILE_FLAGS "-mfma -mavx512vnni -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          set_source_files_properties(${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx2.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
+          set_source_files_properties(${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx512vnni.cpp PROPERTIES COMPILE_FLAGS "-mfma -mavx512vnni -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          check_cxx_compiler_flag("-mavxvnni" HAS_AVXVNNI)
+          if(HAS_AVXVNNI)
+            set(mlas_platform_srcs
+              ${mlas_platform_srcs}
+              ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avxvnni.cpp
+            )
+            set_source_files_properties(${MLAS_SRC_DIR}/sqnbitgemm_kernel_avxvnni.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mavxvnni")
+            set_property(SOURCE ${MLAS_SRC_DIR}/platform.cpp APPEND PROPERTY COMPILE_DEFINITIONS MLAS_AVXVNNI_SUPPORTED)
+          endif()
+        endif()
+        check_cxx_compiler_flag("-mavx512fp16" HAS_AVX512FP16)
+        if(HAS_AVX512FP16)
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${MLAS_SRC_DIR}/halfgemm_kernel_avx512fp16.cpp
+          )
+          set_source_files_properties(${MLAS_SRC_DIR}/halfgemm_kernel_avx512fp16.cpp PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512bw -mavx512vl -mavx512fp16")
+          set_property(SOURCE ${MLAS_SRC_DIR}/platform.cpp APPEND PROPERTY COMPILE_DEFINITIONS MLAS_AVX512FP16_SUPPORTED)
         endif()
         if(NOT APPLE)
           set(mlas_platform_srcs
@@ -553,6 +613,13 @@ else()
             ${MLAS_SRC_DIR}/qgemm_kernel_amx.cpp
             ${MLAS_SRC_DIR}/x86_64/QgemmU8S8KernelAmx.S
             )
+          if(HAS_AVX512BF16)
+            set(mlas_platform_srcs
+              ${mlas_platform_srcs}
+              ${MLAS_SRC_DIR}/bf16gemm_kernel_amx.cpp
+            )
+            set_source_files_properties(${MLAS_SRC_DIR}/bf16gemm_kernel_amx.cpp PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512bw -mavx512vl -mavx512bf16")
+          endif()
           set_source_files_properties(${MLAS_SRC_DIR}/qgemm_kernel_amx.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
           set_source_files_properties(${MLAS_SRC_DIR}/x86_64/QgemmU8S8KernelAmx.S PROPERTIES COMPILE_FLAGS "-mavx2 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
 	    endif()
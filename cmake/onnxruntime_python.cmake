@@ -493,6 +493,7 @@ file(GLOB onnxruntime_python_datasets_data CONFIGURE_DEPENDS
 # and assist with export from PyTorch.
 set(onnxruntime_mobile_util_srcs
     ${REPO_ROOT}/tools/python/util/check_onnx_model_mobile_usability.py
+    ${REPO_ROOT}/tools/python/util/cleanup_shared_weight_store.py
     ${REPO_ROOT}/tools/python/util/convert_onnx_models_to_ort.py
     ${REPO_ROOT}/tools/python/util/file_utils.py
     ${REPO_ROOT}/tools/python/util/logger.py
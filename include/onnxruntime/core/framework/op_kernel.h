@@ -129,6 +129,27 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to use pre-packed buffers that were loaded from a pre-packed weights cache file
+  // instead of calling PrePack(). Unlike UseSharedPrePackedBuffers(), PrePack() is not called on this kernel
+  // instance first, so the kernel must also restore any metadata it would have derived from the tensor in PrePack()
+  // (e.g.) its shape. The buffers are in the same order as the kernel produced them in PrePack().
+  // @param tensor: The constant initialized tensor the buffers were pre-packed from.
+  // @param prepacked_buffers: The cached pre-packed buffers. The deleter of each BufferUniquePtr is NULL.
+  // @param prepacked_buffer_sizes: The size in bytes of each cached buffer. Kernels should check the number and the
+  //                                sizes of the buffers against what PrePack() would produce for the tensor on
+  //                                this machine and decline the buffers on a mismatch.
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param used_cached_buffers: Boolean flag set by the kernel implementation indicating that the cached buffers
+  //                             have been used by the kernel. If false, the session falls back to PrePack().
+  virtual Status UseCachedPrePackedBuffers(const Tensor& /*tensor*/,
+                                           std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                           const std::vector<size_t>& /*prepacked_buffer_sizes*/,
+                                           int /*input_idx*/,
+                                           /*out*/ bool& used_cached_buffers) {
+    used_cached_buffers = false;
+    return Status::OK();
+  }
+
   const OrtDevice GetDevice(OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
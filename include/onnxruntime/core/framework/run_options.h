@@ -5,6 +5,8 @@
 
 #include <string>
 #include <atomic>
+#include <chrono>
+#include <optional>
 #include "core/session/onnxruntime_c_api.h"
 #include "core/framework/config_options.h"
 
@@ -23,6 +25,11 @@ struct OrtRunOptions {
   // be forced to terminate with an error status.
   bool terminate = false;
 
+  // If set, the Run() calls that use this OrtRunOptions instance fail with a DEADLINE_EXCEEDED error status once
+  // the deadline has passed, or as soon as the recorded execution time of their remaining nodes predicts that they
+  // cannot finish before it. The deadline is checked between the nodes of the main graph.
+  std::optional<std::chrono::steady_clock::time_point> deadline;
+
   // Set to 'true' to run only the nodes from feeds to required fetches.
   // So it is possible that only some of the nodes are executed.
   bool only_execute_path_to_fetches = false;
@@ -37,7 +37,7 @@
  *
  * This value is used by some API functions to behave as this version of the header expects.
  */
-#define ORT_API_VERSION 16
+#define ORT_API_VERSION 17
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,6 +63,7 @@ extern "C" {
 #define _In_reads_(X)
 #define _Inout_updates_(X)
 #define _Out_writes_(X)
+#define _Out_writes_opt_(X)
 #define _Inout_updates_all_(X)
 #define _Out_writes_bytes_all_(X)
 #define _Out_writes_all_(X)
@@ -251,6 +252,7 @@ typedef enum OrtErrorCode {
   ORT_NOT_IMPLEMENTED,
   ORT_INVALID_GRAPH,
   ORT_EP_FAIL,
+  ORT_DEADLINE_EXCEEDED,
 } OrtErrorCode;
 
 typedef enum OrtOpAttrType {
@@ -299,6 +301,7 @@ ORT_RUNTIME_CLASS(DnnlProviderOptions);
 ORT_RUNTIME_CLASS(Op);
 ORT_RUNTIME_CLASS(OpAttr);
 ORT_RUNTIME_CLASS(Logger);
+ORT_RUNTIME_CLASS(RequestBatcher);
 
 #ifdef _WIN32
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -4413,6 +4416,172 @@ struct OrtApi {
    * \since Version 1.16.
    */
   ORT_API2_STATUS(KernelContext_GetResource, _In_ const OrtKernelContext* context, _In_ int resouce_version, _In_ int resource_id, _Outptr_ void** resource);
+
+  /** \brief Warm up a session for sets of input shapes
+   *
+   * Runs the model once for each set of input shapes with zero valued inputs. This creates the state that is
+   * otherwise created by the first OrtApi::Run for a set of input shapes, such as memory patterns, tuned kernels and
+   * kernel scratch buffers, and grows the memory arenas to the peak usage of these runs.
+   * Arena shrinkage requested in the run options is not applied to the warm-up runs.
+   * The model must only have tensor inputs, and must accept zero valued inputs.
+   *
+   * \param[in] session
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the names of the inputs whose shapes are
+   *            provided. Inputs that are not listed must have a fully defined shape in the model.
+   * \param[in] input_names_len Number of elements in the input_names array
+   * \param[in] input_shapes Array of `num_warm_up_runs * input_names_len` shapes. The shapes of the inputs for the
+   *            warm-up run i are `input_shapes[i * input_names_len]` to `input_shapes[(i + 1) * input_names_len - 1]`.
+   * \param[in] input_shape_lens Number of dimensions of each shape in the input_shapes array.
+   * \param[in] num_warm_up_runs Number of warm-up runs
+   * \param[out] durations_us Optional. Array of `num_warm_up_runs` elements that receives the duration of each warm-up
+   *             run in microseconds.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SessionWarmUp, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_names_len) const char* const* input_names, size_t input_names_len,
+                  _In_reads_(num_warm_up_runs* input_names_len) const int64_t* const* input_shapes,
+                  _In_reads_(num_warm_up_runs* input_names_len) const size_t* input_shape_lens,
+                  size_t num_warm_up_runs, _Out_writes_opt_(num_warm_up_runs) int64_t* durations_us);
+
+  /** \brief Create a request batcher for a session
+   *
+   * A request batcher combines the requests submitted with OrtApi::RequestBatcherSubmit into batches, and runs each
+   * batch with a single OrtApi::Run in a thread owned by the batcher. The batcher owns two threads, so one batch can
+   * be formed and run while the previous one is still running.
+   * The inputs of the requests in a batch are concatenated along their first dimension, and the outputs are split
+   * along their first dimension and passed to the callback of each request.
+   *
+   * Requests are batched together if they have the same input and output names, and their inputs are non-string CPU
+   * tensors with the same element types and the same shapes apart from the first dimension, which must be the same
+   * for all the inputs of a request. Other requests are run on their own.
+   * No requests are batched unless the model declares the first dimension of all its inputs and outputs as the same
+   * symbolic dimension.
+   * If an output of a batched run is not a CPU tensor whose first dimension is the batch dimension, the requests of
+   * the batch and all later requests are run on their own.
+   *
+   * \param[in] session The session must outlive the batcher.
+   * \param[in] max_batch_size Maximum sum of the first dimensions of the inputs of the requests in a batch.
+   * \param[in] max_wait_us Maximum time in microseconds that a request waits for other requests to batch with.
+   * \param[out] out Newly created ::OrtRequestBatcher. Must be freed with OrtApi::ReleaseRequestBatcher
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CreateRequestBatcher, _Inout_ OrtSession* session, size_t max_batch_size, int64_t max_wait_us,
+                  _Outptr_ OrtRequestBatcher** out);
+
+  /** \brief Submit a request to a request batcher
+   *
+   * The arguments have the same meaning as the arguments of OrtApi::RunAsync. The arrays must stay valid until
+   * run_async_callback is called.
+   *
+   * \param[in] batcher
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input Array of ::OrtValue%s of the input values
+   * \param[in] input_len Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names and outputs array
+   * \param[out] output OrtValue* array of size output_names_len. See OrtApi::RunAsync.
+   * \param[in] run_async_callback Callback function on completion of the request
+   * \param[in] user_data User data that pass back to run_async_callback
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(RequestBatcherSubmit, _Inout_ OrtRequestBatcher* batcher,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output,
+                  _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+  /** \brief Release an ::OrtRequestBatcher
+   *
+   * Runs the pending requests of the batcher before returning.
+   *
+   * \since Version 1.17.
+   */
+  ORT_CLASS_RELEASE(RequestBatcher);
+
+  /** \brief Create a session that shares the model, initializers, pre-packed weights and kernels of a session
+   *
+   * The new session has its own thread pools, allocators and memory patterns, and uses the session options of
+   * the session it is cloned from. Creating it does not load, optimize or pre-pack the model again.
+   *
+   * \param[in] session The session to clone. It must outlive the new session. If it is itself a clone, the session
+   *            it was cloned from must outlive the new session as well.
+   * \param[out] out Returned newly created OrtSession. Must be freed with OrtApi::ReleaseSession
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CloneSession, _In_ const OrtSession* session, _Outptr_ OrtSession** out);
+
+  /** \brief Recycle the buffers of the outputs that are bound to a device
+   *
+   * When enabled, a run with the binding writes each output that is bound to a device with OrtApi::BindOutputToDevice
+   * into the buffer that the previous run allocated for it if the buffer is large enough, and replaces the buffer
+   * with a larger one if it is not. The output shapes can change between runs without binding the outputs again,
+   * and once the largest output shapes have been seen the runs do not allocate the outputs anymore.
+   *
+   * The output values returned by OrtApi::GetBoundOutputValues share their buffers with the next run, which
+   * overwrites their data. Outputs that are produced on another device than the one they are bound to are copied
+   * into their recycled buffer.
+   *
+   * \param[in] binding_ptr
+   * \param[in] recycle 1 to enable recycling, 0 to disable it and release the recycled buffers.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(RecycleBoundOutputBuffers, _Inout_ OrtIoBinding* binding_ptr, int recycle);
+
+  /** \brief Set a deadline for the Run calls that use the run options
+   *
+   * A run fails with ORT_DEADLINE_EXCEEDED once the deadline has passed, or as soon as the execution time that was
+   * recorded for its remaining nodes by earlier runs with a deadline predicts that it cannot finish before the
+   * deadline. The error message reports how many execution steps were executed and the estimated cost of the
+   * skipped ones. The deadline is checked between the nodes of the main graph.
+   *
+   * \param[in] options
+   * \param[in] timeout_us The deadline in microseconds after this call, which allows the deadline to include the time
+   *            a request waited before it is run. A negative value clears the deadline.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(RunOptionsSetDeadline, _Inout_ OrtRunOptions* options, int64_t timeout_us);
+
+  /** \brief Create a tensor that is a view of a contiguous range of the elements of another tensor
+   *
+   * The view covers `shape` worth of elements of `value`, starting at `element_offset` in row major order. A slice of
+   * the leading axis of `value` is created with an offset of start * the size of a row and a shape with the number of
+   * rows in the slice, a reshape of `value` with an offset of 0 and the new shape.
+   *
+   * The view shares the buffer of `value` without copying it, so writes to either one are visible in the other. The
+   * view keeps the buffer alive, so `value` may be released before the view.
+   *
+   * \param[in] value A tensor.
+   * \param[in] element_offset The index of the first element of `value` in the view.
+   * \param[in] shape Dimensions of the view. All the dimensions must be known.
+   * \param[in] shape_len Number of dimensions in `shape`.
+   * \param[out] out Newly created ::OrtValue. Must be freed with OrtApi::ReleaseValue
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CreateTensorView, _In_ const OrtValue* value, size_t element_offset, _In_ const int64_t* shape,
+                  size_t shape_len, _Outptr_ OrtValue** out);
 };
 
 /*
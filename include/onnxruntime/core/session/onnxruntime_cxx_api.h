@@ -522,6 +522,7 @@ ORT_DEFINE_RELEASE(Status);
 ORT_DEFINE_RELEASE(OpAttr);
 ORT_DEFINE_RELEASE(Op);
 ORT_DEFINE_RELEASE(KernelInfo);
+ORT_DEFINE_RELEASE(RequestBatcher);
 
 #undef ORT_DEFINE_RELEASE
 
@@ -766,6 +767,13 @@ struct RunOptions : detail::Base<OrtRunOptions> {
    * Wraps OrtApi::RunOptionsUnsetTerminate
    */
   RunOptions& UnsetTerminate();
+
+  /** \brief Sets the deadline of the Session::Run calls made using this RunOptions instance
+   *
+   * \param timeout_us The deadline in microseconds from now. A negative value clears the deadline.
+   * Wraps OrtApi::RunOptionsSetDeadline
+   */
+  RunOptions& SetDeadline(int64_t timeout_us);
 };
 
 namespace detail {
@@ -1089,6 +1097,18 @@ struct SessionImpl : ConstSessionImpl<T> {
   void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
                 const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data);
 
+  /** \brief Warm up the session by running it with zero valued inputs for each set of input shapes
+   *
+   * Wraps OrtApi::SessionWarmUp
+   *
+   * \param[in] run_options
+   * \param[in] input_names Names of the inputs whose shapes are provided
+   * \param[in] input_shapes The shapes of the inputs in input_names for each warm-up run
+   * \return The duration of each warm-up run in microseconds
+   */
+  std::vector<int64_t> WarmUp(const RunOptions& run_options, const std::vector<const char*>& input_names,
+                              const std::vector<std::vector<std::vector<int64_t>>>& input_shapes);
+
   /** \brief End profiling and return a copy of the profiling file name.
    *
    * \param allocator to allocate memory for the copy of the string returned
@@ -1115,6 +1135,13 @@ struct Session : detail::SessionImpl<OrtSession> {
   Session(const Env& env, const void* model_data, size_t model_data_length, const SessionOptions& options,
           OrtPrepackedWeightsContainer* prepacked_weights_container);  ///< Wraps OrtApi::CreateSessionFromArrayWithPrepackedWeightsContainer
 
+  /** \brief Wraps OrtApi::CloneSession
+   *
+   * Creates a session that shares the model, initializers, pre-packed weights and kernels of this session.
+   * This session must outlive the clone.
+   */
+  Session Clone() const;
+
   ConstSession GetConst() const { return ConstSession{this->p_}; }
   UnownedSession GetUnowned() const { return UnownedSession{this->p_}; }
 };
@@ -1665,6 +1692,25 @@ struct Value : detail::ValueImpl<OrtValue> {
    */
   static Value CreateTensor(OrtAllocator* allocator, const int64_t* shape, size_t shape_len, ONNXTensorElementDataType type);
 
+  /** \brief Creates a tensor that shares the buffer of a contiguous range of the elements of another tensor.
+   *   Wraps OrtApi::CreateTensorView.
+   *
+   * \param value The tensor to create the view of. It may be released before the view.
+   * \param element_offset The index of the first element of `value` in the view.
+   * \param shape Pointer to the view shape dimensions.
+   * \param shape_len The number of view shape dimensions.
+   */
+  static Value CreateTensorView(const ConstValue& value, size_t element_offset, const int64_t* shape, size_t shape_len);
+
+  /** \brief Creates a tensor that shares the buffer of the rows [start, end) of the leading axis of another tensor.
+   *   Wraps OrtApi::CreateTensorView.
+   *
+   * \param value The tensor to create the slice of. It may be released before the slice.
+   * \param start The first row of the slice.
+   * \param end One past the last row of the slice.
+   */
+  static Value CreateTensorSlice(const ConstValue& value, int64_t start, int64_t end);
+
   /** \brief Creates an OrtValue with a Map Onnx type representation.
    *  The API would ref-count the supplied OrtValues and they will be released
    *  when the returned OrtValue is released. The caller may release keys and values after the call
@@ -1842,6 +1888,7 @@ struct IoBindingImpl : ConstIoBindingImpl<T> {
   void ClearBoundOutputs();
   void SynchronizeInputs();
   void SynchronizeOutputs();
+  void RecycleOutputBuffers(bool recycle);  ///< Wraps OrtApi::RecycleBoundOutputBuffers
 };
 
 }  // namespace detail
@@ -1859,6 +1906,24 @@ struct IoBinding : detail::IoBindingImpl<OrtIoBinding> {
   UnownedIoBinding GetUnowned() const { return UnownedIoBinding{this->p_}; }
 };
 
+/** \brief Wrapper around ::OrtRequestBatcher
+ *
+ * Combines the requests submitted for a session into batches that are run with a single Run call.
+ */
+struct RequestBatcher : detail::Base<OrtRequestBatcher> {
+  explicit RequestBatcher(std::nullptr_t) {}  ///< Create an empty RequestBatcher object, must be assigned a valid one to be used
+  /// Wraps OrtApi::CreateRequestBatcher
+  RequestBatcher(Session& session, size_t max_batch_size, int64_t max_wait_us);
+
+  /** \brief Wraps OrtApi::RequestBatcherSubmit
+   *
+   * The arguments have the same meaning as the arguments of Session::RunAsync.
+   */
+  void Submit(const char* const* input_names, const Value* input_values, size_t input_count,
+              const char* const* output_names, Value* output_values, size_t output_count,
+              RunAsyncCallbackFn callback, void* user_data);
+};
+
 /*! \struct Ort::ArenaCfg
  * \brief it is a structure that represents the configuration of an arena based allocator
  * \details Please see docs/C_API.md for details
@@ -347,6 +347,11 @@ inline void IoBindingImpl<T>::SynchronizeOutputs() {
   ThrowOnError(GetApi().SynchronizeBoundOutputs(this->p_));
 }
 
+template <typename T>
+inline void IoBindingImpl<T>::RecycleOutputBuffers(bool recycle) {
+  ThrowOnError(GetApi().RecycleBoundOutputBuffers(this->p_, recycle ? 1 : 0));
+}
+
 namespace binding_utils {
 inline std::vector<std::string> GetOutputNamesHelper(const OrtIoBinding* binding, OrtAllocator* allocator) {
   std::vector<std::string> result;
@@ -415,6 +420,19 @@ inline IoBinding::IoBinding(Session& session) {
   ThrowOnError(GetApi().CreateIoBinding(session, &this->p_));
 }
 
+inline RequestBatcher::RequestBatcher(Session& session, size_t max_batch_size, int64_t max_wait_us) {
+  ThrowOnError(GetApi().CreateRequestBatcher(session, max_batch_size, max_wait_us, &this->p_));
+}
+
+inline void RequestBatcher::Submit(const char* const* input_names, const Value* input_values, size_t input_count,
+                                   const char* const* output_names, Value* output_values, size_t output_count,
+                                   RunAsyncCallbackFn callback, void* user_data) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RequestBatcherSubmit(this->p_, input_names, ort_input_values, input_count,
+                                             output_names, output_count, ort_output_values, callback, user_data));
+}
+
 inline ArenaCfg::ArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes, int max_dead_bytes_per_chunk) {
   ThrowOnError(GetApi().CreateArenaCfg(max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk, &p_));
 }
@@ -590,6 +608,11 @@ inline RunOptions& RunOptions::UnsetTerminate() {
   return *this;
 }
 
+inline RunOptions& RunOptions::SetDeadline(int64_t timeout_us) {
+  ThrowOnError(GetApi().RunOptionsSetDeadline(p_, timeout_us));
+  return *this;
+}
+
 namespace detail {
 
 template <typename T>
@@ -982,6 +1005,29 @@ inline void SessionImpl<T>::RunAsync(const RunOptions& run_options, const char*
                                  ort_output_values, callback, user_data));
 }
 
+template <typename T>
+inline std::vector<int64_t> SessionImpl<T>::WarmUp(const RunOptions& run_options, const std::vector<const char*>& input_names,
+                                                   const std::vector<std::vector<std::vector<int64_t>>>& input_shapes) {
+  std::vector<const int64_t*> shapes;
+  std::vector<size_t> shape_lens;
+  shapes.reserve(input_shapes.size() * input_names.size());
+  shape_lens.reserve(input_shapes.size() * input_names.size());
+  for (const auto& run_input_shapes : input_shapes) {
+    if (run_input_shapes.size() != input_names.size()) {
+      ORT_CXX_API_THROW("Each warm-up run must provide a shape for every input name", ORT_INVALID_ARGUMENT);
+    }
+    for (const auto& shape : run_input_shapes) {
+      shapes.push_back(shape.data());
+      shape_lens.push_back(shape.size());
+    }
+  }
+
+  std::vector<int64_t> durations_us(input_shapes.size());
+  ThrowOnError(GetApi().SessionWarmUp(this->p_, run_options, input_names.data(), input_names.size(),
+                                      shapes.data(), shape_lens.data(), input_shapes.size(), durations_us.data()));
+  return durations_us;
+}
+
 template <typename T>
 inline AllocatedStringPtr SessionImpl<T>::EndProfilingAllocated(OrtAllocator* allocator) {
   char* out = nullptr;
@@ -1035,6 +1081,12 @@ inline Session::Session(const Env& env, const void* model_data, size_t model_dat
                                                                             prepacked_weights_container, &this->p_));
 }
 
+inline Session Session::Clone() const {
+  Session clone{nullptr};
+  ThrowOnError(GetApi().CloneSession(this->p_, &clone.p_));
+  return clone;
+}
+
 inline AllocatedStringPtr ModelMetadata::GetProducerNameAllocated(OrtAllocator* allocator) const {
   char* out;
   ThrowOnError(GetApi().ModelMetadataGetProducerName(p_, allocator, &out));
@@ -1473,6 +1525,25 @@ inline Value Value::CreateTensor(OrtAllocator* allocator, const int64_t* shape,
   return Value{out};
 }
 
+inline Value Value::CreateTensorView(const ConstValue& value, size_t element_offset, const int64_t* shape, size_t shape_len) {
+  OrtValue* out;
+  ThrowOnError(GetApi().CreateTensorView(value, element_offset, shape, shape_len, &out));
+  return Value{out};
+}
+
+inline Value Value::CreateTensorSlice(const ConstValue& value, int64_t start, int64_t end) {
+  std::vector<int64_t> shape = value.GetTensorTypeAndShapeInfo().GetShape();
+  if (shape.empty() || start < 0 || start > end || end > shape[0]) {
+    ORT_CXX_API_THROW("Invalid slice of the leading axis of the tensor", ORT_INVALID_ARGUMENT);
+  }
+  int64_t row_size = 1;
+  for (size_t i = 1; i < shape.size(); ++i) {
+    row_size *= shape[i];
+  }
+  shape[0] = end - start;
+  return CreateTensorView(value, static_cast<size_t>(start * row_size), shape.data(), shape.size());
+}
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 
 template <typename T>
@@ -20,6 +20,52 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// File path of a cache of pre-packed weights. The weights pre-packed by CPU EP kernels are written to this file,
+// and later sessions that load the file reuse the cached buffers instead of pre-packing the weights again.
+// The buffers are memory mapped from the file, which also allows sessions in different processes to share them
+// through the page cache. The file is only used if it was created with the same ORT version on a CPU with the same
+// features, otherwise it is ignored and replaced.
+// Initializers shared between sessions via a PrepackedWeightsContainer are not written to the file.
+// The option is ignored if pre-packing is disabled. By default no cache file is used.
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsCacheFile = "session.prepacked_weights_cache_file";
+
+// Use the intra-op thread pool of the session to speed up session initialization.
+// Initializers placed on CPU are deserialized in parallel, and the kernels of nodes assigned to the CPU EP are
+// created and pre-pack their weights in parallel. Kernels of other execution providers are still created serially.
+// Custom op kernels assigned to the CPU EP must be safe to construct concurrently when this is enabled.
+//
+// Option values:
+// - "0": Session initialization runs on the calling thread. [DEFAULT]
+// - "1": Session initialization uses the intra-op thread pool.
+static const char* const kOrtSessionOptionsConfigParallelInitialization = "session.parallel_initialization";
+
+// Defer loading initializers that are stored in an external data file until the graph that uses them is executed.
+// This reduces the session initialization time and memory usage for models with large parts that are rarely
+// executed, such as the branches of If nodes. The initializers of a graph are loaded on its first execution, and
+// the initializers of a subgraph that never executes are never loaded.
+// Deferred initializers are not available to kernels as constant inputs while they are created. They are pre-packed
+// by the kernels of their graph when they are loaded, with a memory allocation of the session, so the pre-packed
+// weights are not shared between sessions or cached in a pre-packed weights file. Kernels of subgraphs that use them
+// as outer scope values do not pre-pack them. Initializers stored in the model itself are loaded during session
+// initialization as usual.
+//
+// Option values:
+// - "0": All initializers are loaded during session initialization. [DEFAULT]
+// - "1": Initializers with external data are loaded when the graph that uses them is first executed.
+static const char* const kOrtSessionOptionsConfigLazyInitializerMaterialization =
+    "session.lazy_initializer_materialization";
+
+// Directory of a store of weights that are shared read-only between processes, e.g. a directory in /dev/shm.
+// The CPU initializers stored in the model and the weights pre-packed by CPU EP kernels are placed in the store,
+// keyed by a hash of their content. Sessions in other processes that use the same weights map the same memory
+// instead of holding their own copies. Initializers with external data already share the pages of the mapped file
+// and are not placed in the store. Weights smaller than 16KB are not shared.
+// The weights stay in the store when the sessions are released, so sessions created later reuse them. Use
+// `python -m onnxruntime.tools.cleanup_shared_weight_store <directory>` to remove them once no process uses the store.
+// Only supported on POSIX platforms. The initializers in the store are read-only, so the option must not be used
+// with sessions that update their initializers, such as training sessions. By default no store is used.
+static const char* const kOrtSessionOptionsConfigSharedWeightStoreDirectory = "session.shared_weight_store_directory";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
@@ -67,6 +113,11 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable the NHWC layout for fp32 Conv and pooling operators in the level 3 graph optimization.
+// "0": disable; "1": enable. The default is "0".
+// When enabled, the NHWC transformer is used for fp32 instead of the NCHWc transformer.
+static const char* const kOrtSessionOptionsEnableNhwcFp32Conv = "optimization.enable_nhwc_fp32_conv";
+
 #ifdef ENABLE_TRAINING
 // Specifies a list of op types for memory footprint reduction.
 // The value should be a ","-delimited list of pair of
@@ -225,3 +276,40 @@ static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersFil
 // Use this config to control the minimum size of the initializer when externalizing it during serialization
 static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersMinSizeInBytes =
     "session.optimized_model_external_initializers_min_size_in_bytes";
+
+// Collect hardware performance counters (cycles, instructions, LLC misses and dTLB misses) for every kernel
+// invocation while profiling is enabled. The deltas are written to the profile as an additional
+// "<node_name>_hw_counters" node event next to the "<node_name>_kernel_time" event.
+// The counters are read through perf_event_open and are only available on Linux. Access may need to be granted via
+// /proc/sys/kernel/perf_event_paranoid. If the counters cannot be opened a warning is logged and profiling continues
+// without them.
+// Counters are summed over the threads of the process, so the values are only meaningful with the sequential
+// execution mode where one kernel runs at a time.
+//
+// Option values:
+// - "0": Hardware performance counters are not collected. [DEFAULT]
+// - "1": Hardware performance counters are collected.
+static const char* const kOrtSessionOptionsConfigProfilingHardwareCounters = "session.profiling_hardware_counters";
+
+// TunableOp of the CPU execution provider. The blocking and threading parameters of the MLAS single precision GEMM
+// used by the Gemm and MatMul kernels are selected per class of problem shapes from the tuning results of the
+// session, which are bound to the processor model they were produced on.
+// With tuning enabled, the parameters of a class of shapes missing from the tuning results are found on first use by
+// timing the candidates, at most for the max tuning duration per candidate. The tuning results can then be
+// retrieved with InferenceSession::GetTuningResults (get_tuning_results in python) and embedded into the model with
+// onnxruntime/python/tools/offline_tuning.py, in which case they are loaded and TunableOp is enabled when the model is
+// loaded on the same processor model.
+//
+// Option values:
+// - "0": TunableOp is disabled, the built-in heuristic is used. [DEFAULT]
+// - "1": TunableOp is enabled and uses the tuning results of the session.
+static const char* const kOrtSessionOptionsConfigCpuTunableOpEnable = "session.cpu_tunable_op_enable";
+
+// Option values:
+// - "0": Tuning is disabled. [DEFAULT]
+// - "1": Tuning is enabled, TunableOp must be enabled as well.
+static const char* const kOrtSessionOptionsConfigCpuTunableOpTuningEnable = "session.cpu_tunable_op_tuning_enable";
+
+// Maximum duration in milliseconds to time each candidate when tuning. "0" means no limit. [DEFAULT: "0"]
+static const char* const kOrtSessionOptionsConfigCpuTunableOpMaxTuningDurationMs =
+    "session.cpu_tunable_op_max_tuning_duration_ms";
@@ -13,6 +13,7 @@ import java.nio.FloatBuffer;
 import java.nio.IntBuffer;
 import java.nio.LongBuffer;
 import java.nio.ShortBuffer;
+import java.util.Optional;
 
 /**
  * A Java object wrapping an OnnxTensor. Tensors are the main input to the library, and can also be
@@ -112,6 +113,35 @@ public class OnnxTensor extends OnnxTensorLike {
     close(OnnxRuntime.ortApiHandle, nativeHandle);
   }
 
+  /**
+   * Returns a view of the buffer backing this tensor, if it is backed by a Java direct buffer.
+   *
+   * <p>For a tensor that is pinned as an output of {@link OrtSession#run(java.util.Map,
+   * java.util.Map)} the view contains the output written by the last run. The view shares the
+   * memory of the tensor, so it must not be used after the tensor is closed.
+   *
+   * @return Optional.of a view of the backing buffer, or Optional.empty if the tensor memory is
+   *     owned by ORT.
+   */
+  public Optional<Buffer> getBufferRef() {
+    // Buffer.duplicate is not available on Java 8, so the view is created from the concrete type.
+    if (buffer instanceof ByteBuffer) {
+      return Optional.of(((ByteBuffer) buffer).duplicate().order(ByteOrder.nativeOrder()));
+    } else if (buffer instanceof FloatBuffer) {
+      return Optional.of(((FloatBuffer) buffer).duplicate());
+    } else if (buffer instanceof DoubleBuffer) {
+      return Optional.of(((DoubleBuffer) buffer).duplicate());
+    } else if (buffer instanceof ShortBuffer) {
+      return Optional.of(((ShortBuffer) buffer).duplicate());
+    } else if (buffer instanceof IntBuffer) {
+      return Optional.of(((IntBuffer) buffer).duplicate());
+    } else if (buffer instanceof LongBuffer) {
+      return Optional.of(((LongBuffer) buffer).duplicate());
+    } else {
+      return Optional.empty();
+    }
+  }
+
   /**
    * Returns a copy of the underlying OnnxTensor as a ByteBuffer.
    *
@@ -81,11 +81,13 @@ public class OrtException extends Exception {
     /** The ONNX graph is invalid. */
     ORT_INVALID_GRAPH(10),
     /** The ORT execution provider failed. */
-    ORT_EP_FAIL(11);
+    ORT_EP_FAIL(11),
+    /** The operation did not finish before its deadline. */
+    ORT_DEADLINE_EXCEEDED(12);
 
     private final int value;
 
-    private static final OrtErrorCode[] values = new OrtErrorCode[12];
+    private static final OrtErrorCode[] values = new OrtErrorCode[13];
 
     static {
       for (OrtErrorCode ot : OrtErrorCode.values()) {
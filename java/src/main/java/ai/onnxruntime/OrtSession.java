@@ -14,6 +14,7 @@ import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collections;
 import java.util.EnumSet;
+import java.util.IdentityHashMap;
 import java.util.Iterator;
 import java.util.LinkedHashMap;
 import java.util.LinkedHashSet;
@@ -259,17 +260,87 @@ public class OrtSession implements AutoCloseable {
       Set<String> requestedOutputs,
       RunOptions runOptions)
       throws OrtException {
+    return run(inputs, requestedOutputs, Collections.emptyMap(), runOptions);
+  }
+
+  /**
+   * Scores an input feed dict, writing the outputs in the supplied map into the pinned tensors and
+   * returning the map of all outputs.
+   *
+   * <p>The pinned outputs are typically created once from direct buffers with {@link
+   * OnnxTensor#createTensor(OrtEnvironment, java.nio.FloatBuffer, long[])} and reused across runs, so the
+   * outputs are written in place without allocating or copying. They must have the type and shape
+   * the model produces. The pinned outputs are returned in the {@link Result} after the other
+   * outputs, and are not closed when the {@link Result} is closed.
+   *
+   * @param inputs The inputs to score.
+   * @param pinnedOutputs The outputs to write into.
+   * @return The inferred outputs.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public Result run(
+      Map<String, ? extends OnnxTensorLike> inputs, Map<String, ? extends OnnxTensor> pinnedOutputs)
+      throws OrtException {
+    return run(inputs, pinnedOutputs, null);
+  }
+
+  /**
+   * Scores an input feed dict, writing the outputs in the supplied map into the pinned tensors and
+   * returning the map of all outputs.
+   *
+   * <p>See {@link #run(Map, Map)} for the requirements on the pinned outputs.
+   *
+   * @param inputs The inputs to score.
+   * @param pinnedOutputs The outputs to write into.
+   * @param runOptions The RunOptions to control this run.
+   * @return The inferred outputs.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public Result run(
+      Map<String, ? extends OnnxTensorLike> inputs,
+      Map<String, ? extends OnnxTensor> pinnedOutputs,
+      RunOptions runOptions)
+      throws OrtException {
+    Set<String> requestedOutputs = new LinkedHashSet<>(outputNames);
+    requestedOutputs.removeAll(pinnedOutputs.keySet());
+    return run(inputs, requestedOutputs, pinnedOutputs, runOptions);
+  }
+
+  /**
+   * Scores an input feed dict, writing the outputs in the supplied map into the pinned tensors and
+   * returning the map of requested and pinned outputs.
+   *
+   * <p>The requested outputs are sorted based on the supplied set traversal order, followed by the
+   * pinned outputs. See {@link #run(Map, Map)} for the requirements on the pinned outputs.
+   *
+   * @param inputs The inputs to score.
+   * @param requestedOutputs The requested outputs, which must not contain the pinned outputs.
+   * @param pinnedOutputs The outputs to write into.
+   * @param runOptions The RunOptions to control this run.
+   * @return The inferred outputs.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public Result run(
+      Map<String, ? extends OnnxTensorLike> inputs,
+      Set<String> requestedOutputs,
+      Map<String, ? extends OnnxTensor> pinnedOutputs,
+      RunOptions runOptions)
+      throws OrtException {
     if (!closed) {
       if ((inputs.isEmpty() && (numInputs != 0)) || (inputs.size() > numInputs)) {
         throw new OrtException(
             "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
       }
-      if (requestedOutputs.isEmpty() || (requestedOutputs.size() > numOutputs)) {
+      int totalOutputs = requestedOutputs.size() + pinnedOutputs.size();
+      if ((totalOutputs == 0) || (totalOutputs > numOutputs)) {
         throw new OrtException(
-            "Unexpected number of requestedOutputs, expected [1,"
+            "Unexpected number of requestedOutputs and pinnedOutputs, expected [1,"
                 + numOutputs
                 + ") found "
-                + requestedOutputs.size());
+                + totalOutputs);
       }
       String[] inputNamesArray = new String[inputs.size()];
       long[] inputHandles = new long[inputs.size()];
@@ -284,16 +355,29 @@ public class OrtSession implements AutoCloseable {
               "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
         }
       }
-      String[] outputNamesArray = new String[requestedOutputs.size()];
+      String[] outputNamesArray = new String[totalOutputs];
+      long[] outputHandles = new long[totalOutputs];
+      OnnxValue[] pinnedOutputValues = new OnnxValue[totalOutputs];
       i = 0;
       for (String s : requestedOutputs) {
-        if (outputNames.contains(s)) {
-          outputNamesArray[i] = s;
-          i++;
-        } else {
+        if (!outputNames.contains(s)) {
           throw new OrtException(
               "Unknown output name " + s + ", expected one of " + outputNames.toString());
+        } else if (pinnedOutputs.containsKey(s)) {
+          throw new OrtException("Output " + s + " is both requested and pinned.");
+        }
+        outputNamesArray[i] = s;
+        i++;
+      }
+      for (Map.Entry<String, ? extends OnnxTensor> t : pinnedOutputs.entrySet()) {
+        if (!outputNames.contains(t.getKey())) {
+          throw new OrtException(
+              "Unknown output name " + t.getKey() + ", expected one of " + outputNames.toString());
         }
+        outputNamesArray[i] = t.getKey();
+        outputHandles[i] = t.getValue().getNativeHandle();
+        pinnedOutputValues[i] = t.getValue();
+        i++;
       }
       long runOptionsHandle = runOptions == null ? 0 : runOptions.getNativeHandle();
 
@@ -306,9 +390,18 @@ public class OrtSession implements AutoCloseable {
               inputHandles,
               inputNamesArray.length,
               outputNamesArray,
+              outputHandles,
               outputNamesArray.length,
               runOptionsHandle);
-      return new Result(outputNamesArray, outputValues);
+      boolean[] ownedByResult = new boolean[totalOutputs];
+      for (i = 0; i < totalOutputs; i++) {
+        if (pinnedOutputValues[i] != null) {
+          outputValues[i] = pinnedOutputValues[i];
+        } else {
+          ownedByResult[i] = true;
+        }
+      }
+      return new Result(outputNamesArray, outputValues, ownedByResult);
     } else {
       throw new IllegalStateException("Trying to score a closed OrtSession.");
     }
@@ -419,9 +512,10 @@ public class OrtSession implements AutoCloseable {
    * @param inputs The input tensors.
    * @param numInputs The number of inputs.
    * @param outputNamesArray The requested output names.
+   * @param outputs The pinned output tensors, zero for the outputs that are not pinned.
    * @param numOutputs The number of requested outputs.
    * @param runOptionsHandle The (possibly null) pointer to the run options.
-   * @return The OnnxValues produced by this run.
+   * @return The OnnxValues produced by this run, null for the pinned outputs.
    * @throws OrtException If the native call failed in some way.
    */
   private native OnnxValue[] run(
@@ -432,6 +526,7 @@ public class OrtSession implements AutoCloseable {
       long[] inputs,
       long numInputs,
       String[] outputNamesArray,
+      long[] outputs,
       long numOutputs,
       long runOptionsHandle)
       throws OrtException;
@@ -1429,6 +1524,8 @@ public class OrtSession implements AutoCloseable {
 
     private final List<OnnxValue> list;
 
+    private final Set<OnnxValue> owned;
+
     private boolean closed;
 
     /**
@@ -1438,6 +1535,17 @@ public class OrtSession implements AutoCloseable {
      * @param values The output values.
      */
     Result(String[] names, OnnxValue[] values) {
+      this(names, values, null);
+    }
+
+    /**
+     * Creates a Result from the names and values produced by {@link OrtSession#run(Map, Map)}.
+     *
+     * @param names The output names.
+     * @param values The output values.
+     * @param ownedByResult Whether the Result closes each value, null if it closes all of them.
+     */
+    Result(String[] names, OnnxValue[] values, boolean[] ownedByResult) {
       if (names.length != values.length) {
         throw new IllegalArgumentException(
             "Expected same number of names and values, found names.length = "
@@ -1448,20 +1556,30 @@ public class OrtSession implements AutoCloseable {
 
       map = new LinkedHashMap<>(OrtUtil.capacityFromSize(names.length));
       list = new ArrayList<>(names.length);
+      owned = Collections.newSetFromMap(new IdentityHashMap<>());
 
       for (int i = 0; i < names.length; i++) {
         map.put(names[i], values[i]);
         list.add(values[i]);
+        if ((ownedByResult == null) || ownedByResult[i]) {
+          owned.add(values[i]);
+        }
       }
       this.closed = false;
     }
 
+    /**
+     * Closes the outputs, except for the pinned outputs which are owned by the caller of {@link
+     * OrtSession#run(Map, Map)}.
+     */
     @Override
     public void close() {
       if (!closed) {
         closed = true;
         for (OnnxValue t : map.values()) {
-          t.close();
+          if (owned.contains(t)) {
+            t.close();
+          }
         }
       } else {
         logger.warning("Closing an already closed Result");
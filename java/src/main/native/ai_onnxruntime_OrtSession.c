@@ -316,14 +316,15 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_getOutputInfo(JNIE
 /*
  * Class:     ai_onnxruntime_OrtSession
  * Method:    run
- * Signature: (JJJ[Ljava/lang/String;[JJ[Ljava/lang/String;JJ)[Lai/onnxruntime/OnnxValue;
- * private native OnnxValue[] run(long apiHandle, long nativeHandle, long allocatorHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long numOutputs)
+ * Signature: (JJJ[Ljava/lang/String;[JJ[Ljava/lang/String;[JJJ)[Lai/onnxruntime/OnnxValue;
+ * private native OnnxValue[] run(long apiHandle, long nativeHandle, long allocatorHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long[] outputs, long numOutputs, long runOptionsHandle)
  */
 JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run(JNIEnv* jniEnv, jobject jobj, jlong apiHandle,
                                                                   jlong sessionHandle, jlong allocatorHandle,
                                                                   jobjectArray inputNamesArr, jlongArray tensorArr,
                                                                   jlong numInputs, jobjectArray outputNamesArr,
-                                                                  jlong numOutputs, jlong runOptionsHandle) {
+                                                                  jlongArray outputTensorArr, jlong numOutputs,
+                                                                  jlong runOptionsHandle) {
 
   (void)jobj;  // Required JNI parameter not needed by functions which don't need to access their host object.
   const OrtApi* api = (const OrtApi*)apiHandle;
@@ -376,13 +377,20 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run(JNIEnv* jniEnv
   // Release the java array copy of pointers to the tensors.
   (*jniEnv)->ReleaseLongArrayElements(jniEnv, tensorArr, inputValueLongs, JNI_ABORT);
 
+  // Extract the pointers to the pinned output tensors, which are zero for the outputs that are not pinned.
+  // ORT writes the pinned outputs into the supplied tensors instead of allocating new ones.
+  jlong* outputValueLongs = (*jniEnv)->GetLongArrayElements(jniEnv, outputTensorArr, NULL);
+
   // Extract the names of the output values.
   for (int i = 0; i < numOutputs; i++) {
     javaOutputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv, outputNamesArr, i);
     outputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv, javaOutputStrings[i], NULL);
-    outputValues[i] = NULL;
+    outputValues[i] = (OrtValue*)outputValueLongs[i];
   }
 
+  // Release the java array copy of pointers to the pinned tensors.
+  (*jniEnv)->ReleaseLongArrayElements(jniEnv, outputTensorArr, outputValueLongs, JNI_ABORT);
+
   // Actually score the inputs.
   // ORT_API_STATUS(OrtRun, _Inout_ OrtSession* sess, _In_ OrtRunOptions* run_options,
   // _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
@@ -398,9 +406,10 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run(JNIEnv* jniEnv
   jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, ORTJNI_OnnxValueClassName);
   outputArray = (*jniEnv)->NewObjectArray(jniEnv, safecast_int64_to_jsize(numOutputs), onnxValueClass, NULL);
 
-  // Convert the output tensors into ONNXValues
+  // Convert the output tensors into ONNXValues, the pinned outputs are left as null and filled in on the Java side.
+  jlong* pinnedValueLongs = (*jniEnv)->GetLongArrayElements(jniEnv, outputTensorArr, NULL);
   for (int i = 0; i < numOutputs; i++) {
-    if (outputValues[i] != NULL) {
+    if (outputValues[i] != NULL && pinnedValueLongs[i] == 0) {
       jobject onnxValue = convertOrtValueToONNXValue(jniEnv, api, allocator, outputValues[i]);
       if (onnxValue == NULL) {
         break;  // go to cleanup, exception thrown
@@ -408,6 +417,7 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run(JNIEnv* jniEnv
       (*jniEnv)->SetObjectArrayElement(jniEnv, outputArray, i, onnxValue);
     }
   }
+  (*jniEnv)->ReleaseLongArrayElements(jniEnv, outputTensorArr, pinnedValueLongs, JNI_ABORT);
 
   // Note these gotos are in a specific order so they mirror the allocation pattern above.
   // They must be changed if the allocation code is rearranged.
@@ -8,6 +8,7 @@ import static org.junit.jupiter.api.Assertions.assertArrayEquals;
 import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertNotNull;
 import static org.junit.jupiter.api.Assertions.assertSame;
+import static org.junit.jupiter.api.Assertions.assertThrows;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 import static org.junit.jupiter.api.Assertions.fail;
 
@@ -749,6 +750,47 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void testPinnedOutputs() throws OrtException {
+    String modelPath = TestHelpers.getResourcePath("/java-matmul.onnx").toString();
+
+    try (SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options)) {
+      FloatBuffer outputBuffer =
+          ByteBuffer.allocateDirect(4 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+      try (OnnxTensor output = OnnxTensor.createTensor(env, outputBuffer, new long[] {1, 4})) {
+        Map<String, OnnxTensor> pinnedOutputs = Collections.singletonMap("output", output);
+        // The pinned output is reused across runs, and is written in place.
+        for (int i = 1; i <= 2; i++) {
+          try (OnnxTensor t = OnnxTensor.createTensor(env, new float[][] {{i, 0, 0, 0}});
+              OrtSession.Result res =
+                  session.run(Collections.singletonMap("input", t), pinnedOutputs)) {
+            assertEquals(1, res.size());
+            assertSame(output, res.get(0));
+            float[] outputArr = new float[4];
+            outputBuffer.duplicate().get(outputArr);
+            assertArrayEquals(new float[] {i, 2 * i, 3 * i, 4 * i}, outputArr);
+            FloatBuffer bufferRef = (FloatBuffer) output.getBufferRef().get();
+            assertEquals((float) i, bufferRef.get(0));
+          }
+          // Closing the result does not close the pinned output
+          assertArrayEquals(new float[] {i, 2 * i, 3 * i, 4 * i}, output.getFloatBuffer().array());
+        }
+
+        try (OnnxTensor t = OnnxTensor.createTensor(env, new float[][] {{1, 0, 0, 0}})) {
+          assertThrows(
+              OrtException.class,
+              () ->
+                  session.run(
+                      Collections.singletonMap("input", t),
+                      session.getOutputNames(),
+                      pinnedOutputs,
+                      null));
+        }
+      }
+    }
+  }
+
   private static File getTestModelsDir() throws IOException {
     // get build directory, append downloaded models location
     String cwd = System.getProperty("user.dir");
@@ -75,20 +75,10 @@ class Gelu : public OpKernel {
         tp, static_cast<int32_t>(task_count),
         [&](ptrdiff_t task_idx) {
           const auto start = task_idx * length_per_task;
-          const T* p_input = input_data + start;
-          T* p_output = output_data + start;
           int64_t count = std::min(length_per_task, elem_count - start);
 
-          for (int64_t i = 0; i < count; i++) {
-            T value = p_input[i];
-            p_output[i] = value * static_cast<T>(M_SQRT1_2);
-          }
-
-          MlasComputeErf(p_output, p_output, narrow<size_t>(count));
-
-          for (int64_t i = 0; i < count; i++) {
-            p_output[i] = 0.5f * p_input[i] * (p_output[i] + 1.0f);
-          }
+          MlasComputeGeluSilu(MlasGeluErfActivation, input_data + start, nullptr, output_data + start,
+                              narrow<size_t>(count), 1.0f);
         },
         0);
     return Status::OK();
@@ -96,7 +86,7 @@ class Gelu : public OpKernel {
 };
 
 // Implement a new one instead of inheriting from ElementWiseRangedTransform so that we can call
-// MlasComputeLogistic instead of using Eigen for better perf.
+// the single pass MLAS SiLU kernel instead of using Eigen for better perf.
 template <typename T>
 class QuickGelu : public OpKernel {
  public:
@@ -115,18 +105,10 @@ class QuickGelu : public OpKernel {
         tp, static_cast<int32_t>(task_count),
         [&](ptrdiff_t task_idx) {
           const auto start = task_idx * length_per_task;
-          const T* p_input = input_data + start;
-          T* p_output = output_data + start;
           int64_t count = std::min(length_per_task, elem_count - start);
-          for (int64_t i = 0; i < count; i++) {
-            p_output[i] = p_input[i] * alpha_;
-          }
-
-          MlasComputeLogistic(p_output, p_output, onnxruntime::narrow<size_t>(count));
 
-          for (int64_t i = 0; i < count; i++) {
-            p_output[i] = p_input[i] * p_output[i];
-          }
+          MlasComputeGeluSilu(MlasSiluActivation, input_data + start, nullptr, output_data + start,
+                              onnxruntime::narrow<size_t>(count), alpha_);
         },
         0);
     return Status::OK();
@@ -132,6 +132,15 @@ constexpr const char* kMinSeqLenForFlashAttentionPackedQKV = "ORT_MIN_SEQ_LEN_FL
 // Default value for the above setting.
 constexpr int kDefaultMinSeqLenForFlashAttentionPackedQKV = 513;
 
+// Environment variable to enable or disable the fused attention of the CPU kernels. Default is 0 (enabled).
+constexpr const char* kDisableCpuFlashAttention = "ORT_DISABLE_CPU_FLASH_ATTENTION";
+
+// Minimum total sequence length to use the fused attention of the CPU kernels instead of materializing the
+// attention probabilities.
+constexpr const char* kMinSeqLenForCpuFlashAttention = "ORT_MIN_SEQ_LEN_CPU_FLASH_ATTENTION";
+// Default value for the above setting.
+constexpr int kDefaultMinSeqLenForCpuFlashAttention = 256;
+
 }  // namespace attention
 
 }  // namespace contrib
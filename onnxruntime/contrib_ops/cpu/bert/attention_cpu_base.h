@@ -3,12 +3,16 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "attention_base.h"
 #include "attention_helper.h"
 
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/env_var_utils.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -16,7 +20,11 @@ namespace contrib {
 class AttentionCPUBase : public AttentionBase {
  protected:
   AttentionCPUBase(const OpKernelInfo& info, bool require_same_hidden_size)
-      : AttentionBase(info, require_same_hidden_size) {}
+      : AttentionBase(info, require_same_hidden_size) {
+    disable_flash_attention_ = ParseEnvironmentVariableWithDefault<bool>(attention::kDisableCpuFlashAttention, false);
+    min_seq_len_for_flash_attention_ = ParseEnvironmentVariableWithDefault<int>(
+        attention::kMinSeqLenForCpuFlashAttention, attention::kDefaultMinSeqLenForCpuFlashAttention);
+  }
 
   template <typename T>
   Status ApplyAttention(const T* Q,                            // Q data with shape BxNxSxH
@@ -53,6 +61,23 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
+    if constexpr (std::is_same_v<T, float>) {
+      // The fused attention does not materialize the BxNxSxT attention probabilities. The past state is only
+      // supported when it is concatenated to the present K and V outputs.
+      const bool has_past = past != nullptr || past_key != nullptr;
+      const bool has_present = present != nullptr || (present_key != nullptr && present_value != nullptr);
+      if (!disable_flash_attention_ &&
+          total_sequence_length >= min_seq_len_for_flash_attention_ &&
+          (mask_index == nullptr || mask_index->Shape().NumDimensions() != 4) &&
+          (!has_past || has_present)) {
+        return ApplyFlashAttention(Q, K, V, mask_index, past, past_key, past_value, output,
+                                   present, present_key, present_value,
+                                   batch_size, sequence_length, kv_sequence_length, past_sequence_length,
+                                   qk_head_size == 0 ? v_head_size : qk_head_size, v_head_size,
+                                   relative_position_bias, std::move(allocator), tp);
+      }
+    }
+
     // Compute the attention score.
     size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
     auto attention_probs = allocator->Alloc(bytes);
@@ -105,6 +130,114 @@ class AttentionCPUBase : public AttentionBase {
   }
 
  private:
+  bool disable_flash_attention_;
+  int min_seq_len_for_flash_attention_;
+
+  // Computes the attention with the fused MLAS kernel, which tiles K and V and accumulates the softmax online:
+  //  output(B, S, N, H_v) = Softmax(1/sqrt(H) x Q x K' + relative_position_bias + mask) x V
+  Status ApplyFlashAttention(const float* Q,                       // Q data with shape BxNxSxH
+                             const float* K,                       // K data with shape BxNxLxH
+                             const float* V,                       // V value with size BxNxLxH_v
+                             const Tensor* mask_index,             // mask index. nullptr if no mask
+                             const Tensor* past,                   // past state
+                             const Tensor* past_key,               // past K input tensor (if not using past state)
+                             const Tensor* past_value,             // past V input tensor (if not using past state)
+                             Tensor* output,                       // output tensor
+                             Tensor* present,                      // present state
+                             Tensor* present_key,                  // present K output tensor
+                             Tensor* present_value,                // present V output tensor
+                             int batch_size,                       // batch size (B)
+                             int sequence_length,                  // sequence length of Q (S)
+                             int kv_sequence_length,               // sequence length of K or V (L)
+                             int past_sequence_length,             // sequence length of past state (P)
+                             int qk_head_size,                     // head size of Q or K (H)
+                             int v_head_size,                      // head size of V (H_v)
+                             const Tensor* relative_position_bias, // bias addition in QK. Its size is BxNxSxT
+                             AllocatorPtr allocator,
+                             ThreadPool* tp) const {
+    const int total_sequence_length = past_sequence_length + kv_sequence_length;
+    const ptrdiff_t batch_heads = SafeInt<ptrdiff_t>(batch_size) * num_heads_;
+
+    // Concatenate the past and current K and V into the present state, which is then used as K and V. The present
+    // K and V outputs are optional independently of each other, so each of them is only written if it is requested.
+    const float* past_data = past != nullptr ? past->Data<float>() : nullptr;
+    const float* past_k = past_key != nullptr ? past_key->Data<float>() : past_data;
+    const float* past_v = past_value != nullptr ? past_value->Data<float>() : nullptr;
+    float* present_k = present_key != nullptr ? present_key->MutableData<float>() : nullptr;
+    float* present_v = present_value != nullptr ? present_value->MutableData<float>() : nullptr;
+    if (present != nullptr) {
+      if (past_data != nullptr) {
+        past_v = past_data + SafeInt<ptrdiff_t>(batch_heads) * past_sequence_length * v_head_size;
+      }
+      present_k = present->MutableData<float>();
+      present_v = present_k + SafeInt<ptrdiff_t>(batch_heads) * total_sequence_length * v_head_size;
+    }
+
+    if (present_k != nullptr || present_v != nullptr) {
+      const size_t past_k_chunk_length = static_cast<size_t>(past_sequence_length) * qk_head_size;
+      const size_t present_k_chunk_length = static_cast<size_t>(total_sequence_length) * qk_head_size;
+      const size_t past_v_chunk_length = static_cast<size_t>(past_sequence_length) * v_head_size;
+      const size_t present_v_chunk_length = static_cast<size_t>(total_sequence_length) * v_head_size;
+      const double cost = static_cast<double>(total_sequence_length) *
+                          ((present_k != nullptr ? qk_head_size : 0) + (present_v != nullptr ? v_head_size : 0));
+
+      ThreadPool::TryParallelFor(tp, batch_heads, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          if (present_k != nullptr) {
+            ConcatStateChunk(past_k, K + static_cast<size_t>(kv_sequence_length) * qk_head_size * i, present_k,
+                             past_k_chunk_length, present_k_chunk_length, i);
+          }
+          if (present_v != nullptr) {
+            ConcatStateChunk(past_v, V + static_cast<size_t>(kv_sequence_length) * v_head_size * i, present_v,
+                             past_v_chunk_length, present_v_chunk_length, i);
+          }
+        }
+      });
+
+      K = present_k != nullptr ? present_k : K;
+      V = present_v != nullptr ? present_v : V;
+    }
+
+    MLAS_FLASH_ATTENTION_PARAMS params;
+    params.BatchSize = static_cast<size_t>(batch_size);
+    params.NumHeads = static_cast<size_t>(num_heads_);
+    params.SequenceLength = static_cast<size_t>(sequence_length);
+    params.KvSequenceLength = static_cast<size_t>(total_sequence_length);
+    params.QkHeadSize = static_cast<size_t>(qk_head_size);
+    params.VHeadSize = static_cast<size_t>(v_head_size);
+    params.Scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(qk_head_size)) : scale_;
+    params.Query = Q;
+    params.Key = K;
+    params.Value = V;
+    params.Bias = relative_position_bias != nullptr ? relative_position_bias->Data<float>() : nullptr;
+    params.Causal = is_unidirectional_ && sequence_length > 1;
+    params.CausalOffset = static_cast<size_t>(past_sequence_length);
+    params.Output = output->MutableData<float>();
+
+    // The causal mask is applied by the kernel. Masks other than 3D are the same for all the query rows, so only
+    // their (Bx)T additive form is prepared.
+    BufferUniquePtr mask_data_buffer(nullptr, BufferDeleter(allocator));
+    if (mask_index != nullptr) {
+      const bool is_3d_mask = mask_index->Shape().NumDimensions() == 3;
+      const int mask_rows = is_3d_mask ? sequence_length : 1;
+      const size_t mask_data_bytes = SafeInt<size_t>(batch_size) * mask_rows * total_sequence_length * sizeof(float);
+      float* mask_data = static_cast<float*>(allocator->Alloc(mask_data_bytes));
+      mask_data_buffer.reset(mask_data);
+      memset(mask_data, 0, mask_data_bytes);
+
+      PrepareMask(mask_index->Data<int32_t>(), mask_index->Shape().GetDims(), mask_data, false, batch_size,
+                  mask_rows, total_sequence_length - mask_rows, mask_filter_value_);
+
+      params.Mask = mask_data;
+      params.MaskBatchStride = static_cast<size_t>(mask_rows) * total_sequence_length;
+      params.MaskRowStride = is_3d_mask ? static_cast<size_t>(total_sequence_length) : 0;
+    }
+
+    MlasFlashAttention(&params, tp);
+
+    return Status::OK();
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) +
   //                                1 x mask_data(B, N, S, T)
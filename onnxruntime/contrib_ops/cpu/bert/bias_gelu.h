@@ -16,7 +16,7 @@ class BiasGelu : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  protected:
-  void AddBiasGelu(const T* input, const T* bias, T* temp, T* output, int64_t count) const;
+  void AddBiasGelu(const T* input, const T* bias, T* output, int64_t count) const;
 };
 
 }  // namespace contrib
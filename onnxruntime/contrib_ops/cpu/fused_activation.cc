@@ -17,6 +17,10 @@ common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION&
       activation.ActivationKind = MlasTanhActivation;
     } else if (activation_type == "Sigmoid") {
       activation.ActivationKind = MlasLogisticActivation;
+    } else if (activation_type == "Gelu") {
+      activation.ActivationKind = MlasGeluErfActivation;
+    } else if (activation_type == "FastGelu") {
+      activation.ActivationKind = MlasGeluTanhActivation;
     } else {
       // The remaining activation types have additional parameters to be pulled out.
       size_t activation_params_count;
@@ -29,6 +33,9 @@ common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION&
       } else if (activation_type == "HardSigmoid") {
         activation.ActivationKind = MlasHardSigmoidActivation;
         activation_params_count = 2;
+      } else if (activation_type == "QuickGelu") {
+        activation.ActivationKind = MlasSiluActivation;
+        activation_params_count = 1;
       } else {
         return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "unimplemented activation: " + activation_type);
       }
@@ -40,6 +47,13 @@ common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION&
       } else if (activation_params_count != activation_params.size()) {
         return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "activation_params count mismatch");
       }
+      if (activation.ActivationKind == MlasSiluActivation) {
+        // MLAS implements x * sigmoid(x), which is QuickGelu with alpha 1.
+        if (activation_params[0] != 1.0f) {
+          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "unimplemented QuickGelu alpha");
+        }
+        return Status::OK();
+      }
       for (size_t i = 0; i < activation_params_count; i++) {
         activation.Parameters.Values[i] = activation_params[i];
       }
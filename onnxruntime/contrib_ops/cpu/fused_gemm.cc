@@ -9,11 +9,46 @@ namespace contrib {
 constexpr const char* ACTIVATION_NAME_PREFIX = "activation_";
 constexpr size_t ACTIVATION_NAME_PREFIX_LEN = 11;
 
+namespace {
+
+// Returns the activation of the epilogue of the MLAS GEMM for the fused activation, if MLAS implements it.
+bool GetMlasActivation(const std::string& activation, const OpKernelInfo& info, MLAS_ACTIVATION& mlas_activation) {
+  if (activation == "Relu") {
+    mlas_activation.ActivationKind = MlasReluActivation;
+  } else if (activation == "Tanh") {
+    mlas_activation.ActivationKind = MlasTanhActivation;
+  } else if (activation == "Sigmoid") {
+    mlas_activation.ActivationKind = MlasLogisticActivation;
+  } else if (activation == "LeakyRelu") {
+    mlas_activation.ActivationKind = MlasLeakyReluActivation;
+    mlas_activation.Parameters.LeakyRelu.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.01f);
+  } else if (activation == "HardSigmoid") {
+    mlas_activation.ActivationKind = MlasHardSigmoidActivation;
+    mlas_activation.Parameters.HardSigmoid.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.2f);
+    mlas_activation.Parameters.HardSigmoid.beta = info.GetAttrOrDefault<float>("activation_beta", 0.5f);
+  } else if (activation == "Gelu") {
+    mlas_activation.ActivationKind = MlasGeluErfActivation;
+  } else if (activation == "FastGelu") {
+    mlas_activation.ActivationKind = MlasGeluTanhActivation;
+  } else if (activation == "QuickGelu" && info.GetAttrOrDefault<float>("activation_alpha", 1.702f) == 1.0f) {
+    mlas_activation.ActivationKind = MlasSiluActivation;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 template <typename T>
 class FusedGemm final : public Gemm<T> {
  public:
   FusedGemm(const OpKernelInfo& info) : Gemm<T>(info) {
     std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+    if (GetMlasActivation(activation, info, this->mlas_activation_)) {
+      return;
+    }
+
     NodeAttributes attrs;
     for (const auto& p : info.node().GetAttributes()) {
       if (p.first.size() > ACTIVATION_NAME_PREFIX_LEN && p.first.compare(0, ACTIVATION_NAME_PREFIX_LEN, ACTIVATION_NAME_PREFIX) == 0) {
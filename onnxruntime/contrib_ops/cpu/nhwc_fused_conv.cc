@@ -0,0 +1,455 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//
+// This file contains implementation of a fp32 NHWC convolution operator.
+//
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/util/math.h"
+
+#include "contrib_ops/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using ConvPadVector = ConvAttributes::ConvPadVector;
+
+/**
+ * @brief NhwcFusedConv Operator for FP32 tensors
+ *
+ * Input and output are in channels last layout. The optional input Sum, a tensor
+ * of the output shape, is added to the output BEFORE the fused activation.
+ *
+ * Output pixels are partitioned across the threads. For each slice, the input
+ * pixels are addressed through an indirection buffer instead of an im2col copy,
+ * the filter is packed once by PrePack, and the bias and activation are applied
+ * by the GEMM epilogue while the output tile is still in cache.
+ */
+class NhwcFusedConvFloat final : public OpKernel {
+ public:
+  NhwcFusedConvFloat(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+ private:
+  /**
+   * @brief Reorder filter data from (M x C/group x kH x kW) to (kH x kW x C/group) x M,
+   *        forming a matrix of M columns, where each kernel is a single column in
+   *        channel last format.
+   */
+  static void ReorderFilter(const float* input,
+                            float* output,
+                            size_t output_channels,
+                            size_t input_channels,
+                            size_t kernel_size) {
+    for (size_t k = 0; k < kernel_size; k++) {
+      for (size_t ic = 0; ic < input_channels; ic++) {
+        for (size_t oc = 0; oc < output_channels; oc++) {
+          size_t index = (oc * input_channels * kernel_size) + (ic * kernel_size) + k;
+          *output++ = input[index];
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Pack the filter of each group for MlasConvIndirect and MlasGemm.
+   *
+   * @param Wdata                  filter in the Conv operator layout
+   * @param packed_W               receives group_count packed matrices of packed_W_size bytes
+   * @param reordered_W            temporary buffer of group_output_channels x kernel_dim floats
+   */
+  static void PackFilter(const float* Wdata,
+                         uint8_t* packed_W,
+                         float* reordered_W,
+                         size_t group_count,
+                         size_t group_output_channels,
+                         size_t group_input_channels,
+                         size_t kernel_size,
+                         size_t packed_W_size) {
+    const size_t kernel_dim = group_input_channels * kernel_size;
+    for (size_t group_id = 0; group_id < group_count; ++group_id) {
+      ReorderFilter(Wdata, reordered_W, group_output_channels, group_input_channels, kernel_size);
+      MlasGemmPackB(CblasNoTrans, group_output_channels, kernel_dim, reordered_W, group_output_channels, packed_W);
+      packed_W += packed_W_size;
+      Wdata += group_output_channels * kernel_dim;
+    }
+  }
+
+  MLAS_ACTIVATION activation_;
+  ConvAttributes conv_attrs_;
+  TensorShape W_shape_;
+  BufferUniquePtr packed_W_buffer_;
+  bool is_W_packed_{false};
+  BufferUniquePtr reordered_W_buffer_;
+};
+
+Status NhwcFusedConvFloat::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                   /*out*/ bool& is_packed,
+                                   /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+  if (input_idx != 1) {
+    // Only pack filter tensor (aka weights)
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape().GetDims();
+  size_t rank = shape.size();
+  if (rank <= 2) {
+    return Status::OK();
+  }
+
+  const int64_t M = shape[0];
+  const int64_t C = shape[1];
+
+  // Verify that the total number of output channels is a multiple of the group count.
+  if (M % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  // Note: The tensor has already been allocated with this tensor shape, so all
+  // shape indices are guaranteed to fit inside size_t.
+  const size_t output_channels = static_cast<size_t>(M);
+  const size_t group_input_channels = static_cast<size_t>(C);
+  const size_t kernel_size =
+      static_cast<size_t>(std::accumulate(shape.data() + 2, shape.data() + rank, 1LL, std::multiplies<int64_t>()));
+
+  const auto* Wdata = tensor.Data<float>();
+  W_shape_ = shape;
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t group_output_channels = output_channels / group_count;
+  const size_t kernel_dim = group_input_channels * kernel_size;
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+
+  // Don't pack the filter buffer if the MlasConvDepthwise path is used.
+  if (!(group_input_channels == 1 && group_output_channels == 1)) {
+    const size_t packed_W_size = MlasGemmPackBSize(group_output_channels, kernel_dim);
+    size_t packed_W_data_size = SafeInt<size_t>(group_count) * packed_W_size;
+    auto* packed_W = static_cast<uint8_t*>(alloc->Alloc(packed_W_data_size));
+
+    // Initialize memory to 0 as there could be some padding associated with pre-packed
+    // buffer memory and we don not want it uninitialized and generate different hashes
+    // if and when we try to cache this pre-packed buffer for sharing between sessions.
+    memset(packed_W, 0, packed_W_data_size);
+
+    packed_W_buffer_ = BufferUniquePtr(packed_W, BufferDeleter(alloc));
+
+    // Allocate a temporary buffer to hold the reordered oihw->hwio filter for
+    // a single group.
+    auto* group_reordered_W = static_cast<float*>(
+        alloc->Alloc(SafeInt<size_t>(sizeof(float)) * group_output_channels * kernel_dim));
+    BufferUniquePtr group_reordered_W_buffer(group_reordered_W, BufferDeleter(alloc));
+
+    PackFilter(Wdata, packed_W, group_reordered_W, group_count, group_output_channels,
+               group_input_channels, kernel_size, packed_W_size);
+
+    if (share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_W_data_size);
+    }
+
+    is_W_packed_ = true;
+    is_packed = true;
+    return Status::OK();
+  }
+
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(nullptr);  // packed_W_buffer_ is nullptr
+    prepacked_weights->buffer_sizes_.push_back(0);
+  }
+
+  size_t reordered_w_data_size = SafeInt<size_t>(sizeof(float)) * output_channels * kernel_dim;
+  auto* reordered_W = static_cast<float*>(alloc->Alloc(reordered_w_data_size));
+  reordered_W_buffer_ = BufferUniquePtr(reordered_W, BufferDeleter(alloc));
+
+  ReorderFilter(Wdata, reordered_W, output_channels, group_input_channels, kernel_size);
+
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(reordered_W_buffer_));
+    prepacked_weights->buffer_sizes_.push_back(reordered_w_data_size);
+  }
+
+  is_W_packed_ = true;
+  is_packed = true;
+  return Status::OK();
+}
+
+Status NhwcFusedConvFloat::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                     int input_idx,
+                                                     /*out*/ bool& used_shared_buffers) {
+  if (input_idx != 1) {
+    // only the filter tensor is packed
+    return Status::OK();
+  }
+
+  used_shared_buffers = true;
+
+  if (prepacked_buffers.size() == 1) {  // This means that only packed_W_ exists
+    packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  } else if (prepacked_buffers.size() == 2) {  // This means that only reordered_W_ exists
+    // Enforce that the first "placeholder" buffer is nullptr
+    ORT_ENFORCE(prepacked_buffers[0].get() == nullptr);
+    reordered_W_buffer_ = std::move(prepacked_buffers[1]);
+  }
+
+  return Status::OK();
+}
+
+Status NhwcFusedConvFloat::Compute(OpKernelContext* context) const {
+  size_t num_inputs = OpKernel::Node().InputDefs().size();
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = is_W_packed_ ? nullptr : context->Input<Tensor>(1);
+  const auto& W_shape = W ? W->Shape() : W_shape_;
+  const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
+
+  // This tensor is added to the result BEFORE activation is applied
+  const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
+
+  const int64_t N = X->Shape()[0];
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape, true));
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+  const size_t kernel_rank = kernel_shape.size();
+
+  ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_rank * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+
+  const int64_t C = X->Shape()[1 + kernel_rank];
+
+  TensorShapeVector Y_dims({N});
+  TensorShape input_shape = X->Shape().Slice(1, 1 + kernel_rank);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(1, 1 + kernel_rank);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+  if (Sum && Sum->Shape() != Y->Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Z shape does not match output shape.",
+                           " Z: ", Sum->Shape().ToString().c_str(),
+                           " Output: ", Y->Shape().ToString().c_str());
+  }
+
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  const int64_t group_count = conv_attrs_.group;
+  const int64_t group_input_channels = W_shape[1];
+  const int64_t group_output_channels = M / group_count;
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+
+  // Test for depthwise convolution.
+  const bool is_depthwise_conv = (group_input_channels == 1 && group_output_channels == 1);
+
+  // Handle the case of a dynamic weight filter.
+  BufferUniquePtr dynamic_W_buffer;
+  const uint8_t* packed_W = static_cast<const uint8_t*>(packed_W_buffer_.get());
+  const float* reordered_W = static_cast<const float*>(reordered_W_buffer_.get());
+  const size_t packed_W_size = is_depthwise_conv
+                                   ? 0
+                                   : MlasGemmPackBSize(static_cast<size_t>(group_output_channels),
+                                                       static_cast<size_t>(kernel_dim));
+  if (W != nullptr) {
+    if (is_depthwise_conv) {
+      auto* dynamic_W = static_cast<float*>(alloc->Alloc(SafeInt<size_t>(sizeof(float)) * W_shape.Size()));
+      dynamic_W_buffer = BufferUniquePtr(dynamic_W, BufferDeleter(alloc));
+      ReorderFilter(W->Data<float>(), dynamic_W, static_cast<size_t>(M), 1, static_cast<size_t>(kernel_size));
+      reordered_W = dynamic_W;
+    } else {
+      auto* dynamic_W = static_cast<uint8_t*>(alloc->Alloc(SafeInt<size_t>(group_count) * packed_W_size));
+      dynamic_W_buffer = BufferUniquePtr(dynamic_W, BufferDeleter(alloc));
+      auto* group_reordered_W = static_cast<float*>(
+          alloc->Alloc(SafeInt<size_t>(sizeof(float)) * group_output_channels * kernel_dim));
+      BufferUniquePtr group_reordered_W_buffer(group_reordered_W, BufferDeleter(alloc));
+      PackFilter(W->Data<float>(), dynamic_W, group_reordered_W, static_cast<size_t>(group_count),
+                 static_cast<size_t>(group_output_channels), static_cast<size_t>(group_input_channels),
+                 static_cast<size_t>(kernel_size), packed_W_size);
+      packed_W = dynamic_W;
+    }
+  }
+
+  const int64_t X_offset = C * input_image_size;
+  const int64_t Y_offset = M * output_image_size;
+
+  const auto* Xdata = X->Data<float>();
+  const auto* Bdata = B != nullptr ? B->Data<float>() : nullptr;
+  auto* Ydata = Y->MutableData<float>();
+
+  // The Sum input is copied to the output, which is then accumulated into by
+  // the convolution, so that the epilogue adds the bias and applies the
+  // activation to the complete sum.
+  float beta = 0.0f;
+  if (Sum != nullptr) {
+    std::copy_n(Sum->Data<float>(), Y->Shape().Size(), Ydata);
+    beta = 1.0f;
+  }
+
+  // Pointwise convolutions can use the original input tensor in place,
+  // otherwise the input pixels are addressed through an indirection buffer.
+  const bool use_indirection_buffer =
+      is_depthwise_conv || kernel_size != 1 || !conv_attrs_.HasStridesOneAndNoPadding();
+
+  BufferUniquePtr indirection_buffer;
+  std::vector<float> padding_data;
+
+  if (use_indirection_buffer) {
+    // Allocate indirection buffer pointers and prepare a padding vector for
+    // the im2col transform.
+    auto* indirection_data =
+        alloc->Alloc(SafeInt<size_t>(sizeof(const float*)) * kernel_size * output_image_size);
+    indirection_buffer = BufferUniquePtr(indirection_data, BufferDeleter(alloc));
+    padding_data.resize(static_cast<size_t>(C), 0.0f);
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  // Partition the output pixels across the threads, keeping each slice large
+  // enough for the GEMM kernels while its gathered input stays in cache.
+  const int64_t stride_m = std::max(int64_t{16}, int64_t{16384} / std::max(kernel_dim, int64_t{1}));
+  const int64_t task_count = (output_image_size + stride_m - 1) / stride_m;
+
+  for (int64_t image_id = 0; image_id < N; ++image_id) {
+    const auto* input_data = Xdata;
+    auto* output_data = Ydata;
+
+    auto conv_worker = [&](ptrdiff_t batch) {
+      int64_t output_start = (int64_t)batch * stride_m;
+      int64_t output_count = std::min(stride_m, output_image_size - output_start);
+
+      float const** worker_indirection_buffer = nullptr;
+      if (indirection_buffer) {
+        worker_indirection_buffer = static_cast<float const**>(indirection_buffer.get()) + output_start * kernel_size;
+        math::Im2col<float, StorageOrder::NHWC>()(
+            input_data,
+            C,
+            input_shape.GetDims().data(),
+            output_shape.GetDims().data(),
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<ptrdiff_t>(kernel_rank),
+            output_start,
+            output_count,
+            worker_indirection_buffer,
+            padding_data.data());
+      }
+
+      auto* worker_output = output_data + output_start * M;
+
+      MLAS_GEMM_EPILOGUE epilogue;
+      epilogue.Activation = activation_;
+
+      if (is_depthwise_conv) {
+        epilogue.Bias = Bdata;
+        MLAS_GEMM_EPILOGUE_PROCESSOR proc(epilogue);
+        MlasConvDepthwise(
+            worker_indirection_buffer,
+            reordered_W,
+            worker_output,
+            static_cast<size_t>(M),
+            static_cast<size_t>(output_count),
+            static_cast<size_t>(kernel_size),
+            beta,
+            &proc);
+        return;
+      }
+
+      for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+        epilogue.Bias = Bdata != nullptr ? Bdata + group_id * group_output_channels : nullptr;
+        MLAS_GEMM_EPILOGUE_PROCESSOR proc(epilogue);
+
+        const auto* group_packed_W = packed_W + group_id * packed_W_size;
+        auto* group_output = worker_output + group_id * group_output_channels;
+
+        if (worker_indirection_buffer != nullptr) {
+          MlasConvIndirect(
+              worker_indirection_buffer,
+              static_cast<size_t>(group_id * group_input_channels),
+              static_cast<size_t>(group_input_channels),
+              static_cast<size_t>(kernel_size),
+              static_cast<size_t>(output_count),
+              group_packed_W,
+              static_cast<size_t>(group_output_channels),
+              group_output,
+              static_cast<size_t>(M),
+              beta,
+              &proc);
+        } else {
+          MLAS_SGEMM_DATA_PARAMS gemm_params;
+          gemm_params.A = input_data + output_start * C + group_id * group_input_channels;
+          gemm_params.lda = static_cast<size_t>(C);
+          gemm_params.B = reinterpret_cast<const float*>(group_packed_W);
+          gemm_params.BIsPacked = true;
+          gemm_params.C = group_output;
+          gemm_params.ldc = static_cast<size_t>(M);
+          gemm_params.beta = beta;
+          gemm_params.OutputProcessor = &proc;
+          MlasGemm(
+              CblasNoTrans,
+              CblasNoTrans,
+              static_cast<size_t>(output_count),
+              static_cast<size_t>(group_output_channels),
+              static_cast<size_t>(kernel_dim),
+              gemm_params,
+              nullptr);
+        }
+      }
+    };
+
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, onnxruntime::narrow<ptrdiff_t>(task_count), conv_worker);
+
+    Xdata += X_offset;
+    Ydata += Y_offset;
+  }
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    NhwcFusedConv,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcFusedConvFloat);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -7,6 +7,7 @@
 #include "core/providers/common.h"
 #include "dequantize_blockwise.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/mlas/inc/mlas_qnbit.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -18,6 +19,7 @@ class MatMulNBits final : public OpKernel {
     ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("N", &N_));
     ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("block_size", &block_size_));
     ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("bits", &nbits_));
+    accuracy_level_ = info.GetAttrOrDefault<int64_t>("accuracy_level", 0);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -27,6 +29,7 @@ class MatMulNBits final : public OpKernel {
   int64_t N_;
   int64_t block_size_;
   int64_t nbits_;
+  int64_t accuracy_level_;
 };
 
 Status MatMulNBits::Compute(OpKernelContext* ctx) const {
@@ -42,9 +45,58 @@ Status MatMulNBits::Compute(OpKernelContext* ctx) const {
   const auto* scales_data = scales->Data<float>();
   const auto* zero_points_data = zero_points == nullptr ? nullptr : zero_points->Data<uint8_t>();
 
+  TensorShape b_shape({N_, K_});
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape, false, true));
+
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  auto* y_data = y->MutableData<float>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const size_t lda = helper.Lda(false);
+
   AllocatorPtr allocator;
   auto status = ctx->GetTempSpaceAllocator(&allocator);
   ORT_RETURN_IF_ERROR(status);
+
+  // accuracy_level 4 allows A to be quantized to int8 per block.
+  const MLAS_SQNBIT_GEMM_COMPUTE_TYPE compute_type = accuracy_level_ == 4 ? CompInt8 : CompFp32;
+  const size_t nbits = static_cast<size_t>(nbits_);
+  const size_t block_size = static_cast<size_t>(block_size_);
+
+  if (MlasIsSQNBitGemmAvailable(nbits, block_size, compute_type)) {
+    // B is used directly in its quantized layout, it is the same for each batch.
+    const size_t workspace_size = MlasSQNBitGemmBatchWorkspaceSize(M, N, K, max_len, nbits, block_size, compute_type);
+    IAllocatorUniquePtr<uint8_t> workspace;
+    if (workspace_size > 0) {
+      workspace = IAllocator::MakeUniquePtr<uint8_t>(allocator, workspace_size);
+    }
+
+    InlinedVector<MLAS_SQNBIT_GEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].QuantBData = b_data;
+      data[i].QuantBScale = scales_data;
+      data[i].QuantBZeroPoint = zero_points_data;
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+    }
+    MlasSQNBitGemmBatch(M, N, K, max_len, nbits, block_size, compute_type, data.data(), workspace.get(),
+                        thread_pool);
+
+    return Status::OK();
+  }
+
   auto tmp_b_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(K_) * N_);
   DequantizeBlockwise<float>(tmp_b_data_ptr.get(),
                              b_data,
@@ -61,27 +113,8 @@ Status MatMulNBits::Compute(OpKernelContext* ctx) const {
   MlasTranspose(tmp_b_data_ptr.get(), tm_b_data_ptr_trans.get(), N_, K_);
 #endif
 
-  TensorShape b_shape({N_, K_});
-
-  MatMulComputeHelper helper;
-  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape, false, true));
-
-  Tensor* y = ctx->Output(0, helper.OutputShape());
-
-  // Bail out early if the output is going to be empty
-  if (y->Shape().Size() == 0)
-    return Status::OK();
-
-  auto* y_data = y->MutableData<float>();
-
-  const size_t max_len = helper.OutputOffsets().size();
-  const size_t M = static_cast<size_t>(helper.M());
-  const size_t N = static_cast<size_t>(helper.N());
-  const size_t K = static_cast<size_t>(helper.K());
-  const size_t lda = helper.Lda(false);
   const size_t ldb = helper.Ldb(true);
 
-  // TODO: implement with native kernel
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
   for (size_t i = 0; i < max_len; i++) {
     data[i].BIsPacked = false;
@@ -16,16 +16,30 @@ class CPUIDInfo {
   }
 
   bool HasAMX_BF16() const { return has_amx_bf16_; }
+  bool HasAMX_INT8() const { return has_amx_int8_; }
   bool HasAVX() const { return has_avx_; }
   bool HasAVX2() const { return has_avx2_; }
+  bool HasAVX_VNNI() const { return has_avx_vnni_; }
   bool HasAVX512f() const { return has_avx512f_; }
   bool HasAVX512_BF16() const { return has_avx512_bf16_; }
+  bool HasAVX512_VNNI() const { return has_avx512_vnni_; }
   bool HasAVX512Skylake() const { return has_avx512_skylake_; }
   bool HasF16C() const { return has_f16c_; } /*fp16 conversion inst*/
   bool HasSSE3() const { return has_sse3_; }
   bool HasSSE4_1() const { return has_sse4_1_; }
   bool IsHybrid() const { return is_hybrid_; }
 
+  /**
+   * @return the vendor identification string of the x86 processor, e.g. "GenuineIntel" or "AuthenticAMD"
+   */
+  const std::string& GetX86Vendor() const { return x86_vendor_; }
+
+  /**
+   * @return the x86 processor signature (CPUID leaf 1 EAX) without the stepping, which identifies the family and
+   *         model of the processor
+   */
+  uint32_t GetX86FamilyModel() const { return x86_family_model_; }
+
   // ARM
   bool HasArmNeonDot() const { return has_arm_neon_dot_; }
 
@@ -102,16 +116,22 @@ class CPUIDInfo {
 #endif
   }
   bool has_amx_bf16_{false};
+  bool has_amx_int8_{false};
   bool has_avx_{false};
   bool has_avx2_{false};
+  bool has_avx_vnni_{false};
   bool has_avx512f_{false};
   bool has_avx512_bf16_{false};
+  bool has_avx512_vnni_{false};
   bool has_avx512_skylake_{false};
   bool has_f16c_{false};
   bool has_sse3_{false};
   bool has_sse4_1_{false};
   bool is_hybrid_{false};
 
+  std::string x86_vendor_;
+  uint32_t x86_family_model_{0};
+
   std::vector<uint32_t> core_uarchs_;  // micro-arch of each core
 
   // In ARMv8 systems, some power efficient cores has narrower
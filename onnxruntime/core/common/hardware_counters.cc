@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#define ORT_HAS_PERF_EVENT 1
+#endif
+
+#ifdef ORT_HAS_PERF_EVENT
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+#ifdef ORT_HAS_PERF_EVENT
+
+namespace {
+
+struct CounterConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr CounterConfig kCounterConfigs[HW_COUNTER_MAX] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    // PERF_COUNT_HW_CACHE_MISSES counts last level cache misses.
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+};
+
+int OpenCounter(const CounterConfig& counter, int tid) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = counter.type;
+  attr.config = counter.config;
+  // Only count user space so that the counters stay accessible with perf_event_paranoid=2.
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1 /*cpu*/, -1 /*group_fd*/, 0 /*flags*/));
+}
+
+int GetCurrentTid() {
+  return static_cast<int>(syscall(SYS_gettid));
+}
+
+}  // namespace
+
+HardwareCounters::~HardwareCounters() {
+  Close();
+}
+
+bool HardwareCounters::AttachThread(int tid) {
+  ThreadCounterFds fds;
+  bool any_opened = false;
+  for (int i = 0; i < HW_COUNTER_MAX; ++i) {
+    fds[i] = OpenCounter(kCounterConfigs[i], tid);
+    any_opened = any_opened || fds[i] >= 0;
+  }
+
+  if (!any_opened) {
+    return false;
+  }
+
+  thread_fds_[tid] = fds;
+  return true;
+}
+
+bool HardwareCounters::Open(const logging::Logger* logger) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  logger_ = logger;
+  if (is_open_) {
+    return true;
+  }
+
+  // Attach to all threads that currently exist in the process. This includes the workers of
+  // the intra-op thread pool, which are created together with the session.
+  DIR* dir = opendir("/proc/self/task");
+  if (dir != nullptr) {
+    while (dirent* entry = readdir(dir)) {
+      if (entry->d_name[0] == '.') {
+        continue;
+      }
+      AttachThread(std::atoi(entry->d_name));
+    }
+    closedir(dir);
+  } else {
+    AttachThread(GetCurrentTid());
+  }
+
+  is_open_ = !thread_fds_.empty();
+  if (!is_open_.load() && logger_) {
+    LOGS(*logger_, WARNING) << "Failed to open hardware performance counters: " << strerror(errno)
+                            << ". Check /proc/sys/kernel/perf_event_paranoid.";
+  }
+  return is_open_;
+}
+
+void HardwareCounters::Close() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (auto& entry : thread_fds_) {
+    for (int fd : entry.second) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+  thread_fds_.clear();
+  is_open_ = false;
+}
+
+HardwareCounterValues HardwareCounters::Read() {
+  HardwareCounterValues values{};
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!is_open_) {
+    return values;
+  }
+
+  const int tid = GetCurrentTid();
+  if (thread_fds_.find(tid) == thread_fds_.end()) {
+    AttachThread(tid);
+  }
+
+  for (const auto& entry : thread_fds_) {
+    for (int i = 0; i < HW_COUNTER_MAX; ++i) {
+      const int fd = entry.second[i];
+      uint64_t count = 0;
+      if (fd >= 0 && read(fd, &count, sizeof(count)) == sizeof(count)) {
+        values[i] += count;
+      }
+    }
+  }
+
+  return values;
+}
+
+#else  // ORT_HAS_PERF_EVENT
+
+HardwareCounters::~HardwareCounters() = default;
+
+bool HardwareCounters::AttachThread(int /*tid*/) {
+  return false;
+}
+
+bool HardwareCounters::Open(const logging::Logger* logger) {
+  if (logger) {
+    LOGS(*logger, WARNING) << "Hardware performance counters are only supported on Linux.";
+  }
+  return false;
+}
+
+void HardwareCounters::Close() {}
+
+HardwareCounterValues HardwareCounters::Read() {
+  return HardwareCounterValues{};
+}
+
+#endif  // ORT_HAS_PERF_EVENT
+
+}  // namespace profiling
+}  // namespace onnxruntime
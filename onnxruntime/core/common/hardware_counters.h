@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+enum HardwareCounter {
+  HW_CYCLES = 0,
+  HW_INSTRUCTIONS,
+  HW_LLC_MISSES,
+  HW_DTLB_MISSES,
+  HW_COUNTER_MAX
+};
+
+// Names used as event args in the profile output for the above counters.
+static constexpr const char* kHardwareCounterNames[HW_COUNTER_MAX] = {
+    "hw_cycles",
+    "hw_instructions",
+    "hw_llc_misses",
+    "hw_dtlb_misses"};
+
+using HardwareCounterValues = std::array<uint64_t, HW_COUNTER_MAX>;
+
+/**
+ * Reads hardware performance counters (cycles, instructions, LLC misses and dTLB misses)
+ * via perf_event_open on Linux.
+ *
+ * When opened, one set of counters is attached to every thread of the process that exists
+ * at that point, which includes the intra-op thread pool workers of the session. Threads that
+ * call Read() later (e.g. a new thread calling Run) are attached lazily. Read() returns the sum
+ * over all attached threads, so the delta of two reads around a kernel invocation attributes the
+ * work done by the calling thread and the thread pool on behalf of that kernel.
+ *
+ * On other platforms, or when the kernel does not allow access to the counters
+ * (see /proc/sys/kernel/perf_event_paranoid), Open() returns false and the counters stay disabled.
+ */
+class HardwareCounters {
+ public:
+  HardwareCounters() = default;
+  ~HardwareCounters();
+
+  /*
+  Attach counters to the threads of the current process. Returns false if no counter could be opened.
+  */
+  bool Open(const logging::Logger* logger);
+
+  /*
+  Detach from all threads and release the counter file descriptors.
+  */
+  void Close();
+
+  bool IsOpen() const {
+    return is_open_;
+  }
+
+  /*
+  Return the current counter values summed over all attached threads.
+  Counters that are not supported on this machine read as zero.
+  */
+  HardwareCounterValues Read();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HardwareCounters);
+
+  using ThreadCounterFds = std::array<int, HW_COUNTER_MAX>;
+
+  // Open the counters for one thread. Returns false if none of them could be opened.
+  bool AttachThread(int tid);
+
+  OrtMutex mutex_;
+  // Written under mutex_, read without it by IsOpen() on the profiling path.
+  std::atomic<bool> is_open_{false};
+  const logging::Logger* logger_{nullptr};
+  std::unordered_map<int, ThreadCounterFds> thread_fds_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -51,6 +51,9 @@ void Profiler::StartProfiling(const logging::Logger* custom_logger) {
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->StartProfiling(profiling_start_time_);
   }
+  if (hardware_counters_) {
+    hardware_counters_->Open(session_logger_);
+  }
 }
 
 template <typename T>
@@ -64,6 +67,9 @@ void Profiler::StartProfiling(const std::basic_string<T>& file_name) {
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->StartProfiling(profiling_start_time_);
   }
+  if (hardware_counters_) {
+    hardware_counters_->Open(session_logger_);
+  }
 }
 
 template void Profiler::StartProfiling<char>(const std::basic_string<char>& file_name);
@@ -106,6 +112,9 @@ std::string Profiler::EndProfiling() {
   if (!enabled_) {
     return std::string();
   }
+  if (hardware_counters_) {
+    hardware_counters_->Close();
+  }
   if (profile_with_logger_) {
     profile_with_logger_ = false;
     return std::string();
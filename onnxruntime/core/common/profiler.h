@@ -9,6 +9,7 @@
 #include <iostream>
 #include <tuple>
 
+#include "core/common/hardware_counters.h"
 #include "core/common/profiler_common.h"
 #include "core/common/logging/logging.h"
 #include "core/platform/ort_mutex.h"
@@ -110,6 +111,23 @@ class Profiler {
     global_max_num_events_.store(new_max_num_events);
   }
 
+  /*
+  Collect hardware performance counters for node events while profiling is enabled.
+  Must be called before profiling starts.
+  */
+  void EnableHardwareCounters() {
+    if (!hardware_counters_) {
+      hardware_counters_ = std::make_unique<HardwareCounters>();
+    }
+  }
+
+  /*
+  Return the hardware performance counters if they are enabled and could be opened, otherwise nullptr.
+  */
+  HardwareCounters* GetHardwareCounters() const {
+    return enabled_ && hardware_counters_ && hardware_counters_->IsOpen() ? hardware_counters_.get() : nullptr;
+  }
+
   void AddEpProfilers(std::unique_ptr<EpProfiler> ep_profiler) {
     if (ep_profiler) {
       ep_profilers_.push_back(std::move(ep_profiler));
@@ -156,6 +174,7 @@ class Profiler {
 #endif
 
   std::vector<std::unique_ptr<EpProfiler>> ep_profilers_;
+  std::unique_ptr<HardwareCounters> hardware_counters_;
 };
 
 }  // namespace profiling
@@ -349,6 +349,9 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 #endif
       session_state_(session_state),
       mem_patterns_(nullptr) {
+  // load the initializers that were deferred until the graph is executed
+  ORT_THROW_IF_ERROR(session_state.MaterializeLazyInitializedTensors());
+
   Init(
       feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
 #if !defined(DISABLE_SPARSE_TENSORS)
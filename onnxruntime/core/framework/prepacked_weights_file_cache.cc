@@ -0,0 +1,349 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_file_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "onnxruntime_config.h"
+#include "core/common/cpuid_info.h"
+#include "core/common/safeint.h"
+#include "core/framework/allocator_utils.h"
+#include "core/framework/data_types.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// File layout (native byte order, the platform signature covers the architecture):
+//   magic
+//   u64 signature length, signature
+//   u64 number of entries
+//   per entry: u64 key length, key, u64 number of buffers, per buffer: u64 offset, u64 size
+//   buffer data, each buffer starting at a kBufferAlignment aligned offset. An offset of 0 denotes a null buffer.
+constexpr char kMagic[8] = {'O', 'R', 'T', 'P', 'P', 'W', 'C', '1'};
+constexpr size_t kBufferAlignment = 64;
+
+size_t AlignUp(size_t value) {
+  return (value + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+void AppendU64(std::string& out, uint64_t value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendString(std::string& out, const std::string& value) {
+  AppendU64(out, value.size());
+  out.append(value);
+}
+
+// Bounds checked reader over the mapped cache file.
+class Reader {
+ public:
+  Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  bool ReadU64(uint64_t& value) {
+    if (size_ - pos_ < sizeof(value)) {
+      return false;
+    }
+    memcpy(&value, data_ + pos_, sizeof(value));
+    pos_ += sizeof(value);
+    return true;
+  }
+
+  bool ReadString(std::string& value) {
+    uint64_t length = 0;
+    if (!ReadU64(length) || size_ - pos_ < length) {
+      return false;
+    }
+    value.assign(data_ + pos_, static_cast<size_t>(length));
+    pos_ += static_cast<size_t>(length);
+    return true;
+  }
+
+  bool ReadMagic() {
+    if (size_ < sizeof(kMagic) || memcmp(data_, kMagic, sizeof(kMagic)) != 0) {
+      return false;
+    }
+    pos_ = sizeof(kMagic);
+    return true;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t pos_{0};
+};
+
+}  // namespace
+
+PrepackedWeightsFileCache::PrepackedWeightsFileCache(const PathString& file_path) : file_path_(file_path) {
+  AllocatorCreationInfo device_info{[](int) { return std::make_unique<CPUAllocator>(); },
+                                    0, false};
+  allocator_ = CreateAllocator(device_info);
+}
+
+std::string PrepackedWeightsFileCache::GetPlatformSignature() {
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  std::ostringstream ss;
+  ss << ORT_VERSION << ";ptr" << sizeof(void*) << ";"
+#if defined(CPUIDINFO_ARCH_X86)
+     << "x86"
+     << (cpu_info.HasSSE3() ? ",sse3" : "")
+     << (cpu_info.HasSSE4_1() ? ",sse4_1" : "")
+     << (cpu_info.HasAVX() ? ",avx" : "")
+     << (cpu_info.HasAVX2() ? ",avx2" : "")
+     << (cpu_info.HasAVX_VNNI() ? ",avxvnni" : "")
+     << (cpu_info.HasF16C() ? ",f16c" : "")
+     << (cpu_info.HasAVX512f() ? ",avx512f" : "")
+     << (cpu_info.HasAVX512Skylake() ? ",avx512skx" : "")
+     << (cpu_info.HasAVX512_VNNI() ? ",avx512vnni" : "")
+     << (cpu_info.HasAVX512_BF16() ? ",avx512bf16" : "")
+     << (cpu_info.HasAMX_BF16() ? ",amxbf16" : "")
+     << (cpu_info.HasAMX_INT8() ? ",amxint8" : "");
+#elif defined(CPUIDINFO_ARCH_ARM)
+     << "arm"
+     << (cpu_info.HasArmNeonDot() ? ",dot" : "")
+     << (cpu_info.HasFp16VectorAcceleration() ? ",fp16" : "");
+#else
+     << "other";
+  ORT_UNUSED_PARAMETER(cpu_info);
+#endif
+
+  // The packing kernels MLAS selects at runtime determine the layout of the packed buffers, and the feature
+  // flags above may not capture every kernel choice. The packed size of a minimal matrix reflects the strides
+  // and alignment of the selected kernels, so it is part of the signature as well.
+  ss << ";pack" << MlasGemmPackBSize(1, 1);
+  for (const bool a_is_signed : {false, true}) {
+    for (const bool b_is_signed : {false, true}) {
+      ss << "," << MlasGemmPackBSize(1, 1, a_is_signed, b_is_signed);
+    }
+  }
+  return ss.str();
+}
+
+std::string PrepackedWeightsFileCache::GenerateKey(const Node& node, int input_idx, const Tensor& tensor) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  // MurmurHash3 takes an int length, so large buffers are hashed in chunks.
+  auto hash_buffer = [&hash](const void* data, size_t length) {
+    constexpr size_t max_chunk_length = static_cast<size_t>(std::numeric_limits<int>::max());
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+      const size_t chunk_length = std::min(length, max_chunk_length);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk_length), hash[0], &hash);
+      bytes += chunk_length;
+      length -= chunk_length;
+    }
+  };
+
+  hash_buffer(tensor.DataRaw(), tensor.SizeInBytes());
+
+  // Node attributes (e.g. transB) can change the pre-packed layout. Hash them in a stable order.
+  const auto& attributes = node.GetAttributes();
+  std::vector<std::string> attribute_names;
+  attribute_names.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    attribute_names.push_back(attribute.first);
+  }
+  std::sort(attribute_names.begin(), attribute_names.end());
+  for (const auto& name : attribute_names) {
+    const std::string serialized_attribute = attributes.at(name).SerializeAsString();
+    hash_buffer(name.data(), name.size());
+    hash_buffer(serialized_attribute.data(), serialized_attribute.size());
+  }
+
+  std::ostringstream ss;
+  ss << node.Domain() << ":" << node.OpType() << ":" << node.SinceVersion() << ":" << input_idx;
+  // Input types select the kernel and its packing format (e.g. signed vs unsigned activations).
+  for (const auto* input_def : node.InputDefs()) {
+    ss << ":" << (input_def->Exists() && input_def->Type() != nullptr ? *input_def->Type() : "");
+  }
+  ss << ":" << DataTypeImpl::ToString(tensor.DataType()) << tensor.Shape().ToString() << ":" << std::hex;
+  for (uint32_t h : hash) {
+    ss << h;
+  }
+
+  return ss.str();
+}
+
+const PrePackedWeights* PrepackedWeightsFileCache::GetWeight(const std::string& key) const {
+  auto iter = prepacked_weights_map_.find(key);
+  return iter != prepacked_weights_map_.end() ? &iter->second : nullptr;
+}
+
+const PrePackedWeights& PrepackedWeightsFileCache::WriteWeight(const std::string& key,
+                                                              PrePackedWeights&& packed_weight) {
+  has_new_weights_ = true;
+  auto& cached_weight = prepacked_weights_map_[key];
+  cached_weight = std::move(packed_weight);
+  return cached_weight;
+}
+
+Status PrepackedWeightsFileCache::Load(const logging::Logger& logger) {
+  const auto& env = Env::Default();
+  size_t file_length = 0;
+  if (!env.GetFileLength(file_path_.c_str(), file_length).IsOK()) {
+    LOGS(logger, INFO) << "Pre-packed weights cache file " << ToUTF8String(file_path_)
+                       << " does not exist yet. It will be created.";
+    return Status::OK();
+  }
+
+  Env::MappedMemoryPtr mapped_file;
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path_.c_str(), 0, file_length, mapped_file));
+
+  Reader reader(mapped_file.get(), file_length);
+  std::string signature;
+  if (!reader.ReadMagic() || !reader.ReadString(signature)) {
+    LOGS(logger, WARNING) << "Ignoring invalid pre-packed weights cache file " << ToUTF8String(file_path_);
+    return Status::OK();
+  }
+
+  if (signature != GetPlatformSignature()) {
+    LOGS(logger, INFO) << "Ignoring pre-packed weights cache file " << ToUTF8String(file_path_)
+                       << " that was created for a different ORT version or CPU: " << signature;
+    return Status::OK();
+  }
+
+  std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map;
+  uint64_t num_entries = 0;
+  bool is_valid = reader.ReadU64(num_entries);
+  for (uint64_t i = 0; is_valid && i < num_entries; ++i) {
+    std::string key;
+    uint64_t num_buffers = 0;
+    is_valid = reader.ReadString(key) && reader.ReadU64(num_buffers);
+
+    PrePackedWeights weights;
+    for (uint64_t j = 0; is_valid && j < num_buffers; ++j) {
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      is_valid = reader.ReadU64(offset) && reader.ReadU64(size) &&
+                 offset <= file_length && size <= file_length - offset;
+      if (is_valid) {
+        // The mapping is owned by this cache, so the buffers must not be freed by their users.
+        void* buffer = offset == 0 ? nullptr : mapped_file.get() + offset;
+        weights.buffers_.emplace_back(buffer, [](void*) {});
+        weights.buffer_sizes_.push_back(static_cast<size_t>(size));
+      }
+    }
+
+    if (is_valid) {
+      prepacked_weights_map.emplace(std::move(key), std::move(weights));
+    }
+  }
+
+  if (!is_valid) {
+    LOGS(logger, WARNING) << "Ignoring truncated pre-packed weights cache file " << ToUTF8String(file_path_);
+    return Status::OK();
+  }
+
+  mapped_file_ = std::move(mapped_file);
+  prepacked_weights_map_ = std::move(prepacked_weights_map);
+  LOGS(logger, INFO) << "Loaded " << prepacked_weights_map_.size() << " pre-packed weights from "
+                     << ToUTF8String(file_path_);
+  return Status::OK();
+}
+
+Status PrepackedWeightsFileCache::Save(const logging::Logger& logger) {
+  if (!has_new_weights_) {
+    return Status::OK();
+  }
+
+  // Sort the keys so that the file content does not depend on the hash map iteration order.
+  std::vector<const std::string*> keys;
+  keys.reserve(prepacked_weights_map_.size());
+  for (const auto& entry : prepacked_weights_map_) {
+    keys.push_back(&entry.first);
+  }
+  std::sort(keys.begin(), keys.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+
+  // The header size is known up front as all of its fields have a fixed size.
+  const std::string signature = GetPlatformSignature();
+  SafeInt<size_t> header_size = sizeof(kMagic) + sizeof(uint64_t) + signature.size() + sizeof(uint64_t);
+  for (const auto* key : keys) {
+    const auto& weights = prepacked_weights_map_.at(*key);
+    header_size += sizeof(uint64_t) + key->size() + sizeof(uint64_t) +
+                   SafeInt<size_t>(weights.buffers_.size()) * 2 * sizeof(uint64_t);
+  }
+
+  std::string header;
+  header.reserve(header_size);
+  header.append(kMagic, sizeof(kMagic));
+  AppendString(header, signature);
+  AppendU64(header, keys.size());
+
+  std::vector<std::pair<const void*, size_t>> buffers;
+  size_t offset = AlignUp(header_size);
+  for (const auto* key : keys) {
+    const auto& weights = prepacked_weights_map_.at(*key);
+    AppendString(header, *key);
+    AppendU64(header, weights.buffers_.size());
+    for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+      const void* buffer = weights.buffers_[i].get();
+      const size_t size = buffer != nullptr ? weights.buffer_sizes_[i] : 0;
+      AppendU64(header, buffer != nullptr ? offset : 0);
+      AppendU64(header, size);
+      if (buffer != nullptr) {
+        buffers.emplace_back(buffer, size);
+        offset = AlignUp(SafeInt<size_t>(offset) + size);
+      }
+    }
+  }
+  ORT_ENFORCE(header.size() == header_size);
+
+  // Write to a temporary file first as the current file may be mapped by this or another process. The name of the
+  // temporary file is unique to this writer, as several processes may save the cache at the same time. The last
+  // rename wins, and each rename publishes a complete file.
+  std::filesystem::path file_path(file_path_);
+  std::filesystem::path temp_file_path(file_path);
+  std::random_device random_device;
+  std::ostringstream temp_suffix;
+  temp_suffix << "." << Env::Default().GetSelfPid() << "-" << std::hex << random_device() << random_device() << ".tmp";
+  temp_file_path += temp_suffix.str();
+  std::error_code error;
+  {
+    std::ofstream out(temp_file_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(out, "Failed to open ", ToUTF8String(temp_file_path.native()), " for writing.");
+
+    const std::string padding(kBufferAlignment, '\0');
+    out.write(header.data(), header.size());
+    size_t written = header.size();
+    for (const auto& buffer : buffers) {
+      out.write(padding.data(), AlignUp(written) - written);
+      written = AlignUp(written);
+      out.write(static_cast<const char*>(buffer.first), buffer.second);
+      written += buffer.second;
+    }
+    out.close();
+    if (!out) {
+      std::filesystem::remove(temp_file_path, error);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write pre-packed weights to ",
+                             ToUTF8String(temp_file_path.native()));
+    }
+  }
+
+  std::filesystem::rename(temp_file_path, file_path, error);
+  if (error) {
+    std::error_code remove_error;
+    std::filesystem::remove(temp_file_path, remove_error);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to replace ", ToUTF8String(file_path_), ": ", error.message());
+  }
+
+  has_new_weights_ = false;
+  LOGS(logger, INFO) << "Saved " << keys.size() << " pre-packed weights to " << ToUTF8String(file_path_);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/common/path_string.h"
+#include "core/framework/allocator.h"
+#include "core/platform/env.h"
+#include "prepacked_weights.h"
+
+namespace onnxruntime {
+
+class Node;
+class Tensor;
+
+// A cache of pre-packed weights that is persisted in a file so that later sessions of the same model can skip
+// the OpKernel::PrePack() calls for the weights found in it.
+//
+// The entries are keyed by the node (op type, domain, opset, attributes and input types), the input index and
+// the content of the constant initializer that was pre-packed, so the cache file can be shared between models.
+// The file also records the ORT version and the CPU features it was created with as the pre-packed layouts depend
+// on both. A file created with a different version or on a different CPU is ignored and overwritten.
+//
+// The pre-packed buffers of a loaded file are memory mapped. They are handed to the kernels as shared buffers, so the
+// cache must outlive the kernels that use them.
+class PrepackedWeightsFileCache final {
+ public:
+  explicit PrepackedWeightsFileCache(const PathString& file_path);
+
+  ~PrepackedWeightsFileCache() = default;
+
+  // Loads the cache file. A missing file, or one created with a different ORT version or CPU, is not an error.
+  Status Load(const logging::Logger& logger);
+
+  // Writes the cache file if weights were added since it was loaded.
+  Status Save(const logging::Logger& logger);
+
+  // Generates the key to look up the pre-packed buffers of `tensor` for the input `input_idx` of `node`.
+  static std::string GenerateKey(const Node& node, int input_idx, const Tensor& tensor);
+
+  // Returns the allocator that must be used for pre-packed buffers that are going to be written into this cache.
+  AllocatorPtr GetAllocator() const {
+    return allocator_;
+  }
+
+  // Returns the PrePackedWeights instance pertaining to the provided key, or nullptr if there is none.
+  const PrePackedWeights* GetWeight(const std::string& key) const;
+
+  // Writes the PrePackedWeights instance pertaining to the provided key and returns the cached instance.
+  // The buffers must have been allocated with GetAllocator().
+  const PrePackedWeights& WriteWeight(const std::string& key, PrePackedWeights&& packed_weight);
+
+  // Returns the number of elements in the cache
+  size_t GetNumberOfElements() const {
+    return prepacked_weights_map_.size();
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsFileCache);
+
+ private:
+  // Describes the ORT version and the CPU features that the pre-packed layouts depend on.
+  static std::string GetPlatformSignature();
+
+  const PathString file_path_;
+
+  // The mapping and the allocator must outlive the pre-packed buffers that point into them.
+  Env::MappedMemoryPtr mapped_file_;
+  AllocatorPtr allocator_;
+
+  std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map_;
+  bool has_new_weights_{false};
+};
+
+}  // namespace onnxruntime
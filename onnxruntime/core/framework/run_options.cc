@@ -56,6 +56,15 @@ ORT_API_STATUS_IMPL(OrtApis::RunOptionsUnsetTerminate, _Inout_ OrtRunOptions* op
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetDeadline, _Inout_ OrtRunOptions* options, int64_t timeout_us) {
+  if (timeout_us < 0) {
+    options->deadline.reset();
+  } else {
+    options->deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+  }
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(OrtApis::AddRunConfigEntry, _Inout_ OrtRunOptions* options,
                     _In_z_ const char* config_key, _In_z_ const char* config_value) {
   return onnxruntime::ToOrtStatus(options->config_options.AddConfigEntry(config_key, config_value));
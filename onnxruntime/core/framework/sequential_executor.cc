@@ -349,6 +349,11 @@ class KernelScope {
       CalculateTotalInputSizes(&kernel_context, &kernel_,
                                input_activation_sizes_, input_parameter_sizes_,
                                node_name_, input_type_shape_);
+      hardware_counters_ = profiler.GetHardwareCounters();
+      if (hardware_counters_) {
+        // Read last so that the input size calculation above is not attributed to the kernel.
+        hardware_counters_begin_ = hardware_counters_->Read();
+      }
     }
   }
 
@@ -361,6 +366,10 @@ class KernelScope {
 
     if (session_state_.Profiler().IsEnabled()) {
       auto& profiler = session_state_.Profiler();
+      profiling::HardwareCounterValues hardware_counters_end{};
+      if (hardware_counters_) {
+        hardware_counters_end = hardware_counters_->Read();
+      }
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
@@ -379,6 +388,9 @@ class KernelScope {
                                          {"thread_scheduling_stats",
                                           concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
                                      });
+      if (hardware_counters_) {
+        RecordHardwareCounters(profiler, hardware_counters_end);
+      }
       auto sync_time_begin = profiler.Start();
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                      node_name_ + "_fence_after",
@@ -406,6 +418,27 @@ class KernelScope {
   }  //~KernelScope
 
  private:
+  void RecordHardwareCounters(profiling::Profiler& profiler, const profiling::HardwareCounterValues& end) {
+    auto delta = [&](profiling::HardwareCounter counter) {
+      return std::to_string(end[counter] - hardware_counters_begin_[counter]);
+    };
+    profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                   node_name_ + "_hw_counters",
+                                   kernel_begin_time_,
+                                   {
+                                       {"op_name", kernel_.KernelDef().OpName()},
+                                       {"node_index", std::to_string(kernel_.Node().Index())},
+                                       {profiling::kHardwareCounterNames[profiling::HW_CYCLES],
+                                        delta(profiling::HW_CYCLES)},
+                                       {profiling::kHardwareCounterNames[profiling::HW_INSTRUCTIONS],
+                                        delta(profiling::HW_INSTRUCTIONS)},
+                                       {profiling::kHardwareCounterNames[profiling::HW_LLC_MISSES],
+                                        delta(profiling::HW_LLC_MISSES)},
+                                       {profiling::kHardwareCounterNames[profiling::HW_DTLB_MISSES],
+                                        delta(profiling::HW_DTLB_MISSES)},
+                                   });
+  }
+
   TimePoint kernel_begin_time_;
   SessionScope& session_scope_;
   const SessionState& session_state_;
@@ -418,6 +451,9 @@ class KernelScope {
   size_t total_output_sizes_{};
   std::string input_type_shape_;
 
+  profiling::HardwareCounters* hardware_counters_{nullptr};
+  profiling::HardwareCounterValues hardware_counters_begin_{};
+
 #ifdef CONCURRENCY_VISUALIZER
   diagnostic::span span_;
 #endif
@@ -529,7 +565,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 #endif
                                    const bool& terminate_flag,
                                    const bool only_execute_path_to_fetches,
-                                   bool single_thread_mode) {
+                                   bool single_thread_mode,
+                                   const std::optional<std::chrono::steady_clock::time_point>& deadline) {
   auto* execution_plan = session_state.GetExecutionPlan();
   LOGS(logger, VERBOSE) << "Number of streams: " << execution_plan->execution_plan.size();
   int32_t valid_streams = 0;
@@ -572,6 +609,10 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
   ORT_UNUSED_PARAMETER(only_execute_path_to_fetches);
 #endif
 
+  if (deadline.has_value()) {
+    ctx.SetDeadline(*deadline);
+  }
+
   SessionScope session_scope(session_state, ctx.GetExecutionFrame());
 
   auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
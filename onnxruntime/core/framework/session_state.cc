@@ -213,7 +213,8 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
-Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
+Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager,
+                                   concurrency::ThreadPool* thread_pool) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
     size_t max_nodeid = 0;
@@ -222,7 +223,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
+
+    auto create_kernel = [this, &kernel_registry_manager](const Node& node) -> Status {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -230,8 +232,32 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       onnxruntime::ProviderType exec_provider_name = node.GetExecutionProviderType();
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
+      std::unique_ptr<OpKernel> kernel;
+      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, kernel));
+
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      session_kernels_[node.Index()] = std::move(kernel);
+      return Status::OK();
+    };
+
+    // Kernels of the CPU EP are created in parallel if a thread pool is provided. Other execution providers may not
+    // support creating kernels concurrently, so their kernels are always created serially.
+    InlinedVector<const Node*> cpu_nodes;
+    for (const auto& node : nodes) {
+      if (thread_pool != nullptr && node.GetExecutionProviderType() == kCpuExecutionProvider) {
+        cpu_nodes.push_back(&node);
+        continue;
+      }
+      ORT_RETURN_IF_ERROR(create_kernel(node));
+    }
+
+    std::vector<Status> statuses(cpu_nodes.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, static_cast<std::ptrdiff_t>(cpu_nodes.size()),
+                                                  [&](std::ptrdiff_t i) {
+                                                    statuses[i] = create_kernel(*cpu_nodes[i]);
+                                                  });
+    for (const auto& status : statuses) {
+      ORT_RETURN_IF_ERROR(status);
     }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
@@ -272,14 +298,26 @@ void SessionState::PruneRemovableAttributes() {
 }
 
 const SequentialExecutionPlan* SessionState::GetExecutionPlan() const {
+  if (clone_source_ != nullptr) {
+    return clone_source_->GetExecutionPlan();
+  }
+
   if (!p_seq_exec_plan_.has_value()) {
     return nullptr;
   }
   return &p_seq_exec_plan_.value();
 }
 
+StepCostHistory* SessionState::GetStepCostHistory() const {
+  if (clone_source_ != nullptr) {
+    return clone_source_->GetStepCostHistory();
+  }
+
+  return step_cost_history_.get();
+}
+
 const std::vector<AllocPlanPerValue>& SessionState::GetPerValueAllocPlan() const {
-  return p_seq_exec_plan_->allocation_plan;
+  return GetExecutionPlan()->allocation_plan;
 }
 
 Status SessionState::AddInitializedTensor(int ort_value_index, const OrtValue& ort_value, const OrtCallback* d,
@@ -314,6 +352,86 @@ const std::unordered_map<int, OrtValue>& SessionState::GetConstantInitializedTen
   return constant_initialized_tensors_;
 }
 
+Status SessionState::AddLazyInitializedTensor(const std::string& name, int ort_value_index, bool constant,
+                                              std::function<Status(OrtValue& value)> materialize_func) {
+  if (initialized_tensors_.count(ort_value_index) > 0 ||
+      !lazy_initialized_tensors_.insert({ort_value_index, LazyInitializedTensor{name, constant,
+                                                                                std::move(materialize_func)}})
+           .second) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "duplicated ort_value index:", ort_value_index,
+                           ". Do you have duplicated calls to SessionState::AddLazyInitializedTensor function?");
+  }
+
+  lazy_initialized_tensors_materialized_ = false;
+  return Status::OK();
+}
+
+Status SessionState::MaterializeLazyInitializedTensors() const {
+  if (lazy_initialized_tensors_materialized_.load(std::memory_order_acquire)) {
+    return Status::OK();
+  }
+
+  std::lock_guard<OrtMutex> l(lazy_initialized_tensors_mutex_);
+  if (lazy_initialized_tensors_materialized_.load(std::memory_order_relaxed)) {
+    return Status::OK();
+  }
+
+  for (const auto& entry : lazy_initialized_tensors_) {
+    const LazyInitializedTensor& lazy_tensor = entry.second;
+    // skip the initializers materialized by a previous call that failed part way through
+    if (lazy_tensor.materialized) {
+      continue;
+    }
+
+    OrtValue ort_value;
+    ORT_RETURN_IF_ERROR(lazy_tensor.materialize_func(ort_value));
+    VLOGS(logger_, 1) << "Materialized weight with name : " << lazy_tensor.name << " with index: " << entry.first;
+
+    // No kernel of this graph runs before the materialization completes, so the kernels can be updated here.
+    size_t num_packed = 0;
+    for (const auto& [node_index, input_idx] : lazy_tensor.prepack_inputs) {
+      OpKernel* kernel = session_kernels_[node_index].get();
+      AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+      bool is_packed = false;
+      ORT_RETURN_IF_ERROR(kernel->PrePack(ort_value.Get<Tensor>(), input_idx, session_cpu_alloc, is_packed, nullptr));
+      if (is_packed) {
+        ++num_packed;
+      }
+    }
+
+    // release the tensor if all of its users pre-packed it
+    if (!lazy_tensor.release_when_packed || lazy_tensor.prepack_inputs.empty() ||
+        num_packed != lazy_tensor.prepack_inputs.size()) {
+      initialized_tensors_.insert({entry.first, std::move(ort_value)});
+    }
+    lazy_tensor.materialized = true;
+  }
+
+  lazy_initialized_tensors_materialized_.store(true, std::memory_order_release);
+  return Status::OK();
+}
+
+std::vector<std::string> SessionState::GetUnmaterializedInitializerNames() const {
+  std::vector<std::string> names;
+  {
+    std::lock_guard<OrtMutex> l(lazy_initialized_tensors_mutex_);
+    for (const auto& entry : lazy_initialized_tensors_) {
+      if (!entry.second.materialized) {
+        names.push_back(entry.second.name);
+      }
+    }
+  }
+
+  for (const auto& node_to_subgraph_session_states : subgraph_session_states_) {
+    for (const auto& attr_name_to_subgraph_session_state : node_to_subgraph_session_states.second) {
+      auto subgraph_names = attr_name_to_subgraph_session_state.second->GetUnmaterializedInitializerNames();
+      names.insert(names.end(), subgraph_names.begin(), subgraph_names.end());
+    }
+  }
+
+  return names;
+}
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 bool SessionState::IsSparseInitializer(int ort_value_index) const {
   return sparse_initialized_tensors_.count(ort_value_index) > 0;
@@ -360,6 +478,50 @@ void SessionState::CleanInitializedTensorsFromGraph() {
   graph_.CleanAllInitializedTensors();
 }
 
+void SessionState::PlanLazyInitializedTensorsPrePacking() {
+  InlinedHashMap<std::string, LazyInitializedTensor*> constant_lazy_tensors;
+  for (auto& entry : lazy_initialized_tensors_) {
+    if (entry.second.constant) {
+      entry.second.release_when_packed = true;
+      constant_lazy_tensors.insert({entry.second.name, &entry.second});
+    }
+  }
+
+  if (constant_lazy_tensors.empty()) {
+    return;
+  }
+
+  // Kernels of subgraphs that use a lazy initialized tensor of this graph as an outer scope value are not pre-packed,
+  // and they need the tensor, as does a graph output.
+  auto keep_tensor = [&constant_lazy_tensors](const NodeArg* arg) {
+    auto it = constant_lazy_tensors.find(arg->Name());
+    if (it != constant_lazy_tensors.end()) {
+      it->second->release_when_packed = false;
+    }
+  };
+
+  for (const auto& node : GetGraphViewer().Nodes()) {
+    int input_idx = 0;
+    for (const auto* input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        auto it = constant_lazy_tensors.find(input_def->Name());
+        if (it != constant_lazy_tensors.end()) {
+          it->second->prepack_inputs.emplace_back(node.Index(), input_idx);
+        }
+      }
+      input_idx++;
+    }
+
+    for (const auto* implicit_input_def : node.ImplicitInputDefs()) {
+      keep_tensor(implicit_input_def);
+    }
+  }
+
+  for (const auto* output_def : GetGraphViewer().GetOutputs()) {
+    keep_tensor(output_def);
+  }
+}
+
 static Status KernelUseSharedPrePackedBuffers(OpKernel& kernel, int input_idx,
                                               const PrePackedWeights& prepacked_weights,
                                               const std::string& node_name) {
@@ -394,9 +556,177 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
+Status SessionState::PrepackWithFileCache(const Node& node, OpKernel& kernel, int input_idx, const Tensor& tensor,
+                                          /*out*/ bool& is_packed) {
+  is_packed = false;
+  const std::string key = PrepackedWeightsFileCache::GenerateKey(node, input_idx, tensor);
+  const PrePackedWeights* cached_weights = prepacked_weights_file_cache_->GetWeight(key);
+
+  if (cached_weights != nullptr) {
+    std::vector<BufferUniquePtr> cached_prepacked_buffers;
+    cached_prepacked_buffers.reserve(cached_weights->buffers_.size());
+    for (const auto& prepacked_buffer : cached_weights->buffers_) {
+      // BufferDeleter is nullptr because the buffers are owned by the cache
+      cached_prepacked_buffers.emplace_back(prepacked_buffer.get(), BufferDeleter(nullptr));
+    }
+
+    ORT_RETURN_IF_ERROR(kernel.UseCachedPrePackedBuffers(tensor, cached_prepacked_buffers,
+                                                         cached_weights->buffer_sizes_, input_idx, is_packed));
+    if (is_packed) {
+      ++used_cached_pre_packed_weights_counter_;
+      return Status::OK();
+    }
+
+    // The kernel cannot restore its state from the cached buffers. Pre-pack as usual and leave the
+    // cached buffers alone as other kernels may be using them.
+    AllocatorPtr session_cpu_alloc = GetAllocator(kernel.Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+    return kernel.PrePack(tensor, input_idx, session_cpu_alloc, is_packed, nullptr);
+  }
+
+  PrePackedWeights weights_to_be_filled_in;
+  ORT_RETURN_IF_ERROR(kernel.PrePack(tensor, input_idx, prepacked_weights_file_cache_->GetAllocator(),
+                                     is_packed, &weights_to_be_filled_in));
+
+  // Kernels that don't support sharing their pre-packed buffers keep them and leave weights_to_be_filled_in empty.
+  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+    const auto& cached_weights_written =
+        prepacked_weights_file_cache_->WriteWeight(key, std::move(weights_to_be_filled_in));
+    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(kernel, input_idx, cached_weights_written, node.Name()));
+  }
+
+  return Status::OK();
+}
+
+Status SessionState::PrepackWithSharedWeightStore(const Node& node, OpKernel& kernel, int input_idx,
+                                                  const Tensor& tensor, /*out*/ bool& is_packed) {
+  AllocatorPtr session_cpu_alloc = GetAllocator(kernel.Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+  PrePackedWeights weights_to_be_filled_in;
+  ORT_RETURN_IF_ERROR(kernel.PrePack(tensor, input_idx, session_cpu_alloc, is_packed, &weights_to_be_filled_in));
+
+  // Kernels that don't support sharing their pre-packed buffers keep them and leave weights_to_be_filled_in empty.
+  if (!is_packed || weights_to_be_filled_in.buffers_.empty()) {
+    return Status::OK();
+  }
+
+  // Buffers that are too small to be shared, or that the store cannot share, are kept by this session state.
+  PrePackedWeights shared_weights;
+  for (size_t i = 0; i < weights_to_be_filled_in.buffers_.size(); ++i) {
+    auto& buffer = weights_to_be_filled_in.buffers_[i];
+    const void* shared_buffer = nullptr;
+    ORT_RETURN_IF_ERROR(shared_weight_store_->GetOrCreate(buffer.get(), weights_to_be_filled_in.buffer_sizes_[i],
+                                                          shared_buffer));
+    if (shared_buffer != nullptr) {
+      // The buffers are owned by the store and must not be freed by the kernel.
+      shared_weights.buffers_.emplace_back(const_cast<void*>(shared_buffer), [](void*) {});
+    } else {
+      shared_weights.buffers_.emplace_back(buffer.get(), [](void*) {});
+      unshared_prepacked_buffers_.push_back(std::move(buffer));
+    }
+    shared_weights.buffer_sizes_.push_back(weights_to_be_filled_in.buffer_sizes_[i]);
+  }
+
+  return KernelUseSharedPrePackedBuffers(kernel, input_idx, shared_weights, node.Name());
+}
+
+Status SessionState::ParallelPrePackCpuKernels(
+    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+    concurrency::ThreadPool* thread_pool,
+    /*out*/ std::vector<ParallelPrePackResult>& results) {
+  // Find the constant initialized tensor for the input in this graph or the outer scope.
+  auto find_constant_initialized_tensor = [this](const std::string& input_name) -> const Tensor* {
+    for (SessionState* st = this; st != nullptr; st = st->Parent()) {
+      int ort_value_idx;
+      if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+        auto iter = st->constant_initialized_tensors_.find(ort_value_idx);
+        if (iter != st->constant_initialized_tensors_.end()) {
+          return &iter->second.Get<Tensor>();
+        }
+        if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+          break;
+        }
+      }
+    }
+    return nullptr;
+  };
+
+  struct NodeToPrePack {
+    const Node* node;
+    InlinedVector<std::pair<int, const Tensor*>> constant_inputs;
+  };
+
+  InlinedVector<NodeToPrePack> nodes_to_prepack;
+  for (auto& node : GetGraphViewer().Nodes()) {
+    if (node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+
+    NodeToPrePack node_to_prepack{&node, {}};
+    bool has_shared_initializer = false;
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const Tensor* tensor = find_constant_initialized_tensor(input_def->Name());
+        if (tensor != nullptr) {
+          node_to_prepack.constant_inputs.emplace_back(input_idx, tensor);
+          has_shared_initializer = has_shared_initializer ||
+                                   initializers_to_share_map.find(input_def->Name()) != initializers_to_share_map.end();
+        }
+      }
+      input_idx++;
+    }
+
+    // Weights that are cached in the shared container are pre-packed serially by the caller.
+    if (!node_to_prepack.constant_inputs.empty() &&
+        !(has_shared_initializer && prepacked_weights_container_ != nullptr)) {
+      nodes_to_prepack.push_back(std::move(node_to_prepack));
+    }
+  }
+
+  // The inputs of a kernel are pre-packed one after the other as PrePack() updates the state of the kernel.
+  std::vector<Status> statuses(nodes_to_prepack.size());
+  std::vector<InlinedVector<int>> packed_input_indices(nodes_to_prepack.size());
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(nodes_to_prepack.size()),
+      [&](std::ptrdiff_t i) {
+        const auto& node_to_prepack = nodes_to_prepack[i];
+        auto* kernel = GetMutableKernel(node_to_prepack.node->Index());
+        AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+        for (const auto& [input_idx, tensor] : node_to_prepack.constant_inputs) {
+          bool is_packed = false;
+          statuses[i] = kernel->PrePack(*tensor, input_idx, session_cpu_alloc, is_packed, nullptr);
+          if (!statuses[i].IsOK()) {
+            return;
+          }
+          if (is_packed) {
+            packed_input_indices[i].push_back(input_idx);
+          }
+        }
+      });
+
+  results.clear();
+  results.resize(session_kernels_.size());
+  for (size_t i = 0; i < nodes_to_prepack.size(); ++i) {
+    ORT_RETURN_IF_ERROR(statuses[i]);
+    auto& result = results[nodes_to_prepack[i].node->Index()];
+    result.handled = true;
+    result.packed_input_indices = std::move(packed_input_indices[i]);
+  }
+
+  return Status::OK();
+}
+
 Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
+                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                                       concurrency::ThreadPool* thread_pool) {
+  // The weights of CPU EP kernels that are not cached are pre-packed in parallel up front if a thread pool
+  // is provided. The loop below then only does the bookkeeping for them.
+  std::vector<ParallelPrePackResult> parallel_prepack_results;
+  if (thread_pool != nullptr && prepacked_weights_file_cache_ == nullptr && shared_weight_store_ == nullptr) {
+    ORT_RETURN_IF_ERROR(ParallelPrePackCpuKernels(initializers_to_share_map, thread_pool, parallel_prepack_results));
+  }
+
+  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map,
+                                     &parallel_prepack_results](
                                         bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
     for (auto& node : GetGraphViewer().Nodes()) {
       auto kernel = GetMutableKernel(node.Index());
@@ -476,6 +806,19 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
                     }
                   }
 
+                } else if (prepacked_weights_file_cache_ != nullptr &&
+                           node.GetExecutionProviderType() == kCpuExecutionProvider) {  // file cache turned ON
+                  ORT_RETURN_IF_ERROR(PrepackWithFileCache(node, *kernel, input_idx, const_initialized_tensor,
+                                                           is_packed));
+                } else if (shared_weight_store_ != nullptr &&
+                           node.GetExecutionProviderType() == kCpuExecutionProvider) {  // shared weight store turned ON
+                  ORT_RETURN_IF_ERROR(PrepackWithSharedWeightStore(node, *kernel, input_idx, const_initialized_tensor,
+                                                                   is_packed));
+                } else if (node.Index() < parallel_prepack_results.size() &&
+                           parallel_prepack_results[node.Index()].handled) {  // pre-packed in parallel already
+                  const auto& packed_input_indices = parallel_prepack_results[node.Index()].packed_input_indices;
+                  is_packed = std::find(packed_input_indices.begin(), packed_input_indices.end(), input_idx) !=
+                              packed_input_indices.end();
                 } else {  // caching of pre-packed weights' turned OFF
                   AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
                   ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
@@ -1057,6 +1400,9 @@ Status SessionState::CreateSubgraphSessionState() {
                                          thread_pool_, inter_op_thread_pool_, data_transfer_mgr_,
                                          logger_, profiler_, sess_options_, nullptr, allocators_);
 
+      subgraph_session_state->SetPrepackedWeightsFileCache(prepacked_weights_file_cache_);
+      subgraph_session_state->SetSharedWeightStore(shared_weight_store_);
+
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
 
@@ -1198,6 +1544,74 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
                                   remove_initializers, constant_initializers_use_count);
 }
 
+Status SessionState::Clone(const ExecutionProviders& execution_providers,
+                           concurrency::ThreadPool* thread_pool,
+                           concurrency::ThreadPool* inter_op_thread_pool,
+                           const DataTransferManager& data_transfer_mgr,
+                           const logging::Logger& logger,
+                           profiling::Profiler& profiler,
+                           const SessionOptions& sess_options,
+                           std::unique_ptr<SessionState>& clone,
+                           AllocatorMap* parent_allocators) const {
+  ORT_RETURN_IF(GetExecutionPlan() == nullptr, "The session state must be finalized before it can be cloned.");
+
+  // the clone shares the initializers, so load the lazy initialized ones once here
+  ORT_RETURN_IF_ERROR(MaterializeLazyInitializedTensors());
+
+  auto session_state = std::make_unique<SessionState>(graph_, execution_providers, thread_pool, inter_op_thread_pool,
+                                                      data_transfer_mgr, logger, profiler, sess_options,
+                                                      prepacked_weights_container_, parent_allocators);
+  session_state->clone_source_ = clone_source_ != nullptr ? clone_source_ : this;
+  session_state->graph_viewer_.emplace(graph_);
+
+  // the OrtValue indices used by the execution plan and the kernels must be the same, so add the names in
+  // the order of their indices
+  std::vector<const std::string*> ort_value_names(ort_value_name_idx_map_.Size());
+  for (const auto& name_and_idx : ort_value_name_idx_map_) {
+    ort_value_names[name_and_idx.second] = &name_and_idx.first;
+  }
+  session_state->ort_value_name_idx_map_.Reserve(ort_value_names.size());
+  for (const auto* name : ort_value_names) {
+    session_state->ort_value_name_idx_map_.Add(*name);
+  }
+  session_state->node_index_info_.emplace(*session_state->graph_viewer_, session_state->ort_value_name_idx_map_);
+
+  session_state->kernel_create_info_map_ = kernel_create_info_map_;
+  session_state->session_kernels_ = session_kernels_;
+  session_state->initialized_tensors_ = initialized_tensors_;
+  session_state->constant_initialized_tensors_ = constant_initialized_tensors_;
+#if !defined(DISABLE_SPARSE_TENSORS)
+  session_state->sparse_initialized_tensors_ = sparse_initialized_tensors_;
+#endif
+  session_state->input_names_to_nodeinfo_mapping_ = input_names_to_nodeinfo_mapping_;
+  session_state->output_names_to_nodeinfo_mapping_ = output_names_to_nodeinfo_mapping_;
+  session_state->enable_mem_pattern_ = enable_mem_pattern_;
+  session_state->number_of_prepacks_counter_ = number_of_prepacks_counter_;
+  session_state->used_shared_pre_packed_weights_counter_ = used_shared_pre_packed_weights_counter_;
+  session_state->used_cached_pre_packed_weights_counter_ = used_cached_pre_packed_weights_counter_;
+
+#ifdef ORT_ENABLE_STREAM
+  for (auto& ep : execution_providers) {
+    ep->RegisterStreamHandlers(session_state->GetStreamHandleRegistryInstance(), *session_state->allocators_);
+  }
+  session_state->has_device_stream_enabled_ep_ = has_device_stream_enabled_ep_;
+#endif
+
+  for (const auto& entry : subgraph_session_states_) {
+    for (const auto& name_to_subgraph_session_state : entry.second) {
+      std::unique_ptr<SessionState> subgraph_session_state;
+      ORT_RETURN_IF_ERROR(name_to_subgraph_session_state.second->Clone(
+          execution_providers, thread_pool, inter_op_thread_pool, data_transfer_mgr, logger, profiler, sess_options,
+          subgraph_session_state, session_state->allocators_));
+      session_state->AddSubgraphSessionState(entry.first, name_to_subgraph_session_state.first,
+                                             std::move(subgraph_session_state));
+    }
+  }
+
+  clone = std::move(session_state);
+  return Status::OK();
+}
+
 static Status Index(const OrtValueNameIdxMap& ort_value_name_idx_map,
                     const OrtValueName& name,
                     /*out*/ OrtValueIndex& value) {
@@ -1414,6 +1828,7 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                               Logger(),
                                               p_seq_exec_plan_);
   ORT_RETURN_IF_ERROR(status);
+  step_cost_history_ = std::make_unique<StepCostHistory>(*p_seq_exec_plan_);
 
   // Record the allocation plan
 
@@ -1428,6 +1843,15 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   // For inference it is enabled by default, but users can choose to disable it via session options.
   const bool disable_prepacking =
       session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0") == "1";
+  // Independent initialization work is spread over the intra-op thread pool if the user opted in.
+  concurrency::ThreadPool* const initialization_thread_pool =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelInitialization, "0") == "1"
+          ? thread_pool_
+          : nullptr;
+  // Initializers with external data are loaded when the graph is first executed if the user opted in.
+  const bool lazy_initialization =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazyInitializerMaterialization,
+                                                        "0") == "1";
   // Memory pattern tracer allocates all initializers on a single contiguous
   // buffer. This has the effect of reducing memory fragmentation.
   // Further more, in training scenarios NCCL kernels require initializers to be allocated
@@ -1494,7 +1918,15 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
             }
             return Status::OK();
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func));
+          lazy_initialization
+              ? session_state_utils::LazyTensorFunction(
+                    [this](const std::string& name, int idx, bool constant,
+                           session_state_utils::MaterializeTensorFunction materialize_func) -> Status {
+                      return AddLazyInitializedTensor(name, idx, constant, std::move(materialize_func));
+                    })
+              : session_state_utils::LazyTensorFunction(),
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func,
+          initialization_thread_pool, shared_weight_store_));
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1508,11 +1940,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager, initialization_thread_pool));
 
   if (!disable_prepacking) {
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+                                                          session_options.initializers_to_share_map,
+                                                          initialization_thread_pool));
+    PlanLazyInitializedTensorsPrePacking();
   }
 
   ORT_RETURN_IF_ERROR(
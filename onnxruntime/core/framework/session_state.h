@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -22,6 +24,9 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_file_cache.h"
+#include "core/framework/shared_weight_store.h"
+#include "core/framework/step_cost_history.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
@@ -155,6 +160,10 @@ class SessionState {
    * Gets the map of ort_value_index to initialized tensors (weights) so that it can be used by the
    * execution frame to setup the appropriate OrtValue vectors.
    * The lifetime of returned OrtValues are limited by this SessionState object.
+   * If initializers were added by AddLazyInitializedTensor, MaterializeLazyInitializedTensors inserts them into this
+   * map during the first Run, possibly while another Run is in progress. Once the session is initialized, only read
+   * the map after MaterializeLazyInitializedTensors has returned successfully (the execution frame calls it before
+   * reading the map), and call MaterializeLazyInitializedTensors first from any other caller.
    */
   const std::unordered_map<int, OrtValue>& GetInitializedTensors() const;
 
@@ -162,9 +171,33 @@ class SessionState {
    * Gets the map of ort_value_index to initialized tensors (e.g. weights) that are constant
    * and cannot be overridden at runtime.
    * The lifetime of returned OrtValues are limited by this SessionState object.
+   * Lazy initialized tensors are never added to this map, so it is not modified once the session is initialized.
    */
   const std::unordered_map<int, OrtValue>& GetConstantInitializedTensors() const;
 
+  /**
+   * Adds an initialized tensor that is deserialized by calling materialize_func when the graph is first executed.
+   * Until then it is not part of the maps returned by GetInitializedTensors and GetConstantInitializedTensors,
+   * so kernels do not see it as a constant input while they are created. If it is constant, it is pre-packed by the
+   * kernels of this graph when it is materialized.
+   */
+  Status AddLazyInitializedTensor(const std::string& name, int ort_value_index, bool constant,
+                                  std::function<Status(OrtValue& value)> materialize_func);
+
+  /**
+   * Materializes the initialized tensors added by AddLazyInitializedTensor if that has not been done yet, and
+   * pre-packs the constant ones for the kernels of this graph that consume them.
+   * This is called by the execution frame before the graph is executed, so initializers of subgraphs that never
+   * execute (e.g. the branch of an If node that is never taken) are never loaded.
+   */
+  Status MaterializeLazyInitializedTensors() const;
+
+  /**
+   * Gets the names of the initialized tensors added by AddLazyInitializedTensor that have not been materialized
+   * yet, in this session state and the session states of its subgraphs.
+   */
+  std::vector<std::string> GetUnmaterializedInitializerNames() const;
+
 #if !defined(DISABLE_SPARSE_TENSORS)
   bool IsSparseInitializer(int ort_value_index) const;
 #endif
@@ -193,6 +226,9 @@ class SessionState {
   // execution plan. nullptr until FinalizeSessionState is called
   const SequentialExecutionPlan* GetExecutionPlan() const;
 
+  // the recorded cost of the steps of the execution plan. nullptr until FinalizeSessionState is called
+  StepCostHistory* GetStepCostHistory() const;
+
   const std::vector<AllocPlanPerValue>& GetPerValueAllocPlan() const;
 
   /**
@@ -311,6 +347,22 @@ class SessionState {
                               bool remove_initializers = true,
                               bool saving_ort_format = false);
 
+  /**
+   * Creates a session state for another session that shares the kernels, initializers and execution plan of this
+   * finalized session state, and has its own allocators, memory patterns and device streams.
+   * The session states of the subgraphs are cloned as well.
+   * The session state that owns the shared data (this one, or the one this was cloned from) must outlive the clone.
+   */
+  Status Clone(const ExecutionProviders& execution_providers,
+               concurrency::ThreadPool* thread_pool,
+               concurrency::ThreadPool* inter_op_thread_pool,
+               const DataTransferManager& data_transfer_mgr,
+               const logging::Logger& logger,
+               profiling::Profiler& profiler,
+               const SessionOptions& sess_options,
+               std::unique_ptr<SessionState>& clone,
+               AllocatorMap* parent_allocators = nullptr) const;
+
   SessionState* Parent() {
     return parent_;
   }
@@ -327,6 +379,22 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetUsedCachedPrePackedWeightCounter() const {
+    return used_cached_pre_packed_weights_counter_;
+  }
+
+  // Set the file backed cache of pre-packed weights. Must be called before FinalizeSessionState, and the cache must
+  // outlive this SessionState as the kernels may use buffers owned by it.
+  void SetPrepackedWeightsFileCache(PrepackedWeightsFileCache* prepacked_weights_file_cache) {
+    prepacked_weights_file_cache_ = prepacked_weights_file_cache;
+  }
+
+  // Set the store that CPU initializers and pre-packed weights are shared through with other processes. Must be called
+  // before FinalizeSessionState, and the store must outlive this SessionState as the weights are mapped by it.
+  void SetSharedWeightStore(SharedWeightStore* shared_weight_store) {
+    shared_weight_store_ = shared_weight_store;
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -365,7 +433,9 @@ class SessionState {
   void CreateGraphInfo();
 
   // create kernels using info in kernel_create_info_map_
-  Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+  // Creates the kernels of the CPU EP nodes on thread_pool if it is not nullptr.
+  Status CreateKernels(const KernelRegistryManager& custom_registry_manager,
+                       concurrency::ThreadPool* thread_pool = nullptr);
 
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
@@ -376,7 +446,33 @@ class SessionState {
    * The original constant initialized tensors will be removed to save memory.
    */
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           concurrency::ThreadPool* thread_pool = nullptr);
+
+  struct ParallelPrePackResult {
+    // True if the constant initializers of the node were pre-packed by ParallelPrePackCpuKernels
+    bool handled = false;
+    InlinedVector<int> packed_input_indices;
+  };
+
+  // Pre-pack the constant initializers of the CPU EP kernels on thread_pool. The weights that are cached in the shared
+  // pre-packed weights container are skipped. results is indexed by node index.
+  Status ParallelPrePackCpuKernels(const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                   concurrency::ThreadPool* thread_pool,
+                                   /*out*/ std::vector<ParallelPrePackResult>& results);
+
+  // Record the kernel inputs of this graph that consume each constant lazy initialized tensor, so that
+  // MaterializeLazyInitializedTensors can pre-pack them. Called once the kernels are created.
+  void PlanLazyInitializedTensorsPrePacking();
+
+  // Pre-pack a constant initializer using the buffers from prepacked_weights_file_cache_ if possible.
+  // Newly pre-packed buffers are added to the cache.
+  Status PrepackWithFileCache(const Node& node, OpKernel& kernel, int input_idx, const Tensor& tensor,
+                              /*out*/ bool& is_packed);
+
+  // Pre-pack a constant initializer and hand the kernel the copies of the pre-packed buffers in shared_weight_store_.
+  Status PrepackWithSharedWeightStore(const Node& node, OpKernel& kernel, int input_idx, const Tensor& tensor,
+                                      /*out*/ bool& is_packed);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -411,8 +507,9 @@ class SessionState {
   // fused_funcs_mgr_ must live longer than the session_kernels_, becaues a kernel could be created from this manager
   FuncManager fused_funcs_mgr_;
 
-  // cache of the constructed kernels to avoid spending construction time per executor
-  std::vector<std::unique_ptr<OpKernel>> session_kernels_;
+  // cache of the constructed kernels to avoid spending construction time per executor.
+  // shared with the session states cloned from this one.
+  std::vector<std::shared_ptr<OpKernel>> session_kernels_;
   Graph& graph_;
   std::optional<GraphViewer> graph_viewer_;  // GraphViewer for const access to Graph
 
@@ -459,7 +556,9 @@ class SessionState {
   OrtValueNameIdxMap ort_value_name_idx_map_;
 
   // initialized tensors
-  std::unordered_map<int, OrtValue> initialized_tensors_;  // key is ort_value_index
+  // lazy initialized tensors are added to this map by MaterializeLazyInitializedTensors under
+  // lazy_initialized_tensors_mutex_ before the graph is first executed.
+  mutable std::unordered_map<int, OrtValue> initialized_tensors_;  // key is ort_value_index
   // subset of initialized_tensors_ that are constant and cannot be overridden at runtime
   std::unordered_map<int, OrtValue> constant_initialized_tensors_;
 
@@ -471,11 +570,31 @@ class SessionState {
   InlinedHashSet<int> sparse_initialized_tensors_;
 #endif
 
+  // initialized tensors that are deserialized when the graph is first executed. key is ort_value_index
+  struct LazyInitializedTensor {
+    std::string name;
+    bool constant;
+    std::function<Status(OrtValue& value)> materialize_func;
+    // the kernel inputs of this graph that pre-pack the tensor once it is materialized, as node index and input index
+    InlinedVector<std::pair<NodeIndex, int>> prepack_inputs;
+    // true if the tensor is only used by prepack_inputs, so it is released once all of them have pre-packed it
+    bool release_when_packed{false};
+    // set under lazy_initialized_tensors_mutex_ once the tensor was materialized and pre-packed
+    mutable bool materialized{false};
+  };
+  InlinedHashMap<int, LazyInitializedTensor> lazy_initialized_tensors_;
+  mutable OrtMutex lazy_initialized_tensors_mutex_;
+  // set once all the lazy initialized tensors were added to initialized_tensors_
+  mutable std::atomic<bool> lazy_initialized_tensors_materialized_{true};
+
   // This data structure is for uninitializing string tensors and
   // munmap memory region and close file descriptor
   InlinedHashMap<int, OrtCallback> deleter_for_initialized_tensors_;
   InlinedVector<BufferUniquePtr> weights_buffers_;
   std::optional<SequentialExecutionPlan> p_seq_exec_plan_;
+  std::unique_ptr<StepCostHistory> step_cost_history_;
+  // session state that owns the execution plan if this session state was created by Clone
+  const SessionState* clone_source_ = nullptr;
 
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
@@ -521,6 +640,17 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // Cache of pre-packed weights persisted in a file. Used for the weights that are not shared between sessions via
+  // prepacked_weights_container_. Owned by the InferenceSession. Can be nullptr.
+  PrepackedWeightsFileCache* prepacked_weights_file_cache_{};
+
+  // Store of weights shared with other processes. Used for the weights that are not cached by
+  // prepacked_weights_container_ or prepacked_weights_file_cache_. Owned by the InferenceSession. Can be nullptr.
+  SharedWeightStore* shared_weight_store_{};
+
+  // Pre-packed buffers of the kernels that could not be placed in shared_weight_store_.
+  std::vector<IAllocatorUniquePtr<void>> unshared_prepacked_buffers_;
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -551,6 +681,10 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times a pre-packed weight loaded from the pre-packed weights file cache
+  // was used by the session state
+  size_t used_cached_pre_packed_weights_counter_ = 0;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
@@ -7,6 +7,7 @@
 
 #include <core/common/status.h>
 
+#include "core/framework/endian.h"
 #include "core/framework/ortdevice.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/session_state_utils.h"
@@ -20,12 +21,14 @@
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_weight_store.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/framework/bfc_arena.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -69,13 +72,15 @@ struct ExtDataValueDeleter {
   }
 };
 
-// given a tensor proto with external data return an OrtValue with a tensor for
-// that data; the pointers for the tensor data and the tensor itself are owned
-// by the OrtValue's deleter
+// given a tensor proto with external data return a tensor that uses the external data in place.
+// the external data file is memory mapped read-only, so processes that load the same model share its pages.
+// tensor is left empty if the data can't be used in place, in which case it must be copied by the caller.
+// the pointers for the tensor data and the tensor itself are owned by the OrtValue's deleter
 static inline common::Status ExtDataTensorProtoToTensor(const Env& env,
                                                         const std::basic_string<PATH_CHAR_TYPE>& proto_path,
                                                         const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                                        Tensor& tensor, OrtCallback& ext_data_deleter) {
+                                                        std::unique_ptr<Tensor>& tensor,
+                                                        OrtCallback& ext_data_deleter) {
   ORT_ENFORCE(utils::HasExternalData(tensor_proto));
 
   void* ext_data_buf = nullptr;
@@ -83,12 +88,27 @@ static inline common::Status ExtDataTensorProtoToTensor(const Env& env,
   ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(env, proto_path.c_str(), tensor_proto,
                                                        ext_data_buf, ext_data_len, ext_data_deleter));
 
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+
+  // External data is stored in little-endian order and the kernels require the data to be aligned to the
+  // element size. Otherwise the data has to be converted into an allocated buffer by the caller.
+  const bool is_aligned = reinterpret_cast<uintptr_t>(ext_data_buf) % type->Size() == 0;
+  if (endian::native != endian::little || !is_aligned) {
+    if (!is_aligned) {
+      LOGS_DEFAULT(WARNING) << "External data of initializer '" << tensor_proto.name()
+                            << "' is not aligned to its element size and will be copied.";
+    }
+    ScopedOrtCallbackInvoker release_ext_data(ext_data_deleter);
+    ext_data_deleter = OrtCallback{nullptr, nullptr};
+    return common::Status::OK();
+  }
+
   // NB: creating a do-nothing allocator per tensor is wasteful; can perhaps be
   // avoided if the Tensor class implements the do-nothing behavior when given a
   // nullptr for the allocator argument
-  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
   TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
-  tensor = Tensor(type, tensor_shape, ext_data_buf, OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator));
+  tensor = std::make_unique<Tensor>(type, tensor_shape, ext_data_buf,
+                                    OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator));
 
   return common::Status::OK();
 }
@@ -106,6 +126,26 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   // Get shape and type of the tensor, and allocate the empty tensor
   TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
   const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+
+  const OrtDevice device = m != nullptr ? m->GetAllocInfo().device : alloc->Info().device;
+  if (device.Type() == OrtDevice::CPU && utils::HasExternalData(tensor_proto)) {
+    // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we can
+    // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor. If we called
+    // TensorProtoToTensor it would copy the data, causing unnecessary overhead
+    std::unique_ptr<Tensor> p_ext_data_tensor;
+    OrtCallback ext_data_deleter;
+    ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, p_ext_data_tensor,
+                                                   ext_data_deleter));
+    if (p_ext_data_tensor) {
+      ExtDataValueDeleter deleter{ext_data_deleter, p_ext_data_tensor.get()};
+
+      MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
+      ort_value.Init(p_ext_data_tensor.release(), ml_tensor_type, deleter);
+      return common::Status::OK();
+    }
+    // The external data can't be used in place. Copy it into an allocated buffer below.
+  }
+
   std::unique_ptr<Tensor> p_tensor;
   if (m != nullptr) {
     p_tensor = std::make_unique<Tensor>(type, tensor_shape, m->GetBuffer(), m->GetAllocInfo());
@@ -128,19 +168,6 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 
   if (p_tensor->Location().device.Type() == OrtDevice::CPU) {
     // deserialize directly to CPU tensor
-    if (utils::HasExternalData(tensor_proto)) {
-      // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we can
-      // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor. If we called
-      // TensorProtoToTensor it would copy the data, causing unnecessary overhead
-      OrtCallback ext_data_deleter;
-      ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
-
-      ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
-
-      MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
-      ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
-      return common::Status::OK();
-    }
     ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_tensor));
   } else {  // non-cpu tensor
     if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
@@ -149,24 +176,25 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 
     // deserialize to CPU first for non-CPU allocator, then copy
     std::unique_ptr<Tensor> p_deserialize_tensor;
-    if (use_device_allocator_for_initializers) {
-      void* tensor_buffer = nullptr;
-      ORT_RETURN_IF_ERROR(AllocateBufferUsingDeviceAllocatorFromShapeAndType(tensor_shape, type, default_cpu_alloc, tensor_buffer));
-      p_deserialize_tensor = std::make_unique<Tensor>(type, tensor_shape, tensor_buffer, default_cpu_alloc);
-    } else {
-      // If the provided allocator is an arena-based allocator, the call to Alloc() will tap into memory from the arena
-      // (may expand it if there isn't a chunk that can be allotted to the memory request).
-      // If the provided allocator is non-arena based, the device specific Alloc() call will be used to allocate the necessary memory.
-      p_deserialize_tensor = std::make_unique<Tensor>(type, tensor_shape, default_cpu_alloc);
-    }
-
     OrtCallback ext_data_deleter;
     std::optional<ScopedOrtCallbackInvoker> scoped_ort_callback_invoker;
     if (utils::HasExternalData(tensor_proto)) {
-      ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_deserialize_tensor,
+      ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, p_deserialize_tensor,
                                                      ext_data_deleter));
       scoped_ort_callback_invoker = ScopedOrtCallbackInvoker(ext_data_deleter);
-    } else {
+    }
+
+    if (!p_deserialize_tensor) {
+      if (use_device_allocator_for_initializers) {
+        void* tensor_buffer = nullptr;
+        ORT_RETURN_IF_ERROR(AllocateBufferUsingDeviceAllocatorFromShapeAndType(tensor_shape, type, default_cpu_alloc, tensor_buffer));
+        p_deserialize_tensor = std::make_unique<Tensor>(type, tensor_shape, tensor_buffer, default_cpu_alloc);
+      } else {
+        // If the provided allocator is an arena-based allocator, the call to Alloc() will tap into memory from the arena
+        // (may expand it if there isn't a chunk that can be allotted to the memory request).
+        // If the provided allocator is non-arena based, the device specific Alloc() call will be used to allocate the necessary memory.
+        p_deserialize_tensor = std::make_unique<Tensor>(type, tensor_shape, default_cpu_alloc);
+      }
       ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_deserialize_tensor));
     }
     // TODO!! Need a temp buffer allocator for non-escape buffers that maybe too big for stack allocation.
@@ -187,6 +215,37 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   return common::Status::OK();
 }
 
+// given a CPU initializer with raw data, create a tensor that uses a copy of the data in the shared weight store.
+// if the store does not share the data, the initializer is deserialized into a buffer from alloc instead.
+static common::Status DeserializeTensorProtoToSharedWeights(const Env& env,
+                                                            const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                                                            const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                            SharedWeightStore& shared_weight_store,
+                                                            const AllocatorPtr& alloc,
+                                                            const AllocatorPtr& default_cpu_alloc,
+                                                            OrtValue& ort_value,
+                                                            const DataTransferManager& data_transfer_mgr,
+                                                            bool use_device_allocator_for_initializers) {
+  const std::string& raw_data = tensor_proto.raw_data();
+  TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+
+  const void* shared_data = nullptr;
+  if (tensor_shape.Size() >= 0 && raw_data.size() == SafeInt<size_t>(tensor_shape.Size()) * type->Size()) {
+    ORT_RETURN_IF_ERROR(shared_weight_store.GetOrCreate(raw_data.data(), raw_data.size(), shared_data));
+  }
+
+  if (shared_data == nullptr) {
+    return DeserializeTensorProto(env, proto_path, tensor_proto, nullptr, alloc, default_cpu_alloc, ort_value,
+                                  data_transfer_mgr, use_device_allocator_for_initializers);
+  }
+
+  // the shared data is mapped read-only and owned by the store
+  Tensor::InitOrtValue(type, tensor_shape, const_cast<void*>(shared_data),
+                       OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator), ort_value);
+  return common::Status::OK();
+}
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_alloc,
@@ -194,10 +253,13 @@ common::Status SaveInitializedTensors(
     const std::vector<OrtValueIndex>& initializer_allocation_order,
     ITensorAllocator& planner,
     const SaveTensorFunction& save_tensor_func,
+    const LazyTensorFunction& lazy_tensor_func,
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func) {
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool,
+    SharedWeightStore* shared_weight_store) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -234,6 +296,12 @@ common::Status SaveInitializedTensors(
   const InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   InlinedHashMap<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   InlinedHashSet<int> user_supplied_initializer_ids;  // set containing the ort value ids of all user supplied initializers
+  // set containing the ort value ids of the initializers that are deserialized when they are first needed.
+  // only initializers with external data are deferred, so the data stays in the external data file until then.
+  InlinedHashSet<int> lazy_initializer_ids;
+  // set containing the ort value ids of the CPU initializers that are placed in the shared weight store.
+  // initializers with external data are not, as their pages are shared via the mapped external data file.
+  InlinedHashSet<int> shared_initializer_ids;
 
   id_to_initialized_tensor.reserve(initialized_tensor_set.size());
   user_supplied_initializer_ids.reserve(initialized_tensor_set.size());
@@ -243,6 +311,21 @@ common::Status SaveInitializedTensors(
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (lazy_tensor_func && utils::HasExternalData(*entry.second)
+#if !defined(DISABLE_SPARSE_TENSORS)
+               && !graph.GetGraph().IsSparseInitializer(entry.first)
+#endif
+    ) {
+      lazy_initializer_ids.insert(ort_value_index);
+    } else if (shared_weight_store != nullptr && endian::native == endian::little &&
+               exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU &&
+               utils::HasRawData(*entry.second) && !utils::HasExternalData(*entry.second) &&
+               entry.second->raw_data().size() >= SharedWeightStore::kMinBufferSize
+#if !defined(DISABLE_SPARSE_TENSORS)
+               && !graph.GetGraph().IsSparseInitializer(entry.first)
+#endif
+    ) {
+      shared_initializer_ids.insert(ort_value_index);
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
@@ -256,7 +339,9 @@ common::Status SaveInitializedTensors(
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end(),
                 "OrtValue index: ", ort_value_index, " from initializer_allocation_order not found among initialized tensors");
-    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU)) {
+    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU) &&
+        lazy_initializer_ids.find(ort_value_index) == lazy_initializer_ids.end() &&
+        shared_initializer_ids.find(ort_value_index) == shared_initializer_ids.end()) {
       // can not trace string tensor
       ORT_ENFORCE(entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING, "Can not trace string tensor");
       ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
@@ -265,8 +350,11 @@ common::Status SaveInitializedTensors(
   }
 
   for (const auto& entry : initialized_tensors_to_allocate) {
-    // We don't want to trace shared initializers since their memory is provided by the user
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    // We don't want to trace shared initializers since their memory is provided by the user or the shared weight store,
+    // or lazy initializers since their memory is allocated when they are materialized
+    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+        lazy_initializer_ids.find(entry.first) != lazy_initializer_ids.end() ||
+        shared_initializer_ids.find(entry.first) != shared_initializer_ids.end()) {
       continue;
     }
     if (entry.second->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
@@ -292,7 +380,67 @@ common::Status SaveInitializedTensors(
 
   OrtCallback deleter{nullptr, nullptr};
 
-  // 3. create weight tensors based on weights buffer
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  auto deserialize_tensor = [&](const ONNX_NAMESPACE::TensorProto& tensor_proto, const std::optional<MemBuffer>& m,
+                                const AllocatorPtr& alloc, OrtValue& ort_value) -> Status {
+    Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
+                                       default_cpu_alloc, ort_value, data_transfer_mgr,
+                                       use_device_allocator_for_initializers);
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << tensor_proto.name() << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
+    }
+    return Status::OK();
+  };
+
+  // 3. deserialize the initializers that are planned on CPU in parallel if a thread pool is provided.
+  // Initializers on other devices are deserialized in step 4 as they are copied to the device.
+  struct DeserializedInitializer {
+    OrtValue ort_value;
+    Status status;
+  };
+  InlinedHashMap<int, DeserializedInitializer> deserialized_initializers;
+  if (thread_pool != nullptr) {
+    struct InitializerToDeserialize {
+      int ort_value_index;
+      const ONNX_NAMESPACE::TensorProto* tensor_proto;
+      std::optional<MemBuffer> m;
+      AllocatorPtr alloc;
+    };
+    std::vector<InitializerToDeserialize> initializers_to_deserialize;
+    initializers_to_deserialize.reserve(id_to_initialized_tensor.size());
+    for (const auto& entry : id_to_initialized_tensor) {
+      const std::string& name = entry.second->name();
+      if (name.empty() ||
+          user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+          lazy_initializer_ids.find(entry.first) != lazy_initializer_ids.end() ||
+          shared_initializer_ids.find(entry.first) != shared_initializer_ids.end() ||
+          exec_plan.GetLocation(entry.first).Type() != OrtDevice::CPU) {
+        continue;
+      }
+
+      // The planner is not thread safe, so the buffers are retrieved up front.
+      auto& initializer = initializers_to_deserialize.emplace_back(
+          InitializerToDeserialize{entry.first, entry.second, std::nullopt, nullptr});
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(entry.first, name, initializer.m, initializer.alloc));
+      deserialized_initializers[entry.first];
+    }
+
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(initializers_to_deserialize.size()),
+        [&](std::ptrdiff_t i) {
+          const auto& initializer = initializers_to_deserialize[i];
+          // The map is not modified while deserializing, so the entries can be updated concurrently.
+          auto& deserialized = deserialized_initializers.find(initializer.ort_value_index)->second;
+          deserialized.status = deserialize_tensor(*initializer.tensor_proto, initializer.m, initializer.alloc,
+                                                   deserialized.ort_value);
+        });
+  }
+
+  // 4. create weight tensors based on weights buffer
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const std::string& name = entry.second->name();
@@ -302,11 +450,51 @@ common::Status SaveInitializedTensors(
       continue;
     }
 
+    if (lazy_initializer_ids.find(ort_value_index) != lazy_initializer_ids.end()) {
+      // lazy initializers are not traced by the planner, so they are allocated separately
+      AllocatorPtr alloc = planner.GetAllocator(exec_plan.GetLocation(ort_value_index));
+
+      // The TensorProto is copied as the graph may release its initializers once the session state is finalized.
+      // It only references the external data, so this is cheap.
+      MaterializeTensorFunction materialize_func =
+          [&env, graph_loc, tensor_proto = *entry.second, alloc, default_cpu_alloc, &data_transfer_mgr,
+           use_device_allocator_for_initializers](OrtValue& ort_value) -> Status {
+        Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, nullptr, alloc, default_cpu_alloc,
+                                           ort_value, data_transfer_mgr, use_device_allocator_for_initializers);
+        if (!st.IsOK()) {
+          std::ostringstream oss;
+          oss << "Deserialize tensor " << tensor_proto.name() << " failed." << st.ErrorMessage();
+          return Status(st.Category(), st.Code(), oss.str());
+        }
+        return Status::OK();
+      };
+
+      VLOGS(logger, 1) << "Deferring weight with name : " << name << " with index: " << ort_value_index;
+      const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
+      ORT_RETURN_IF_ERROR(lazy_tensor_func(name, ort_value_index, constant, std::move(materialize_func)));
+      continue;
+    }
+
     OrtValue ort_value;
 
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (auto deserialized = deserialized_initializers.find(ort_value_index);
+               deserialized != deserialized_initializers.end()) {
+      ORT_RETURN_IF_ERROR(deserialized->second.status);
+      ort_value = std::move(deserialized->second.ort_value);
+    } else if (shared_initializer_ids.find(ort_value_index) != shared_initializer_ids.end()) {
+      // shared initializers are not traced by the planner, so a fallback buffer is allocated separately
+      AllocatorPtr alloc = planner.GetAllocator(exec_plan.GetLocation(ort_value_index));
+      Status st = DeserializeTensorProtoToSharedWeights(env, graph_loc, *entry.second, *shared_weight_store, alloc,
+                                                        default_cpu_alloc, ort_value, data_transfer_mgr,
+                                                        use_device_allocator_for_initializers);
+      if (!st.IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
+        return Status(st.Category(), st.Code(), oss.str());
+      }
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
@@ -314,17 +502,7 @@ common::Status SaveInitializedTensors(
       AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
       ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
-
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr,
-                                         use_device_allocator_for_initializers);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
-      }
+      ORT_RETURN_IF_ERROR(deserialize_tensor(tensor_proto, m, alloc, ort_value));
     }
 
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
@@ -21,6 +21,7 @@ class GraphViewer;
 class OrtValueNameIdxMap;
 class DataTransferManager;
 class NodeArg;
+class SharedWeightStore;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
 #endif
@@ -29,9 +30,18 @@ namespace logging {
 class Logger;
 }
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(const std::string& name, int idx, const OrtValue& value,
                                                 const OrtCallback& d, bool constant, bool sparse)>;
+// Deserializes an initializer that was deferred by SaveInitializedTensors.
+using MaterializeTensorFunction = std::function<Status(OrtValue& value)>;
+// Registers an initializer that is deserialized by calling materialize_func when it is first needed.
+using LazyTensorFunction = std::function<Status(const std::string& name, int idx, bool constant,
+                                                MaterializeTensorFunction materialize_func)>;
 using MemoryProfileFunction = std::function<void(ITensorAllocator& planner)>;
 
 common::Status SaveInitializedTensors(
@@ -40,11 +50,14 @@ common::Status SaveInitializedTensors(
     const OrtValueNameIdxMap& ort_value_name_idx_map, const std::vector<OrtValueIndex>& initializer_allocation_order,
     ITensorAllocator& planner,
     const SaveTensorFunction& save_tensor_func,
+    const LazyTensorFunction& lazy_tensor_func,
     const logging::Logger& logger,
     const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func);
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool = nullptr,
+    SharedWeightStore* shared_weight_store = nullptr);
 
 common::Status SaveInputOutputNamesToNodeMapping(const GraphViewer& graph,
                                                  SessionState& session_state,
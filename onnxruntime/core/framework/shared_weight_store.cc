@@ -0,0 +1,255 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_weight_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "core/common/logging/logging.h"
+#include "core/framework/murmurhash3.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr const char* kLockFileName = "store.lock";
+constexpr const char* kBufferFileExtension = ".weights";
+constexpr const char* kTempFilePrefix = "tmp-";
+
+// The file name of a buffer is the hash and the size of its content.
+std::string GetBufferFileName(const void* data, size_t size) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  // MurmurHash3 takes an int length, so large buffers are hashed in chunks.
+  constexpr size_t max_chunk_length = static_cast<size_t>(std::numeric_limits<int>::max());
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t length = size; length > 0;) {
+    const size_t chunk_length = std::min(length, max_chunk_length);
+    MurmurHash3::x86_128(bytes, static_cast<int>(chunk_length), hash[0], &hash);
+    bytes += chunk_length;
+    length -= chunk_length;
+  }
+
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0');
+  for (uint32_t h : hash) {
+    ss << std::setw(8) << h;
+  }
+  ss << "-" << std::dec << size << kBufferFileExtension;
+  return ss.str();
+}
+
+bool IsStoreFile(const std::string& file_name) {
+  const std::string extension{kBufferFileExtension};
+  return file_name.rfind(kTempFilePrefix, 0) == 0 ||
+         (file_name.size() > extension.size() &&
+          file_name.compare(file_name.size() - extension.size(), extension.size(), extension) == 0);
+}
+
+#if !defined(_WIN32)
+Status ReportSystemError(const char* operation_name, const std::string& path) {
+  const int err_no = errno;
+  return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, operation_name, " file \"", path, "\" failed: ",
+                         std::generic_category().message(err_no));
+}
+#endif
+
+}  // namespace
+
+SharedWeightStore::SharedWeightStore(const PathString& directory, int lock_fd)
+    : directory_(directory), lock_fd_(lock_fd) {
+}
+
+SharedWeightStore::~SharedWeightStore() {
+  // Unmap the buffers before the lock is released, as the buffers may be removed once it is.
+  buffers_.clear();
+#if !defined(_WIN32)
+  close(lock_fd_);
+#endif
+}
+
+Status SharedWeightStore::Open(const PathString& directory, std::unique_ptr<SharedWeightStore>& store) {
+#if defined(_WIN32)
+  ORT_UNUSED_PARAMETER(directory);
+  ORT_UNUSED_PARAMETER(store);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The shared weight store is not supported on this platform.");
+#else
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  ORT_RETURN_IF(error, "Failed to create the shared weight store directory ", directory, ": ", error.message());
+
+  const std::string lock_path = (std::filesystem::path(directory) / kLockFileName).string();
+  const int lock_fd = open(lock_path.c_str(), O_RDONLY | O_CREAT | O_CLOEXEC, 0644);
+  if (lock_fd < 0) {
+    return ReportSystemError("open", lock_path);
+  }
+
+  // The shared lock marks the store as being in use until it is destroyed. It waits for a running RemoveUnused().
+  if (flock(lock_fd, LOCK_SH) != 0) {
+    auto status = ReportSystemError("flock", lock_path);
+    close(lock_fd);
+    return status;
+  }
+
+  store.reset(new SharedWeightStore(directory, lock_fd));
+  return Status::OK();
+#endif
+}
+
+Status SharedWeightStore::WriteBuffer(const PathString& file_name, const void* data, size_t size) const {
+#if defined(_WIN32)
+  ORT_UNUSED_PARAMETER(file_name);
+  ORT_UNUSED_PARAMETER(data);
+  ORT_UNUSED_PARAMETER(size);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The shared weight store is not supported on this platform.");
+#else
+  static std::atomic<uint64_t> temp_file_counter{0};
+
+  const std::filesystem::path file_path = std::filesystem::path(directory_) / file_name;
+  std::filesystem::path temp_file_path = std::filesystem::path(directory_) /
+                                         (kTempFilePrefix + std::to_string(getpid()) + "-" +
+                                          std::to_string(temp_file_counter++));
+  std::error_code remove_error;
+  {
+    std::ofstream out(temp_file_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(out, "Failed to open ", temp_file_path.string(), " for writing.");
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    out.close();
+    if (!out) {
+      // e.g. the file system is full, don't leave a partial file behind
+      std::filesystem::remove(temp_file_path, remove_error);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write shared weights to ", temp_file_path.string());
+    }
+  }
+
+  // Linking fails if another process created the buffer in the meantime, in which case its file is used.
+  std::error_code error;
+  std::filesystem::create_hard_link(temp_file_path, file_path, error);
+  std::filesystem::remove(temp_file_path, remove_error);
+  ORT_RETURN_IF(error && error != std::errc::file_exists,
+                "Failed to create ", file_path.string(), ": ", error.message());
+
+  return Status::OK();
+#endif
+}
+
+Status SharedWeightStore::GetOrCreate(const void* data, size_t size, const void*& shared_data) {
+  shared_data = nullptr;
+  if (data == nullptr || size < kMinBufferSize) {
+    return Status::OK();
+  }
+
+  const PathString file_name = ToPathString(GetBufferFileName(data, size));
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto iter = buffers_.find(file_name);
+  if (iter == buffers_.end()) {
+    const std::filesystem::path file_path = std::filesystem::path(directory_) / file_name;
+    // The store is an optimization, so a store that cannot be written (e.g. as it is full) or mapped leaves the
+    // data unshared rather than failing the caller.
+    std::error_code error;
+    if (!std::filesystem::exists(file_path, error)) {
+      Status status = WriteBuffer(file_name, data, size);
+      if (!status.IsOK()) {
+        LOGS_DEFAULT(WARNING) << "Weights are not shared as they could not be added to the shared weight store: "
+                              << status.ErrorMessage();
+        return Status::OK();
+      }
+    }
+
+    // Accessing a mapping beyond the end of the file is fatal, so a file of the wrong size is not used.
+    const auto file_size = std::filesystem::file_size(file_path, error);
+    if (error || file_size != size) {
+      return Status::OK();
+    }
+
+    Env::MappedMemoryPtr mapped_buffer;
+    Status status = Env::Default().MapFileIntoMemory(file_path.c_str(), 0, size, mapped_buffer);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Weights are not shared as the shared weight store could not be mapped: "
+                            << status.ErrorMessage();
+      return Status::OK();
+    }
+    iter = buffers_.emplace(file_name, std::move(mapped_buffer)).first;
+  }
+
+  // The file name is derived from a hash of the content, so the content itself needs to be compared.
+  if (memcmp(iter->second.get(), data, size) == 0) {
+    shared_data = iter->second.get();
+  }
+
+  return Status::OK();
+}
+
+Status SharedWeightStore::RemoveUnused(const PathString& directory, bool& in_use, size_t& num_removed) {
+  in_use = false;
+  num_removed = 0;
+#if defined(_WIN32)
+  ORT_UNUSED_PARAMETER(directory);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The shared weight store is not supported on this platform.");
+#else
+  const std::string lock_path = (std::filesystem::path(directory) / kLockFileName).string();
+  const int lock_fd = open(lock_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (lock_fd < 0) {
+    return errno == ENOENT ? Status::OK() : ReportSystemError("open", lock_path);
+  }
+
+  // The lock file itself is kept, as a store that is being opened may already have opened it.
+  Status status;
+  if (flock(lock_fd, LOCK_EX | LOCK_NB) != 0) {
+    if (errno == EWOULDBLOCK) {
+      in_use = true;
+    } else {
+      status = ReportSystemError("flock", lock_path);
+    }
+  } else {
+    std::error_code error;
+    std::vector<std::filesystem::path> file_paths;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+      if (IsStoreFile(entry.path().filename().string())) {
+        file_paths.push_back(entry.path());
+      }
+    }
+
+    for (const auto& file_path : file_paths) {
+      if (error) {
+        break;
+      }
+      if (std::filesystem::remove(file_path, error)) {
+        ++num_removed;
+      }
+    }
+
+    if (error) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to remove the shared weights in ", directory, ": ",
+                               error.message());
+    }
+  }
+
+  close(lock_fd);
+  return status;
+#endif
+}
+
+size_t SharedWeightStore::GetNumberOfBuffers() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return buffers_.size();
+}
+
+}  // namespace onnxruntime
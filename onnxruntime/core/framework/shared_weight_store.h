@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// A content addressed store of read-only weight buffers that are shared between processes.
+//
+// Each buffer is a file in the store directory that is named after a hash of its content. The files are memory mapped
+// read-only, so all the processes that use the same weights map the same physical pages. When the directory is on a
+// memory backed file system such as /dev/shm the buffers are plain shared memory.
+//
+// A buffer file is written under a temporary name and then linked to its final name, so other processes never see a
+// partially written buffer. The content of an existing buffer is compared with the data it is requested for, so a hash
+// collision results in an unshared buffer rather than in wrong weights.
+//
+// Every open store holds a shared lock on the lock file of its directory. RemoveUnused() only removes the buffers of
+// a directory when no process has the store open, so the buffers can be reused by processes that start later, such
+// as restarted workers, until they are cleaned up.
+//
+// Access to the buffers is controlled by the permissions of the directory. Only supported on POSIX platforms.
+class SharedWeightStore final {
+ public:
+  // Opens the store in `directory`, which is created if it does not exist.
+  static Status Open(const PathString& directory, std::unique_ptr<SharedWeightStore>& store);
+
+  ~SharedWeightStore();
+
+  // Returns a read-only shared copy of `data`, which is created if the store does not have one yet.
+  // `shared_data` is set to nullptr if the data is not shared, in which case the caller keeps its own copy. This is
+  // also the case if the store cannot be written or mapped, which is logged as a warning.
+  // The shared copy is valid until the store is destroyed.
+  Status GetOrCreate(const void* data, size_t size, /*out*/ const void*& shared_data);
+
+  // Removes the buffers in `directory` unless a process has the store open, in which case `in_use` is set and
+  // nothing is removed.
+  static Status RemoveUnused(const PathString& directory, /*out*/ bool& in_use, /*out*/ size_t& num_removed);
+
+  // Returns the number of buffers mapped by this store
+  size_t GetNumberOfBuffers() const;
+
+  // Buffers smaller than this are not shared as every buffer takes up at least one page of memory.
+  static constexpr size_t kMinBufferSize = 16 * 1024;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedWeightStore);
+
+ private:
+  SharedWeightStore(const PathString& directory, int lock_fd);
+
+  Status WriteBuffer(const PathString& file_name, const void* data, size_t size) const;
+
+  const PathString directory_;
+  const int lock_fd_;
+
+  mutable OrtMutex mutex_;
+  // The mapped buffers keyed by their file name.
+  std::unordered_map<PathString, Env::MappedMemoryPtr> buffers_;
+};
+
+}  // namespace onnxruntime
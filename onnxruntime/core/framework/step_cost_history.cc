@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/step_cost_history.h"
+
+#include "core/framework/sequential_execution_plan.h"
+
+namespace onnxruntime {
+
+StepCostHistory::StepCostHistory(const SequentialExecutionPlan& plan) {
+  num_steps_.reserve(plan.execution_plan.size());
+  costs_.reserve(plan.execution_plan.size());
+  for (const auto& stream : plan.execution_plan) {
+    const size_t num_steps = stream ? stream->steps_.size() : 0;
+    num_steps_.push_back(num_steps);
+    // value initialization sets the costs to 0
+    costs_.emplace_back(new std::atomic<int64_t>[num_steps]());
+  }
+}
+
+void StepCostHistory::Record(size_t stream_idx, size_t step_idx, int64_t duration_ns) {
+  auto& cost = costs_[stream_idx][step_idx];
+  const int64_t previous = cost.load(std::memory_order_relaxed);
+  // the first duration is used as is so the history is usable after a single Run()
+  const int64_t updated = previous == 0 ? duration_ns : previous + (duration_ns - previous) / 8;
+  cost.store(updated, std::memory_order_relaxed);
+}
+
+std::vector<int64_t> StepCostHistory::GetRemainingCosts(size_t stream_idx) const {
+  const size_t num_steps = num_steps_[stream_idx];
+  std::vector<int64_t> remaining_costs(num_steps + 1, 0);
+  for (size_t i = num_steps; i > 0; --i) {
+    remaining_costs[i - 1] = remaining_costs[i] + costs_[stream_idx][i - 1].load(std::memory_order_relaxed);
+  }
+  return remaining_costs;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace onnxruntime {
+
+struct SequentialExecutionPlan;
+
+// Keeps track of how long the steps of an execution plan take.
+// Run() calls with a deadline record the duration of the steps they execute, and use the recorded durations to
+// predict whether their remaining steps can finish before the deadline.
+// The durations are recorded by concurrent Run() calls without synchronization, so they are only estimates.
+class StepCostHistory {
+ public:
+  explicit StepCostHistory(const SequentialExecutionPlan& plan);
+
+  // Records the duration of a step. The cost of a step is a moving average of its recorded durations.
+  void Record(size_t stream_idx, size_t step_idx, int64_t duration_ns);
+
+  // Returns the cost of each step of a stream added to the cost of the steps after it, in nanoseconds.
+  // The returned vector has an additional entry of 0 for the end of the stream.
+  // Steps that were never executed by a Run() call with a deadline have a cost of 0.
+  std::vector<int64_t> GetRemainingCosts(size_t stream_idx) const;
+
+ private:
+  std::vector<size_t> num_steps_;
+  // the step costs of each stream, in nanoseconds
+  std::vector<std::unique_ptr<std::atomic<int64_t>[]>> costs_;
+};
+
+}  // namespace onnxruntime
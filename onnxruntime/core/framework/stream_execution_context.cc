@@ -5,8 +5,11 @@
 #include "core/framework/execution_frame.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/session_state.h"
+#include "core/framework/step_cost_history.h"
 #include "core/common/spin_pause.h"
 
+#include <sstream>
+
 namespace onnxruntime {
 #ifdef ORT_ENABLE_STREAM
 StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
@@ -173,6 +176,69 @@ void StreamExecutionContext::RecycleNodeInputs(onnxruntime::NodeIndex node_index
   }
 }
 
+void StreamExecutionContext::SetDeadline(std::chrono::steady_clock::time_point deadline) {
+  has_deadline_ = true;
+  deadline_ = deadline;
+  step_cost_history_ = session_state_->GetStepCostHistory();
+
+  const size_t num_streams = session_state_->GetExecutionPlan()->execution_plan.size();
+  remaining_step_costs_.clear();
+  remaining_step_costs_.reserve(num_streams);
+  for (size_t i = 0; i < num_streams; ++i) {
+    if (step_cost_history_) {
+      remaining_step_costs_.push_back(step_cost_history_->GetRemainingCosts(i));
+    } else {
+      remaining_step_costs_.emplace_back(session_state_->GetExecutionPlan()->execution_plan[i]->steps_.size() + 1, 0);
+    }
+  }
+
+  // value initialization sets the counts to 0
+  executed_steps_.reset(new std::atomic<size_t>[num_streams]());
+}
+
+Status StreamExecutionContext::CheckDeadline(size_t stream_idx, size_t step_idx,
+                                             std::chrono::steady_clock::time_point now) const {
+  executed_steps_[stream_idx].store(step_idx, std::memory_order_relaxed);
+
+  const int64_t remaining_cost_ns = remaining_step_costs_[stream_idx][step_idx];
+  const int64_t time_left_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline_ - now).count();
+  if (time_left_ns > 0 && remaining_cost_ns <= time_left_ns) {
+    return Status::OK();
+  }
+
+  // report the work done and skipped by all the streams
+  size_t num_executed_steps = 0;
+  size_t num_steps = 0;
+  int64_t skipped_cost_ns = 0;
+  for (size_t i = 0; i < remaining_step_costs_.size(); ++i) {
+    const size_t executed = executed_steps_[i].load(std::memory_order_relaxed);
+    num_executed_steps += executed;
+    num_steps += remaining_step_costs_[i].size() - 1;
+    skipped_cost_ns += remaining_step_costs_[i][executed];
+  }
+
+  std::ostringstream reason;
+  if (time_left_ns <= 0) {
+    reason << "The deadline of the run was exceeded.";
+  } else {
+    reason << "The run cannot finish before its deadline. The remaining steps have an estimated cost of "
+           << remaining_cost_ns / 1000 << "us and " << time_left_ns / 1000 << "us are left.";
+  }
+
+  return ORT_MAKE_STATUS(ONNXRUNTIME, DEADLINE_EXCEEDED, reason.str(), " Executed ", num_executed_steps, " of ",
+                         num_steps, " steps. The skipped steps have an estimated cost of ", skipped_cost_ns / 1000,
+                         "us.");
+}
+
+void StreamExecutionContext::RecordStepCost(size_t stream_idx, size_t step_idx,
+                                            std::chrono::steady_clock::duration duration) {
+  executed_steps_[stream_idx].store(step_idx + 1, std::memory_order_relaxed);
+  if (step_cost_history_) {
+    step_cost_history_->Record(stream_idx, step_idx,
+                               std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+  }
+}
+
 void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& session_scope, const bool& terminate_flag, size_t since) {
   if (!ctx.TaskStatus().IsOK()) {
     // already in bad status, terminate it
@@ -214,6 +280,16 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
       ctx.CompleteTask();
       return;
     }
+    std::chrono::steady_clock::time_point step_start;
+    if (ctx.HasDeadline()) {
+      step_start = std::chrono::steady_clock::now();
+      Status deadline_status = ctx.CheckDeadline(stream_idx, since, step_start);
+      if (!deadline_status.IsOK()) {
+        ctx.SetStatus(deadline_status);
+        ctx.CompleteTask();
+        return;
+      }
+    }
     bool continue_flag = true;
     Status status;
     ORT_TRY {
@@ -230,6 +306,9 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
       ctx.CompleteTask();
       return;
     }
+    if (ctx.HasDeadline()) {
+      ctx.RecordStepCost(stream_idx, since, std::chrono::steady_clock::now() - step_start);
+    }
     if (!continue_flag) {
       // break but not terminate
       ctx.CompleteTask();
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #pragma once
+#include <chrono>
 #include "core/common/logging/logging.h"
 #include "core/framework/device_stream_collection.h"
 #include "core/framework/execution_frame.h"
@@ -16,6 +17,7 @@
 
 namespace onnxruntime {
 class SessionState;
+class StepCostHistory;
 
 class SessionScope;
 typedef InlinedHashMap<std::string, OrtValue> OrtValueCache;
@@ -116,6 +118,18 @@ class StreamExecutionContext {
   // Release the OrtValues after a step, based on the execution plan.
   void RecycleNodeInputs(onnxruntime::NodeIndex node_index);
 
+  // Set the deadline of the execution. Must be called before the streams are run.
+  void SetDeadline(std::chrono::steady_clock::time_point deadline);
+
+  bool HasDeadline() const { return has_deadline_; }
+
+  // Check whether the steps of a stream from 'step_idx' on can finish before the deadline, based on their recorded
+  // cost. Returns a DEADLINE_EXCEEDED status that reports the work that is skipped if they cannot.
+  Status CheckDeadline(size_t stream_idx, size_t step_idx, std::chrono::steady_clock::time_point now) const;
+
+  // Record the duration of a step that was executed with a deadline.
+  void RecordStepCost(size_t stream_idx, size_t step_idx, std::chrono::steady_clock::duration duration);
+
 #ifdef ENABLE_TRAINING
   void SetOrtValueCache(OrtValueCachePtr cache) {
     cache_ = std::move(cache);
@@ -160,6 +174,14 @@ class StreamExecutionContext {
 
   Status task_status_{Status::OK()};
 
+  bool has_deadline_{false};
+  std::chrono::steady_clock::time_point deadline_;
+  StepCostHistory* step_cost_history_{nullptr};
+  // the recorded cost of the steps of each stream from a step on, in nanoseconds
+  std::vector<std::vector<int64_t>> remaining_step_costs_;
+  // the number of steps of each stream that were executed
+  std::unique_ptr<std::atomic<size_t>[]> executed_steps_;
+
 #ifdef ENABLE_TRAINING
   const ProgramRegion* program_range_{nullptr};
 
@@ -1408,7 +1408,8 @@ ONNX_MS_OPERATOR_SET_SCHEMA(FusedGemm, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(
 The FusedGemm operator schema is the same as Gemm besides it includes attributes
-activation and leaky_relu_alpha.)DOC")
+activation and leaky_relu_alpha, and the optional input R which is added to the
+output after the activation.)DOC")
                                 .Input(
                                     0,
                                     "A",
@@ -1430,6 +1431,12 @@ activation and leaky_relu_alpha.)DOC")
                                     "The shape of C should be unidirectional broadcastable to (M, N).",
                                     "T",
                                     OpSchema::Optional)
+                                .Input(
+                                    3,
+                                    "R",
+                                    "Residual input tensor of shape (M, N), added after the activation.",
+                                    "T",
+                                    OpSchema::Optional)
                                 .Output(0, "Y", "Output tensor of shape (M, N).", "T")
                                 .TypeConstraint(
                                     "T",
@@ -2947,6 +2954,8 @@ Input zero_points is stored as uint8_t. If bits <= 4, two zero points are stored
   - [(N * n_blocks_per_col + 1) / 2] if bits <=4
   - [N * n_blocks_per_col] if bits > 4
 
+8 bits values are stored one per byte.
+
 )DOC";
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulNBits)
@@ -2957,6 +2966,9 @@ Input zero_points is stored as uint8_t. If bits <= 4, two zero points are stored
       .Attr("N", "size of each output feature", AttributeProto::INT)
       .Attr("bits", "number of bits used for weight quantization (default 4)", AttributeProto::INT)
       .Attr("block_size", "number of groupsize used for weight quantization,(default 128). It needs to be a power of 2 and not smaller than 16.", AttributeProto::INT)
+      .Attr("accuracy_level",
+            "The minimum accuracy level of input A, can be: 0(unset), 1(fp32), 2(fp16), 3(bf16), or 4(int8) (default unset). It is used to control how input A is quantized or downcast internally while doing computation, for example: 0 means input A will not be quantized or downcast while doing computation. 4 means input A can be quantized with the same block_size to int8 internally from type T1.",
+            AttributeProto::INT, static_cast<int64_t>(0))
       .Input(0, "A", "The input tensor, not quantized", "T1")
       .Input(1, "B", "1-dimensional data blob", "T2")
       .Input(2, "scales", "quantization scale", "T1")
@@ -91,6 +91,15 @@ Abstract:
 #endif // ARM64
 #endif // Visual Studio 16 or earlier does not support fp16 intrinsic
 
+//
+// Half precision GEMM has vectorized kernels on x64 too, selected at runtime
+// (F16C or AVX512-FP16), even though the other fp16 routines do not.
+//
+
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) || defined(MLAS_TARGET_AMD64)
+#define MLAS_F16GEMM_SUPPORTED
+#endif
+
 //
 // Basic Linear Algebra Subprograms (BLAS) types.
 //
@@ -104,7 +113,8 @@ typedef enum { CblasLeft=141, CblasRight=142} CBLAS_SIDE;
 #endif
 
 //
-// Forward declare the thread pool implementation class and half precision floating point.
+// Forward declare the thread pool implementation class and the half precision
+// and bfloat16 floating point types.
 //
 // N.B. Avoid including ONNX Runtime headers here to keep the dependencies for
 // standalone MLAS test executables smaller.
@@ -115,6 +125,7 @@ namespace onnxruntime {
         class ThreadPool;
     };
     struct MLFloat16;
+    struct BFloat16;
 };  // namespace onnxruntime
 
 using MLAS_THREADPOOL = onnxruntime::concurrency::ThreadPool;
@@ -158,6 +169,9 @@ enum MLAS_ACTIVATION_KIND {
     MlasLogisticActivation,
     MlasClipActivation,
     MlasHardSigmoidActivation,
+    MlasGeluErfActivation,
+    MlasGeluTanhActivation,
+    MlasSiluActivation,
     MlasActivationKindCount,
 };
 
@@ -196,6 +210,21 @@ MlasActivation(
 // op(X) = X or op(X) = transpose(X) or op(X) = conjg(transpose(X))
 //
 
+template<typename T>
+class MLAS_GEMM_POSTPROCESSOR
+{
+   public:
+    virtual void Process(T*,         /**< the address of matrix to process */
+                         size_t,     /**< the start row index of matrix */
+                         size_t,     /**< the start col index of matrix */
+                         size_t,     /**< the element count per row to process */
+                         size_t,     /**< the element count per col to process */
+                         size_t      /**< the leading dimension of matrix */
+    ) const = 0;
+
+    virtual ~MLAS_GEMM_POSTPROCESSOR() {}
+};
+
 /**
  * @brief Supply matrices data information to single precision gemm functions
  */
@@ -209,6 +238,69 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor = nullptr; /**< Optional processor of each tile of C */
+};
+
+/**
+ * @brief Dimension of a single precision GEMM partitioned across threads
+ */
+enum MLAS_SGEMM_THREAD_PARTITION {
+    MlasSgemmPartitionDefault, /**< N if N is larger than M, else M */
+    MlasSgemmPartitionM,
+    MlasSgemmPartitionN,
+};
+
+/**
+ * @brief Blocking and threading parameters of a single precision GEMM, as
+ *        found by tuning a class of problem shapes on the current processor.
+ *        A zero member selects the built-in heuristic for that parameter.
+ */
+struct MLAS_SGEMM_TUNING_PARAMETERS {
+    size_t StrideN = 0;          /**< N stride of the B panel, a multiple of 16 */
+    size_t StrideK = 0;          /**< K stride of the B panel, StrideN * StrideK must not exceed 16384 */
+    size_t ThreadComplexity = 0; /**< multiply-adds assigned to each thread */
+    MLAS_SGEMM_THREAD_PARTITION Partition = MlasSgemmPartitionDefault;
+};
+
+/**
+ * @brief Epilogue of a single precision GEMM, applied to each tile of C after
+ *        its last K slice while the tile is still in cache:
+ *
+ *        C = Activation(C + Bias) + Residual
+ *
+ *        and, if QuantOutput is supplied, C is also quantized to QuantOutput
+ *        with QuantScale and QuantZeroPoint.
+ */
+struct MLAS_GEMM_EPILOGUE {
+    const float* Bias = nullptr;      /**< optional bias per column, vector size N */
+    MLAS_ACTIVATION Activation{MlasIdentityActivation, {}};
+    const float* Residual = nullptr;  /**< optional matrix added after the activation */
+    size_t ldr = 0;                   /**< leading dimension of Residual */
+    void* QuantOutput = nullptr;      /**< optional int8 or uint8 quantized copy of C */
+    size_t ldq = 0;                   /**< leading dimension of QuantOutput */
+    bool QuantOutputIsSigned = false; /**< whether QuantOutput is int8 */
+    float QuantScale = 1.0f;
+    int32_t QuantZeroPoint = 0;
+};
+
+/**
+ * @brief Output processor of MLAS_GEMM_EPILOGUE, to be supplied as the
+ *        OutputProcessor of MLAS_SGEMM_DATA_PARAMS.
+ */
+class MLAS_GEMM_EPILOGUE_PROCESSOR : public MLAS_GEMM_POSTPROCESSOR<float>
+{
+   public:
+    MLAS_GEMM_EPILOGUE_PROCESSOR(const MLAS_GEMM_EPILOGUE& Epilogue) : Epilogue_(Epilogue) {}
+
+    void Process(float* C,
+                 size_t StartM,
+                 size_t StartN,
+                 size_t CountM,
+                 size_t CountN,
+                 size_t ldc) const override;
+
+   private:
+    MLAS_GEMM_EPILOGUE Epilogue_;
 };
 
 /**
@@ -224,6 +316,9 @@ struct MLAS_SGEMM_DATA_PARAMS {
  * @param BatchSize  Supplies number of multiplications in this batch
  * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
                      base library threading support should be used.
+ * @param TuningParameters  Optionally supplies the blocking and threading
+                     parameters tuned for this shape, see
+                     MlasSgemmTuningCandidates.
  */
 void
 MLASCALL
@@ -235,7 +330,23 @@ MlasGemmBatch(
     size_t K,
     const MLAS_SGEMM_DATA_PARAMS* Data,
     size_t BatchSize,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_TUNING_PARAMETERS* TuningParameters = nullptr
+    );
+
+/**
+ * @brief  Returns the blocking and threading parameters to search when tuning
+ *         a single precision GEMM. The first candidate is the built-in
+ *         heuristic, and the order of the candidates is stable so that the
+ *         index of the fastest one can be persisted.
+ *
+ * @param[out] CandidateCount  Receives the number of candidates.
+ * @return the array of candidates
+ */
+const MLAS_SGEMM_TUNING_PARAMETERS*
+MLASCALL
+MlasSgemmTuningCandidates(
+    size_t* CandidateCount
     );
 
 /**
@@ -816,6 +927,155 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(4x4, 3x3) convolution routines.
+//
+// The filter is transformed once by MlasConvWinogradPackFilter and the
+// convolution is then computed by MlasConvWinograd with the parameters
+// returned by MlasConvPrepare. The transformed filter is packed like the
+// matrix B of MlasGemmPackB and has the same alignment requirements.
+//
+
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t InputChannels,
+    size_t FilterCount
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    void* PackedFilter
+    );
+
+void
+MLASCALL
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Single precision NHWC convolution and pooling routines.
+//
+// The input is supplied as an indirection buffer: for each output pixel, the
+// addresses of the input pixels under each element of the kernel, each
+// address pointing to the channels of the pixel or to a vector of zeroes for
+// the padding. The routines are single threaded and are called for a range of
+// output pixels by the threads of the caller.
+//
+
+/**
+ * @brief Indirect convolution for fp32 NHWC
+ * @param Input             Supplies the indirection buffer, OutputCount x KernelSize
+ * @param InputOffset       Offset of the channels of the group in each input pixel
+ * @param InputChannels     # of input channels of the group
+ * @param KernelSize        # of elements of the kernel
+ * @param OutputCount       # of output pixels
+ * @param PackedFilter      Filter packed by MlasGemmPackB as a (KernelSize x InputChannels) x FilterCount matrix
+ * @param FilterCount       # of filters of the group
+ * @param Output            Supplies the address of the first output pixel
+ * @param ldc               # of elements between output pixels
+ * @param Beta              Supplies the multiplier of the existing output
+ * @param OutputProcessor   Optional processor of each tile of the output, such as MLAS_GEMM_EPILOGUE_PROCESSOR
+ */
+void
+MLASCALL
+MlasConvIndirect(
+    const float* const* Input,
+    size_t InputOffset,
+    size_t InputChannels,
+    size_t KernelSize,
+    size_t OutputCount,
+    const void* PackedFilter,
+    size_t FilterCount,
+    float* Output,
+    size_t ldc,
+    float Beta,
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor
+    );
+
+/**
+ * @brief Indirect depthwise convolution for fp32 NHWC
+ * @param Input         Supplies the indirection buffer, OutputCount x KernelSize
+ * @param Filter        Supplies the filter in the KernelSize x Channels layout
+ * @param Output        Supplies the address of the result tensor
+ * @param Channels      # of channels
+ * @param OutputCount   # of output pixels
+ * @param KernelSize    # of elements of the kernel
+ * @param Beta          Supplies the multiplier of the existing output
+ * @param PostProc      Optional processor of the output, such as MLAS_GEMM_EPILOGUE_PROCESSOR
+ */
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    float Beta,
+    const MLAS_GEMM_POSTPROCESSOR<float>* PostProc
+    );
+
+/**
+ * @brief Max pooling for fp32 NHWC. Null entries of the indirection buffer are skipped.
+ * @param Input         Supplies the indirection buffer, OutputCount x KernelSize
+ * @param Output        Supplies the address of the result tensor
+ * @param Channels      C in NHWC
+ * @param OutputCount   # of output pixels
+ * @param KernelSize    # of elements of the kernel
+ */
+void
+MLASCALL
+MlasNhwcMaxPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+/**
+ * @brief Average pooling for fp32 NHWC. Null entries of the indirection buffer
+ *        are skipped and not counted.
+ * @param Input         Supplies the indirection buffer, OutputCount x KernelSize
+ * @param Output        Supplies the address of the result tensor
+ * @param Channels      C in NHWC
+ * @param OutputCount   # of output pixels
+ * @param KernelSize    # of elements of the kernel
+ */
+void
+MLASCALL
+MlasNhwcAvgPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1021,6 +1281,77 @@ MlasComputeTanh(
     size_t N
     );
 
+/**
+ * @brief Computes the Gelu or SiLU activation in a single pass:
+ *        Output = Act(Input + Bias)
+ *
+ * @param ActivationKind    MlasGeluErfActivation, MlasGeluTanhActivation or MlasSiluActivation
+ * @param Input             the input buffer
+ * @param Bias              optional bias vector of N elements, nullptr if not present
+ * @param Output            the output buffer, may be the input buffer
+ * @param N                 the number of elements
+ * @param Alpha             for MlasSiluActivation, the scale of the input of the
+ *                          logistic function: x * logistic(Alpha * x). 1 is SiLU
+ *                          and 1.702 is QuickGelu. Ignored by the Gelu kinds.
+ */
+void
+MLASCALL
+MlasComputeGeluSilu(
+    MLAS_ACTIVATION_KIND ActivationKind,
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Alpha
+    );
+
+//
+// Attention routines.
+//
+
+/**
+ * @brief Parameters of the fused multi-head attention.
+ *
+ *        For each batch b and head n, computes
+ *        Softmax(Scale * Q x K' + Bias + Mask) x V without materializing the
+ *        S x T attention probabilities: the keys and values are processed in
+ *        tiles and the softmax is accumulated online.
+ */
+struct MLAS_FLASH_ATTENTION_PARAMS {
+    size_t BatchSize;                /**< batch size (B) */
+    size_t NumHeads;                 /**< number of heads (N) */
+    size_t SequenceLength;           /**< sequence length of the query (S) */
+    size_t KvSequenceLength;         /**< sequence length of the key and value (T) */
+    size_t QkHeadSize;               /**< head size of the query and key (H) */
+    size_t VHeadSize;                /**< head size of the value (H_v) */
+    float Scale;                     /**< scale applied to Q x K' */
+    const float* Query;              /**< query with shape BxNxSxH */
+    const float* Key;                /**< key with shape BxNxTxH */
+    const float* Value;              /**< value with shape BxNxTxH_v */
+    const float* Mask = nullptr;     /**< optional additive mask, row s of batch b at
+                                          Mask + b * MaskBatchStride + s * MaskRowStride */
+    size_t MaskBatchStride = 0;
+    size_t MaskRowStride = 0;        /**< 0 to broadcast a BxT mask to all the rows */
+    const float* Bias = nullptr;     /**< optional additive bias with shape BxNxSxT */
+    bool Causal = false;             /**< query s only attends to keys j <= s + CausalOffset */
+    size_t CausalOffset = 0;
+    float* Output;                   /**< output with shape BxSxNxH_v */
+};
+
+/**
+ * @brief Computes the fused multi-head attention.
+ *
+ * @param Params     Supplies the attention parameters.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -1404,7 +1735,8 @@ using MLAS_FP16 = onnxruntime::MLFloat16;
 constexpr size_t FP16_SIZE = sizeof(uint16_t);
 
 /**
- * @brief Whether current CPU supports FP16 acceleration.
+ * @brief Whether current CPU supports FP16 acceleration. On x64 this only
+ *        covers the half precision GEMM, see MLAS_F16GEMM_SUPPORTED.
 */
 bool MLASCALL
 MlasFp16AccelerationSupported();
@@ -1611,6 +1943,156 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
+//
+// Normalization routines
+//
+
+/**
+ * @brief Parameters of the layer and RMS normalization of the rows of a
+ *        matrix, with an optional skip connection added first:
+ *
+ *        X = Input + Skip + SkipBias
+ *        Output = (X - Mean(X)) * InvStdDev(X) * Scale + Bias  (layer norm)
+ *        Output = X * InvRms(X) * Scale                        (RMS norm)
+ *
+ *        T is float or MLAS_FP16, the statistics are computed in fp32.
+ */
+template<typename T>
+struct MLAS_NORM_PARAMS {
+    const T* Input = nullptr;       /**< input rows, Rows x D */
+    const T* Skip = nullptr;        /**< optional skip rows, repeated every SkipRows rows */
+    size_t SkipRows = 0;            /**< number of rows of Skip */
+    const T* SkipBias = nullptr;    /**< optional bias added with the skip, vector size D */
+    const T* Scale = nullptr;       /**< scale (gamma), vector size D */
+    const T* Bias = nullptr;        /**< optional bias (beta), vector size D, layer norm only */
+    T* Output = nullptr;            /**< output rows, Rows x D */
+    T* SkipOutput = nullptr;        /**< optional copy of X, Rows x D */
+    float* Mean = nullptr;          /**< optional mean of each row, layer norm only */
+    float* InvStdDev = nullptr;     /**< optional inverse standard deviation or RMS of each row */
+    size_t Rows = 0;
+    size_t D = 0;
+    float Epsilon = 0.0f;
+};
+
+/**
+ * @brief Layer normalization of the rows of a matrix.
+ *
+ * @param Params     Supplies the normalization parameters.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+template<typename T>
+void
+MLASCALL
+MlasLayerNorm(
+    const MLAS_NORM_PARAMS<T>* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief RMS normalization of the rows of a matrix, Params->Bias and
+ *        Params->Mean are ignored.
+ *
+ * @param Params     Supplies the normalization parameters.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+template<typename T>
+void
+MLASCALL
+MlasRmsNorm(
+    const MLAS_NORM_PARAMS<T>* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// BFloat16 routines
+//
+
+using MLAS_BF16 = onnxruntime::BFloat16;
+
+/**
+ * @brief Whether current CPU has native bfloat16 dot product instructions
+ *        (AVX512-BF16 or AMX-BF16). The bfloat16 GEMM routines work on all
+ *        platforms, but fall back to a portable kernel without them.
+*/
+bool MLASCALL
+MlasBf16AccelerationSupported();
+
+/**
+ * @brief Data parameters for bfloat16 GEMM routine
+ *        All except C are [in] parameters
+*/
+struct MLAS_BF16_GEMM_DATA_PARAMS {
+    const MLAS_BF16* A = nullptr;     /**< address of A */
+    const void* B = nullptr;          /**< address of B, or of the packed B when ldb is 0 */
+    const float* Bias = nullptr;      /**< address of Bias, vector size N */
+    void* C = nullptr;                /**< address of result matrix, fp32 or bfloat16 */
+    size_t lda = 0;                   /**< leading dimension of A */
+    size_t ldb = 0;                   /**< leading dimension of B, 0 when B is pre-packed*/
+    size_t ldc = 0;                   /**< leading dimension of C*/
+    bool CIsBf16 = false;             /**< result is rounded to bfloat16 instead of stored as fp32 */
+};
+
+/**
+ * @brief BFloat16 Batched GEMM:  C = A * B + Bias
+ *        The products are accumulated in fp32.
+ *
+ * Note:  We only support uniform batching, so shapes and types of the
+ *        input must be same across all parameter blocks.
+ *
+ * @param[in]  M       row size of matrix A and C
+ * @param[in]  N       column size of matrix B and C
+ * @param[in]  K       column size of matrix A and row size of matrix B
+ * @param[in]  BatchN  number of batches
+ * @param[inout]  DataParams  An array (size BatchN) of parameter blocks
+ * @param[in]  ThreadPool
+*/
+void
+MLASCALL
+MlasBf16GemmBatch(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_BF16_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool = nullptr
+    );
+
+/**
+ * @brief For bfloat16 GEMM, returns size of the
+ *        packing buffer needed for right hand side
+ * @param[in] N   Number of columns
+ * @param[in] K   Number of rows
+ * @return  size of the packing buffer
+*/
+size_t
+MLASCALL
+MlasBf16GemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief For bfloat16 GEMM, pack the right hand
+ *        side matrix B
+ *
+ * @param[in]  N        Number of columns
+ * @param[in]  K        Number of rows
+ * @param[in]  B        Address of matrix B
+ * @param[in]  ldb      leading dimension of input matrix B
+ * @param[out] PackedB  Address of the packed matrix
+*/
+void
+MLASCALL
+MlasBf16GemmPackB(
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    );
+
 /**
  * @brief Indirect Depthwise convolution for fp16
  * @param Input         Supplies the indirect buffer for NHWC input
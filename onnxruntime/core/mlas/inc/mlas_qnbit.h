@@ -0,0 +1,133 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    mlas_qnbit.h
+
+Abstract:
+
+    This module contains the public data structures and procedure prototypes
+    for the fp32 matrix multiplication with a blockwise n-bit quantized right
+    hand side (SQNBitGemm).
+
+    B is quantized along K in blocks of BlkLen values, each block with its
+    own scale and optional zero point, in the layout of the MatMulNBits
+    operator:
+
+        QuantBData       [N][BlockCountK][BlkLen * BlkBitWidth / 8]
+        QuantBScale      [N][BlockCountK]
+        QuantBZeroPoint  [N * BlockCountK] if BlkBitWidth > 4, otherwise
+                         [(N * BlockCountK + 1) / 2] with two zero points per
+                         byte, the first one in the low nibble
+
+    where BlockCountK = (K + BlkLen - 1) / BlkLen. The values of a block are
+    stored as bit planes, high bits first:
+
+        uint8 one_bits[(BlkBitWidth & 1) * BlkLen / 8];         // bit 2 of 3 bit values
+        uint8 two_bits[((BlkBitWidth >> 1) & 1) * BlkLen / 4];  // bits 0-1 of 2 and 3 bit values
+        uint8 four_bits[((BlkBitWidth >> 2) & 1) * BlkLen / 2]; // 4 bit values
+
+    with the first value of a plane in its least significant bits. 8 bit
+    values are stored one per byte. Without zero points, the zero point is
+    2^(BlkBitWidth - 1).
+
+--*/
+
+#pragma once
+
+#include "mlas.h"
+
+/**
+ * @brief Define the data type of the computation.
+ */
+typedef enum {
+    CompFp32 = 0,   /*!< A is used as fp32, B is dequantized to fp32 */
+    CompInt8 = 1,   /*!< A is quantized to int8 per block of B, the products are accumulated in int32 */
+} MLAS_SQNBIT_GEMM_COMPUTE_TYPE;
+
+/**
+ * @brief Data parameters for the n-bit quantized GEMM routine
+ *        C = A * B + Bias
+ *        A must be a float32 matrix
+ *        B must be a blockwise n-bit quantized matrix
+ *        All except C are [in] parameters
+ */
+struct MLAS_SQNBIT_GEMM_DATA_PARAMS {
+    const float* A = nullptr;               /**< address of A (float32 matrix)*/
+    size_t lda = 0;                         /**< leading dimension of A */
+    const void* QuantBData = nullptr;       /**< address of quantized B data */
+    const float* QuantBScale = nullptr;     /**< address of scales of quantized B */
+    const void* QuantBZeroPoint = nullptr;  /**< optional address of zero points of quantized B */
+    const float* Bias = nullptr;            /**< optional address of Bias, vector size N */
+    float* C = nullptr;                     /**< address of result matrix */
+    size_t ldc = 0;                         /**< leading dimension of C*/
+};
+
+/**
+ * @brief Determines whether the n-bit quantized GEMM is implemented for the
+ *        given parameters on the current hardware.
+ *
+ * @param[in]  BlkBitWidth  number of bits of a quantized value: 2, 3, 4 or 8
+ * @param[in]  BlkLen       number of values of a block: 16, 32, 64, 128 or 256
+ * @param[in]  ComputeType  data type of the computation
+ */
+bool MLASCALL
+MlasIsSQNBitGemmAvailable(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType
+    );
+
+/**
+ * @brief Returns the size of the workspace needed by MlasSQNBitGemmBatch, 0
+ *        if no workspace is needed.
+ */
+size_t MLASCALL
+MlasSQNBitGemmBatchWorkspaceSize(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType
+    );
+
+/**
+ * @brief Batched GEMM:  C = A * B + Bias
+ *        A must be a float32 matrix
+ *        B must be a blockwise n-bit quantized matrix
+ *
+ *        A single row of A (M == 1) is multiplied directly with the quantized
+ *        data, larger fp32 computations dequantize slices of B for the SGEMM
+ *        kernel.
+ *
+ * @param[in]  M            row size of matrix A and C
+ * @param[in]  N            column size of matrix B and C
+ * @param[in]  K            column size of matrix A and row size of matrix B
+ * @param[in]  BatchN       number of batches
+ * @param[in]  BlkBitWidth  number of bits of a quantized value
+ * @param[in]  BlkLen       number of values of a block
+ * @param[in]  ComputeType  data type of the computation
+ * @param[inout]  DataParams  An array (size BatchN) of parameter blocks
+ * @param[in]  Workspace    address of the workspace, of the size returned by
+ *                          MlasSQNBitGemmBatchWorkspaceSize
+ * @param[in]  ThreadPool
+ */
+void MLASCALL
+MlasSQNBitGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType,
+    const MLAS_SQNBIT_GEMM_DATA_PARAMS* DataParams,
+    void* Workspace,
+    MLAS_THREADPOOL* ThreadPool = nullptr
+    );
@@ -404,6 +404,68 @@ Return Value:
     }
 }
 
+void
+MlasGeluSiluActivation(
+    MLAS_ACTIVATION_KIND ActivationKind,
+    float* Buffer,
+    const float* Bias,
+    size_t M,
+    size_t N,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the Gelu or SiLU activation function to the output
+    matrix after optionally adding a bias vector per row. The activations
+    are computed in a single pass by the kernel of the platform.
+
+        GeluErf:  x * 0.5 * (1 + erf(x / sqrt(2)))
+        GeluTanh: x * 0.5 * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+        Silu:     x * logistic(x)
+
+Arguments:
+
+    ActivationKind - Supplies the kind of the activation.
+
+    Buffer - Supplies the output matrix.
+
+    Bias - Supplies the optional bias vector.
+
+    M - Supplies the number of elements of the bias vector and the number of
+        rows in the output matrix.
+
+    N - Supplies the number of columns of the output matrix.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Bias == nullptr && N == ldc) {
+        MlasComputeGeluSilu(ActivationKind, Buffer, nullptr, Buffer, M * N, 1.0f);
+        return;
+    }
+
+    while (M-- > 0) {
+
+        if (Bias != nullptr) {
+            const float RowBias = *Bias++;
+            for (size_t n = 0; n < N; n++) {
+                Buffer[n] += RowBias;
+            }
+        }
+
+        MlasComputeGeluSilu(ActivationKind, Buffer, nullptr, Buffer, N, 1.0f);
+
+        Buffer += ldc;
+    }
+}
+
 void
 MLASCALL
 MlasActivation(
@@ -510,6 +572,14 @@ Return Value:
             break;
         }
 
+        case MlasGeluErfActivation:
+        case MlasGeluTanhActivation:
+        case MlasSiluActivation:
+        {
+            MlasGeluSiluActivation(Activation->ActivationKind, Buffer, Bias, M, N, ldc);
+            break;
+        }
+
         case MlasActivationKindCount:
         {
             MLAS_THROW_EX(std::runtime_error, "bad mlas activation kind");
@@ -517,3 +587,128 @@ Return Value:
         }
     }
 }
+
+void
+MLAS_GEMM_EPILOGUE_PROCESSOR::Process(
+    float* C,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    ) const
+/*++
+
+Routine Description:
+
+    This routine applies the epilogue to a tile of the output matrix of a
+    GEMM: the bias per column is added, then the activation is applied and
+    the residual matrix is added, and finally the tile is optionally
+    quantized.
+
+Arguments:
+
+    C - Supplies the address of the output matrix.
+
+    StartM - Supplies the first row of the tile.
+
+    StartN - Supplies the first column of the tile.
+
+    CountM - Supplies the number of rows of the tile.
+
+    CountN - Supplies the number of columns of the tile.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* Tile = C + StartM * ldc + StartN;
+
+    const MLAS_ACTIVATION_KIND ActivationKind = Epilogue_.Activation.ActivationKind;
+
+    //
+    // The Gelu and SiLU kernels add the bias per column in the same pass as
+    // the activation.
+    //
+
+    if (ActivationKind == MlasGeluErfActivation || ActivationKind == MlasGeluTanhActivation ||
+        ActivationKind == MlasSiluActivation) {
+
+        const float* Bias = (Epilogue_.Bias != nullptr) ? Epilogue_.Bias + StartN : nullptr;
+
+        for (size_t m = 0; m < CountM; m++) {
+            float* c = Tile + m * ldc;
+            MlasComputeGeluSilu(ActivationKind, c, Bias, c, CountN, 1.0f);
+        }
+
+    } else {
+
+        //
+        // Add the bias per column. MlasActivation adds a bias per row, so the
+        // bias is added here.
+        //
+
+        if (Epilogue_.Bias != nullptr) {
+
+            const float* Bias = Epilogue_.Bias + StartN;
+
+            for (size_t m = 0; m < CountM; m++) {
+
+                float* c = Tile + m * ldc;
+                size_t n = 0;
+
+                for (; n + 4 <= CountN; n += 4) {
+                    MlasStoreFloat32x4(c + n, MlasAddFloat32x4(MlasLoadFloat32x4(c + n), MlasLoadFloat32x4(Bias + n)));
+                }
+
+                for (; n < CountN; n++) {
+                    c[n] += Bias[n];
+                }
+            }
+        }
+
+        if (ActivationKind != MlasIdentityActivation) {
+            MlasActivation(&Epilogue_.Activation, Tile, nullptr, CountM, CountN, ldc);
+        }
+    }
+
+    if (Epilogue_.Residual != nullptr) {
+
+        const float* Residual = Epilogue_.Residual + StartM * Epilogue_.ldr + StartN;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            float* c = Tile + m * ldc;
+            const float* r = Residual + m * Epilogue_.ldr;
+            size_t n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+                MlasStoreFloat32x4(c + n, MlasAddFloat32x4(MlasLoadFloat32x4(c + n), MlasLoadFloat32x4(r + n)));
+            }
+
+            for (; n < CountN; n++) {
+                c[n] += r[n];
+            }
+        }
+    }
+
+    if (Epilogue_.QuantOutput != nullptr) {
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            const size_t Offset = (StartM + m) * Epilogue_.ldq + StartN;
+
+            if (Epilogue_.QuantOutputIsSigned) {
+                MlasQuantizeLinear(Tile + m * ldc, static_cast<int8_t*>(Epilogue_.QuantOutput) + Offset,
+                                   CountN, Epilogue_.QuantScale, int8_t(Epilogue_.QuantZeroPoint));
+            } else {
+                MlasQuantizeLinear(Tile + m * ldc, static_cast<uint8_t*>(Epilogue_.QuantOutput) + Offset,
+                                   CountN, Epilogue_.QuantScale, uint8_t(Epilogue_.QuantZeroPoint));
+            }
+        }
+    }
+}
@@ -0,0 +1,328 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply operation.
+
+    The products are accumulated in fp32. The kernels are selected through
+    MLAS_PLATFORM::Bf16GemmDispatch: the default kernel converts the operands
+    to fp32 and runs on any platform, while the AVX512-BF16 and AMX-BF16
+    kernels consume the packed bfloat16 operands directly.
+
+--*/
+
+#include "bf16gemm.h"
+
+//
+// Define the number of rows of a thread partition and the number of columns
+// of B that are packed at a time when B is not pre-packed.
+//
+
+constexpr size_t MLAS_BF16_GEMM_STRIDE_M = 128;
+constexpr size_t MLAS_BF16_GEMM_STRIDE_N = 128;
+
+//
+// Define the number of rows that are computed at a time when the result is
+// rounded to bfloat16, bounding the size of the fp32 staging buffer.
+//
+
+constexpr size_t MLAS_BF16_GEMM_CONVERT_STRIDE_M = 16;
+
+bool
+MLASCALL
+MlasBf16AccelerationSupported()
+{
+    return GetMlasPlatform().Bf16GemmDispatch != &MlasBf16GemmDispatchDefault;
+}
+
+static
+void
+MlasBf16GemmCopyPackB(
+    uint16_t* D,
+    const uint16_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine packs columns of B into panels, see bf16gemm.h for the
+    layout. The padding rows and columns of the panels are zero filled.
+
+Arguments:
+
+    D - Supplies the address of the packed panels.
+
+    B - Supplies the address of the first column of B to pack.
+
+    ldb - Supplies the leading dimension of B.
+
+    CountN - Supplies the number of columns to pack.
+
+    CountK - Supplies the number of rows of B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t PackedCountK = MlasBf16GemmPackedCountK(CountK);
+
+    for (size_t n = 0; n < CountN; n += MLAS_BF16_GEMM_PACKED_N) {
+
+        const size_t cols = std::min(CountN - n, MLAS_BF16_GEMM_PACKED_N);
+
+        for (size_t k = 0; k < PackedCountK; k += 2) {
+
+            for (size_t c = 0; c < MLAS_BF16_GEMM_PACKED_N; c++) {
+
+                D[c * 2] = (c < cols && k < CountK) ? B[k * ldb + n + c] : 0;
+                D[c * 2 + 1] = (c < cols && k + 1 < CountK) ? B[(k + 1) * ldb + n + c] : 0;
+            }
+
+            D += MLAS_BF16_GEMM_PACKED_N * 2;
+        }
+    }
+}
+
+static
+void
+MlasBf16GemmKernelDefault(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* PackedB,
+    size_t CountK,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias
+    )
+{
+    const size_t PackedCountK = MlasBf16GemmPackedCountK(CountK);
+
+    for (size_t n = 0; n < CountN; n += MLAS_BF16_GEMM_PACKED_N) {
+
+        const size_t cols = std::min(CountN - n, MLAS_BF16_GEMM_PACKED_N);
+        const uint16_t* b = PackedB + (n / MLAS_BF16_GEMM_PACKED_N) * PackedCountK * MLAS_BF16_GEMM_PACKED_N;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            float Accumulators[MLAS_BF16_GEMM_PACKED_N];
+
+            for (size_t c = 0; c < cols; c++) {
+                Accumulators[c] = (Bias != nullptr) ? Bias[n + c] : 0.0f;
+            }
+
+            const uint16_t* a = A + m * lda;
+
+            for (size_t k = 0; k < CountK; k++) {
+
+                const float AValue = MlasBf16ToFloat(a[k]);
+                const uint16_t* bk = b + (k / 2) * MLAS_BF16_GEMM_PACKED_N * 2 + (k % 2);
+
+                for (size_t c = 0; c < cols; c++) {
+                    Accumulators[c] += AValue * MlasBf16ToFloat(bk[c * 2]);
+                }
+            }
+
+            std::copy_n(Accumulators, cols, C + m * ldc + n);
+        }
+    }
+}
+
+const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchDefault = {
+    MlasBf16GemmKernelDefault,
+};
+
+static
+void
+MlasBf16GemmOperation(
+    const MLAS_BF16_GEMM_KERNEL* Kernel,
+    const size_t K,
+    const MLAS_BF16_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    )
+{
+    const size_t PackedCountK = MlasBf16GemmPackedCountK(K);
+    const size_t PackedPanelSize = PackedCountK * MLAS_BF16_GEMM_PACKED_N;
+
+    const size_t StrideN = MLAS_BF16_GEMM_STRIDE_N;
+    const size_t PackedBSize = UpAlignSize(StrideN * PackedCountK * sizeof(uint16_t));
+    const size_t ConvertBufferSize = Data->CIsBf16 ?
+        UpAlignSize(MLAS_BF16_GEMM_CONVERT_STRIDE_M * StrideN * sizeof(float)) : 0;
+
+    uint16_t* PackedB = nullptr;
+    float* ConvertBuffer = nullptr;
+
+    if (Data->ldb != 0 || ConvertBufferSize != 0) {
+        MlasThreadedBufAlloc(PackedBSize + ConvertBufferSize);
+        PackedB = reinterpret_cast<uint16_t*>(ThreadedBufHolder.get());
+        ConvertBuffer = reinterpret_cast<float*>(ThreadedBufHolder.get() + PackedBSize);
+    }
+
+    const uint16_t* A = reinterpret_cast<const uint16_t*>(Data->A) + RangeStartM * Data->lda;
+    const uint16_t* B = reinterpret_cast<const uint16_t*>(Data->B);
+
+    for (size_t n = 0; n < RangeCountN; n += StrideN) {
+
+        const size_t CountN = std::min(RangeCountN - n, StrideN);
+        const size_t StartN = RangeStartN + n;
+
+        //
+        // Use the pre-packed panels of B or pack the columns on the fly. The
+        // partitions of N are aligned to the panel width.
+        //
+
+        const uint16_t* b;
+
+        if (Data->ldb == 0) {
+            b = B + (StartN / MLAS_BF16_GEMM_PACKED_N) * PackedPanelSize;
+        } else {
+            MlasBf16GemmCopyPackB(PackedB, B + StartN, Data->ldb, CountN, K);
+            b = PackedB;
+        }
+
+        const float* Bias = (Data->Bias != nullptr) ? Data->Bias + StartN : nullptr;
+
+        if (!Data->CIsBf16) {
+            float* C = reinterpret_cast<float*>(Data->C) + RangeStartM * Data->ldc + StartN;
+            Kernel(A, Data->lda, b, K, C, Data->ldc, RangeCountM, CountN, Bias);
+            continue;
+        }
+
+        uint16_t* C = reinterpret_cast<uint16_t*>(Data->C) + RangeStartM * Data->ldc + StartN;
+
+        for (size_t m = 0; m < RangeCountM; m += MLAS_BF16_GEMM_CONVERT_STRIDE_M) {
+
+            const size_t CountM = std::min(RangeCountM - m, MLAS_BF16_GEMM_CONVERT_STRIDE_M);
+
+            Kernel(A + m * Data->lda, Data->lda, b, K, ConvertBuffer, StrideN, CountM, CountN, Bias);
+
+            for (size_t i = 0; i < CountM; i++) {
+                for (size_t j = 0; j < CountN; j++) {
+                    C[(m + i) * Data->ldc + j] = MlasFloatToBf16(ConvertBuffer[i * StrideN + j]);
+                }
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasBf16GemmBatch(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_BF16_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const MLAS_BF16_GEMM_KERNEL* Kernel = GetMlasPlatform().Bf16GemmDispatch->Kernel;
+
+    if (ThreadPool == nullptr) {
+        for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
+            MlasBf16GemmOperation(Kernel, K, &DataParams[gemm_i], 0, M, 0, N);
+        }
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the GEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    ptrdiff_t ThreadsPerGemm = TargetThreadCount / BatchN;
+    if (ThreadsPerGemm < 1) {
+        ThreadsPerGemm = 1;
+    }
+
+    constexpr size_t StrideM = MLAS_BF16_GEMM_STRIDE_M;
+
+    //
+    // Split N into partitions aligned to the width of a packed panel.
+    //
+
+    size_t nc = N;
+    if (ThreadsPerGemm > 1) {
+        const size_t BlockedM = MlasDivRoundup(M, StrideM);
+        const size_t max_nc = MlasDivRoundup(N * BlockedM, ThreadsPerGemm);
+        if (max_nc < nc) {
+            nc = std::min(nc, MlasDivRoundup(max_nc, MLAS_BF16_GEMM_PACKED_N) *
+                                  MLAS_BF16_GEMM_PACKED_N);
+        }
+    }
+    const size_t StrideN = nc;
+
+    const size_t ThreadCountM = MlasDivRoundup(M, StrideM);
+    const size_t ThreadCountN = MlasDivRoundup(N, StrideN);
+    ThreadsPerGemm = ThreadCountM * ThreadCountN;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
+        const auto gemm_i = tid / ThreadsPerGemm;
+        const auto blk_i = tid % ThreadsPerGemm;
+
+        const ptrdiff_t ThreadIdN = blk_i / ThreadCountM;
+        const ptrdiff_t ThreadIdM = blk_i % ThreadCountM;
+
+        const size_t RangeStartM = ThreadIdM * StrideM;
+        const size_t RangeCountM = std::min(M - RangeStartM, StrideM);
+
+        const size_t RangeStartN = ThreadIdN * StrideN;
+        const size_t RangeCountN = std::min(N - RangeStartN, StrideN);
+
+        MlasBf16GemmOperation(Kernel, K, &DataParams[gemm_i], RangeStartM, RangeCountM,
+                              RangeStartN, RangeCountN);
+    });
+}
+
+size_t
+MLASCALL
+MlasBf16GemmPackBSize(
+    size_t N,
+    size_t K
+    )
+{
+    const size_t AlignedN = MlasDivRoundup(N, MLAS_BF16_GEMM_PACKED_N) * MLAS_BF16_GEMM_PACKED_N;
+
+    return AlignedN * MlasBf16GemmPackedCountK(K) * sizeof(uint16_t);
+}
+
+void
+MLASCALL
+MlasBf16GemmPackB(
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    )
+{
+    MlasBf16GemmCopyPackB(reinterpret_cast<uint16_t*>(PackedB),
+                          reinterpret_cast<const uint16_t*>(B), ldb, N, K);
+}
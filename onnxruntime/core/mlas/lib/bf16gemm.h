@@ -0,0 +1,112 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm.h
+
+Abstract:
+
+    This module defines the packed layout and the kernel interface of the
+    bfloat16 matrix/matrix multiply operation.
+
+    B is packed into panels of MLAS_BF16_GEMM_PACKED_N columns. Each panel
+    stores pairs of consecutive rows of B interleaved column by column:
+
+        Panel[k / 2][n][k % 2]
+
+    which is both the operand layout of the AVX512-BF16 VDPBF16PS instruction
+    and the B tile layout of the AMX-BF16 TDPBF16PS instruction. K is padded
+    with zeros to a multiple of MLAS_BF16_GEMM_PACKED_K, the depth of one AMX
+    tile, and N is padded with zeros to a multiple of the panel width.
+
+--*/
+
+#pragma once
+
+#include <cstring>
+
+#include "mlasi.h"
+
+constexpr size_t MLAS_BF16_GEMM_PACKED_N = 16;
+constexpr size_t MLAS_BF16_GEMM_PACKED_K = 32;
+
+/**
+ * @brief Returns the number of rows of a panel of packed B.
+ */
+MLAS_FORCEINLINE
+size_t
+MlasBf16GemmPackedCountK(
+    size_t K
+    )
+{
+    return (K + MLAS_BF16_GEMM_PACKED_K - 1) & ~(MLAS_BF16_GEMM_PACKED_K - 1);
+}
+
+MLAS_FORCEINLINE
+float
+MlasBf16ToFloat(
+    uint16_t Value
+    )
+{
+    uint32_t Bits = uint32_t(Value) << 16;
+    float Result;
+    std::memcpy(&Result, &Bits, sizeof(Result));
+    return Result;
+}
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToBf16(
+    float Value
+    )
+{
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+
+    //
+    // Keep NaNs quiet, otherwise round to nearest even.
+    //
+
+    if ((Bits & 0x7fffffff) > 0x7f800000) {
+        return uint16_t((Bits >> 16) | 0x40);
+    }
+    Bits += 0x7fff + ((Bits >> 16) & 1);
+    return uint16_t(Bits >> 16);
+}
+
+/**
+ * @brief Computes C = A * PackedB + Bias for a block of the output.
+ *
+ * @param A             Address of the first row of A
+ * @param lda           Leading dimension of A
+ * @param PackedB       Address of the first packed panel of B
+ * @param CountK        Number of columns of A and rows of B
+ * @param C             Address of the fp32 result
+ * @param ldc           Leading dimension of C
+ * @param CountM        Number of rows of A and C
+ * @param CountN        Number of columns of C
+ * @param Bias          Address of the bias for the first column, or nullptr
+ */
+typedef
+void
+(MLAS_BF16_GEMM_KERNEL)(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* PackedB,
+    size_t CountK,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias
+    );
+
+struct MLAS_BF16_GEMM_DISPATCH {
+    MLAS_BF16_GEMM_KERNEL* Kernel;
+};
+
+MLAS_BF16_GEMM_KERNEL MlasBf16GemmKernelAvx512Bf16;
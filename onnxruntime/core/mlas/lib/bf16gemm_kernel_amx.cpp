@@ -0,0 +1,224 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the bfloat16 GEMM kernel for AMX-BF16.
+
+    Blocks of 32x32 results are accumulated in four tiles from two tiles of A
+    and two panels of packed B, which are already in the B tile layout. Rows
+    of A that do not fill a tile are left to the AVX512-BF16 kernel.
+
+--*/
+
+#include "bf16gemm.h"
+#include "amx_common.h"
+
+#include <atomic>
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+#define TILE_M 16
+#define TILE_N 16
+#define TILE_K 32
+
+static_assert(TILE_N == MLAS_BF16_GEMM_PACKED_N && TILE_K == MLAS_BF16_GEMM_PACKED_K,
+              "Packed B must be in the tile layout");
+
+static
+void
+MlasBf16GemmAmxThreadInit()
+{
+    static thread_local struct tileconfig_t tc = {0};
+    struct tileconfig_t current_tc = {0};
+    tile_storeconfig(&current_tc);
+
+    //
+    // The tile configuration is per thread and may have been replaced by
+    // another AMX kernel on this thread, so it is reloaded if any tile differs.
+    //
+
+    if (tc.palette_id == 0 || std::memcmp(&current_tc.colb, &tc.colb, sizeof(uint16_t) * 8) != 0 ||
+        std::memcmp(&current_tc.rows, &tc.rows, sizeof(uint8_t) * 8) != 0) {
+        // Filling tile configure structure.
+        tc.palette_id = 1;
+        for (int t = 0; t < 8; t++) {
+            tc.rows[t] = TILE_M;
+            tc.colb[t] = TILE_K * sizeof(uint16_t);
+        }
+
+        tile_loadconfig(&tc);
+    }
+}
+
+//
+// The tile instructions are opaque to the compiler, so the staging buffers
+// they read or write need an explicit compiler barrier.
+//
+
+MLAS_FORCEINLINE
+void
+MlasBf16GemmAmxCompilerBarrier()
+{
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+static
+void
+MlasBf16GemmAmxStoreTile(
+    const float* Tile,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias
+    )
+{
+    const __mmask16 Mask = (CountN >= TILE_N) ? __mmask16(0xFFFF) : __mmask16((1u << CountN) - 1);
+    const __m512 BiasVector = (Bias != nullptr) ? _mm512_maskz_loadu_ps(Mask, Bias) : _mm512_setzero_ps();
+
+    for (size_t m = 0; m < CountM; m++) {
+        const __m512 Row = _mm512_add_ps(_mm512_load_ps(Tile + m * TILE_N), BiasVector);
+        _mm512_mask_storeu_ps(C + m * ldc, Mask, Row);
+    }
+}
+
+static
+void
+MlasBf16GemmKernelAmx(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* PackedB,
+    size_t CountK,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias
+    )
+{
+    const size_t TileCountM = CountM / TILE_M;
+
+    if (TileCountM > 0) {
+
+        MlasBf16GemmAmxThreadInit();
+
+        const size_t PackedCountK = MlasBf16GemmPackedCountK(CountK);
+        const size_t PanelSize = PackedCountK * TILE_N;
+        const size_t FullCountK = CountK & ~size_t(TILE_K - 1);
+        const int StrideA = static_cast<int>(lda * sizeof(uint16_t));
+
+        MLAS_DECLSPEC_ALIGN(uint16_t TileA[2][TILE_M * TILE_K], 64);
+        MLAS_DECLSPEC_ALIGN(float TileC[4][TILE_M * TILE_N], 64);
+
+        for (size_t m = 0; m < TileCountM * TILE_M; m += 2 * TILE_M) {
+
+            const bool TwoTilesM = m + 2 * TILE_M <= TileCountM * TILE_M;
+            const uint16_t* a0 = A + m * lda;
+            const uint16_t* a1 = a0 + TILE_M * lda;
+
+            for (size_t n = 0; n < CountN; n += 2 * TILE_N) {
+
+                const bool TwoTilesN = n + TILE_N < CountN;
+                const uint16_t* b0 = PackedB + (n / TILE_N) * PanelSize;
+                const uint16_t* b1 = b0 + PanelSize;
+
+                tile_zero(TMM0);
+                tile_zero(TMM1);
+                tile_zero(TMM2);
+                tile_zero(TMM3);
+
+                for (size_t k = 0; k < PackedCountK; k += TILE_K) {
+
+                    //
+                    // Load full tiles of A in place. The last columns of A are
+                    // copied to a zero padded tile, so that the padding of B
+                    // is never multiplied with elements past the end of A.
+                    //
+
+                    if (k < FullCountK) {
+                        tile_loadd(TMM4, a0 + k, StrideA);
+                        if (TwoTilesM) {
+                            tile_loadd(TMM5, a1 + k, StrideA);
+                        }
+                    } else {
+                        const size_t RemainingK = CountK - k;
+                        for (size_t t = 0; t < (TwoTilesM ? 2u : 1u); t++) {
+                            std::fill_n(TileA[t], TILE_M * TILE_K, uint16_t(0));
+                            for (size_t r = 0; r < TILE_M; r++) {
+                                std::copy_n((t == 0 ? a0 : a1) + r * lda + k, RemainingK, TileA[t] + r * TILE_K);
+                            }
+                        }
+                        MlasBf16GemmAmxCompilerBarrier();
+                        tile_loadd(TMM4, TileA[0], TILE_K * sizeof(uint16_t));
+                        if (TwoTilesM) {
+                            tile_loadd(TMM5, TileA[1], TILE_K * sizeof(uint16_t));
+                        }
+                    }
+
+                    tile_loadd(TMM6, b0 + k * TILE_N, TILE_N * 2 * sizeof(uint16_t));
+                    tile_dpbf16ps(TMM0, TMM4, TMM6);
+                    if (TwoTilesM) {
+                        tile_dpbf16ps(TMM2, TMM5, TMM6);
+                    }
+
+                    if (TwoTilesN) {
+                        tile_loadd(TMM7, b1 + k * TILE_N, TILE_N * 2 * sizeof(uint16_t));
+                        tile_dpbf16ps(TMM1, TMM4, TMM7);
+                        if (TwoTilesM) {
+                            tile_dpbf16ps(TMM3, TMM5, TMM7);
+                        }
+                    }
+                }
+
+                tile_stored(TMM0, TileC[0], TILE_N * sizeof(float));
+                tile_stored(TMM1, TileC[1], TILE_N * sizeof(float));
+                tile_stored(TMM2, TileC[2], TILE_N * sizeof(float));
+                tile_stored(TMM3, TileC[3], TILE_N * sizeof(float));
+                MlasBf16GemmAmxCompilerBarrier();
+
+                const size_t CountN0 = std::min(CountN - n, size_t(TILE_N));
+                const float* Bias0 = (Bias != nullptr) ? Bias + n : nullptr;
+                float* c = C + m * ldc + n;
+
+                MlasBf16GemmAmxStoreTile(TileC[0], c, ldc, TILE_M, CountN0, Bias0);
+                if (TwoTilesM) {
+                    MlasBf16GemmAmxStoreTile(TileC[2], c + TILE_M * ldc, ldc, TILE_M, CountN0, Bias0);
+                }
+
+                if (TwoTilesN) {
+                    const size_t CountN1 = std::min(CountN - n - TILE_N, size_t(TILE_N));
+                    const float* Bias1 = (Bias != nullptr) ? Bias + n + TILE_N : nullptr;
+                    MlasBf16GemmAmxStoreTile(TileC[1], c + TILE_N, ldc, TILE_M, CountN1, Bias1);
+                    if (TwoTilesM) {
+                        MlasBf16GemmAmxStoreTile(TileC[3], c + TILE_M * ldc + TILE_N, ldc, TILE_M, CountN1, Bias1);
+                    }
+                }
+            }
+        }
+    }
+
+    const size_t m = TileCountM * TILE_M;
+
+    if (m < CountM) {
+        MlasBf16GemmKernelAvx512Bf16(A + m * lda, lda, PackedB, CountK, C + m * ldc, ldc, CountM - m, CountN, Bias);
+    }
+}
+
+const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAmx = {
+    MlasBf16GemmKernelAmx,
+};
@@ -0,0 +1,158 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the bfloat16 GEMM kernel for AVX512-BF16.
+
+    Each VDPBF16PS multiplies a pair of consecutive elements of a row of A,
+    broadcast to all lanes, with the pairs of rows of 16 columns of a packed
+    panel of B and accumulates both products into fp32.
+
+--*/
+
+#include "bf16gemm.h"
+
+#include <immintrin.h>
+
+//
+// Define the number of rows of A that share the loads of B.
+//
+
+constexpr size_t MLAS_BF16_GEMM_AVX512_ROWS = 4;
+
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasBf16GemmKernelAvx512Bf16Rows(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* PackedB,
+    size_t PackedCountK,
+    size_t CountK,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    const float* Bias
+    )
+{
+    const size_t PanelSize = PackedCountK * MLAS_BF16_GEMM_PACKED_N;
+
+    //
+    // Process two panels of B at a time.
+    //
+
+    for (size_t n = 0; n < CountN; n += 2 * MLAS_BF16_GEMM_PACKED_N) {
+
+        const size_t Remaining = CountN - n;
+        const __mmask16 Mask0 = (Remaining >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << Remaining) - 1);
+        const __mmask16 Mask1 = (Remaining >= 32) ? __mmask16(0xFFFF) :
+                                (Remaining > 16) ? __mmask16((1u << (Remaining - 16)) - 1) : __mmask16(0);
+
+        const uint16_t* b0 = PackedB + (n / MLAS_BF16_GEMM_PACKED_N) * PanelSize;
+        const uint16_t* b1 = (Mask1 != 0) ? b0 + PanelSize : b0;
+
+        __m512 Bias0 = _mm512_setzero_ps();
+        __m512 Bias1 = _mm512_setzero_ps();
+        if (Bias != nullptr) {
+            Bias0 = _mm512_maskz_loadu_ps(Mask0, Bias + n);
+            Bias1 = _mm512_maskz_loadu_ps(Mask1, Bias + n + 16);
+        }
+
+        __m512 Acc0[RowCount];
+        __m512 Acc1[RowCount];
+        for (size_t r = 0; r < RowCount; r++) {
+            Acc0[r] = Bias0;
+            Acc1[r] = Bias1;
+        }
+
+        size_t k = 0;
+
+        for (; k + 2 <= CountK; k += 2) {
+
+            const __m512bh B0 = (__m512bh)_mm512_loadu_si512(b0 + k * MLAS_BF16_GEMM_PACKED_N);
+            const __m512bh B1 = (__m512bh)_mm512_loadu_si512(b1 + k * MLAS_BF16_GEMM_PACKED_N);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                int32_t Pair;
+                std::memcpy(&Pair, A + r * lda + k, sizeof(Pair));
+                const __m512bh APair = (__m512bh)_mm512_set1_epi32(Pair);
+                Acc0[r] = _mm512_dpbf16_ps(Acc0[r], APair, B0);
+                Acc1[r] = _mm512_dpbf16_ps(Acc1[r], APair, B1);
+            }
+        }
+
+        //
+        // Pair the last element of an odd row of A with zero, as the element
+        // past the end of the row may not be readable or may not be finite.
+        //
+
+        if (k < CountK) {
+
+            const __m512bh B0 = (__m512bh)_mm512_loadu_si512(b0 + k * MLAS_BF16_GEMM_PACKED_N);
+            const __m512bh B1 = (__m512bh)_mm512_loadu_si512(b1 + k * MLAS_BF16_GEMM_PACKED_N);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                const __m512bh APair = (__m512bh)_mm512_set1_epi32(A[r * lda + k]);
+                Acc0[r] = _mm512_dpbf16_ps(Acc0[r], APair, B0);
+                Acc1[r] = _mm512_dpbf16_ps(Acc1[r], APair, B1);
+            }
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            _mm512_mask_storeu_ps(C + r * ldc + n, Mask0, Acc0[r]);
+            _mm512_mask_storeu_ps(C + r * ldc + n + 16, Mask1, Acc1[r]);
+        }
+    }
+}
+
+void
+MlasBf16GemmKernelAvx512Bf16(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* PackedB,
+    size_t CountK,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias
+    )
+{
+    const size_t PackedCountK = MlasBf16GemmPackedCountK(CountK);
+
+    size_t m = 0;
+
+    for (; m + MLAS_BF16_GEMM_AVX512_ROWS <= CountM; m += MLAS_BF16_GEMM_AVX512_ROWS) {
+        MlasBf16GemmKernelAvx512Bf16Rows<MLAS_BF16_GEMM_AVX512_ROWS>(
+            A + m * lda, lda, PackedB, PackedCountK, CountK, C + m * ldc, ldc, CountN, Bias);
+    }
+
+    switch (CountM - m) {
+        case 3:
+            MlasBf16GemmKernelAvx512Bf16Rows<3>(
+                A + m * lda, lda, PackedB, PackedCountK, CountK, C + m * ldc, ldc, CountN, Bias);
+            break;
+        case 2:
+            MlasBf16GemmKernelAvx512Bf16Rows<2>(
+                A + m * lda, lda, PackedB, PackedCountK, CountK, C + m * ldc, ldc, CountN, Bias);
+            break;
+        case 1:
+            MlasBf16GemmKernelAvx512Bf16Rows<1>(
+                A + m * lda, lda, PackedB, PackedCountK, CountK, C + m * ldc, ldc, CountN, Bias);
+            break;
+        default:
+            break;
+    }
+}
+
+const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAvx512Bf16 = {
+    MlasBf16GemmKernelAvx512Bf16,
+};
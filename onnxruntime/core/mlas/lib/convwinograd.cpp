@@ -0,0 +1,617 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convwinograd.cpp
+
+Abstract:
+
+    This module implements the Winograd F(4x4, 3x3) convolution.
+
+    The output image is split in 4x4 tiles, each computed from a 6x6 tile of
+    the input image. The input tiles and the filters are transformed to the
+    Winograd domain, where the convolution becomes 36 independent GEMMs of
+    the filters by the input channels, and the products are transformed back
+    to the output tiles. This takes 36 multiplications per input channel for
+    16 output pixels instead of 144.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the size of the tiles of the output and input images and the number
+// of elements of a transformed tile.
+//
+
+constexpr size_t MlasWinogradOutputTile = 4;
+constexpr size_t MlasWinogradInputTile = 6;
+constexpr size_t MlasWinogradTransformCount = MlasWinogradInputTile * MlasWinogradInputTile;
+
+//
+// Define the range of the number of input channels and filters for the
+// Winograd convolution to be faster than the GEMM of the expanded input. Below
+// the minimum, the GEMMs are too small to amortize the transforms of the input
+// and output tiles. Above the maximum number of filter elements, the
+// transformed filter, four times the size of the filter, is streamed from
+// memory by GEMMs of few tiles.
+//
+
+constexpr size_t MlasWinogradMinimumChannels = 16;
+constexpr size_t MlasWinogradMaximumFilterElements = 256 * 256;
+
+//
+// Define the bounds of the number of tiles transformed as a block by a
+// thread, and the number of elements of the thread buffer used to size the
+// block.
+//
+
+constexpr size_t MlasWinogradMinimumTileBlock = 16;
+constexpr size_t MlasWinogradMaximumTileBlock = 64;
+constexpr size_t MlasWinogradTileBlockElements = 8192;
+
+static
+MLAS_FORCEINLINE
+void
+MlasWinogradInputTransform6(
+    const float* d,
+    size_t ldd,
+    float* t,
+    size_t ldt
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a vector of six elements by the input transform
+    matrix B^T.
+
+Arguments:
+
+    d - Supplies the vector.
+
+    ldd - Supplies the stride of the elements of the vector.
+
+    t - Receives the transformed vector.
+
+    ldt - Supplies the stride of the elements of the transformed vector.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float d0 = d[0 * ldd];
+    const float d1 = d[1 * ldd];
+    const float d2 = d[2 * ldd];
+    const float d3 = d[3 * ldd];
+    const float d4 = d[4 * ldd];
+    const float d5 = d[5 * ldd];
+
+    t[0 * ldt] = 4.0f * d0 - 5.0f * d2 + d4;
+    t[1 * ldt] = -4.0f * (d1 + d2) + d3 + d4;
+    t[2 * ldt] = 4.0f * (d1 - d2) - d3 + d4;
+    t[3 * ldt] = 2.0f * (d3 - d1) - d2 + d4;
+    t[4 * ldt] = 2.0f * (d1 - d3) - d2 + d4;
+    t[5 * ldt] = 4.0f * d1 - 5.0f * d3 + d5;
+}
+
+static
+MLAS_FORCEINLINE
+void
+MlasWinogradFilterTransform3(
+    const float* g,
+    size_t ldg,
+    float* t,
+    size_t ldt
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a vector of three elements by the filter transform
+    matrix G.
+
+Arguments:
+
+    g - Supplies the vector.
+
+    ldg - Supplies the stride of the elements of the vector.
+
+    t - Receives the transformed vector.
+
+    ldt - Supplies the stride of the elements of the transformed vector.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float g0 = g[0 * ldg];
+    const float g1 = g[1 * ldg];
+    const float g2 = g[2 * ldg];
+
+    t[0 * ldt] = g0 / 4.0f;
+    t[1 * ldt] = -(g0 + g1 + g2) / 6.0f;
+    t[2 * ldt] = -(g0 - g1 + g2) / 6.0f;
+    t[3 * ldt] = g0 / 24.0f + g1 / 12.0f + g2 / 6.0f;
+    t[4 * ldt] = g0 / 24.0f - g1 / 12.0f + g2 / 6.0f;
+    t[5 * ldt] = g2;
+}
+
+static
+MLAS_FORCEINLINE
+void
+MlasWinogradOutputTransform6(
+    const float* m,
+    size_t ldm,
+    float* t,
+    size_t ldt
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a vector of six elements by the output transform
+    matrix A^T.
+
+Arguments:
+
+    m - Supplies the vector.
+
+    ldm - Supplies the stride of the elements of the vector.
+
+    t - Receives the transformed vector.
+
+    ldt - Supplies the stride of the elements of the transformed vector.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float m0 = m[0 * ldm];
+    const float m1 = m[1 * ldm];
+    const float m2 = m[2 * ldm];
+    const float m3 = m[3 * ldm];
+    const float m4 = m[4 * ldm];
+    const float m5 = m[5 * ldm];
+
+    const float s12 = m1 + m2;
+    const float d12 = m1 - m2;
+    const float s34 = m3 + m4;
+    const float d34 = m3 - m4;
+
+    t[0 * ldt] = m0 + s12 + s34;
+    t[1 * ldt] = d12 + 2.0f * d34;
+    t[2 * ldt] = s12 + 4.0f * s34;
+    t[3 * ldt] = d12 + 8.0f * d34 + m5;
+}
+
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether a convolution should use the Winograd
+    algorithm.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    KernelShape - Supplies the shape of the kernel.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    StrideShape - Supplies the shape of the stride.
+
+Return Value:
+
+    Returns true if the Winograd algorithm supports the convolution and is
+    expected to be faster than the other algorithms.
+
+--*/
+{
+    if (Dimensions != 2 || GroupCount != 1) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        if (KernelShape[dim] != 3 || DilationShape[dim] != 1 || StrideShape[dim] != 1) {
+            return false;
+        }
+    }
+
+    return InputChannels >= MlasWinogradMinimumChannels && FilterCount >= MlasWinogradMinimumChannels &&
+           InputChannels * FilterCount <= MlasWinogradMaximumFilterElements;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t InputChannels,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the length in bytes of the transformed filter.
+
+Arguments:
+
+    InputChannels - Supplies the number of input channels.
+
+    FilterCount - Supplies the number of filters.
+
+Return Value:
+
+    Returns the length in bytes of the transformed filter.
+
+--*/
+{
+    return MlasWinogradTransformCount * MlasGemmPackBSize(FilterCount, InputChannels);
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters to the Winograd domain. Each of
+    the 36 elements of the transformed filters forms an InputChannels by
+    FilterCount matrix, which is packed as the matrix B of a GEMM.
+
+Arguments:
+
+    InputChannels - Supplies the number of input channels.
+
+    FilterCount - Supplies the number of filters.
+
+    Filter - Supplies the filter tensor in the FilterCount x InputChannels x
+        3 x 3 layout.
+
+    PackedFilter - Receives the transformed filter, sized to the number of
+        bytes returned by MlasConvWinogradPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    //
+    // The transformed filters are only needed until they are packed, so they
+    // are not kept in the thread local buffer for the lifetime of the thread.
+    //
+
+    std::unique_ptr<float[]> TransformedFilter(new float[MlasWinogradTransformCount * MatrixSize]);
+    float* U = TransformedFilter.get();
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* g = Filter + (f * InputChannels + c) * 9;
+            float Gg[MlasWinogradInputTile * 3];
+            float u[MlasWinogradTransformCount];
+
+            //
+            // u = G x g x G^T
+            //
+
+            for (size_t j = 0; j < 3; j++) {
+                MlasWinogradFilterTransform3(g + j, 3, Gg + j, 3);
+            }
+
+            for (size_t i = 0; i < MlasWinogradInputTile; i++) {
+                MlasWinogradFilterTransform3(Gg + i * 3, 1, u + i * MlasWinogradInputTile, 1);
+            }
+
+            for (size_t xi = 0; xi < MlasWinogradTransformCount; xi++) {
+                U[xi * MatrixSize + f * InputChannels + c] = u[xi];
+            }
+        }
+    }
+
+    //
+    // The matrices are stored as FilterCount x InputChannels, so are packed
+    // transposed.
+    //
+
+    const size_t PackedSize = MlasGemmPackBSize(FilterCount, InputChannels);
+
+    for (size_t xi = 0; xi < MlasWinogradTransformCount; xi++) {
+        MlasGemmPackB(CblasTrans, FilterCount, InputChannels, U + xi * MatrixSize, InputChannels,
+                      static_cast<uint8_t*>(PackedFilter) + xi * PackedSize);
+    }
+}
+
+static
+void
+MlasConvWinogradThreaded(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    float* Output,
+    size_t StartTile,
+    size_t CountTiles,
+    size_t TileBlock
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the output tiles of a block of tiles of an image.
+
+Arguments:
+
+    Parameters - Supplies the convolution parameters.
+
+    Input - Supplies the input image.
+
+    PackedFilter - Supplies the transformed filter.
+
+    Output - Supplies the output image.
+
+    StartTile - Supplies the index of the first tile of the block.
+
+    CountTiles - Supplies the number of tiles of the block.
+
+    TileBlock - Supplies the maximum number of tiles of a block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t TileCountWidth = MlasDivRoundup(OutputWidth, MlasWinogradOutputTile);
+    const float Beta = Parameters->Beta;
+
+    //
+    // Carve the thread local buffer into the transformed input tiles and the
+    // products of the transformed filter and input tiles. The elements of a
+    // transformed tile are stored consecutively for each channel, so that each
+    // element forms a matrix of CountTiles rows with a stride of 36 channels.
+    //
+
+    MlasThreadedBufAlloc(MlasWinogradTransformCount * (InputChannels + FilterCount) * TileBlock * sizeof(float));
+    float* V = reinterpret_cast<float*>(ThreadedBufHolder.get());
+    float* M = V + MlasWinogradTransformCount * InputChannels * TileBlock;
+
+    const size_t ldv = MlasWinogradTransformCount * InputChannels;
+    const size_t ldm = MlasWinogradTransformCount * FilterCount;
+
+    //
+    // Transform the input tiles: V = B^T x d x B.
+    //
+
+    for (size_t t = 0; t < CountTiles; t++) {
+
+        const size_t Tile = StartTile + t;
+        const ptrdiff_t ih0 = ptrdiff_t((Tile / TileCountWidth) * MlasWinogradOutputTile) - ptrdiff_t(Parameters->Padding[0]);
+        const ptrdiff_t iw0 = ptrdiff_t((Tile % TileCountWidth) * MlasWinogradOutputTile) - ptrdiff_t(Parameters->Padding[1]);
+
+        const bool Interior = ih0 >= 0 && iw0 >= 0 &&
+                              size_t(ih0) + MlasWinogradInputTile <= InputHeight &&
+                              size_t(iw0) + MlasWinogradInputTile <= InputWidth;
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* input = Input + c * InputSize;
+            float d[MlasWinogradTransformCount];
+            float Bd[MlasWinogradTransformCount];
+
+            //
+            // Gather the input tile, padding the elements outside of the
+            // image with zeroes.
+            //
+
+            if (Interior) {
+                for (size_t i = 0; i < MlasWinogradInputTile; i++) {
+                    const float* row = input + (size_t(ih0) + i) * InputWidth + size_t(iw0);
+                    std::copy_n(row, MlasWinogradInputTile, d + i * MlasWinogradInputTile);
+                }
+            } else {
+                for (size_t i = 0; i < MlasWinogradInputTile; i++) {
+                    const ptrdiff_t ih = ih0 + ptrdiff_t(i);
+                    for (size_t j = 0; j < MlasWinogradInputTile; j++) {
+                        const ptrdiff_t iw = iw0 + ptrdiff_t(j);
+                        const bool Valid = ih >= 0 && iw >= 0 && size_t(ih) < InputHeight && size_t(iw) < InputWidth;
+                        d[i * MlasWinogradInputTile + j] = Valid ? input[size_t(ih) * InputWidth + size_t(iw)] : 0.0f;
+                    }
+                }
+            }
+
+            for (size_t j = 0; j < MlasWinogradInputTile; j++) {
+                MlasWinogradInputTransform6(d + j, MlasWinogradInputTile, Bd + j, MlasWinogradInputTile);
+            }
+
+            float* v = V + t * ldv + c;
+
+            for (size_t i = 0; i < MlasWinogradInputTile; i++) {
+                MlasWinogradInputTransform6(Bd + i * MlasWinogradInputTile, 1,
+                                            v + i * MlasWinogradInputTile * InputChannels, InputChannels);
+            }
+        }
+    }
+
+    //
+    // Multiply the transformed input tiles and filter for each element of the
+    // transformed tiles.
+    //
+
+    const size_t AlignedN = (FilterCount + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+    const size_t PackedSize = MlasGemmPackBSize(FilterCount, InputChannels);
+
+    for (size_t xi = 0; xi < MlasWinogradTransformCount; xi++) {
+        MlasSgemmPackedOperation(CblasNoTrans, CountTiles, 0, FilterCount, InputChannels, 1.0f,
+                                 V + xi * InputChannels, ldv,
+                                 static_cast<const uint8_t*>(PackedFilter) + xi * PackedSize, AlignedN, 0.0f,
+                                 M + xi * FilterCount, ldm);
+    }
+
+    //
+    // Transform the products to the output tiles: Y = A^T x M x A.
+    //
+
+    for (size_t t = 0; t < CountTiles; t++) {
+
+        const size_t Tile = StartTile + t;
+        const size_t oh0 = (Tile / TileCountWidth) * MlasWinogradOutputTile;
+        const size_t ow0 = (Tile % TileCountWidth) * MlasWinogradOutputTile;
+        const size_t CountH = std::min(OutputHeight - oh0, MlasWinogradOutputTile);
+        const size_t CountW = std::min(OutputWidth - ow0, MlasWinogradOutputTile);
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            const float* m = M + t * ldm + f;
+
+            float Am[MlasWinogradOutputTile * MlasWinogradInputTile];
+            float Y[MlasWinogradOutputTile * MlasWinogradOutputTile];
+
+            for (size_t j = 0; j < MlasWinogradInputTile; j++) {
+                MlasWinogradOutputTransform6(m + j * FilterCount, MlasWinogradInputTile * FilterCount,
+                                             Am + j, MlasWinogradInputTile);
+            }
+
+            for (size_t i = 0; i < MlasWinogradOutputTile; i++) {
+                MlasWinogradOutputTransform6(Am + i * MlasWinogradInputTile, 1, Y + i * MlasWinogradOutputTile, 1);
+            }
+
+            float* output = Output + f * OutputSize + oh0 * OutputWidth + ow0;
+
+            for (size_t i = 0; i < CountH; i++) {
+
+                float* y = output + i * OutputWidth;
+
+                for (size_t j = 0; j < CountW; j++) {
+                    y[j] = (Beta == 0.0f) ? Y[i * MlasWinogradOutputTile + j]
+                                          : Y[i * MlasWinogradOutputTile + j] + Beta * y[j];
+                }
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters returned by MlasConvPrepare. The convolution must be
+        supported by MlasConvWinogradIsSupported.
+
+    Input - Supplies the input tensor.
+
+    PackedFilter - Supplies the filter transformed by
+        MlasConvWinogradPackFilter.
+
+    Bias - Optionally supplies the bias vector.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BatchCount = Parameters->BatchCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputGroupSize = InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+
+    const size_t TileCount = MlasDivRoundup(Parameters->OutputShape[0], MlasWinogradOutputTile) *
+                             MlasDivRoundup(Parameters->OutputShape[1], MlasWinogradOutputTile);
+
+    //
+    // Size the block of tiles so that the transformed tiles of a thread stay
+    // in the cache, but keep the GEMMs wide enough for the kernels.
+    //
+
+    size_t TileBlock = MlasWinogradTileBlockElements / (InputChannels + FilterCount);
+    TileBlock = std::max(TileBlock, MlasWinogradMinimumTileBlock);
+    TileBlock = std::min(TileBlock, MlasWinogradMaximumTileBlock);
+    TileBlock = std::min(TileBlock, TileCount);
+
+    const size_t TileBlockCount = MlasDivRoundup(TileCount, TileBlock);
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(BatchCount * TileBlockCount), [&](ptrdiff_t tid) {
+        const size_t batch = size_t(tid) / TileBlockCount;
+        const size_t StartTile = (size_t(tid) % TileBlockCount) * TileBlock;
+        const size_t CountTiles = std::min(TileCount - StartTile, TileBlock);
+
+        MlasConvWinogradThreaded(Parameters, Input + batch * InputGroupSize, PackedFilter,
+                                 Output + batch * OutputGroupSize, StartTile, CountTiles, TileBlock);
+    });
+
+    //
+    // Apply the activation with optional bias.
+    //
+
+    for (size_t batch = 0; batch < BatchCount; batch++) {
+        MlasActivation(Parameters->Activation, Output + batch * OutputGroupSize, Bias, FilterCount,
+                       Parameters->OutputSize, Parameters->OutputSize);
+    }
+}
@@ -0,0 +1,268 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    flashattn.cpp
+
+Abstract:
+
+    This module implements the fused multi-head attention.
+
+    The query rows of each head are split in blocks. For each block of rows,
+    the keys and values are processed in tiles: the attention scores of a tile
+    are computed to a thread local buffer, then the running maximum and sum of
+    each row are updated and the partial output is rescaled accordingly
+    (online softmax), so that the S x T attention probabilities are never
+    materialized.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of query rows and number of keys processed per tile.
+//
+
+constexpr size_t MlasFlashAttentionRowBlock = 64;
+constexpr size_t MlasFlashAttentionKvBlock = 128;
+
+static
+size_t
+MlasFlashAttentionKvLimit(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    size_t Row
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of keys attended by a query row.
+
+Arguments:
+
+    Params - Supplies the attention parameters.
+
+    Row - Supplies the index of the query row.
+
+Return Value:
+
+    The number of keys attended by the row.
+
+--*/
+{
+    if (!Params->Causal) {
+        return Params->KvSequenceLength;
+    }
+
+    return std::min(Params->KvSequenceLength, Row + Params->CausalOffset + 1);
+}
+
+static
+void
+MlasFlashAttentionThreaded(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    size_t BatchHead,
+    size_t StartRow,
+    size_t CountRows
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the attention output of a block of query rows of a
+    head.
+
+Arguments:
+
+    Params - Supplies the attention parameters.
+
+    BatchHead - Supplies the index of the batch times the number of heads plus
+        the index of the head.
+
+    StartRow - Supplies the first query row of the block.
+
+    CountRows - Supplies the number of query rows of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t S = Params->SequenceLength;
+    const size_t T = Params->KvSequenceLength;
+    const size_t H = Params->QkHeadSize;
+    const size_t Hv = Params->VHeadSize;
+    const size_t BatchIndex = BatchHead / Params->NumHeads;
+    const size_t HeadIndex = BatchHead % Params->NumHeads;
+
+    const float* Q = Params->Query + (BatchHead * S + StartRow) * H;
+    const float* K = Params->Key + BatchHead * T * H;
+    const float* V = Params->Value + BatchHead * T * Hv;
+
+    //
+    // Carve the thread local buffer into the scores of a tile, the partial
+    // output and the running maximum and sum of each row.
+    //
+
+    MlasThreadedBufAlloc((MlasFlashAttentionRowBlock * (MlasFlashAttentionKvBlock + Hv + 2)) * sizeof(float));
+    float* Scores = reinterpret_cast<float*>(ThreadedBufHolder.get());
+    float* Accumulator = Scores + MlasFlashAttentionRowBlock * MlasFlashAttentionKvBlock;
+    float* RowMaximum = Accumulator + MlasFlashAttentionRowBlock * Hv;
+    float* RowSum = RowMaximum + MlasFlashAttentionRowBlock;
+
+    std::fill_n(Accumulator, CountRows * Hv, 0.0f);
+    std::fill_n(RowMaximum, CountRows, std::numeric_limits<float>::lowest());
+    std::fill_n(RowSum, CountRows, 0.0f);
+
+    //
+    // Keys past the limit of the last row are masked for all the rows.
+    //
+
+    const size_t KvLimit = MlasFlashAttentionKvLimit(Params, StartRow + CountRows - 1);
+
+    size_t CountKv;
+    for (size_t kv = 0; kv < KvLimit; kv += CountKv) {
+        CountKv = std::min(KvLimit - kv, MlasFlashAttentionKvBlock);
+
+        //
+        // Scores = Scale * Q x K' for the tile.
+        //
+
+        MlasSgemmOperation(CblasNoTrans, CblasTrans, CountRows, CountKv, H, Params->Scale,
+                           Q, H, K + kv * H, H, 0.0f, Scores, CountKv);
+
+        for (size_t i = 0; i < CountRows; i++) {
+
+            const size_t Row = StartRow + i;
+            float* s = Scores + i * CountKv;
+
+            if (Params->Bias != nullptr) {
+                const float* Bias = Params->Bias + (BatchHead * S + Row) * T + kv;
+                for (size_t j = 0; j < CountKv; j++) {
+                    s[j] += Bias[j];
+                }
+            }
+
+            if (Params->Mask != nullptr) {
+                const float* Mask = Params->Mask + BatchIndex * Params->MaskBatchStride +
+                                    Row * Params->MaskRowStride + kv;
+                for (size_t j = 0; j < CountKv; j++) {
+                    s[j] += Mask[j];
+                }
+            }
+
+            //
+            // The columns past the causal limit of the row take no part in
+            // the softmax and have a zero probability.
+            //
+
+            const size_t RowLimit = MlasFlashAttentionKvLimit(Params, Row);
+            const size_t RowCountKv = (RowLimit > kv) ? std::min(RowLimit - kv, CountKv) : 0;
+
+            std::fill(s + RowCountKv, s + CountKv, 0.0f);
+
+            if (RowCountKv == 0) {
+                continue;
+            }
+
+#if defined(MLAS_TARGET_AMD64)
+            const float Maximum = std::max(RowMaximum[i], GetMlasPlatform().ReduceMaximumF32Kernel(s, RowCountKv));
+#else
+            const float Maximum = std::max(RowMaximum[i], MlasReduceMaximumF32Kernel(s, RowCountKv));
+#endif
+            float NegativeMaximum = -Maximum;
+
+            //
+            // Replace the scores with exp(s - Maximum) and rescale the partial
+            // results computed with the previous maximum.
+            //
+
+#if defined(MLAS_TARGET_AMD64)
+            const float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(s, s, RowCountKv, &NegativeMaximum);
+#else
+            const float Accumulation = MlasComputeSumExpF32Kernel(s, s, RowCountKv, &NegativeMaximum);
+#endif
+
+            if (Maximum != RowMaximum[i]) {
+                const float Correction = std::exp(RowMaximum[i] - Maximum);
+                float* o = Accumulator + i * Hv;
+                for (size_t h = 0; h < Hv; h++) {
+                    o[h] *= Correction;
+                }
+                RowSum[i] *= Correction;
+                RowMaximum[i] = Maximum;
+            }
+
+            RowSum[i] += Accumulation;
+        }
+
+        //
+        // Accumulator += P x V for the tile.
+        //
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, CountRows, Hv, CountKv, 1.0f,
+                           Scores, CountKv, V + kv * Hv, Hv, 1.0f, Accumulator, Hv);
+    }
+
+    //
+    // Normalize the rows and write them in the BxSxNxH_v layout.
+    //
+
+    const size_t ldo = Params->NumHeads * Hv;
+    float* Output = Params->Output + (BatchIndex * S + StartRow) * ldo + HeadIndex * Hv;
+
+    for (size_t i = 0; i < CountRows; i++) {
+        const float Scale = (RowSum[i] > 0.0f) ? 1.0f / RowSum[i] : 0.0f;
+        const float* o = Accumulator + i * Hv;
+        float* y = Output + i * ldo;
+        for (size_t h = 0; h < Hv; h++) {
+            y[h] = o[h] * Scale;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the fused multi-head attention.
+
+Arguments:
+
+    Params - Supplies the attention parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BatchHeadCount = Params->BatchSize * Params->NumHeads;
+    const size_t RowBlockCount = MlasDivRoundup(Params->SequenceLength, MlasFlashAttentionRowBlock);
+
+    if (BatchHeadCount == 0 || RowBlockCount == 0) {
+        return;
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(BatchHeadCount * RowBlockCount), [&](ptrdiff_t tid) {
+        const size_t BatchHead = size_t(tid) / RowBlockCount;
+        const size_t StartRow = (size_t(tid) % RowBlockCount) * MlasFlashAttentionRowBlock;
+        const size_t CountRows = std::min(Params->SequenceLength - StartRow, MlasFlashAttentionRowBlock);
+
+        MlasFlashAttentionThreaded(Params, BatchHead, StartRow, CountRows);
+    });
+}
@@ -0,0 +1,132 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    gelu.cpp
+
+Abstract:
+
+    This module implements routines to compute the Gelu and SiLU activations
+    in a single pass, with an optional bias vector added to the input.
+
+--*/
+
+#include "gelu.h"
+
+//
+// Vector operations of the portable kernel.
+//
+
+struct MLAS_GELU_VECTOR_FLOAT32X4 {
+
+    using Type = MLAS_FLOAT32X4;
+
+    static constexpr size_t Width = 4;
+
+    static MLAS_FORCEINLINE Type Zero() { return MlasZeroFloat32x4(); }
+
+    static MLAS_FORCEINLINE Type Broadcast(float Value) { return MlasBroadcastFloat32x4(Value); }
+
+    static MLAS_FORCEINLINE Type Load(const float* Buffer) { return MlasLoadFloat32x4(Buffer); }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, Type Vector) { MlasStoreFloat32x4(Buffer, Vector); }
+
+    static MLAS_FORCEINLINE Type Add(Type Vector1, Type Vector2) { return MlasAddFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Sub(Type Vector1, Type Vector2) { return MlasSubtractFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Mul(Type Vector1, Type Vector2) { return MlasMultiplyFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Div(Type Vector1, Type Vector2) { return MlasDivideFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Min(Type Vector1, Type Vector2) { return MlasMinimumFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Max(Type Vector1, Type Vector2) { return MlasMaximumFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type MultiplyAdd(Type Vector1, Type Vector2, Type Vector3)
+    {
+        return MlasMultiplyAddFloat32x4(Vector1, Vector2, Vector3);
+    }
+
+    static MLAS_FORCEINLINE Type Abs(Type Vector)
+    {
+        return MlasAndNotFloat32x4(MlasBroadcastFloat32x4(-0.0f), Vector);
+    }
+
+    static MLAS_FORCEINLINE Type CopySign(Type Magnitude, Type Sign)
+    {
+        return MlasOrFloat32x4(Magnitude, MlasAndFloat32x4(Sign, MlasBroadcastFloat32x4(-0.0f)));
+    }
+
+    static MLAS_FORCEINLINE Type SelectGreaterThan(Type Vector1, Type Vector2, Type TrueValue, Type FalseValue)
+    {
+        Type Mask = MlasGreaterThanFloat32x4(Vector1, Vector2);
+        return MlasOrFloat32x4(MlasAndFloat32x4(Mask, TrueValue), MlasAndNotFloat32x4(Mask, FalseValue));
+    }
+
+    static MLAS_FORCEINLINE Type PowerOf2(Type Vector) { return MlasPowerOf2Float32x4(Vector); }
+};
+
+void
+MLASCALL
+MlasGeluSiluF32Kernel(
+    MLAS_ACTIVATION_KIND ActivationKind,
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+{
+    MlasGeluSiluKernelDispatch<MLAS_GELU_VECTOR_FLOAT32X4>(ActivationKind, Input, Bias, Output, N, Alpha);
+}
+
+void
+MLASCALL
+MlasComputeGeluSilu(
+    MLAS_ACTIVATION_KIND ActivationKind,
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the Gelu or SiLU activation of a buffer after
+    optionally adding a bias vector.
+
+Arguments:
+
+    ActivationKind - Supplies MlasGeluErfActivation, MlasGeluTanhActivation
+        or MlasSiluActivation.
+
+    Input - Supplies the input buffer.
+
+    Bias - Optionally supplies the bias vector of N elements.
+
+    Output - Supplies the output buffer. This may be the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    Alpha - Supplies the scale of the input of the logistic function for the
+        SiLU activation: 1 for SiLU, 1.702 for QuickGelu. Ignored otherwise.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().GeluSiluF32Kernel(ActivationKind, Input, Bias, Output, N, Alpha);
+#else
+    MlasGeluSiluF32Kernel(ActivationKind, Input, Bias, Output, N, Alpha);
+#endif
+}
@@ -0,0 +1,328 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    gelu.h
+
+Abstract:
+
+    This module implements the single pass kernel of the Gelu and SiLU
+    activations, which is specialized with the vector type of each instruction
+    set.
+
+    The erf and logistic approximations are inlined with the multiply by the
+    input, so a row is read and written once:
+
+        GeluErf:  x * 0.5 * (1 + erf(x / sqrt(2)))
+        GeluTanh: x * 0.5 * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+                = x * logistic(2 * sqrt(2 / pi) * (x + 0.044715 * x^3))
+        Silu:     x * logistic(alpha * x)
+
+    The approximations use the coefficients of MlasErfKernel and
+    MlasLogisticKernel.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+struct MLAS_GELU_CONSTANTS {
+    static constexpr float ErfUpperAbsRange = 3.925f;
+    static constexpr float ErfSplitBoundary = 0.921875f;
+    static constexpr float ErfSMALL_P0 = -5.99104969e-4f;
+    static constexpr float ErfSMALL_P1 = 4.99339588e-3f;
+    static constexpr float ErfSMALL_P2 = -2.67667342e-2f;
+    static constexpr float ErfSMALL_P3 = 1.12818025e-1f;
+    static constexpr float ErfSMALL_P4 = -3.76124859e-1f;
+    static constexpr float ErfSMALL_P5_Minus_One = 1.28379151e-1f;
+    static constexpr float ErfBIG_P0 = 1.72948930e-5f;
+    static constexpr float ErfBIG_P1 = -3.83208680e-4f;
+    static constexpr float ErfBIG_P2 = 3.88393435e-3f;
+    static constexpr float ErfBIG_P3 = -2.42545605e-2f;
+    static constexpr float ErfBIG_P4 = 1.06777847e-1f;
+    static constexpr float ErfBIG_P5 = 6.34846687e-1f;
+    static constexpr float ErfBIG_P6_Minus_One = 1.28717512e-1f;
+    static constexpr float Exp_LowerRange = -88.3762626647949f;
+    static constexpr float Exp_Log2Reciprocal = 1.44269504088896341f;
+    static constexpr float Exp_log2_hi = -6.93145752e-1f;
+    static constexpr float Exp_log2_lo = -1.42860677e-6f;
+    static constexpr float Exp_P0 = 1.38319808e-3f;
+    static constexpr float Exp_P1 = 8.37550033e-3f;
+    static constexpr float Exp_P2 = 4.16689515e-2f;
+    static constexpr float Exp_P3 = 1.66664466e-1f;
+    static constexpr float Exp_P4 = 4.99999851e-1f;
+    static constexpr float Exp_P5 = 1.00000000e+0f;
+    static constexpr float Exp_P6 = 1.00000000e+0f;
+    static constexpr float Exp_C = 1.25829120e+7f;
+    static constexpr float LogisticLowerRange = -18.0f;
+    static constexpr float LogisticUpperRange = 18.0f;
+    static constexpr float Logistic_alpha_9 = 4.37031012579801e-11f;
+    static constexpr float Logistic_alpha_7 = 1.15627324459942e-07f;
+    static constexpr float Logistic_alpha_5 = 6.08574864600143e-05f;
+    static constexpr float Logistic_alpha_3 = 8.51377133304701e-03f;
+    static constexpr float Logistic_alpha_1 = 2.48287947061529e-01f;
+    static constexpr float Logistic_beta_10 = 6.10247389755681e-13f;
+    static constexpr float Logistic_beta_8 = 5.76102136993427e-09f;
+    static constexpr float Logistic_beta_6 = 6.29106785017040e-06f;
+    static constexpr float Logistic_beta_4 = 1.70198817374094e-03f;
+    static constexpr float Logistic_beta_2 = 1.16817656904453e-01f;
+    static constexpr float Logistic_beta_0 = 9.93151921023180e-01f;
+    static constexpr float SqrtHalf = 0.70710678118654752f;
+    static constexpr float TwoSqrtTwoOverPi = 1.5957691216057308f;
+    static constexpr float GeluTanhCubic = 0.044715f;
+};
+
+template<typename Vector>
+MLAS_FORCEINLINE
+typename Vector::Type
+MlasGeluErfVector(
+    typename Vector::Type Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function of a vector.
+
+Arguments:
+
+    Value - Supplies the input vector.
+
+Return Value:
+
+    Returns the error function of the input vector.
+
+--*/
+{
+    using VectorType = typename Vector::Type;
+    using C = MLAS_GELU_CONSTANTS;
+
+    VectorType AbsValue = Vector::Min(Vector::Broadcast(C::ErfUpperAbsRange), Vector::Abs(Value));
+    VectorType SquareValue = Vector::Mul(AbsValue, AbsValue);
+
+    VectorType r_small = Vector::Broadcast(C::ErfSMALL_P0);
+    r_small = Vector::MultiplyAdd(r_small, SquareValue, Vector::Broadcast(C::ErfSMALL_P1));
+    r_small = Vector::MultiplyAdd(r_small, SquareValue, Vector::Broadcast(C::ErfSMALL_P2));
+    r_small = Vector::MultiplyAdd(r_small, SquareValue, Vector::Broadcast(C::ErfSMALL_P3));
+    r_small = Vector::MultiplyAdd(r_small, SquareValue, Vector::Broadcast(C::ErfSMALL_P4));
+    r_small = Vector::MultiplyAdd(r_small, SquareValue, Vector::Broadcast(C::ErfSMALL_P5_Minus_One));
+    r_small = Vector::MultiplyAdd(r_small, AbsValue, AbsValue);
+
+    VectorType r_big = Vector::Broadcast(C::ErfBIG_P0);
+    r_big = Vector::MultiplyAdd(r_big, AbsValue, Vector::Broadcast(C::ErfBIG_P1));
+    r_big = Vector::MultiplyAdd(r_big, AbsValue, Vector::Broadcast(C::ErfBIG_P2));
+    r_big = Vector::MultiplyAdd(r_big, AbsValue, Vector::Broadcast(C::ErfBIG_P3));
+    r_big = Vector::MultiplyAdd(r_big, AbsValue, Vector::Broadcast(C::ErfBIG_P4));
+    r_big = Vector::MultiplyAdd(r_big, AbsValue, Vector::Broadcast(C::ErfBIG_P5));
+    r_big = Vector::MultiplyAdd(r_big, AbsValue, Vector::Broadcast(C::ErfBIG_P6_Minus_One));
+    r_big = Vector::MultiplyAdd(r_big, AbsValue, AbsValue);
+
+    //
+    // Compute 1 - exp(-r_big).
+    //
+
+    r_big = Vector::Max(Vector::Broadcast(C::Exp_LowerRange), Vector::Sub(Vector::Zero(), r_big));
+
+    VectorType exp_c = Vector::Broadcast(C::Exp_C);
+    VectorType r = Vector::MultiplyAdd(Vector::Broadcast(C::Exp_Log2Reciprocal), r_big, exp_c);
+    r = Vector::Sub(r, exp_c);
+
+    VectorType fx = Vector::MultiplyAdd(r, Vector::Broadcast(C::Exp_log2_hi), r_big);
+    fx = Vector::MultiplyAdd(r, Vector::Broadcast(C::Exp_log2_lo), fx);
+
+    VectorType y = Vector::Broadcast(C::Exp_P0);
+    y = Vector::MultiplyAdd(y, fx, Vector::Broadcast(C::Exp_P1));
+    y = Vector::MultiplyAdd(y, fx, Vector::Broadcast(C::Exp_P2));
+    y = Vector::MultiplyAdd(y, fx, Vector::Broadcast(C::Exp_P3));
+    y = Vector::MultiplyAdd(y, fx, Vector::Broadcast(C::Exp_P4));
+    y = Vector::MultiplyAdd(y, fx, Vector::Broadcast(C::Exp_P5));
+    y = Vector::MultiplyAdd(y, fx, Vector::Broadcast(C::Exp_P6));
+
+    y = Vector::Mul(y, Vector::PowerOf2(r));
+    y = Vector::Sub(Vector::Broadcast(1.0f), y);
+
+    //
+    // Select the result of the split and restore the sign of the input.
+    //
+
+    y = Vector::SelectGreaterThan(AbsValue, Vector::Broadcast(C::ErfSplitBoundary), y, r_small);
+
+    return Vector::CopySign(y, Value);
+}
+
+template<typename Vector>
+MLAS_FORCEINLINE
+typename Vector::Type
+MlasGeluLogisticVector(
+    typename Vector::Type Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the logistic function of a vector.
+
+Arguments:
+
+    Value - Supplies the input vector.
+
+Return Value:
+
+    Returns the logistic function of the input vector.
+
+--*/
+{
+    using VectorType = typename Vector::Type;
+    using C = MLAS_GELU_CONSTANTS;
+
+    Value = Vector::Max(Vector::Broadcast(C::LogisticLowerRange), Value);
+    Value = Vector::Min(Vector::Broadcast(C::LogisticUpperRange), Value);
+
+    VectorType ValueSquared = Vector::Mul(Value, Value);
+
+    VectorType p;
+    p = Vector::MultiplyAdd(ValueSquared, Vector::Broadcast(C::Logistic_alpha_9), Vector::Broadcast(C::Logistic_alpha_7));
+    p = Vector::MultiplyAdd(p, ValueSquared, Vector::Broadcast(C::Logistic_alpha_5));
+    p = Vector::MultiplyAdd(p, ValueSquared, Vector::Broadcast(C::Logistic_alpha_3));
+    p = Vector::MultiplyAdd(p, ValueSquared, Vector::Broadcast(C::Logistic_alpha_1));
+    p = Vector::Mul(p, Value);
+
+    VectorType q;
+    q = Vector::MultiplyAdd(ValueSquared, Vector::Broadcast(C::Logistic_beta_10), Vector::Broadcast(C::Logistic_beta_8));
+    q = Vector::MultiplyAdd(q, ValueSquared, Vector::Broadcast(C::Logistic_beta_6));
+    q = Vector::MultiplyAdd(q, ValueSquared, Vector::Broadcast(C::Logistic_beta_4));
+    q = Vector::MultiplyAdd(q, ValueSquared, Vector::Broadcast(C::Logistic_beta_2));
+    q = Vector::MultiplyAdd(q, ValueSquared, Vector::Broadcast(C::Logistic_beta_0));
+
+    return Vector::Add(Vector::Div(p, q), Vector::Broadcast(0.5f));
+}
+
+template<typename Vector, MLAS_ACTIVATION_KIND ActivationKind>
+MLAS_FORCEINLINE
+typename Vector::Type
+MlasGeluSiluVector(
+    typename Vector::Type Value,
+    typename Vector::Type Alpha
+    )
+{
+    using C = MLAS_GELU_CONSTANTS;
+
+    if (ActivationKind == MlasGeluErfActivation) {
+        typename Vector::Type Erf = MlasGeluErfVector<Vector>(Vector::Mul(Value, Vector::Broadcast(C::SqrtHalf)));
+        return Vector::Mul(Vector::Mul(Value, Vector::Broadcast(0.5f)), Vector::Add(Erf, Vector::Broadcast(1.0f)));
+    } else if (ActivationKind == MlasGeluTanhActivation) {
+        typename Vector::Type Value3 = Vector::Mul(Vector::Mul(Value, Value), Value);
+        typename Vector::Type Inner = Vector::MultiplyAdd(Value3, Vector::Broadcast(C::GeluTanhCubic), Value);
+        return Vector::Mul(Value, MlasGeluLogisticVector<Vector>(Vector::Mul(Inner, Vector::Broadcast(C::TwoSqrtTwoOverPi))));
+    } else {
+        return Vector::Mul(Value, MlasGeluLogisticVector<Vector>(Vector::Mul(Value, Alpha)));
+    }
+}
+
+template<typename Vector, MLAS_ACTIVATION_KIND ActivationKind>
+void
+MlasGeluSiluKernelImpl(
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the Gelu or SiLU activation to a row after optionally
+    adding a bias vector.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Bias - Optionally supplies the bias vector of N elements.
+
+    Output - Receives the activated row. This may be the input row.
+
+    N - Supplies the number of elements of the row.
+
+    Alpha - Supplies the scale of the input of the logistic function for the
+        SiLU activation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using VectorType = typename Vector::Type;
+    constexpr size_t Width = Vector::Width;
+
+    const VectorType AlphaVector = Vector::Broadcast(Alpha);
+
+    while (N >= Width) {
+
+        VectorType Value = Vector::Load(Input);
+
+        if (Bias != nullptr) {
+            Value = Vector::Add(Value, Vector::Load(Bias));
+            Bias += Width;
+        }
+
+        Vector::Store(Output, MlasGeluSiluVector<Vector, ActivationKind>(Value, AlphaVector));
+
+        Input += Width;
+        Output += Width;
+        N -= Width;
+    }
+
+    //
+    // Process the remaining elements with the vector code through a padded
+    // buffer, so that all of the elements share the same approximation.
+    //
+
+    if (N > 0) {
+
+        float Buffer[Width] = {};
+
+        for (size_t n = 0; n < N; n++) {
+            Buffer[n] = (Bias != nullptr) ? Input[n] + Bias[n] : Input[n];
+        }
+
+        Vector::Store(Buffer, MlasGeluSiluVector<Vector, ActivationKind>(Vector::Load(Buffer), AlphaVector));
+
+        std::copy_n(Buffer, N, Output);
+    }
+}
+
+template<typename Vector>
+MLAS_FORCEINLINE
+void
+MlasGeluSiluKernelDispatch(
+    MLAS_ACTIVATION_KIND ActivationKind,
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+{
+    switch (ActivationKind) {
+
+        case MlasGeluErfActivation:
+            MlasGeluSiluKernelImpl<Vector, MlasGeluErfActivation>(Input, Bias, Output, N, Alpha);
+            break;
+
+        case MlasGeluTanhActivation:
+            MlasGeluSiluKernelImpl<Vector, MlasGeluTanhActivation>(Input, Bias, Output, N, Alpha);
+            break;
+
+        default:
+            MlasGeluSiluKernelImpl<Vector, MlasSiluActivation>(Input, Bias, Output, N, Alpha);
+            break;
+    }
+}
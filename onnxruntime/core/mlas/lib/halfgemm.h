@@ -509,6 +509,8 @@ MlasHalfGemmGetDispatch()
 {
 #if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
     return &MlasHalfGemmDispatchNeon;
+#elif defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().HalfGemmDispatch;
 #else
     return &MlasHalfGemmDispatchDefault;
 #endif
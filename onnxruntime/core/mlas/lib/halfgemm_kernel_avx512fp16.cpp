@@ -0,0 +1,215 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements half precision GEMM kernel for x64 processors that
+    support AVX512-FP16.
+
+    Like the NEON kernel, the products are accumulated in fp16 with
+    VFMADD231PH, on 64 columns of B at a time.
+
+--*/
+
+#include "halfgemm.h"
+
+#include <immintrin.h>
+
+struct MLAS_HALF_GEMM_KERNEL_AVX512FP16 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+MLAS_FORCEINLINE
+__m512h
+MlasHalfGemmAvx512Fp16Load(
+    const _mlas_fp16_* S,
+    __mmask32 Mask
+    )
+{
+    return _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, S));
+}
+
+MLAS_FORCEINLINE
+void
+MlasHalfGemmAvx512Fp16Store(
+    _mlas_fp16_* D,
+    __mmask32 Mask,
+    __m512h Value
+    )
+{
+    _mm512_mask_storeu_epi16(D, Mask, _mm512_castph_si512(Value));
+}
+
+MLAS_FORCEINLINE
+void
+MlasHalfGemmAvx512Fp16ConvertRow(
+    _mlas_fp16_* D,
+    const float* S,
+    size_t Count
+    )
+{
+    size_t i = 0;
+
+    for (; i + 16 <= Count; i += 16) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(D + i),
+                            _mm512_cvtps_ph(_mm512_loadu_ps(S + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    if (i < Count) {
+        const __mmask16 Mask = __mmask16((1u << (Count - i)) - 1);
+        _mm256_mask_storeu_epi16(D + i, Mask,
+                                 _mm512_cvtps_ph(_mm512_maskz_loadu_ps(Mask, S + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+    )
+{
+    for (size_t m = 0; m < CountM; m++) {
+        MlasHalfGemmAvx512Fp16ConvertRow(D + m * CountK, A + m * lda, CountK);
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+{
+    for (size_t k = 0; k < CountK; k++) {
+        MlasHalfGemmAvx512Fp16ConvertRow(D + k * CountN, B + k * ldb, CountN);
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx512Fp16Rows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    for (size_t n = 0; n < CountN; n += 64) {
+
+        const size_t Remaining = CountN - n;
+        const __mmask32 Mask0 = (Remaining >= 32) ? __mmask32(0xFFFFFFFF) : __mmask32((1u << Remaining) - 1);
+        const __mmask32 Mask1 = (Remaining >= 64) ? __mmask32(0xFFFFFFFF) :
+                                (Remaining > 32) ? __mmask32((1u << (Remaining - 32)) - 1) : __mmask32(0);
+
+        __m512h Acc0[RowCount];
+        __m512h Acc1[RowCount];
+
+        const __m512h Bias0 = (Bias != nullptr) ? MlasHalfGemmAvx512Fp16Load(Bias + n, Mask0) : _mm512_setzero_ph();
+        const __m512h Bias1 = (Bias != nullptr) ? MlasHalfGemmAvx512Fp16Load(Bias + n + 32, Mask1) : _mm512_setzero_ph();
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Acc0[r] = Bias0;
+            Acc1[r] = Bias1;
+            if (!ZeroMode) {
+                Acc0[r] = _mm512_add_ph(Acc0[r], MlasHalfGemmAvx512Fp16Load(C + r * ldc + n, Mask0));
+                Acc1[r] = _mm512_add_ph(Acc1[r], MlasHalfGemmAvx512Fp16Load(C + r * ldc + n + 32, Mask1));
+            }
+        }
+
+        const _mlas_fp16_* b = B + n;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            const __m512h B0 = MlasHalfGemmAvx512Fp16Load(b, Mask0);
+            const __m512h B1 = MlasHalfGemmAvx512Fp16Load(b + 32, Mask1);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                const __m512h ABroadcast = _mm512_castsi512_ph(_mm512_set1_epi16(short(A[r * lda + k])));
+                Acc0[r] = _mm512_fmadd_ph(ABroadcast, B0, Acc0[r]);
+                Acc1[r] = _mm512_fmadd_ph(ABroadcast, B1, Acc1[r]);
+            }
+
+            b += ldb;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            MlasHalfGemmAvx512Fp16Store(C + r * ldc + n, Mask0, Acc0[r]);
+            MlasHalfGemmAvx512Fp16Store(C + r * ldc + n + 32, Mask1, Acc1[r]);
+        }
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM)) {
+        case 6:
+            MlasHalfGemmKernelAvx512Fp16Rows<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            MlasHalfGemmKernelAvx512Fp16Rows<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            MlasHalfGemmKernelAvx512Fp16Rows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmKernelAvx512Fp16Rows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelAvx512Fp16Rows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmKernelAvx512Fp16Rows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM,
+    0
+};
@@ -0,0 +1,345 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_f16c.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM driver for x64 processors
+    that support F16C but not AVX512-FP16.
+
+    The fp16 operands are converted to fp32 with F16C as they are copied into
+    the local panels, B in the packed layout of the SGEMM kernels, and the
+    products are accumulated in fp32 by the platform SGEMM kernel (FMA3 or
+    AVX512F). The results are rounded to fp16 once, after the last slice of K.
+
+--*/
+
+#include "halfgemm.h"
+
+#include <immintrin.h>
+
+//
+// Define the slices of the operation: the local panels of A, B and C hold
+// up to StrideM x StrideK, StrideK x StrideN and StrideM x StrideN fp32
+// elements. StrideN is a multiple of the 16 column width of packed B.
+//
+
+constexpr MLAS_HALF_GEMM_STRIDES MLAS_HALF_GEMM_F16C_STRIDES{64, 128, 256};
+
+//
+// Load and convert helpers. An fp32 operand is rounded to fp16 first, as if it
+// had been cast to fp16 like on the other platforms.
+//
+
+MLAS_FORCEINLINE
+__m256
+MlasHalfGemmF16cLoad8(
+    const _mlas_fp16_* S
+    )
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S)));
+}
+
+MLAS_FORCEINLINE
+__m256
+MlasHalfGemmF16cLoad8(
+    const float* S
+    )
+{
+    return _mm256_cvtph_ps(_mm256_cvtps_ph(_mm256_loadu_ps(S), _MM_FROUND_TO_NEAREST_INT));
+}
+
+MLAS_FORCEINLINE
+float
+MlasHalfGemmF16cLoad1(
+    const _mlas_fp16_* S
+    )
+{
+    return _cvtsh_ss(*S);
+}
+
+MLAS_FORCEINLINE
+float
+MlasHalfGemmF16cLoad1(
+    const float* S
+    )
+{
+    return _cvtsh_ss(_cvtss_sh(*S, _MM_FROUND_TO_NEAREST_INT));
+}
+
+template<typename T>
+static
+void
+MlasHalfGemmF16cConvertA(
+    float* D,
+    const T* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine converts rows of A to a row major fp32 panel with a leading
+    dimension of CountK.
+
+--*/
+{
+    while (CountM-- > 0) {
+
+        size_t k = 0;
+
+        for (; k + 8 <= CountK; k += 8) {
+            _mm256_storeu_ps(D + k, MlasHalfGemmF16cLoad8(A + k));
+        }
+
+        for (; k < CountK; k++) {
+            D[k] = MlasHalfGemmF16cLoad1(A + k);
+        }
+
+        D += CountK;
+        A += lda;
+    }
+}
+
+template<typename T>
+static
+void
+MlasHalfGemmF16cConvertPackB(
+    float* D,
+    const T* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine converts columns of B to fp32 and packs them in the layout of
+    MlasSgemmCopyPackB: columns of 16 elements are made contiguous and the last
+    columns are zero padded to 16.
+
+--*/
+{
+    for (size_t n = 0; n < CountN; n += 16) {
+
+        const size_t cols = std::min(CountN - n, size_t(16));
+        const T* b = B + n;
+
+        if (cols == 16) {
+
+            for (size_t k = 0; k < CountK; k++) {
+                _mm256_storeu_ps(D, MlasHalfGemmF16cLoad8(b));
+                _mm256_storeu_ps(D + 8, MlasHalfGemmF16cLoad8(b + 8));
+                D += 16;
+                b += ldb;
+            }
+
+        } else {
+
+            for (size_t k = 0; k < CountK; k++) {
+                for (size_t c = 0; c < 16; c++) {
+                    D[c] = (c < cols) ? MlasHalfGemmF16cLoad1(b + c) : 0.0f;
+                }
+                D += 16;
+                b += ldb;
+            }
+        }
+    }
+}
+
+static
+void
+MlasHalfGemmF16cStoreC(
+    _mlas_fp16_* C,
+    size_t ldc,
+    const float* PanelC,
+    size_t ldpc,
+    size_t CountM,
+    size_t CountN,
+    const _mlas_fp16_* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the bias to the fp32 results and rounds them to fp16.
+
+--*/
+{
+    while (CountM-- > 0) {
+
+        size_t n = 0;
+
+        for (; n + 8 <= CountN; n += 8) {
+            __m256 Row = _mm256_loadu_ps(PanelC + n);
+            if (Bias != nullptr) {
+                Row = _mm256_add_ps(Row, MlasHalfGemmF16cLoad8(Bias + n));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(C + n),
+                             _mm256_cvtps_ph(Row, _MM_FROUND_TO_NEAREST_INT));
+        }
+
+        for (; n < CountN; n++) {
+            float Value = PanelC[n];
+            if (Bias != nullptr) {
+                Value += MlasHalfGemmF16cLoad1(Bias + n);
+            }
+            C[n] = _cvtss_sh(Value, _MM_FROUND_TO_NEAREST_INT);
+        }
+
+        C += ldc;
+        PanelC += ldpc;
+    }
+}
+
+static
+void
+MlasHalfGemmOperationF16c(
+    const size_t N,
+    const size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    )
+{
+    constexpr MLAS_HALF_GEMM_STRIDES Strides = MLAS_HALF_GEMM_F16C_STRIDES;
+    constexpr size_t PanelASize = UpAlignSize(Strides.M * Strides.K * sizeof(float));
+    constexpr size_t PanelBSize = UpAlignSize(Strides.N * Strides.K * sizeof(float));
+    constexpr size_t PanelCSize = UpAlignSize(Strides.M * Strides.N * sizeof(float));
+    MlasThreadedBufAlloc(PanelASize + PanelBSize + PanelCSize);
+
+    uint8_t* p = ThreadedBufHolder.get();
+    auto* PanelA = reinterpret_cast<float*>(p);
+    p += PanelASize;
+    auto* PanelB = reinterpret_cast<float*>(p);
+    p += PanelBSize;
+    auto* PanelC = reinterpret_cast<float*>(p);
+
+    //
+    // Pre-packed B was converted by MlasHalfGemmConvertPackBF16c to a row major
+    // fp16 matrix.
+    //
+
+    const bool BIsPacked = (Data->ldb == 0);
+    const size_t ldb = BIsPacked ? N : Data->ldb;
+    const bool BIsfp32 = Data->BIsfp32 && !BIsPacked;
+
+    const size_t lda = Data->lda;
+    const size_t ldc = Data->ldc;
+
+    MLAS_GEMM_FLOAT_KERNEL* Kernel = GetMlasPlatform().GemmFloatKernel;
+
+    //
+    // Step through each slice of matrix C, accumulating the slices of K in
+    // the local fp32 panel.
+    //
+
+    size_t CountM;
+    for (size_t m = 0; m < RangeCountM; m += CountM) {
+        CountM = std::min(RangeCountM - m, Strides.M);
+        const size_t StartM = RangeStartM + m;
+
+        size_t CountN;
+        for (size_t n = 0; n < RangeCountN; n += CountN) {
+            CountN = std::min(RangeCountN - n, Strides.N);
+            const size_t StartN = RangeStartN + n;
+
+            if (K == 0) {
+                for (size_t i = 0; i < CountM; i++) {
+                    std::fill_n(PanelC + i * Strides.N, CountN, 0.0f);
+                }
+            }
+
+            size_t CountK;
+            for (size_t k = 0; k < K; k += CountK) {
+                CountK = std::min(K - k, Strides.K);
+
+                if (Data->AIsfp32) {
+                    MlasHalfGemmF16cConvertA(PanelA,
+                        reinterpret_cast<const float*>(Data->A) + StartM * lda + k, lda, CountM, CountK);
+                } else {
+                    MlasHalfGemmF16cConvertA(PanelA,
+                        reinterpret_cast<const _mlas_fp16_*>(Data->A) + StartM * lda + k, lda, CountM, CountK);
+                }
+
+                if (BIsfp32) {
+                    MlasHalfGemmF16cConvertPackB(PanelB,
+                        reinterpret_cast<const float*>(Data->B) + k * ldb + StartN, ldb, CountN, CountK);
+                } else {
+                    MlasHalfGemmF16cConvertPackB(PanelB,
+                        reinterpret_cast<const _mlas_fp16_*>(Data->B) + k * ldb + StartN, ldb, CountN, CountK);
+                }
+
+                const float* a = PanelA;
+                float* c = PanelC;
+                size_t RowsRemaining = CountM;
+
+                while (RowsRemaining > 0) {
+                    const size_t RowsHandled = Kernel(a, PanelB, c, CountK, RowsRemaining, CountN,
+                                                      CountK, Strides.N, 1.0f, k == 0);
+                    a += CountK * RowsHandled;
+                    c += Strides.N * RowsHandled;
+                    RowsRemaining -= RowsHandled;
+                }
+            }
+
+            const _mlas_fp16_* Bias = (Data->Bias == nullptr) ? nullptr :
+                reinterpret_cast<const _mlas_fp16_*>(Data->Bias) + StartN;
+
+            MlasHalfGemmF16cStoreC(reinterpret_cast<_mlas_fp16_*>(Data->C) + StartM * ldc + StartN, ldc,
+                                   PanelC, Strides.N, CountM, CountN, Bias);
+
+            if (Data->OutputProcessor != nullptr) {
+                Data->OutputProcessor->Process(Data->C, StartM, StartN, CountM, CountN, ldc);
+            }
+        }
+    }
+}
+
+static
+void
+MlasHalfGemmConvertPackBF16c(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+{
+    for (size_t k = 0; k < CountK; k++) {
+
+        size_t n = 0;
+
+        for (; n + 8 <= CountN; n += 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(D + n),
+                             _mm256_cvtps_ph(_mm256_loadu_ps(B + n), _MM_FROUND_TO_NEAREST_INT));
+        }
+
+        for (; n < CountN; n++) {
+            D[n] = _cvtss_sh(B[n], _MM_FROUND_TO_NEAREST_INT);
+        }
+
+        D += CountN;
+        B += ldb;
+    }
+}
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchF16c = {
+    MlasHalfGemmOperationF16c,
+    nullptr,
+    MlasHalfGemmConvertPackBF16c,
+    1,
+    MLAS_HALF_GEMM_F16C_STRIDES.M,
+    0
+};
@@ -0,0 +1,82 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    gelu_avx2.cpp
+
+Abstract:
+
+    This module implements the single pass kernel of the Gelu and SiLU
+    activations using AVX2 and FMA3 intrinsics.
+
+--*/
+
+#include "../../gelu.h"
+
+struct MLAS_GELU_VECTOR_AVX2 {
+
+    using Type = __m256;
+
+    static constexpr size_t Width = 8;
+
+    static MLAS_FORCEINLINE Type Zero() { return _mm256_setzero_ps(); }
+
+    static MLAS_FORCEINLINE Type Broadcast(float Value) { return _mm256_set1_ps(Value); }
+
+    static MLAS_FORCEINLINE Type Load(const float* Buffer) { return _mm256_loadu_ps(Buffer); }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, Type Vector) { _mm256_storeu_ps(Buffer, Vector); }
+
+    static MLAS_FORCEINLINE Type Add(Type Vector1, Type Vector2) { return _mm256_add_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Sub(Type Vector1, Type Vector2) { return _mm256_sub_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Mul(Type Vector1, Type Vector2) { return _mm256_mul_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Div(Type Vector1, Type Vector2) { return _mm256_div_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Min(Type Vector1, Type Vector2) { return _mm256_min_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Max(Type Vector1, Type Vector2) { return _mm256_max_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type MultiplyAdd(Type Vector1, Type Vector2, Type Vector3)
+    {
+        return _mm256_fmadd_ps(Vector1, Vector2, Vector3);
+    }
+
+    static MLAS_FORCEINLINE Type Abs(Type Vector) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), Vector); }
+
+    static MLAS_FORCEINLINE Type CopySign(Type Magnitude, Type Sign)
+    {
+        return _mm256_or_ps(Magnitude, _mm256_and_ps(Sign, _mm256_set1_ps(-0.0f)));
+    }
+
+    static MLAS_FORCEINLINE Type SelectGreaterThan(Type Vector1, Type Vector2, Type TrueValue, Type FalseValue)
+    {
+        return _mm256_blendv_ps(FalseValue, TrueValue, _mm256_cmp_ps(Vector1, Vector2, _CMP_GT_OQ));
+    }
+
+    static MLAS_FORCEINLINE Type PowerOf2(Type Vector)
+    {
+        __m256i emm0 = _mm256_add_epi32(_mm256_cvttps_epi32(Vector), _mm256_set1_epi32(127));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(emm0, 23));
+    }
+};
+
+void
+MLASCALL
+MlasGeluSiluF32KernelAvx2(
+    MLAS_ACTIVATION_KIND ActivationKind,
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+{
+    MlasGeluSiluKernelDispatch<MLAS_GELU_VECTOR_AVX2>(ActivationKind, Input, Bias, Output, N, Alpha);
+}
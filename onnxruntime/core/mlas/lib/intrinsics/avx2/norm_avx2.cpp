@@ -0,0 +1,72 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    norm_avx2.cpp
+
+Abstract:
+
+    This module implements the row kernel of the layer and RMS normalization
+    using AVX2 and FMA3 intrinsics.
+
+--*/
+
+#include "../../norm.h"
+
+struct MLAS_NORM_VECTOR_AVX2 {
+
+    using Type = __m256;
+
+    static constexpr size_t Width = 8;
+
+    static MLAS_FORCEINLINE Type Zero() { return _mm256_setzero_ps(); }
+
+    static MLAS_FORCEINLINE Type Broadcast(float Value) { return _mm256_set1_ps(Value); }
+
+    static MLAS_FORCEINLINE Type Load(const float* Buffer) { return _mm256_loadu_ps(Buffer); }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, Type Vector) { _mm256_storeu_ps(Buffer, Vector); }
+
+    static MLAS_FORCEINLINE Type Add(Type Vector1, Type Vector2) { return _mm256_add_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Sub(Type Vector1, Type Vector2) { return _mm256_sub_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Mul(Type Vector1, Type Vector2) { return _mm256_mul_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type MultiplyAdd(Type Vector1, Type Vector2, Type Vector3)
+    {
+        return _mm256_fmadd_ps(Vector1, Vector2, Vector3);
+    }
+
+    static MLAS_FORCEINLINE float ReduceAdd(Type Vector)
+    {
+        __m128 v = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_movehdup_ps(v));
+        return _mm_cvtss_f32(v);
+    }
+};
+
+void
+MLASCALL
+MlasNormF32KernelAvx2(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* SkipOutput,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Statistics
+    )
+{
+    MlasNormF32KernelImpl<MLAS_NORM_VECTOR_AVX2>(Input, Skip, SkipBias, SkipOutput, Scale, Bias,
+                                                 Output, D, Epsilon, Simplified, Statistics);
+}
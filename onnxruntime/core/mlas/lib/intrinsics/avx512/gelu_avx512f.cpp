@@ -0,0 +1,91 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    gelu_avx512f.cpp
+
+Abstract:
+
+    This module implements the single pass kernel of the Gelu and SiLU
+    activations using AVX512F intrinsics.
+
+--*/
+
+#include "../../gelu.h"
+
+struct MLAS_GELU_VECTOR_AVX512F {
+
+    using Type = __m512;
+
+    static constexpr size_t Width = 16;
+
+    static MLAS_FORCEINLINE Type Zero() { return _mm512_setzero_ps(); }
+
+    static MLAS_FORCEINLINE Type Broadcast(float Value) { return _mm512_set1_ps(Value); }
+
+    static MLAS_FORCEINLINE Type Load(const float* Buffer) { return _mm512_loadu_ps(Buffer); }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, Type Vector) { _mm512_storeu_ps(Buffer, Vector); }
+
+    static MLAS_FORCEINLINE Type Add(Type Vector1, Type Vector2) { return _mm512_add_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Sub(Type Vector1, Type Vector2) { return _mm512_sub_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Mul(Type Vector1, Type Vector2) { return _mm512_mul_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Div(Type Vector1, Type Vector2) { return _mm512_div_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Min(Type Vector1, Type Vector2) { return _mm512_min_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Max(Type Vector1, Type Vector2) { return _mm512_max_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type MultiplyAdd(Type Vector1, Type Vector2, Type Vector3)
+    {
+        return _mm512_fmadd_ps(Vector1, Vector2, Vector3);
+    }
+
+    //
+    // The floating point logical instructions require AVX512DQ, so the sign
+    // bit is handled with the integer instructions.
+    //
+
+    static MLAS_FORCEINLINE Type Abs(Type Vector)
+    {
+        return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(Vector), _mm512_set1_epi32(0x7FFFFFFF)));
+    }
+
+    static MLAS_FORCEINLINE Type CopySign(Type Magnitude, Type Sign)
+    {
+        __m512i SignBits = _mm512_and_si512(_mm512_castps_si512(Sign), _mm512_set1_epi32(int32_t(0x80000000)));
+        return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(Magnitude), SignBits));
+    }
+
+    static MLAS_FORCEINLINE Type SelectGreaterThan(Type Vector1, Type Vector2, Type TrueValue, Type FalseValue)
+    {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(Vector1, Vector2, _CMP_GT_OQ), FalseValue, TrueValue);
+    }
+
+    static MLAS_FORCEINLINE Type PowerOf2(Type Vector)
+    {
+        __m512i emm0 = _mm512_add_epi32(_mm512_cvttps_epi32(Vector), _mm512_set1_epi32(127));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(emm0, 23));
+    }
+};
+
+void
+MLASCALL
+MlasGeluSiluF32KernelAvx512F(
+    MLAS_ACTIVATION_KIND ActivationKind,
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+{
+    MlasGeluSiluKernelDispatch<MLAS_GELU_VECTOR_AVX512F>(ActivationKind, Input, Bias, Output, N, Alpha);
+}
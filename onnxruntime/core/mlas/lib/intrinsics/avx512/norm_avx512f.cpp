@@ -0,0 +1,66 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    norm_avx512f.cpp
+
+Abstract:
+
+    This module implements the row kernel of the layer and RMS normalization
+    using AVX512F intrinsics.
+
+--*/
+
+#include "../../norm.h"
+
+struct MLAS_NORM_VECTOR_AVX512F {
+
+    using Type = __m512;
+
+    static constexpr size_t Width = 16;
+
+    static MLAS_FORCEINLINE Type Zero() { return _mm512_setzero_ps(); }
+
+    static MLAS_FORCEINLINE Type Broadcast(float Value) { return _mm512_set1_ps(Value); }
+
+    static MLAS_FORCEINLINE Type Load(const float* Buffer) { return _mm512_loadu_ps(Buffer); }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, Type Vector) { _mm512_storeu_ps(Buffer, Vector); }
+
+    static MLAS_FORCEINLINE Type Add(Type Vector1, Type Vector2) { return _mm512_add_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Sub(Type Vector1, Type Vector2) { return _mm512_sub_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Mul(Type Vector1, Type Vector2) { return _mm512_mul_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type MultiplyAdd(Type Vector1, Type Vector2, Type Vector3)
+    {
+        return _mm512_fmadd_ps(Vector1, Vector2, Vector3);
+    }
+
+    static MLAS_FORCEINLINE float ReduceAdd(Type Vector) { return _mm512_reduce_add_ps(Vector); }
+};
+
+void
+MLASCALL
+MlasNormF32KernelAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* SkipOutput,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Statistics
+    )
+{
+    MlasNormF32KernelImpl<MLAS_NORM_VECTOR_AVX512F>(Input, Skip, SkipBias, SkipOutput, Scale, Bias,
+                                                    Output, D, Epsilon, Simplified, Statistics);
+}
@@ -574,6 +574,33 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_NORM_FLOAT_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* SkipOutput,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Statistics
+    );
+
+typedef
+void
+(MLASCALL MLAS_GELU_SILU_FLOAT_KERNEL)(
+    MLAS_ACTIVATION_KIND ActivationKind,
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Alpha
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -765,6 +792,18 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_NORM_FLOAT_KERNEL MlasNormF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_NORM_FLOAT_KERNEL MlasNormF32KernelAvx2;
+    MLAS_NORM_FLOAT_KERNEL MlasNormF32KernelAvx512F;
+#endif
+
+    MLAS_GELU_SILU_FLOAT_KERNEL MlasGeluSiluF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_GELU_SILU_FLOAT_KERNEL MlasGeluSiluF32KernelAvx2;
+    MLAS_GELU_SILU_FLOAT_KERNEL MlasGeluSiluF32KernelAvx512F;
+#endif
+
 }
 
 //
@@ -794,7 +833,10 @@ extern "C" {
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 
 //
-// Single-threaded single precision matrix/matrix multiply operation.
+// Single-threaded single precision matrix/matrix multiply operation. The
+// optional output processor is applied to C as the block at RangeStartM and
+// RangeStartN of its output matrix. The optional tuning parameters replace the
+// heuristic selection of the strides through matrix B.
 //
 
 void
@@ -811,7 +853,35 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor = nullptr,
+    size_t RangeStartM = 0,
+    size_t RangeStartN = 0,
+    const MLAS_SGEMM_TUNING_PARAMETERS* TuningParameters = nullptr
+    );
+
+//
+// Single-threaded single precision matrix/matrix multiply operation with the
+// matrix B packed by MlasGemmPackB.
+//
+
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor = nullptr,
+    size_t RangeStartM = 0
     );
 
 //
@@ -863,6 +933,24 @@ struct MLAS_FPQ4GEMM_DISPATCH;
 
 extern const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchAvx512;
 
+struct MLAS_SQNBIT_GEMM_DISPATCH;
+
+extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx2;
+extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvxVnni;
+extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512vnni;
+
+struct MLAS_BF16_GEMM_DISPATCH;
+
+extern const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchDefault;
+extern const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAvx512Bf16;
+extern const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAmx;
+
+struct MLAS_HALFGEMM_DISPATCH;
+
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchDefault;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchF16c;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16;
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -977,6 +1065,8 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_NORM_FLOAT_KERNEL* NormF32Kernel;
+    MLAS_GELU_SILU_FLOAT_KERNEL* GeluSiluF32Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     uint32_t NchwcBlockSize;
@@ -990,6 +1080,11 @@ struct MLAS_PLATFORM {
 
     const MLAS_FPQ4GEMM_DISPATCH* FpQ4GemmDispatch{nullptr};
     const MLAS_Q8Q4GEMM_DISPATCH* Q8Q4GemmDispatch{nullptr};
+    const MLAS_SQNBIT_GEMM_DISPATCH* SQNBitGemmDispatch{nullptr};
+    const MLAS_BF16_GEMM_DISPATCH* Bf16GemmDispatch{&MlasBf16GemmDispatchDefault};
+#if defined(MLAS_TARGET_AMD64)
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch{&MlasHalfGemmDispatchDefault};
+#endif
 };
 
 inline
@@ -0,0 +1,356 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    norm.cpp
+
+Abstract:
+
+    This module implements the layer and RMS normalization routines, with an
+    optional skip connection added to the input.
+
+    Half precision rows are converted to single precision in a thread local
+    buffer, normalized by the single precision kernel and converted back.
+
+--*/
+
+#include "norm.h"
+
+//
+// Vector operations of the portable kernel.
+//
+
+struct MLAS_NORM_VECTOR_FLOAT32X4 {
+
+    using Type = MLAS_FLOAT32X4;
+
+    static constexpr size_t Width = 4;
+
+    static MLAS_FORCEINLINE Type Zero() { return MlasZeroFloat32x4(); }
+
+    static MLAS_FORCEINLINE Type Broadcast(float Value) { return MlasBroadcastFloat32x4(Value); }
+
+    static MLAS_FORCEINLINE Type Load(const float* Buffer) { return MlasLoadFloat32x4(Buffer); }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, Type Vector) { MlasStoreFloat32x4(Buffer, Vector); }
+
+    static MLAS_FORCEINLINE Type Add(Type Vector1, Type Vector2) { return MlasAddFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Sub(Type Vector1, Type Vector2) { return MlasSubtractFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type Mul(Type Vector1, Type Vector2) { return MlasMultiplyFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE Type MultiplyAdd(Type Vector1, Type Vector2, Type Vector3)
+    {
+        return MlasMultiplyAddFloat32x4(Vector1, Vector2, Vector3);
+    }
+
+    static MLAS_FORCEINLINE float ReduceAdd(Type Vector) { return MlasReduceAddFloat32x4(Vector); }
+};
+
+void
+MLASCALL
+MlasNormF32Kernel(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* SkipOutput,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Statistics
+    )
+{
+    MlasNormF32KernelImpl<MLAS_NORM_VECTOR_FLOAT32X4>(Input, Skip, SkipBias, SkipOutput, Scale, Bias,
+                                                      Output, D, Epsilon, Simplified, Statistics);
+}
+
+MLAS_FORCEINLINE
+void
+MlasNormF32Row(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* SkipOutput,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Statistics
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().NormF32Kernel(Input, Skip, SkipBias, SkipOutput, Scale, Bias,
+                                    Output, D, Epsilon, Simplified, Statistics);
+#else
+    MlasNormF32Kernel(Input, Skip, SkipBias, SkipOutput, Scale, Bias,
+                      Output, D, Epsilon, Simplified, Statistics);
+#endif
+}
+
+template<typename T>
+void
+MlasNormThreaded(
+    const MLAS_NORM_PARAMS<T>* Params,
+    bool Simplified,
+    size_t StartRow,
+    size_t CountRows
+    );
+
+template<>
+void
+MlasNormThreaded<float>(
+    const MLAS_NORM_PARAMS<float>* Params,
+    bool Simplified,
+    size_t StartRow,
+    size_t CountRows
+    )
+{
+    const size_t D = Params->D;
+    const float* Bias = Simplified ? nullptr : Params->Bias;
+
+    for (size_t Row = StartRow; Row < StartRow + CountRows; Row++) {
+
+        const float* Skip = (Params->Skip != nullptr) ? Params->Skip + (Row % Params->SkipRows) * D : nullptr;
+        float* SkipOutput = (Params->SkipOutput != nullptr) ? Params->SkipOutput + Row * D : nullptr;
+        float Statistics[2];
+
+        MlasNormF32Row(Params->Input + Row * D, Skip, Params->SkipBias, SkipOutput, Params->Scale, Bias,
+                       Params->Output + Row * D, D, Params->Epsilon, Simplified, Statistics);
+
+        if (Params->Mean != nullptr) {
+            Params->Mean[Row] = Statistics[0];
+        }
+
+        if (Params->InvStdDev != nullptr) {
+            Params->InvStdDev[Row] = Statistics[1];
+        }
+    }
+}
+
+static
+void
+MlasNormConvertHalfToFloat(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    const _mlas_fp16_* s = reinterpret_cast<const _mlas_fp16_*>(Source);
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_Half2Float(s[i]);
+    }
+}
+
+static
+void
+MlasNormConvertFloatToHalf(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count
+    )
+{
+    _mlas_fp16_* d = reinterpret_cast<_mlas_fp16_*>(Destination);
+
+    for (size_t i = 0; i < Count; i++) {
+        d[i] = MLAS_Float2Half(Source[i]);
+    }
+}
+
+template<>
+void
+MlasNormThreaded<MLAS_FP16>(
+    const MLAS_NORM_PARAMS<MLAS_FP16>* Params,
+    bool Simplified,
+    size_t StartRow,
+    size_t CountRows
+    )
+{
+    const size_t D = Params->D;
+    const bool HasBias = !Simplified && Params->Bias != nullptr;
+
+    //
+    // Carve the thread local buffer into single precision copies of the
+    // vectors and rows.
+    //
+
+    MlasThreadedBufAlloc(6 * D * sizeof(float));
+    float* Scale = reinterpret_cast<float*>(ThreadedBufHolder.get());
+    float* Bias = Scale + D;
+    float* SkipBias = Bias + D;
+    float* Input = SkipBias + D;
+    float* Skip = Input + D;
+    float* Output = Skip + D;
+
+    MlasNormConvertHalfToFloat(Params->Scale, Scale, D);
+
+    if (HasBias) {
+        MlasNormConvertHalfToFloat(Params->Bias, Bias, D);
+    }
+
+    if (Params->SkipBias != nullptr) {
+        MlasNormConvertHalfToFloat(Params->SkipBias, SkipBias, D);
+    }
+
+    for (size_t Row = StartRow; Row < StartRow + CountRows; Row++) {
+
+        MlasNormConvertHalfToFloat(Params->Input + Row * D, Input, D);
+
+        if (Params->Skip != nullptr) {
+            MlasNormConvertHalfToFloat(Params->Skip + (Row % Params->SkipRows) * D, Skip, D);
+        }
+
+        //
+        // The sum of the input and skip overwrites the single precision skip
+        // row, which is read before it is written.
+        //
+
+        float* SkipOutput = (Params->SkipOutput != nullptr) ? Skip : nullptr;
+        float Statistics[2];
+
+        MlasNormF32Row(Input, (Params->Skip != nullptr) ? Skip : nullptr,
+                       (Params->SkipBias != nullptr) ? SkipBias : nullptr, SkipOutput,
+                       Scale, HasBias ? Bias : nullptr, Output, D, Params->Epsilon, Simplified, Statistics);
+
+        if (SkipOutput != nullptr) {
+            MlasNormConvertFloatToHalf(SkipOutput, Params->SkipOutput + Row * D, D);
+        }
+
+        MlasNormConvertFloatToHalf(Output, Params->Output + Row * D, D);
+
+        if (Params->Mean != nullptr) {
+            Params->Mean[Row] = Statistics[0];
+        }
+
+        if (Params->InvStdDev != nullptr) {
+            Params->InvStdDev[Row] = Statistics[1];
+        }
+    }
+}
+
+template<typename T>
+void
+MlasNorm(
+    const MLAS_NORM_PARAMS<T>* Params,
+    bool Simplified,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes the rows of a matrix.
+
+Arguments:
+
+    Params - Supplies the normalization parameters.
+
+    Simplified - Supplies true for the RMS normalization.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Rows = Params->Rows;
+
+    if (Rows == 0 || Params->D == 0) {
+        return;
+    }
+
+    //
+    // Limit the number of threads to the number of rows and try to keep each
+    // thread processing a minimum number of elements before using another
+    // thread.
+    //
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > Rows) {
+        ThreadCount = ptrdiff_t(Rows);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    const size_t BlockCount = ((Rows * Params->D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+        size_t StartRow;
+        size_t CountRows;
+        MlasPartitionWork(tid, ThreadCount, Rows, &StartRow, &CountRows);
+
+        MlasNormThreaded<T>(Params, Simplified, StartRow, CountRows);
+    });
+}
+
+template<typename T>
+void
+MLASCALL
+MlasLayerNorm(
+    const MLAS_NORM_PARAMS<T>* Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasNorm<T>(Params, false, ThreadPool);
+}
+
+template<typename T>
+void
+MLASCALL
+MlasRmsNorm(
+    const MLAS_NORM_PARAMS<T>* Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasNorm<T>(Params, true, ThreadPool);
+}
+
+template
+void
+MLASCALL
+MlasLayerNorm<float>(
+    const MLAS_NORM_PARAMS<float>* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasLayerNorm<MLAS_FP16>(
+    const MLAS_NORM_PARAMS<MLAS_FP16>* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasRmsNorm<float>(
+    const MLAS_NORM_PARAMS<float>* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasRmsNorm<MLAS_FP16>(
+    const MLAS_NORM_PARAMS<MLAS_FP16>* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
@@ -0,0 +1,195 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    norm.h
+
+Abstract:
+
+    This module implements the row kernel of the layer and RMS normalization,
+    which is specialized with the vector type of each instruction set.
+
+    The sum of the input and skip rows is staged in the output row, which then
+    stays in cache for the variance and normalization passes.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+template<typename Vector>
+MLAS_FORCEINLINE
+void
+MlasNormF32KernelImpl(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* SkipOutput,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Statistics
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Optionally supplies the skip row added to the input.
+
+    SkipBias - Optionally supplies the bias added to the input.
+
+    SkipOutput - Optionally receives the sum of the input, skip and bias.
+
+    Scale - Supplies the scale of the normalized row.
+
+    Bias - Optionally supplies the bias of the normalized row.
+
+    Output - Receives the normalized row.
+
+    D - Supplies the number of elements of the row.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Simplified - Supplies true for the RMS normalization.
+
+    Statistics - Receives the mean (0 for the RMS normalization) and the
+        inverse standard deviation (or RMS) of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using VectorType = typename Vector::Type;
+    constexpr size_t Width = Vector::Width;
+
+    const size_t VectorD = D - D % Width;
+
+    //
+    // Add the skip and bias to the input and accumulate the sum of the row, or
+    // the sum of the squares for the RMS normalization.
+    //
+
+    VectorType Accumulator = Vector::Zero();
+    float Accumulation = 0.0f;
+
+    size_t d = 0;
+
+    for (; d < VectorD; d += Width) {
+
+        VectorType x = Vector::Load(Input + d);
+
+        if (Skip != nullptr) {
+            x = Vector::Add(x, Vector::Load(Skip + d));
+        }
+
+        if (SkipBias != nullptr) {
+            x = Vector::Add(x, Vector::Load(SkipBias + d));
+        }
+
+        if (SkipOutput != nullptr) {
+            Vector::Store(SkipOutput + d, x);
+        }
+
+        Vector::Store(Output + d, x);
+
+        Accumulator = Simplified ? Vector::MultiplyAdd(x, x, Accumulator) : Vector::Add(Accumulator, x);
+    }
+
+    for (; d < D; d++) {
+
+        float x = Input[d];
+
+        if (Skip != nullptr) {
+            x += Skip[d];
+        }
+
+        if (SkipBias != nullptr) {
+            x += SkipBias[d];
+        }
+
+        if (SkipOutput != nullptr) {
+            SkipOutput[d] = x;
+        }
+
+        Output[d] = x;
+
+        Accumulation += Simplified ? x * x : x;
+    }
+
+    Accumulation += Vector::ReduceAdd(Accumulator);
+
+    float Mean = 0.0f;
+    float Variance = Accumulation / float(D);
+
+    if (!Simplified) {
+
+        //
+        // Compute the variance from the row in cache, which does not lose
+        // precision like the difference of the mean square and squared mean.
+        //
+
+        Mean = Variance;
+        Accumulator = Vector::Zero();
+        Accumulation = 0.0f;
+
+        const VectorType MeanBroadcast = Vector::Broadcast(Mean);
+
+        for (d = 0; d < VectorD; d += Width) {
+            const VectorType x = Vector::Sub(Vector::Load(Output + d), MeanBroadcast);
+            Accumulator = Vector::MultiplyAdd(x, x, Accumulator);
+        }
+
+        for (; d < D; d++) {
+            const float x = Output[d] - Mean;
+            Accumulation += x * x;
+        }
+
+        Variance = (Accumulation + Vector::ReduceAdd(Accumulator)) / float(D);
+    }
+
+    const float InvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+
+    //
+    // Normalize the row.
+    //
+
+    const VectorType MeanBroadcast = Vector::Broadcast(Mean);
+    const VectorType InvStdDevBroadcast = Vector::Broadcast(InvStdDev);
+
+    for (d = 0; d < VectorD; d += Width) {
+
+        VectorType y = Vector::Mul(Vector::Sub(Vector::Load(Output + d), MeanBroadcast), InvStdDevBroadcast);
+
+        if (Bias != nullptr) {
+            y = Vector::MultiplyAdd(y, Vector::Load(Scale + d), Vector::Load(Bias + d));
+        } else {
+            y = Vector::Mul(y, Vector::Load(Scale + d));
+        }
+
+        Vector::Store(Output + d, y);
+    }
+
+    for (; d < D; d++) {
+        const float y = (Output[d] - Mean) * InvStdDev * Scale[d];
+        Output[d] = (Bias != nullptr) ? y + Bias[d] : y;
+    }
+
+    Statistics[0] = Mean;
+    Statistics[1] = InvStdDev;
+}
@@ -226,6 +226,8 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->NormF32Kernel = MlasNormF32Kernel;
+    this->GeluSiluF32Kernel = MlasGeluSiluF32Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -329,6 +331,20 @@ Return Value:
                 this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->NormF32Kernel = MlasNormF32KernelAvx2;
+                this->GeluSiluF32Kernel = MlasGeluSiluF32KernelAvx2;
+
+                //
+                // Check if the processor supports F16C features.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->HalfGemmDispatch = &MlasHalfGemmDispatchF16c;
+                }
+
+#if !defined(ORT_MINIMAL_BUILD)
+                this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx2;
+#endif
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -355,6 +371,9 @@ Return Value:
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
                     this->GemvU8S8Kernel = MlasGemvU8S8KernelAvxVnni;
                     this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvxVnni;
+#if defined(MLAS_AVXVNNI_SUPPORTED) && !defined(ORT_MINIMAL_BUILD)
+                    this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAvxVnni;
+#endif
                 }
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -379,6 +398,8 @@ Return Value:
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->NormF32Kernel = MlasNormF32KernelAvx512F;
+                    this->GeluSiluF32Kernel = MlasGeluSiluF32KernelAvx512F;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
 
@@ -406,7 +427,32 @@ Return Value:
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
+                            this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512vnni;
+                        }
+
+#if defined(MLAS_AVX512BF16_SUPPORTED)
+
+                        //
+                        // Check if the processor supports AVX512-BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->Bf16GemmDispatch = &MlasBf16GemmDispatchAvx512Bf16;
                         }
+#endif
+
+#if defined(MLAS_AVX512FP16_SUPPORTED)
+
+                        //
+                        // Check if the processor supports AVX512-FP16.
+                        //
+
+                        if ((Cpuid7[3] & 0x800000) != 0) {
+
+                            this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx512Fp16;
+                        }
+#endif
                     }
                 }
 
@@ -421,6 +467,20 @@ Return Value:
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
                     }
                 }
+
+#if defined(MLAS_AVX512BF16_SUPPORTED)
+                //
+                // Check if the processor supports AMX-TILE and AMX-BF16
+                // features. The AMX kernel leaves the rows that do not fill
+                // a tile to the AVX512-BF16 kernel.
+                //
+                if ((Cpuid7[3] & 0b1 << 24) != 0 && (Cpuid7[3] & 0b1 << 22) != 0 &&
+                    this->Bf16GemmDispatch == &MlasBf16GemmDispatchAvx512Bf16) {
+                    if (MlasInitAMX()) {
+                        this->Bf16GemmDispatch = &MlasBf16GemmDispatchAmx;
+                    }
+                }
+#endif
 #endif // __APPLE__
 
 #endif // ORT_MINIMAL_BUILD
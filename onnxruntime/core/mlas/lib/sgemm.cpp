@@ -1079,6 +1079,69 @@ Return Value:
     return C;
 }
 
+float*
+MlasSgemmKernelLoopProcessOutput(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode,
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor,
+    size_t StartM,
+    size_t StartN
+    )
+/*++
+
+Routine Description:
+
+    This routine steps through the rows of the input and output matrices calling
+    the kernel until all rows have been processed, then applies the output
+    processor to each block of rows while it is still in cache.
+
+Arguments:
+
+    A, B, C, CountK, CountM, CountN, lda, ldc, alpha, ZeroMode - Supplies the
+        arguments of MlasSgemmKernelLoop.
+
+    OutputProcessor - Supplies the optional output processor.
+
+    StartM - Supplies the row of C in the output matrix.
+
+    StartN - Supplies the column of C in the output matrix.
+
+Return Value:
+
+    Returns the next address of matrix C.
+
+--*/
+{
+    if (OutputProcessor == nullptr) {
+        return MlasSgemmKernelLoop(A, B, C, CountK, CountM, CountN, lda, ldc, alpha, ZeroMode);
+    }
+
+    float* OutputMatrix = C - StartM * ldc - StartN;
+
+    while (CountM > 0) {
+
+        const size_t RowsProcessed = std::min(CountM, size_t(MLAS_SGEMM_TRANSA_ROWS));
+
+        C = MlasSgemmKernelLoop(A, B, C, CountK, RowsProcessed, CountN, lda, ldc, alpha, ZeroMode);
+
+        OutputProcessor->Process(OutputMatrix, StartM, StartN, RowsProcessed, CountN, ldc);
+
+        A += lda * RowsProcessed;
+        CountM -= RowsProcessed;
+        StartM += RowsProcessed;
+    }
+
+    return C;
+}
+
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -1093,7 +1156,11 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor,
+    size_t RangeStartM,
+    size_t RangeStartN,
+    const MLAS_SGEMM_TUNING_PARAMETERS* TuningParameters
     )
 /*++
 
@@ -1131,6 +1198,17 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    OutputProcessor - Supplies the optional processor of the output matrix,
+        applied to each tile after its last K slice.
+
+    RangeStartM - Supplies the row of matrix C in the output matrix of the
+        output processor.
+
+    RangeStartN - Supplies the column of matrix C in the output matrix of the
+        output processor.
+
+    TuningParameters - Optionally supplies the tuned strides through matrix B.
+
 Return Value:
 
     None.
@@ -1147,6 +1225,9 @@ Return Value:
 
     if (K == 0) {
         MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        if (OutputProcessor != nullptr) {
+            OutputProcessor->Process(C - RangeStartM * ldc - RangeStartN, RangeStartM, RangeStartN, M, N, ldc);
+        }
         return;
     }
 
@@ -1170,6 +1251,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            if (OutputProcessor != nullptr) {
+                OutputProcessor->Process(C - RangeStartM * ldc - RangeStartN, RangeStartM, RangeStartN, M, N, ldc);
+            }
             return;
         }
 
@@ -1177,6 +1261,9 @@ Return Value:
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+            if (OutputProcessor != nullptr) {
+                OutputProcessor->Process(C - RangeStartM * ldc - RangeStartN, RangeStartM, RangeStartN, M, N, ldc);
+            }
             return;
         }
 
@@ -1205,6 +1292,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            if (OutputProcessor != nullptr) {
+                OutputProcessor->Process(C - RangeStartM * ldc - RangeStartN, RangeStartM, RangeStartN, M, N, ldc);
+            }
             return;
         }
 
@@ -1219,11 +1309,22 @@ Return Value:
     // for better utilization of the B panel. Avoid changing the K stride if
     // the A panel needs to be used for transposing.
     //
+    // Tuned strides are used instead if they fit the panel buffers.
+    //
 
     size_t StrideN = MLAS_SGEMM_STRIDEN;
     size_t StrideK = MLAS_SGEMM_STRIDEK;
 
-    if (N >= K) {
+    if (TuningParameters != nullptr && TuningParameters->StrideN != 0 &&
+        TuningParameters->StrideN % MLAS_SGEMM_STRIDEN_THREAD_ALIGN == 0 &&
+        TuningParameters->StrideK != 0 &&
+        TuningParameters->StrideN * TuningParameters->StrideK <= MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK &&
+        (TransA == CblasNoTrans || TuningParameters->StrideK <= MLAS_SGEMM_STRIDEK)) {
+
+        StrideN = TuningParameters->StrideN;
+        StrideK = TuningParameters->StrideK;
+
+    } else if (N >= K) {
 
         while (StrideK / 2 >= K) {
             StrideN *= 2;
@@ -1278,14 +1379,17 @@ Return Value:
             }
 
             //
-            // Step through each slice of matrix A along the M dimension.
+            // Step through each slice of matrix A along the M dimension. The
+            // output processor is applied after the last slice of K.
             //
 
             float* c = C + n;
+            const MLAS_GEMM_POSTPROCESSOR<float>* SliceProcessor = (k + CountK == K) ? OutputProcessor : nullptr;
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoopProcessOutput(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    SliceProcessor, RangeStartM, RangeStartN + n);
 
             } else {
 
@@ -1302,6 +1406,8 @@ Return Value:
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
+                    const size_t StartM = RangeStartM + M - RowsRemaining;
+
                     RowsRemaining -= RowsTransposed;
                     a += RowsTransposed;
 
@@ -1309,7 +1415,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoopProcessOutput(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        SliceProcessor, StartM, RangeStartN + n);
                 }
             }
 
@@ -1332,7 +1439,9 @@ MlasSgemmPackedOperation(
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor,
+    size_t RangeStartM
     )
 /*++
 
@@ -1372,6 +1481,12 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    OutputProcessor - Supplies the optional processor of the output matrix,
+        applied to each tile after its last K slice.
+
+    RangeStartM - Supplies the row of matrix C in the output matrix of the
+        output processor.
+
 Return Value:
 
     None.
@@ -1417,10 +1532,12 @@ Return Value:
 
             const float* pb = (const float*)PackedB + AlignedN * k + CountK * SliceStartN;
             float* c = C + n;
+            const MLAS_GEMM_POSTPROCESSOR<float>* SliceProcessor = (k + CountK == K) ? OutputProcessor : nullptr;
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoopProcessOutput(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    SliceProcessor, RangeStartM, SliceStartN);
 
             } else {
 
@@ -1437,6 +1554,8 @@ Return Value:
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
+                    const size_t StartM = RangeStartM + M - RowsRemaining;
+
                     RowsRemaining -= RowsTransposed;
                     a += RowsTransposed;
 
@@ -1444,7 +1563,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoopProcessOutput(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        SliceProcessor, StartM, SliceStartN);
                 }
             }
 
@@ -1464,6 +1584,7 @@ MlasSgemmThreaded(
     const size_t K,
 
     const MLAS_SGEMM_DATA_PARAMS* DataParams,
+    const MLAS_SGEMM_TUNING_PARAMETERS* TuningParameters,
     ptrdiff_t ThreadId
     )
 /*++
@@ -1487,6 +1608,8 @@ Arguments:
 
     DataParams - Supplies the data position and layout of the matrices
 
+    TuningParameters - Optionally supplies the tuned strides through matrix B.
+
     ThreadId - Supplies the current index of the threaded operation.
 
 Return Value:
@@ -1540,7 +1663,8 @@ Return Value:
 
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
             K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc,
+            DataParams->OutputProcessor, RangeStartM);
 
     } else {
 
@@ -1549,7 +1673,8 @@ Return Value:
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc,
+            DataParams->OutputProcessor, RangeStartM, RangeStartN, TuningParameters);
     }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -1567,7 +1692,8 @@ MlasGemmBatch(
     size_t K,
     const MLAS_SGEMM_DATA_PARAMS* Data,
     size_t BatchSize,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_TUNING_PARAMETERS* TuningParameters
     )
 {
 
@@ -1578,10 +1704,20 @@ MlasGemmBatch(
 
     const double Complexity = double(M) * double(N) * double(K);
 
+    size_t ThreadComplexity = MLAS_SGEMM_THREAD_COMPLEXITY;
+    MLAS_SGEMM_THREAD_PARTITION Partition = MlasSgemmPartitionDefault;
+
+    if (TuningParameters != nullptr) {
+        if (TuningParameters->ThreadComplexity != 0) {
+            ThreadComplexity = TuningParameters->ThreadComplexity;
+        }
+        Partition = TuningParameters->Partition;
+    }
+
     ptrdiff_t TargetThreadCount;
 
-    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
-        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    if (Complexity < double(ThreadComplexity * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(ThreadComplexity)) + 1;
     } else {
         TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
     }
@@ -1603,7 +1739,7 @@ MlasGemmBatch(
     ptrdiff_t ThreadCountM;
     ptrdiff_t ThreadCountN;
 
-    if (N > M) {
+    if (Partition == MlasSgemmPartitionN || (Partition == MlasSgemmPartitionDefault && N > M)) {
 
         const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
             MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
@@ -1632,13 +1768,66 @@ MlasGemmBatch(
         ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
         ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
         MlasSgemmThreaded(ThreadCountM, ThreadCountN,
-            TransA, TransB, M, N, K, &(Data[GemmIdx]), ThreadIdx);
+            TransA, TransB, M, N, K, &(Data[GemmIdx]), TuningParameters, ThreadIdx);
     });
 }
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
 #endif
 
+const MLAS_SGEMM_TUNING_PARAMETERS*
+MLASCALL
+MlasSgemmTuningCandidates(
+    size_t* CandidateCount
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the blocking and threading parameters to search when
+    tuning a single precision GEMM for a class of problem shapes.
+
+    The candidates trade the N and K strides of the B panel at its fixed
+    size, scale the work assigned to each thread, and force the partitioning
+    of the operation across threads along either dimension. The first
+    candidate is the built-in heuristic.
+
+    N.B. The index of the fastest candidate is persisted by the tuning
+    results, so candidates must only be appended to this list.
+
+Arguments:
+
+    CandidateCount - Receives the number of candidates.
+
+Return Value:
+
+    Returns the array of candidates.
+
+--*/
+{
+    static const MLAS_SGEMM_TUNING_PARAMETERS Candidates[] = {
+        {0, 0, 0, MlasSgemmPartitionDefault},
+        {256, 64, 0, MlasSgemmPartitionDefault},
+        {64, 256, 0, MlasSgemmPartitionDefault},
+        {512, 32, 0, MlasSgemmPartitionDefault},
+        {32, 512, 0, MlasSgemmPartitionDefault},
+        {0, 0, 16 * 1024, MlasSgemmPartitionDefault},
+        {0, 0, 256 * 1024, MlasSgemmPartitionDefault},
+        {256, 64, 16 * 1024, MlasSgemmPartitionDefault},
+        {64, 256, 16 * 1024, MlasSgemmPartitionDefault},
+        {256, 64, 256 * 1024, MlasSgemmPartitionDefault},
+        {64, 256, 256 * 1024, MlasSgemmPartitionDefault},
+        {0, 0, 0, MlasSgemmPartitionM},
+        {0, 0, 0, MlasSgemmPartitionN},
+        {256, 64, 0, MlasSgemmPartitionM},
+        {64, 256, 0, MlasSgemmPartitionN},
+    };
+
+    *CandidateCount = sizeof(Candidates) / sizeof(Candidates[0]);
+
+    return Candidates;
+}
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
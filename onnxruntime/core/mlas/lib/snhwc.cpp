@@ -0,0 +1,395 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    snhwc.cpp
+
+Abstract:
+
+    This module implements the single precision convolution and pooling
+    routines for tensors in the NHWC layout.
+
+    The input pixels are addressed through an indirection buffer, so that no
+    image sized im2col buffer is built. The general convolution gathers the
+    pixels of a block of output rows into a thread local buffer sized to stay
+    in the cache, then multiplies the block by the packed filter.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of elements of the thread local buffer of the gathered
+// input pixels, and the minimum number of output rows of a block.
+//
+
+constexpr size_t MlasConvIndirectBufferElements = 16384;
+constexpr size_t MlasConvIndirectMinimumRowBlock = 16;
+
+void
+MLASCALL
+MlasConvIndirect(
+    const float* const* Input,
+    size_t InputOffset,
+    size_t InputChannels,
+    size_t KernelSize,
+    size_t OutputCount,
+    const void* PackedFilter,
+    size_t FilterCount,
+    float* Output,
+    size_t ldc,
+    float Beta,
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution of a range of output pixels in the
+    NHWC layout.
+
+Arguments:
+
+    Input - Supplies the indirection buffer of OutputCount x KernelSize input
+        pixels.
+
+    InputOffset - Supplies the offset of the channels of the group in each
+        input pixel.
+
+    InputChannels - Supplies the number of input channels of the group.
+
+    KernelSize - Supplies the number of elements of the kernel.
+
+    OutputCount - Supplies the number of output pixels.
+
+    PackedFilter - Supplies the filter packed by MlasGemmPackB as a matrix of
+        KernelSize x InputChannels rows and FilterCount columns.
+
+    FilterCount - Supplies the number of filters of the group.
+
+    Output - Supplies the address of the first output pixel.
+
+    ldc - Supplies the number of elements between output pixels.
+
+    Beta - Supplies the multiplier of the existing output.
+
+    OutputProcessor - Optionally supplies the processor of each tile of the
+        output, after its last K slice.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t K = KernelSize * InputChannels;
+    const size_t AlignedN = (FilterCount + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    //
+    // Size the block of output rows to the thread local buffer, but keep
+    // enough rows for the SGEMM kernels.
+    //
+
+    size_t RowBlock = std::max(MlasConvIndirectBufferElements / K, MlasConvIndirectMinimumRowBlock);
+    RowBlock = std::min(RowBlock, OutputCount);
+
+    MlasThreadedBufAlloc(RowBlock * K * sizeof(float));
+    float* A = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    size_t CountM;
+
+    for (size_t m = 0; m < OutputCount; m += CountM) {
+
+        CountM = std::min(OutputCount - m, RowBlock);
+
+        //
+        // Gather the input pixels of the block of output rows.
+        //
+
+        const float* const* input = Input + m * KernelSize;
+        float* a = A;
+
+        for (size_t i = 0; i < CountM * KernelSize; i++) {
+            std::copy_n(input[i] + InputOffset, InputChannels, a);
+            a += InputChannels;
+        }
+
+        MlasSgemmPackedOperation(CblasNoTrans, CountM, 0, FilterCount, K, 1.0f, A, K, PackedFilter, AlignedN,
+                                 Beta, Output + m * ldc, ldc, OutputProcessor, m);
+    }
+}
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    float Beta,
+    const MLAS_GEMM_POSTPROCESSOR<float>* PostProc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the depthwise convolution of a range of output
+    pixels in the NHWC layout.
+
+Arguments:
+
+    Input - Supplies the indirection buffer of OutputCount x KernelSize input
+        pixels.
+
+    Filter - Supplies the filter in the KernelSize x Channels layout.
+
+    Output - Supplies the address of the first output pixel.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output pixels.
+
+    KernelSize - Supplies the number of elements of the kernel.
+
+    Beta - Supplies the multiplier of the existing output.
+
+    PostProc - Optionally supplies the processor of the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 BetaBroadcast = MlasBroadcastFloat32x4(Beta);
+    float* output = Output;
+
+    for (size_t i = 0; i < OutputCount; i++) {
+
+        const float* const* input = Input + i * KernelSize;
+        size_t c = 0;
+
+        for (; c + 16 <= Channels; c += 16) {
+
+            MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator2 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator3 = MlasZeroFloat32x4();
+
+            if (Beta != 0.0f) {
+                Accumulator0 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(output + c), BetaBroadcast);
+                Accumulator1 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(output + c + 4), BetaBroadcast);
+                Accumulator2 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(output + c + 8), BetaBroadcast);
+                Accumulator3 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(output + c + 12), BetaBroadcast);
+            }
+
+            const float* filter = Filter + c;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                const float* in = input[k] + c;
+                Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(in), MlasLoadFloat32x4(filter), Accumulator0);
+                Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(in + 4), MlasLoadFloat32x4(filter + 4), Accumulator1);
+                Accumulator2 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(in + 8), MlasLoadFloat32x4(filter + 8), Accumulator2);
+                Accumulator3 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(in + 12), MlasLoadFloat32x4(filter + 12), Accumulator3);
+                filter += Channels;
+            }
+
+            MlasStoreFloat32x4(output + c, Accumulator0);
+            MlasStoreFloat32x4(output + c + 4, Accumulator1);
+            MlasStoreFloat32x4(output + c + 8, Accumulator2);
+            MlasStoreFloat32x4(output + c + 12, Accumulator3);
+        }
+
+        for (; c + 4 <= Channels; c += 4) {
+
+            MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+            if (Beta != 0.0f) {
+                Accumulator = MlasMultiplyFloat32x4(MlasLoadFloat32x4(output + c), BetaBroadcast);
+            }
+
+            const float* filter = Filter + c;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input[k] + c), MlasLoadFloat32x4(filter), Accumulator);
+                filter += Channels;
+            }
+
+            MlasStoreFloat32x4(output + c, Accumulator);
+        }
+
+        for (; c < Channels; c++) {
+
+            float Accumulator = (Beta != 0.0f) ? output[c] * Beta : 0.0f;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                Accumulator += input[k][c] * Filter[k * Channels + c];
+            }
+
+            output[c] = Accumulator;
+        }
+
+        output += Channels;
+    }
+
+    if (PostProc != nullptr) {
+        PostProc->Process(Output, 0, 0, OutputCount, Channels, Channels);
+    }
+}
+
+struct MLAS_NHWC_MAXIMUM_POOLING {
+
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 InitialVector() { return MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest()); }
+
+    static MLAS_FORCEINLINE float InitialValue() { return std::numeric_limits<float>::lowest(); }
+
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2) { return MlasMaximumFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE float Reduce(float Value1, float Value2) { return std::max(Value1, Value2); }
+
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Finalize(MLAS_FLOAT32X4 Vector, size_t Count)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Count);
+        return Vector;
+    }
+
+    static MLAS_FORCEINLINE float Finalize(float Value, size_t Count)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Count);
+        return Value;
+    }
+};
+
+struct MLAS_NHWC_AVERAGE_POOLING {
+
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 InitialVector() { return MlasZeroFloat32x4(); }
+
+    static MLAS_FORCEINLINE float InitialValue() { return 0.0f; }
+
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2) { return MlasAddFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE float Reduce(float Value1, float Value2) { return Value1 + Value2; }
+
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Finalize(MLAS_FLOAT32X4 Vector, size_t Count)
+    {
+        return MlasMultiplyFloat32x4(Vector, MlasBroadcastFloat32x4(1.0f / float(Count)));
+    }
+
+    static MLAS_FORCEINLINE float Finalize(float Value, size_t Count) { return Value / float(Count); }
+};
+
+template<typename PoolingType>
+void
+MlasNhwcPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the pooling of a range of output pixels in the
+    NHWC layout.
+
+Arguments:
+
+    Input - Supplies the indirection buffer of OutputCount x KernelSize input
+        pixels. Null entries are skipped.
+
+    Output - Supplies the address of the first output pixel.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output pixels.
+
+    KernelSize - Supplies the number of elements of the kernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t i = 0; i < OutputCount; i++) {
+
+        const float* const* input = Input + i * KernelSize;
+
+        size_t Count = 0;
+
+        for (size_t k = 0; k < KernelSize; k++) {
+            Count += (input[k] != nullptr) ? 1 : 0;
+        }
+
+        //
+        // A window entirely in the padding has no input pixel: use a single
+        // element count so that the average is the initial value.
+        //
+
+        Count = std::max(Count, size_t(1));
+
+        size_t c = 0;
+
+        for (; c + 4 <= Channels; c += 4) {
+
+            MLAS_FLOAT32X4 Accumulator = PoolingType::InitialVector();
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                if (input[k] != nullptr) {
+                    Accumulator = PoolingType::Reduce(Accumulator, MlasLoadFloat32x4(input[k] + c));
+                }
+            }
+
+            MlasStoreFloat32x4(Output + c, PoolingType::Finalize(Accumulator, Count));
+        }
+
+        for (; c < Channels; c++) {
+
+            float Accumulator = PoolingType::InitialValue();
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                if (input[k] != nullptr) {
+                    Accumulator = PoolingType::Reduce(Accumulator, input[k][c]);
+                }
+            }
+
+            Output[c] = PoolingType::Finalize(Accumulator, Count);
+        }
+
+        Output += Channels;
+    }
+}
+
+void
+MLASCALL
+MlasNhwcMaxPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasNhwcPool<MLAS_NHWC_MAXIMUM_POOLING>(Input, Output, Channels, OutputCount, KernelSize);
+}
+
+void
+MLASCALL
+MlasNhwcAvgPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasNhwcPool<MLAS_NHWC_AVERAGE_POOLING>(Input, Output, Channels, OutputCount, KernelSize);
+}
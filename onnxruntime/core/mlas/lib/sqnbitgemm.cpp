@@ -0,0 +1,415 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm.cpp
+
+Abstract:
+
+    This module implements the fp32 matrix multiplication with a blockwise
+    n-bit quantized right hand side (SQNBitGemm).
+
+    A single row of A is multiplied directly with the quantized data of B,
+    which is the memory bound case of token generation. More rows of A are
+    computed with the SGEMM kernel from slices of B dequantized to the thread
+    local buffer. With CompInt8, the rows of A are quantized to int8 per block
+    of B and all rows are computed with the int8 kernel.
+
+--*/
+
+#include "sqnbitgemm.h"
+
+namespace
+{
+
+constexpr size_t MlasSQNBitGemmStrideN = 128;
+constexpr size_t MlasSQNBitGemmStrideK = 256;
+
+/**
+ * @brief Returns the size of the quantized data of one row of A with CompInt8:
+ *        the int8 values, the scales and the sums of the blocks.
+ */
+size_t
+MlasSQNBitGemmQuantARowSize(
+    size_t BlockCountK,
+    size_t BlkLen
+    )
+{
+    return UpAlignSize(BlockCountK * BlkLen) + BlockCountK * (sizeof(float) + sizeof(int32_t));
+}
+
+bool
+MlasSQNBitGemmIsSupported(
+    size_t BlkBitWidth,
+    size_t BlkLen
+    )
+{
+    switch (BlkBitWidth) {
+        case 2:
+        case 3:
+        case 4:
+        case 8:
+            break;
+        default:
+            return false;
+    }
+
+    switch (BlkLen) {
+        case 16:
+        case 32:
+        case 64:
+        case 128:
+        case 256:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Quantizes one row of A to int8 per block, with the scale of the
+ *        block from its absolute maximum.
+ */
+void
+MlasSQNBitGemmQuantizeARow(
+    const float* A,
+    size_t K,
+    size_t BlkLen,
+    size_t BlockCountK,
+    uint8_t* QuantARow
+    )
+{
+    int8_t* QuantA = reinterpret_cast<int8_t*>(QuantARow);
+    float* QuantAScale = reinterpret_cast<float*>(QuantARow + UpAlignSize(BlockCountK * BlkLen));
+    int32_t* QuantASum = reinterpret_cast<int32_t*>(QuantAScale + BlockCountK);
+
+    for (size_t kb = 0; kb < BlockCountK; kb++) {
+
+        const size_t k = kb * BlkLen;
+        const size_t CountK = std::min(K - k, BlkLen);
+
+        float AbsMax = 0.0f;
+
+        for (size_t i = 0; i < CountK; i++) {
+            AbsMax = std::max(AbsMax, std::fabs(A[k + i]));
+        }
+
+        const float Scale = AbsMax / 127.0f;
+        const float ReciprocalScale = (Scale != 0.0f) ? 1.0f / Scale : 0.0f;
+
+        int32_t Sum = 0;
+
+        for (size_t i = 0; i < CountK; i++) {
+            const int32_t q = int32_t(std::nearbyintf(A[k + i] * ReciprocalScale));
+            QuantA[k + i] = int8_t(std::min(std::max(q, -127), 127));
+            Sum += QuantA[k + i];
+        }
+
+        std::fill_n(QuantA + k + CountK, BlkLen - CountK, int8_t(0));
+
+        QuantAScale[kb] = Scale;
+        QuantASum[kb] = Sum;
+    }
+}
+
+void
+MlasSQNBitGemmAddBias(
+    const float* Bias,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+{
+    for (size_t m = 0; m < CountM; m++) {
+        for (size_t n = 0; n < CountN; n++) {
+            C[m * ldc + n] += Bias[n];
+        }
+    }
+}
+
+void
+MlasSQNBitGemmInt8Operation(
+    const MLAS_SQNBIT_GEMM_DISPATCH* Dispatch,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const MLAS_SQNBIT_GEMM_DATA_PARAMS* DataParams,
+    const uint8_t* QuantA,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+{
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const size_t QuantARowSize = MlasSQNBitGemmQuantARowSize(BlockCountK, BlkLen);
+    const float* Bias = (DataParams->Bias != nullptr) ? DataParams->Bias + RangeStartN : nullptr;
+
+    for (size_t m = RangeStartM; m < RangeStartM + RangeCountM; m++) {
+
+        const uint8_t* QuantARow = QuantA + m * QuantARowSize;
+        const float* QuantAScale = reinterpret_cast<const float*>(QuantARow + UpAlignSize(BlockCountK * BlkLen));
+        const int32_t* QuantASum = reinterpret_cast<const int32_t*>(QuantAScale + BlockCountK);
+
+        Dispatch->Int8Kernel(BlkBitWidth, BlkLen,
+                             reinterpret_cast<const int8_t*>(QuantARow), QuantAScale, QuantASum,
+                             static_cast<const uint8_t*>(DataParams->QuantBData),
+                             DataParams->QuantBScale,
+                             static_cast<const uint8_t*>(DataParams->QuantBZeroPoint),
+                             DataParams->C + m * DataParams->ldc + RangeStartN,
+                             RangeStartN, RangeCountN, BlockCountK, Bias);
+    }
+}
+
+void
+MlasSQNBitGemmFp32Operation(
+    const MLAS_SQNBIT_GEMM_DISPATCH* Dispatch,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const MLAS_SQNBIT_GEMM_DATA_PARAMS* DataParams,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+{
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const size_t lda = DataParams->lda;
+    const size_t ldc = DataParams->ldc;
+
+    const float* A = DataParams->A + RangeStartM * lda;
+    const uint8_t* QuantBData = static_cast<const uint8_t*>(DataParams->QuantBData);
+    const uint8_t* QuantBZeroPoint = static_cast<const uint8_t*>(DataParams->QuantBZeroPoint);
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+    const float* Bias = (DataParams->Bias != nullptr) ? DataParams->Bias + RangeStartN : nullptr;
+
+    if (RangeCountM == 1) {
+
+        //
+        // The kernel reads whole blocks of A, copy the row to the thread local
+        // buffer if the last block is partial.
+        //
+
+        if (K % BlkLen != 0) {
+            MlasThreadedBufAlloc(BlockCountK * BlkLen * sizeof(float));
+            float* PaddedA = reinterpret_cast<float*>(ThreadedBufHolder.get());
+            std::copy_n(A, K, PaddedA);
+            std::fill_n(PaddedA + K, BlockCountK * BlkLen - K, 0.0f);
+            A = PaddedA;
+        }
+
+        Dispatch->Fp32GemvKernel(BlkBitWidth, BlkLen, A, QuantBData, DataParams->QuantBScale,
+                                 QuantBZeroPoint, C, RangeStartN, RangeCountN, BlockCountK, Bias);
+        return;
+    }
+
+    //
+    // The slices of B along K are multiples of the block length, so that each
+    // block is dequantized with a single scale and zero point.
+    //
+
+    const size_t StrideK = std::max(MlasSQNBitGemmStrideK / BlkLen, size_t(1)) * BlkLen;
+
+    MlasThreadedBufAlloc(StrideK * MlasSQNBitGemmStrideN * sizeof(float));
+    float* PackedB = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    size_t CountN;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+        CountN = std::min(RangeCountN - n, MlasSQNBitGemmStrideN);
+
+        size_t CountK;
+        for (size_t k = 0; k < K; k += CountK) {
+            CountK = std::min(K - k, StrideK);
+
+            Dispatch->DequantBKernel(BlkBitWidth, BlkLen, PackedB, QuantBData, DataParams->QuantBScale,
+                                     QuantBZeroPoint, RangeStartN + n, CountN, k, CountK, BlockCountK);
+
+            const float* a = A + k;
+            float* c = C + n;
+
+            size_t RowsRemaining = RangeCountM;
+            while (RowsRemaining > 0) {
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_POWER)
+                size_t RowsHandled = GetMlasPlatform().GemmFloatKernel(
+                    a, PackedB, c, CountK, RowsRemaining, CountN, lda, ldc, 1.0f, k == 0);
+#else
+                size_t RowsHandled = (k == 0) ?
+                    MlasSgemmKernelZero(a, PackedB, c, CountK, RowsRemaining, CountN, lda, ldc, 1.0f) :
+                    MlasSgemmKernelAdd(a, PackedB, c, CountK, RowsRemaining, CountN, lda, ldc, 1.0f);
+#endif
+
+                c += ldc * RowsHandled;
+                a += lda * RowsHandled;
+                RowsRemaining -= RowsHandled;
+            }
+        }
+
+        if (Bias != nullptr) {
+            MlasSQNBitGemmAddBias(Bias + n, C + n, RangeCountM, CountN, ldc);
+        }
+    }
+}
+
+}  // namespace
+
+bool MLASCALL
+MlasIsSQNBitGemmAvailable(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType
+    )
+{
+    const auto* Dispatch = GetMlasPlatform().SQNBitGemmDispatch;
+
+    if (Dispatch == nullptr || !MlasSQNBitGemmIsSupported(BlkBitWidth, BlkLen)) {
+        return false;
+    }
+
+    switch (ComputeType) {
+        case CompFp32:
+            return Dispatch->Fp32GemvKernel != nullptr && Dispatch->DequantBKernel != nullptr;
+        case CompInt8:
+            return Dispatch->Int8Kernel != nullptr;
+        default:
+            return false;
+    }
+}
+
+size_t MLASCALL
+MlasSQNBitGemmBatchWorkspaceSize(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(BlkBitWidth);
+
+    if (ComputeType != CompInt8) {
+        return 0;
+    }
+
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+
+    return M * BatchN * MlasSQNBitGemmQuantARowSize(BlockCountK, BlkLen);
+}
+
+void MLASCALL
+MlasSQNBitGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType,
+    const MLAS_SQNBIT_GEMM_DATA_PARAMS* DataParams,
+    void* Workspace,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const auto* Dispatch = GetMlasPlatform().SQNBitGemmDispatch;
+
+    if (!MlasIsSQNBitGemmAvailable(BlkBitWidth, BlkLen, ComputeType)) {
+        MLAS_THROW_EX(std::invalid_argument, "SQNBitGemm is not available for the given parameters");
+    }
+
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const size_t QuantARowSize = MlasSQNBitGemmQuantARowSize(BlockCountK, BlkLen);
+    uint8_t* QuantA = static_cast<uint8_t*>(Workspace);
+
+    if (ComputeType == CompInt8) {
+        MlasTrySimpleParallel(ThreadPool, ptrdiff_t(M * BatchN), [&](ptrdiff_t tid) {
+            const size_t gemm_i = size_t(tid) / M;
+            const size_t m = size_t(tid) % M;
+            const auto* Data = &DataParams[gemm_i];
+            MlasSQNBitGemmQuantizeARow(Data->A + m * Data->lda, K, BlkLen, BlockCountK,
+                                       QuantA + size_t(tid) * QuantARowSize);
+        });
+    }
+
+    const auto Operation = [&](size_t gemm_i, size_t RangeStartM, size_t RangeCountM,
+                               size_t RangeStartN, size_t RangeCountN) {
+        const auto* Data = &DataParams[gemm_i];
+        if (ComputeType == CompInt8) {
+            MlasSQNBitGemmInt8Operation(Dispatch, K, BlkBitWidth, BlkLen, Data,
+                                        QuantA + gemm_i * M * QuantARowSize,
+                                        RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        } else {
+            MlasSQNBitGemmFp32Operation(Dispatch, K, BlkBitWidth, BlkLen, Data,
+                                        RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        }
+    };
+
+    if (ThreadPool == nullptr) {
+        for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
+            Operation(gemm_i, 0, M, 0, N);
+        }
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool) * 8;
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    ptrdiff_t ThreadsPerGemm = TargetThreadCount / BatchN;
+    if (ThreadsPerGemm < 1) {
+        ThreadsPerGemm = 1;
+    }
+
+    constexpr size_t StrideM = 128;
+
+    size_t nc = N;
+    if (ThreadsPerGemm > 1) {
+        // more than one thread per GEMM
+
+        const size_t BlockedM = MlasDivRoundup(M, StrideM);
+        const size_t max_nc = MlasDivRoundup(N * BlockedM, ThreadsPerGemm);
+        if (max_nc < nc) {
+            nc = std::min(nc, MlasDivRoundup(max_nc, MLAS_QGEMM_STRIDEN_THREAD_ALIGN) *
+                                  MLAS_QGEMM_STRIDEN_THREAD_ALIGN);
+        }
+    }
+    const size_t StrideN = nc;
+
+    const size_t ThreadCountM = MlasDivRoundup(M, StrideM);
+    const size_t ThreadCountN = MlasDivRoundup(N, StrideN);
+    ThreadsPerGemm = ThreadCountM * ThreadCountN;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
+        const auto gemm_i = tid / ThreadsPerGemm;
+        const auto blk_i = tid % ThreadsPerGemm;
+
+        const ptrdiff_t ThreadIdN = blk_i / ThreadCountM;
+        const ptrdiff_t ThreadIdM = blk_i % ThreadCountM;
+
+        const size_t RangeStartM = ThreadIdM * StrideM;
+        const size_t RangeCountM = std::min(M - RangeStartM, (size_t)StrideM);
+
+        const size_t RangeStartN = ThreadIdN * StrideN;
+        const size_t RangeCountN = std::min(N - RangeStartN, (size_t)StrideN);
+
+        Operation(size_t(gemm_i), RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+    });
+}
@@ -0,0 +1,185 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm.h
+
+Abstract:
+
+    This module defines the kernel interface of the fp32 matrix
+    multiplication with a blockwise n-bit quantized right hand side.
+
+    The kernels address quantized B in the layout documented in
+    mlas_qnbit.h, from the base of the matrix and the first column of the
+    range they compute.
+
+--*/
+
+#pragma once
+
+#include <cstring>
+
+#include "mlas_qnbit.h"
+#include "mlasi.h"
+
+/**
+ * @brief Returns the number of bytes of the data of one block.
+ */
+constexpr
+size_t
+MlasQNBitBlkDataSize(
+    size_t BlkBitWidth,
+    size_t BlkLen
+    )
+{
+    return BlkLen * BlkBitWidth / 8;
+}
+
+/**
+ * @brief Returns the zero point of the block with the given index, which is
+ *        n * BlockCountK + k / BlkLen.
+ */
+MLAS_FORCEINLINE
+uint8_t
+MlasQNBitZeroPoint(
+    const uint8_t* QuantBZeroPoint,
+    size_t BlkBitWidth,
+    size_t BlockIndex
+    )
+{
+    if (QuantBZeroPoint == nullptr) {
+        return uint8_t(1u << (BlkBitWidth - 1));
+    }
+    if (BlkBitWidth > 4) {
+        return QuantBZeroPoint[BlockIndex];
+    }
+    const uint8_t ZeroPoints = QuantBZeroPoint[BlockIndex / 2];
+    return (BlockIndex & 1) ? (ZeroPoints >> 4) : (ZeroPoints & 0x0F);
+}
+
+/**
+ * @brief Returns the quantized value i of a block.
+ */
+MLAS_FORCEINLINE
+uint8_t
+MlasQNBitValue(
+    const uint8_t* BlkData,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    size_t i
+    )
+{
+    switch (BlkBitWidth) {
+        case 2:
+            return (BlkData[i / 4] >> (2 * (i % 4))) & 0x03;
+        case 3:
+            return ((BlkData[BlkLen / 8 + i / 4] >> (2 * (i % 4))) & 0x03) |
+                   (((BlkData[i / 8] >> (i % 8)) & 0x01) << 2);
+        case 4:
+            return (BlkData[i / 2] >> (4 * (i % 2))) & 0x0F;
+        default:
+            return BlkData[i];
+    }
+}
+
+/**
+ * @brief Computes one row of C = A * B + Bias for a range of columns,
+ *        multiplying with the quantized data of B.
+ *
+ * @param BlkBitWidth       Number of bits of a quantized value
+ * @param BlkLen            Number of values of a block
+ * @param A                 Address of the row of A, zero padded to
+ *                          BlockCountK * BlkLen values
+ * @param QuantBData        Address of the quantized data of B
+ * @param QuantBScale       Address of the scales of B
+ * @param QuantBZeroPoint   Address of the zero points of B, or nullptr
+ * @param C                 Address of the first column of the row of C
+ * @param StartN            First column of the range
+ * @param CountN            Number of columns of the range
+ * @param BlockCountK       Number of blocks along K
+ * @param Bias              Address of the bias for the first column, or nullptr
+ */
+typedef
+void
+(MLAS_SQNBIT_GEMM_FP32_GEMV_KERNEL)(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    );
+
+/**
+ * @brief Dequantizes a slice of B to the packed layout of the SGEMM kernels:
+ *        columns of 16 elements are made contiguous and the last columns are
+ *        zero padded to 16.
+ *
+ * @param StartK            First row of the slice, a multiple of BlkLen
+ * @param CountK            Number of rows of the slice
+ */
+typedef
+void
+(MLAS_SQNBIT_GEMM_DEQUANT_B_KERNEL)(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    float* PackedB,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t StartN,
+    size_t CountN,
+    size_t StartK,
+    size_t CountK,
+    size_t BlockCountK
+    );
+
+/**
+ * @brief Computes one row of C = A * B + Bias for a range of columns from
+ *        the row of A quantized to int8 per block.
+ *
+ * @param QuantA            Address of the int8 row of A, zero padded to
+ *                          BlockCountK * BlkLen values
+ * @param QuantAScale       Address of the scales of the blocks of A
+ * @param QuantASum         Address of the sums of the int8 values of the
+ *                          blocks of A
+ */
+typedef
+void
+(MLAS_SQNBIT_GEMM_INT8_KERNEL)(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const int8_t* QuantA,
+    const float* QuantAScale,
+    const int32_t* QuantASum,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    );
+
+struct MLAS_SQNBIT_GEMM_DISPATCH {
+    MLAS_SQNBIT_GEMM_FP32_GEMV_KERNEL* Fp32GemvKernel;
+    MLAS_SQNBIT_GEMM_DEQUANT_B_KERNEL* DequantBKernel;
+    MLAS_SQNBIT_GEMM_INT8_KERNEL* Int8Kernel;
+};
+
+//
+// The AVX2 kernels are shared by the dispatches of the processors with VNNI.
+//
+
+MLAS_SQNBIT_GEMM_FP32_GEMV_KERNEL MlasSQNBitGemmFp32GemvKernelAvx2;
+MLAS_SQNBIT_GEMM_DEQUANT_B_KERNEL MlasSQNBitGemmDequantBKernelAvx2;
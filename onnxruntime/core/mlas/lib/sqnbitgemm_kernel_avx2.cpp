@@ -0,0 +1,313 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the n-bit quantized GEMM kernels for AVX2.
+
+    The int8 kernel multiplies the unsigned quantized values with the signed
+    values of A with VPMADDUBSW. 8 bit values are offset by 128 and the sign
+    of A is moved to them first, so that the pairs of products cannot
+    saturate.
+
+--*/
+
+#include "sqnbitgemm_kernel_avx_common.h"
+
+template<size_t BlkBitWidth, size_t NCols>
+MLAS_FORCEINLINE
+void
+MlasSQNBitGemmFp32GemvComputeColumnsAvx2(
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t n,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSize(BlkBitWidth, BlkLen);
+
+    __m256 Acc[NCols];
+
+    for (size_t c = 0; c < NCols; c++) {
+        Acc[c] = _mm256_setzero_ps();
+    }
+
+    for (size_t kb = 0; kb < BlockCountK; kb++) {
+
+        const float* a = A + kb * BlkLen;
+
+        const uint8_t* Data[NCols];
+        __m256 BlkAcc[NCols];
+        __m256 SumA = _mm256_setzero_ps();
+
+        for (size_t c = 0; c < NCols; c++) {
+            Data[c] = QuantBData + ((n + c) * BlockCountK + kb) * BlkDataSize;
+            BlkAcc[c] = _mm256_setzero_ps();
+        }
+
+        for (size_t j = 0; j < BlkLen; j += 16) {
+
+            const __m256 a0 = _mm256_loadu_ps(a + j);
+            const __m256 a1 = _mm256_loadu_ps(a + j + 8);
+            SumA = _mm256_add_ps(SumA, _mm256_add_ps(a0, a1));
+
+            for (size_t c = 0; c < NCols; c++) {
+                const __m128i u = MlasQNBitUnpack16<BlkBitWidth>(Data[c], BlkLen, j);
+                const __m256 b0 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(u));
+                const __m256 b1 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(u, 8)));
+                BlkAcc[c] = _mm256_fmadd_ps(a0, b0, BlkAcc[c]);
+                BlkAcc[c] = _mm256_fmadd_ps(a1, b1, BlkAcc[c]);
+            }
+        }
+
+        //
+        // scale * sum(a * (b - zp)) = scale * (sum(a * b) - zp * sum(a))
+        //
+
+        for (size_t c = 0; c < NCols; c++) {
+            const size_t BlockIndex = (n + c) * BlockCountK + kb;
+            const __m256 ZeroPoint = _mm256_set1_ps(float(MlasQNBitZeroPoint(QuantBZeroPoint, BlkBitWidth, BlockIndex)));
+            BlkAcc[c] = _mm256_fnmadd_ps(SumA, ZeroPoint, BlkAcc[c]);
+            Acc[c] = _mm256_fmadd_ps(BlkAcc[c], _mm256_set1_ps(QuantBScale[BlockIndex]), Acc[c]);
+        }
+    }
+
+    for (size_t c = 0; c < NCols; c++) {
+        C[c] = MlasQNBitReduceAdd(Acc[c]) + ((Bias != nullptr) ? Bias[c] : 0.0f);
+    }
+}
+
+template<size_t BlkBitWidth>
+void
+MlasSQNBitGemmFp32GemvAvx2(
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    constexpr size_t NCols = 4;
+
+    size_t n = 0;
+
+    for (; n + NCols <= CountN; n += NCols) {
+        MlasSQNBitGemmFp32GemvComputeColumnsAvx2<BlkBitWidth, NCols>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+            C + n, StartN + n, BlockCountK, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+
+    for (; n < CountN; n++) {
+        MlasSQNBitGemmFp32GemvComputeColumnsAvx2<BlkBitWidth, 1>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+            C + n, StartN + n, BlockCountK, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+}
+
+void
+MlasSQNBitGemmFp32GemvKernelAvx2(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    switch (BlkBitWidth) {
+        case 2:
+            MlasSQNBitGemmFp32GemvAvx2<2>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+                                          C, StartN, CountN, BlockCountK, Bias);
+            break;
+        case 3:
+            MlasSQNBitGemmFp32GemvAvx2<3>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+                                          C, StartN, CountN, BlockCountK, Bias);
+            break;
+        case 4:
+            MlasSQNBitGemmFp32GemvAvx2<4>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+                                          C, StartN, CountN, BlockCountK, Bias);
+            break;
+        default:
+            MlasSQNBitGemmFp32GemvAvx2<8>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+                                          C, StartN, CountN, BlockCountK, Bias);
+            break;
+    }
+}
+
+template<size_t BlkBitWidth>
+void
+MlasSQNBitGemmDequantBAvx2(
+    size_t BlkLen,
+    float* PackedB,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t StartN,
+    size_t CountN,
+    size_t StartK,
+    size_t CountK,
+    size_t BlockCountK
+    )
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSize(BlkBitWidth, BlkLen);
+    const size_t StartBlock = StartK / BlkLen;
+
+    MLAS_DECLSPEC_ALIGN(float Values[16], 32);
+
+    for (size_t n = 0; n < CountN; n += 16) {
+
+        const size_t CountColumns = std::min(CountN - n, size_t(16));
+
+        for (size_t c = 0; c < 16; c++) {
+
+            float* d = PackedB + c;
+
+            if (c >= CountColumns) {
+                for (size_t k = 0; k < CountK; k++) {
+                    d[k * 16] = 0.0f;
+                }
+                continue;
+            }
+
+            for (size_t k = 0; k < CountK; k += BlkLen) {
+
+                const size_t BlockIndex = (StartN + n + c) * BlockCountK + StartBlock + k / BlkLen;
+                const uint8_t* Data = QuantBData + BlockIndex * BlkDataSize;
+                const __m256 Scale = _mm256_set1_ps(QuantBScale[BlockIndex]);
+                const __m256 ZeroPoint = _mm256_set1_ps(float(MlasQNBitZeroPoint(QuantBZeroPoint, BlkBitWidth, BlockIndex)));
+                const size_t CountBlkK = std::min(CountK - k, BlkLen);
+
+                for (size_t j = 0; j < CountBlkK; j += 16) {
+
+                    const __m128i u = MlasQNBitUnpack16<BlkBitWidth>(Data, BlkLen, j);
+                    const __m256 b0 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(u));
+                    const __m256 b1 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(u, 8)));
+                    _mm256_store_ps(Values, _mm256_mul_ps(_mm256_sub_ps(b0, ZeroPoint), Scale));
+                    _mm256_store_ps(Values + 8, _mm256_mul_ps(_mm256_sub_ps(b1, ZeroPoint), Scale));
+
+                    const size_t CountValues = std::min(CountBlkK - j, size_t(16));
+
+                    for (size_t i = 0; i < CountValues; i++) {
+                        d[(k + j + i) * 16] = Values[i];
+                    }
+                }
+            }
+        }
+
+        PackedB += CountK * 16;
+    }
+}
+
+void
+MlasSQNBitGemmDequantBKernelAvx2(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    float* PackedB,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t StartN,
+    size_t CountN,
+    size_t StartK,
+    size_t CountK,
+    size_t BlockCountK
+    )
+{
+    switch (BlkBitWidth) {
+        case 2:
+            MlasSQNBitGemmDequantBAvx2<2>(BlkLen, PackedB, QuantBData, QuantBScale, QuantBZeroPoint,
+                                          StartN, CountN, StartK, CountK, BlockCountK);
+            break;
+        case 3:
+            MlasSQNBitGemmDequantBAvx2<3>(BlkLen, PackedB, QuantBData, QuantBScale, QuantBZeroPoint,
+                                          StartN, CountN, StartK, CountK, BlockCountK);
+            break;
+        case 4:
+            MlasSQNBitGemmDequantBAvx2<4>(BlkLen, PackedB, QuantBData, QuantBScale, QuantBZeroPoint,
+                                          StartN, CountN, StartK, CountK, BlockCountK);
+            break;
+        default:
+            MlasSQNBitGemmDequantBAvx2<8>(BlkLen, PackedB, QuantBData, QuantBScale, QuantBZeroPoint,
+                                          StartN, CountN, StartK, CountK, BlockCountK);
+            break;
+    }
+}
+
+struct MLAS_SQNBIT_GEMM_DOT_AVX2 {
+
+    template<size_t BlkBitWidth>
+    static constexpr uint8_t Offset() { return (BlkBitWidth == 8) ? 128 : 0; }
+
+    template<size_t BlkBitWidth>
+    static
+    MLAS_FORCEINLINE
+    __m256i
+    Dot(
+        __m256i Acc,
+        __m256i b,
+        __m256i a
+        )
+    {
+        __m256i Products;
+
+        if constexpr (BlkBitWidth == 8) {
+            const __m256i bs = _mm256_xor_si256(b, _mm256_set1_epi8(int8_t(0x80)));
+            Products = _mm256_maddubs_epi16(_mm256_abs_epi8(bs), _mm256_sign_epi8(a, bs));
+        } else {
+            Products = _mm256_maddubs_epi16(b, a);
+        }
+
+        return _mm256_add_epi32(Acc, _mm256_madd_epi16(Products, _mm256_set1_epi16(1)));
+    }
+};
+
+static
+void
+MlasSQNBitGemmInt8KernelAvx2(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const int8_t* QuantA,
+    const float* QuantAScale,
+    const int32_t* QuantASum,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    MlasSQNBitGemmInt8KernelAvxDispatch<MLAS_SQNBIT_GEMM_DOT_AVX2>(BlkBitWidth, BlkLen,
+        QuantA, QuantAScale, QuantASum, QuantBData, QuantBScale, QuantBZeroPoint,
+        C, StartN, CountN, BlockCountK, Bias);
+}
+
+const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx2 = {
+    MlasSQNBitGemmFp32GemvKernelAvx2,
+    MlasSQNBitGemmDequantBKernelAvx2,
+    MlasSQNBitGemmInt8KernelAvx2,
+};
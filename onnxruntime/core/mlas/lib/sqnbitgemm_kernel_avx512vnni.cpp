@@ -0,0 +1,203 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_avx512vnni.cpp
+
+Abstract:
+
+    This module implements the n-bit quantized GEMM kernels for AVX512-VNNI.
+
+    The fp32 kernel converts 16 quantized values at a time to one ZMM
+    register. The int8 kernel uses the 256-bit form of VPDPBUSD, which sums
+    the products of the unsigned quantized values and the signed values of A
+    without intermediate saturation, for all bit widths.
+
+--*/
+
+#include "sqnbitgemm_kernel_avx_common.h"
+
+template<size_t BlkBitWidth, size_t NCols>
+MLAS_FORCEINLINE
+void
+MlasSQNBitGemmFp32GemvComputeColumnsAvx512(
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t n,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSize(BlkBitWidth, BlkLen);
+
+    __m512 Acc[NCols];
+
+    for (size_t c = 0; c < NCols; c++) {
+        Acc[c] = _mm512_setzero_ps();
+    }
+
+    for (size_t kb = 0; kb < BlockCountK; kb++) {
+
+        const float* a = A + kb * BlkLen;
+
+        const uint8_t* Data[NCols];
+        __m512 BlkAcc[NCols];
+        __m512 SumA = _mm512_setzero_ps();
+
+        for (size_t c = 0; c < NCols; c++) {
+            Data[c] = QuantBData + ((n + c) * BlockCountK + kb) * BlkDataSize;
+            BlkAcc[c] = _mm512_setzero_ps();
+        }
+
+        for (size_t j = 0; j < BlkLen; j += 16) {
+
+            const __m512 av = _mm512_loadu_ps(a + j);
+            SumA = _mm512_add_ps(SumA, av);
+
+            for (size_t c = 0; c < NCols; c++) {
+                const __m512 bv = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(
+                    MlasQNBitUnpack16<BlkBitWidth>(Data[c], BlkLen, j)));
+                BlkAcc[c] = _mm512_fmadd_ps(av, bv, BlkAcc[c]);
+            }
+        }
+
+        //
+        // scale * sum(a * (b - zp)) = scale * (sum(a * b) - zp * sum(a))
+        //
+
+        for (size_t c = 0; c < NCols; c++) {
+            const size_t BlockIndex = (n + c) * BlockCountK + kb;
+            const __m512 ZeroPoint = _mm512_set1_ps(float(MlasQNBitZeroPoint(QuantBZeroPoint, BlkBitWidth, BlockIndex)));
+            BlkAcc[c] = _mm512_fnmadd_ps(SumA, ZeroPoint, BlkAcc[c]);
+            Acc[c] = _mm512_fmadd_ps(BlkAcc[c], _mm512_set1_ps(QuantBScale[BlockIndex]), Acc[c]);
+        }
+    }
+
+    for (size_t c = 0; c < NCols; c++) {
+        C[c] = _mm512_reduce_add_ps(Acc[c]) + ((Bias != nullptr) ? Bias[c] : 0.0f);
+    }
+}
+
+template<size_t BlkBitWidth>
+void
+MlasSQNBitGemmFp32GemvAvx512(
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    constexpr size_t NCols = 4;
+
+    size_t n = 0;
+
+    for (; n + NCols <= CountN; n += NCols) {
+        MlasSQNBitGemmFp32GemvComputeColumnsAvx512<BlkBitWidth, NCols>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+            C + n, StartN + n, BlockCountK, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+
+    for (; n < CountN; n++) {
+        MlasSQNBitGemmFp32GemvComputeColumnsAvx512<BlkBitWidth, 1>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+            C + n, StartN + n, BlockCountK, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+}
+
+static
+void
+MlasSQNBitGemmFp32GemvKernelAvx512(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    switch (BlkBitWidth) {
+        case 2:
+            MlasSQNBitGemmFp32GemvAvx512<2>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+                                            C, StartN, CountN, BlockCountK, Bias);
+            break;
+        case 3:
+            MlasSQNBitGemmFp32GemvAvx512<3>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+                                            C, StartN, CountN, BlockCountK, Bias);
+            break;
+        case 4:
+            MlasSQNBitGemmFp32GemvAvx512<4>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+                                            C, StartN, CountN, BlockCountK, Bias);
+            break;
+        default:
+            MlasSQNBitGemmFp32GemvAvx512<8>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint,
+                                            C, StartN, CountN, BlockCountK, Bias);
+            break;
+    }
+}
+
+struct MLAS_SQNBIT_GEMM_DOT_AVX512VNNI {
+
+    template<size_t BlkBitWidth>
+    static constexpr uint8_t Offset() { return 0; }
+
+    template<size_t BlkBitWidth>
+    static
+    MLAS_FORCEINLINE
+    __m256i
+    Dot(
+        __m256i Acc,
+        __m256i b,
+        __m256i a
+        )
+    {
+        return _mm256_dpbusd_epi32(Acc, b, a);
+    }
+};
+
+static
+void
+MlasSQNBitGemmInt8KernelAvx512Vnni(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const int8_t* QuantA,
+    const float* QuantAScale,
+    const int32_t* QuantASum,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    MlasSQNBitGemmInt8KernelAvxDispatch<MLAS_SQNBIT_GEMM_DOT_AVX512VNNI>(BlkBitWidth, BlkLen,
+        QuantA, QuantAScale, QuantASum, QuantBData, QuantBScale, QuantBZeroPoint,
+        C, StartN, CountN, BlockCountK, Bias);
+}
+
+const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512vnni = {
+    MlasSQNBitGemmFp32GemvKernelAvx512,
+    MlasSQNBitGemmDequantBKernelAvx2,
+    MlasSQNBitGemmInt8KernelAvx512Vnni,
+};
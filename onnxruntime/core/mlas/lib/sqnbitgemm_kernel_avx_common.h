@@ -0,0 +1,304 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_avx_common.h
+
+Abstract:
+
+    This module implements the parts of the n-bit quantized GEMM kernels that
+    are shared by the AVX2, AVX-VNNI and AVX512-VNNI implementations: the
+    unpacking of quantized values and the int8 kernel, which is specialized
+    with the instruction sequence of the int8 dot product.
+
+--*/
+
+#pragma once
+
+#include "sqnbitgemm.h"
+
+#include <immintrin.h>
+
+/**
+ * @brief Unpacks the quantized values j to j + 15 of a block to 16 bytes.
+ */
+template<size_t BlkBitWidth>
+MLAS_FORCEINLINE
+__m128i
+MlasQNBitUnpack16(
+    const uint8_t* BlkData,
+    size_t BlkLen,
+    size_t j
+    );
+
+MLAS_FORCEINLINE
+__m128i
+MlasQNBitUnpack16TwoBits(
+    const uint8_t* TwoBits
+    )
+{
+    uint32_t Bits;
+    std::memcpy(&Bits, TwoBits, sizeof(Bits));
+
+    const __m128i Mask = _mm_set1_epi8(0x03);
+    const __m128i v = _mm_cvtsi32_si128(int(Bits));
+
+    //
+    // Extract the four values of each byte to separate vectors, then
+    // interleave them back in order.
+    //
+
+    const __m128i v0 = _mm_and_si128(v, Mask);
+    const __m128i v1 = _mm_and_si128(_mm_srli_epi16(v, 2), Mask);
+    const __m128i v2 = _mm_and_si128(_mm_srli_epi16(v, 4), Mask);
+    const __m128i v3 = _mm_and_si128(_mm_srli_epi16(v, 6), Mask);
+
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(v0, v1), _mm_unpacklo_epi8(v2, v3));
+}
+
+template<>
+MLAS_FORCEINLINE
+__m128i
+MlasQNBitUnpack16<2>(
+    const uint8_t* BlkData,
+    size_t BlkLen,
+    size_t j
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(BlkLen);
+
+    return MlasQNBitUnpack16TwoBits(BlkData + j / 4);
+}
+
+template<>
+MLAS_FORCEINLINE
+__m128i
+MlasQNBitUnpack16<3>(
+    const uint8_t* BlkData,
+    size_t BlkLen,
+    size_t j
+    )
+{
+    uint16_t Bits;
+    std::memcpy(&Bits, BlkData + j / 8, sizeof(Bits));
+
+    //
+    // Broadcast each byte of the high bit plane to 8 bytes and test the bit
+    // of each value.
+    //
+
+    const __m128i BitMask = _mm_set1_epi64x(int64_t(0x8040201008040201ull));
+    const __m128i v = _mm_shuffle_epi8(_mm_cvtsi32_si128(int(Bits)),
+                                       _mm_set_epi64x(0x0101010101010101ll, 0));
+    const __m128i HighBit = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(v, BitMask), BitMask),
+                                          _mm_set1_epi8(0x04));
+
+    return _mm_or_si128(MlasQNBitUnpack16TwoBits(BlkData + BlkLen / 8 + j / 4), HighBit);
+}
+
+template<>
+MLAS_FORCEINLINE
+__m128i
+MlasQNBitUnpack16<4>(
+    const uint8_t* BlkData,
+    size_t BlkLen,
+    size_t j
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(BlkLen);
+
+    const __m128i Mask = _mm_set1_epi8(0x0F);
+    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(BlkData + j / 2));
+
+    return _mm_unpacklo_epi8(_mm_and_si128(v, Mask), _mm_and_si128(_mm_srli_epi16(v, 4), Mask));
+}
+
+template<>
+MLAS_FORCEINLINE
+__m128i
+MlasQNBitUnpack16<8>(
+    const uint8_t* BlkData,
+    size_t BlkLen,
+    size_t j
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(BlkLen);
+
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(BlkData + j));
+}
+
+MLAS_FORCEINLINE
+float
+MlasQNBitReduceAdd(
+    __m256 v
+    )
+{
+    __m128 x = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+    x = _mm_add_ss(x, _mm_movehdup_ps(x));
+    return _mm_cvtss_f32(x);
+}
+
+/**
+ * @brief Computes NCols columns of one row of the int8 kernel.
+ *
+ *        DotProduct::Dot accumulates the dot products of the unsigned values
+ *        of B minus DotProduct::Offset with the signed values of A, the
+ *        difference to the zero point is corrected with the sum of A.
+ */
+template<size_t BlkBitWidth, typename DotProduct, size_t NCols>
+MLAS_FORCEINLINE
+void
+MlasSQNBitGemmInt8ComputeColumns(
+    size_t BlkLen,
+    const int8_t* QuantA,
+    const float* QuantAScale,
+    const int32_t* QuantASum,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t n,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSize(BlkBitWidth, BlkLen);
+
+    __m256 Acc[NCols];
+    float Correction[NCols];
+
+    for (size_t c = 0; c < NCols; c++) {
+        Acc[c] = _mm256_setzero_ps();
+        Correction[c] = 0.0f;
+    }
+
+    for (size_t kb = 0; kb < BlockCountK; kb++) {
+
+        const int8_t* a = QuantA + kb * BlkLen;
+        const float ScaleA = QuantAScale[kb];
+        const int32_t SumA = QuantASum[kb];
+
+        const uint8_t* Data[NCols];
+        float Scale[NCols];
+        __m256i IntAcc[NCols];
+
+        for (size_t c = 0; c < NCols; c++) {
+            const size_t BlockIndex = (n + c) * BlockCountK + kb;
+            const int32_t ZeroPoint = MlasQNBitZeroPoint(QuantBZeroPoint, BlkBitWidth, BlockIndex);
+            Data[c] = QuantBData + BlockIndex * BlkDataSize;
+            Scale[c] = ScaleA * QuantBScale[BlockIndex];
+            Correction[c] += Scale[c] * float((int32_t(DotProduct::template Offset<BlkBitWidth>()) - ZeroPoint) * SumA);
+            IntAcc[c] = _mm256_setzero_si256();
+        }
+
+        if (BlkLen == 16) {
+
+            const __m256i av = _mm256_inserti128_si256(_mm256_setzero_si256(),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(a)), 0);
+
+            for (size_t c = 0; c < NCols; c++) {
+                const __m256i bv = _mm256_inserti128_si256(_mm256_setzero_si256(),
+                    MlasQNBitUnpack16<BlkBitWidth>(Data[c], BlkLen, 0), 0);
+                IntAcc[c] = DotProduct::template Dot<BlkBitWidth>(IntAcc[c], bv, av);
+            }
+
+        } else {
+
+            for (size_t j = 0; j < BlkLen; j += 32) {
+
+                const __m256i av = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + j));
+
+                for (size_t c = 0; c < NCols; c++) {
+                    const __m256i bv = _mm256_set_m128i(MlasQNBitUnpack16<BlkBitWidth>(Data[c], BlkLen, j + 16),
+                                                        MlasQNBitUnpack16<BlkBitWidth>(Data[c], BlkLen, j));
+                    IntAcc[c] = DotProduct::template Dot<BlkBitWidth>(IntAcc[c], bv, av);
+                }
+            }
+        }
+
+        for (size_t c = 0; c < NCols; c++) {
+            Acc[c] = _mm256_fmadd_ps(_mm256_cvtepi32_ps(IntAcc[c]), _mm256_set1_ps(Scale[c]), Acc[c]);
+        }
+    }
+
+    for (size_t c = 0; c < NCols; c++) {
+        C[c] = MlasQNBitReduceAdd(Acc[c]) + Correction[c] + ((Bias != nullptr) ? Bias[c] : 0.0f);
+    }
+}
+
+template<size_t BlkBitWidth, typename DotProduct>
+void
+MlasSQNBitGemmInt8KernelAvx(
+    size_t BlkLen,
+    const int8_t* QuantA,
+    const float* QuantAScale,
+    const int32_t* QuantASum,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    constexpr size_t NCols = 4;
+
+    size_t n = 0;
+
+    for (; n + NCols <= CountN; n += NCols) {
+        MlasSQNBitGemmInt8ComputeColumns<BlkBitWidth, DotProduct, NCols>(
+            BlkLen, QuantA, QuantAScale, QuantASum, QuantBData, QuantBScale, QuantBZeroPoint,
+            C + n, StartN + n, BlockCountK, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+
+    for (; n < CountN; n++) {
+        MlasSQNBitGemmInt8ComputeColumns<BlkBitWidth, DotProduct, 1>(
+            BlkLen, QuantA, QuantAScale, QuantASum, QuantBData, QuantBScale, QuantBZeroPoint,
+            C + n, StartN + n, BlockCountK, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+}
+
+template<typename DotProduct>
+void
+MlasSQNBitGemmInt8KernelAvxDispatch(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const int8_t* QuantA,
+    const float* QuantAScale,
+    const int32_t* QuantASum,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    switch (BlkBitWidth) {
+        case 2:
+            MlasSQNBitGemmInt8KernelAvx<2, DotProduct>(BlkLen, QuantA, QuantAScale, QuantASum,
+                QuantBData, QuantBScale, QuantBZeroPoint, C, StartN, CountN, BlockCountK, Bias);
+            break;
+        case 3:
+            MlasSQNBitGemmInt8KernelAvx<3, DotProduct>(BlkLen, QuantA, QuantAScale, QuantASum,
+                QuantBData, QuantBScale, QuantBZeroPoint, C, StartN, CountN, BlockCountK, Bias);
+            break;
+        case 4:
+            MlasSQNBitGemmInt8KernelAvx<4, DotProduct>(BlkLen, QuantA, QuantAScale, QuantASum,
+                QuantBData, QuantBScale, QuantBZeroPoint, C, StartN, CountN, BlockCountK, Bias);
+            break;
+        default:
+            MlasSQNBitGemmInt8KernelAvx<8, DotProduct>(BlkLen, QuantA, QuantAScale, QuantASum,
+                QuantBData, QuantBScale, QuantBZeroPoint, C, StartN, CountN, BlockCountK, Bias);
+            break;
+    }
+}
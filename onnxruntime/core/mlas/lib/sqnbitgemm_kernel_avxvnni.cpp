@@ -0,0 +1,69 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_avxvnni.cpp
+
+Abstract:
+
+    This module implements the n-bit quantized GEMM int8 kernel for AVX-VNNI.
+
+    VPDPBUSD sums the products of the unsigned quantized values and the
+    signed values of A without intermediate saturation, for all bit widths.
+    The fp32 kernels are the AVX2 ones.
+
+--*/
+
+#include "sqnbitgemm_kernel_avx_common.h"
+
+struct MLAS_SQNBIT_GEMM_DOT_AVXVNNI {
+
+    template<size_t BlkBitWidth>
+    static constexpr uint8_t Offset() { return 0; }
+
+    template<size_t BlkBitWidth>
+    static
+    MLAS_FORCEINLINE
+    __m256i
+    Dot(
+        __m256i Acc,
+        __m256i b,
+        __m256i a
+        )
+    {
+        return _mm256_dpbusd_avx_epi32(Acc, b, a);
+    }
+};
+
+static
+void
+MlasSQNBitGemmInt8KernelAvxVnni(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const int8_t* QuantA,
+    const float* QuantAScale,
+    const int32_t* QuantASum,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t StartN,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+{
+    MlasSQNBitGemmInt8KernelAvxDispatch<MLAS_SQNBIT_GEMM_DOT_AVXVNNI>(BlkBitWidth, BlkLen,
+        QuantA, QuantAScale, QuantASum, QuantBData, QuantBScale, QuantBZeroPoint,
+        C, StartN, CountN, BlockCountK, Bias);
+}
+
+const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvxVnni = {
+    MlasSQNBitGemmFp32GemvKernelAvx2,
+    MlasSQNBitGemmDequantBKernelAvx2,
+    MlasSQNBitGemmInt8KernelAvxVnni,
+};
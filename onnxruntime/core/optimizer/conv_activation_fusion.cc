@@ -102,6 +102,33 @@ class ConvActivationSelector : public NodeSelector {
       return false;
     };
 
+    // The activations that MLAS computes in the single pass Gelu and SiLU kernels, which only the float
+    // convolutions of the CPU EP apply. QuickGelu with alpha 1 is SiLU, x * sigmoid(x), which QuickGeluFusion
+    // rewrites from the Sigmoid and Mul.
+    auto is_supported_cpu_float_activation = [&node](const Node& activation_node) {
+#if !defined(DISABLE_CONTRIB_OPS)
+      if (!HasElementDataType(*node.InputDefs()[0], ONNX_NAMESPACE::TensorProto_DataType_FLOAT)) {
+        return false;
+      }
+
+      if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Gelu", {1}, kMSDomain) ||
+          (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "FastGelu", {1}, kMSDomain) &&
+           activation_node.InputDefs().size() == 1)) {
+        return true;
+      }
+
+      if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "QuickGelu", {1}, kMSDomain)) {
+        const auto* alpha_attr = graph_utils::GetNodeAttribute(activation_node, "alpha");
+        return alpha_attr != nullptr && alpha_attr->f() == 1.0f;
+      }
+#else
+      ORT_UNUSED_PARAMETER(node);
+      ORT_UNUSED_PARAMETER(activation_node);
+#endif  // !defined(DISABLE_CONTRIB_OPS)
+
+      return false;
+    };
+
     if (!ConvFusionDataTypeCheck(node)) {
       return std::nullopt;
     }
@@ -113,7 +140,8 @@ class ConvActivationSelector : public NodeSelector {
       }
     } else if (node_ep.empty() || node_ep == kCpuExecutionProvider) {
       if (!is_supported_non_cuda_rocm_ep_activation(*next_node) &&
-          !graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "HardSigmoid", {6})) {
+          !graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "HardSigmoid", {6}) &&
+          !is_supported_cpu_float_activation(*next_node)) {
         return std::nullopt;
       }
     } else {
@@ -203,6 +231,8 @@ class FuseConvActivationAction : public ReplaceWithNew {
       float beta = (beta_attr == nullptr ? 0.5f : beta_attr->f());
       activation_params.push_back(alpha);
       activation_params.push_back(beta);
+    } else if (activation_op_type == "QuickGelu") {
+      activation_params.push_back(graph_utils::GetNodeAttribute(*activation, "alpha")->f());
     }
 
     if (!activation_params.empty()) {
@@ -3,6 +3,7 @@
 
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/gemm_activation_fusion.h"
+#include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 
 using namespace ONNX_NAMESPACE;
@@ -18,6 +19,13 @@ bool IsSupportedOptypeVersionAndDomain(const Node& node, const std::string& op_t
           graph_utils::MatchesOpSetDomain(node, domain));
 }
 
+// QuickGelu with alpha 1 is SiLU, x * sigmoid(x), which FusedGemm computes in the GEMM epilogue. QuickGeluFusion
+// rewrites the Sigmoid and Mul of SiLU to it.
+bool IsSiluQuickGelu(const Node& node) {
+  const auto* alpha_attr = graph_utils::GetNodeAttribute(node, "alpha");
+  return alpha_attr != nullptr && alpha_attr->f() == 1.0f;
+}
+
 // If the op has multiple versions, here we require it must have a single implementation that can work across all the
 // versions. Because in the fusion, we discarded the op version information.
 bool IsFusableActivation(const Node& node) {
@@ -33,9 +41,38 @@ bool IsFusableActivation(const Node& node) {
 #ifndef DISABLE_CONTRIB_OPS
          IsSupportedOptypeVersionAndDomain(node, "ScaledTanh", {1}, kOnnxDomain) ||
          IsSupportedOptypeVersionAndDomain(node, "ParametricSoftplus", {1}, kOnnxDomain) ||
+         IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain) ||
+         (IsSupportedOptypeVersionAndDomain(node, "FastGelu", {1}, kMSDomain) && node.InputDefs().size() == 1) ||
+         (IsSupportedOptypeVersionAndDomain(node, "QuickGelu", {1}, kMSDomain) && IsSiluQuickGelu(node)) ||
 #endif
          IsSupportedOptypeVersionAndDomain(node, "ThresholdedRelu", {1, 10}, kOnnxDomain);
 }
+
+// Returns the Add that follows the activation with a residual input of the shape of the output, which FusedGemm
+// adds after the activation, or nullptr.
+Node* GetResidualAdd(Graph& graph, const Node& act_node, NodeArg*& residual) {
+  if (act_node.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(act_node)) {
+    return nullptr;
+  }
+
+  const Node& add_node = *(act_node.OutputNodesBegin());
+  if (!IsSupportedOptypeVersionAndDomain(add_node, "Add", {7, 13, 14}, kOnnxDomain) ||
+      add_node.GetExecutionProviderType() != act_node.GetExecutionProviderType()) {
+    return nullptr;
+  }
+
+  const NodeArg* output = act_node.OutputDefs()[0];
+  const auto& add_inputs = add_node.InputDefs();
+  const NodeArg* other = (add_inputs[0] == output) ? add_inputs[1] : add_inputs[0];
+  if (other == output || !optimizer_utils::IsShapeKnownOnAllDims(*other, 2) ||
+      !optimizer_utils::IsShapeKnownOnAllDims(*output, 2) ||
+      !optimizer_utils::CompareShape(*other->Shape(), *output->Shape())) {
+    return nullptr;
+  }
+
+  residual = graph.GetNodeArg(other->Name());
+  return graph.GetNode(add_node.Index());
+}
 }  // namespace
 
 Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
@@ -68,9 +105,18 @@ Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
     Node& gemm_node = node;
     Node& act_node = *graph.GetNode(next_node.Index());  // get mutable reference
 
+    // A following Add of a residual is fused as the optional input R of FusedGemm.
+    std::vector<NodeArg*> fused_inputs = gemm_node.MutableInputDefs();
+    NodeArg* residual = nullptr;
+    Node* add_node = GetResidualAdd(graph, act_node, residual);
+    if (add_node != nullptr) {
+      fused_inputs.resize(3, &graph.GetOrCreateNodeArg("", nullptr));
+      fused_inputs.push_back(residual);
+    }
+
     Node& fused_gemm = graph.AddNode(graph.GenerateNodeName("fused " + gemm_node.Name()), "FusedGemm",
                                      "fused Gemm " + gemm_node.Name() + "with activation " + act_node.OpType(),
-                                     gemm_node.MutableInputDefs(), {}, &gemm_node.GetAttributes(), kMSDomain);
+                                     fused_inputs, {}, &gemm_node.GetAttributes(), kMSDomain);
 
     // Add a new attribute to specify the activation type
     fused_gemm.AddAttribute("activation", act_node.OpType());
@@ -86,8 +132,12 @@ Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
       fused_gemm.AddAttributeProto(std::move(fused_gemm_attr));
     }
 
-    // move output definitions and edges from act_node to fused_gemm. delete gemm_node and act_node.
-    graph_utils::FinalizeNodeFusion(graph, {gemm_node, act_node}, fused_gemm);
+    // move output definitions and edges from the last fused node to fused_gemm. delete the fused nodes.
+    if (add_node != nullptr) {
+      graph_utils::FinalizeNodeFusion(graph, {gemm_node, act_node, *add_node}, fused_gemm);
+    } else {
+      graph_utils::FinalizeNodeFusion(graph, {gemm_node, act_node}, fused_gemm);
+    }
 
     modified = true;
   }
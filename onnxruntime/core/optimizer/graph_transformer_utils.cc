@@ -362,13 +362,17 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
     case TransformerLevel::Level3: {
 #ifndef DISABLE_CONTRIB_OPS
-      // Register the NCHWc layout transformer if supported by the platform.
-      if (MlasNchwcGetBlockSize() > 1) {
+      const bool enable_nhwc_fp32 =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFp32Conv, "0") == "1";
+      // Register the NCHWc layout transformer if supported by the platform, unless the
+      // fp32 operators are to be transformed to NHWC instead.
+      if (MlasNchwcGetBlockSize() > 1 && !enable_nhwc_fp32) {
         transformers.emplace_back(std::make_unique<NchwcTransformer>());
       }
       AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
       auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
-      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry));
+      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
+                                                                enable_nhwc_fp32);
       if (nhwc_transformer->IsActive()) {
         transformers.emplace_back(std::move(nhwc_transformer));
       }
@@ -442,9 +446,12 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformersForMinimalB
       // currently the only level 3 optimizer is the NhwcTransformer which is fully supported at runtime
       if (!saving) {
 #ifndef DISABLE_CONTRIB_OPS
+        const bool enable_nhwc_fp32 =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFp32Conv, "0") == "1";
         AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
         auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
-        auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry));
+        auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
+                                                                  enable_nhwc_fp32);
         if (nhwc_transformer->IsActive()) {
           transformers.emplace_back(std::move(nhwc_transformer));
         }
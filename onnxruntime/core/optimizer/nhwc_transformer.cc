@@ -43,7 +43,8 @@ NhwcConvLookup(
   return &(iter->second);
 }
 
-NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry) noexcept
+NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry,
+                                 bool enable_fp32) noexcept
     : GraphTransformer("NhwcTransformer"), cpu_allocator_(std::move(cpu_allocator)) {
   if (!cpu_kernel_registry) {
     // This is a CPU op nodes optimizer, not useful if cpu EP is not available.
@@ -164,6 +165,82 @@ NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<Ker
           OpTransformInfo{nhwc_gavgpool_fp16.op_type_, nhwc_gavgpool_fp16.domain_, nhwc_gavgpool_fp16.version_, false});
     }
   }
+
+  if (!enable_fp32) {
+    // fp32 operators are left to the NCHWc transformer unless requested.
+    return;
+  }
+
+  {
+    // fp32 conv -> fp32 nhwc conv
+    OpKernelRegistryId nhwc_conv_fp32{
+        "NhwcFusedConv", kMSDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+    const KernelCreateInfo* kernel_create_info{};
+    const auto status = cpu_kernel_registry->TryFindKernel(
+        kCpuExecutionProvider, nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_,
+        nhwc_conv_fp32.version_, nhwc_conv_fp32.type_constraints_, &kernel_create_info);
+    if (status.IsOK() && kernel_create_info != nullptr) {
+      kernel_create_info = nullptr;
+      conv_table_.emplace(
+          OpIdInfo("Conv", kOnnxDomain, api::DataType::FLOAT),
+          OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+      conv_table_.emplace(
+          OpIdInfo("FusedConv", kMSDomain, api::DataType::FLOAT),
+          OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+    }
+  }
+
+  {
+    // fp32 MaxPool -> fp32 nhwc MaxPool
+    OpKernelRegistryId nhwc_maxpool_fp32{
+        "MaxPool", kMSInternalNHWCDomain, 12, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+    const KernelCreateInfo* kernel_create_info{};
+    const auto status = cpu_kernel_registry->TryFindKernel(
+        kCpuExecutionProvider, nhwc_maxpool_fp32.op_type_, nhwc_maxpool_fp32.domain_,
+        nhwc_maxpool_fp32.version_, nhwc_maxpool_fp32.type_constraints_, &kernel_create_info);
+    if (status.IsOK() && kernel_create_info != nullptr) {
+      kernel_create_info = nullptr;
+      conv_table_.emplace(
+          OpIdInfo("MaxPool", kOnnxDomain, api::DataType::FLOAT),
+          OpTransformInfo{nhwc_maxpool_fp32.op_type_, nhwc_maxpool_fp32.domain_, nhwc_maxpool_fp32.version_, false});
+    }
+  }
+
+  {
+    // fp32 AveragePool -> fp32 nhwc AveragePool
+    OpKernelRegistryId nhwc_avgpool_fp32{
+        "AveragePool", kMSInternalNHWCDomain, 11, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+    const KernelCreateInfo* kernel_create_info{};
+    const auto status = cpu_kernel_registry->TryFindKernel(
+        kCpuExecutionProvider, nhwc_avgpool_fp32.op_type_, nhwc_avgpool_fp32.domain_,
+        nhwc_avgpool_fp32.version_, nhwc_avgpool_fp32.type_constraints_, &kernel_create_info);
+    if (status.IsOK() && kernel_create_info != nullptr) {
+      kernel_create_info = nullptr;
+      conv_table_.emplace(
+          OpIdInfo("AveragePool", kOnnxDomain, api::DataType::FLOAT),
+          OpTransformInfo{nhwc_avgpool_fp32.op_type_, nhwc_avgpool_fp32.domain_, nhwc_avgpool_fp32.version_, false});
+    }
+  }
+
+  {
+    // fp32 GlobalAveragePool -> fp32 nhwc GlobalAveragePool
+    OpKernelRegistryId nhwc_gavgpool_fp32{
+        "GlobalAveragePool", kMSInternalNHWCDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+    const KernelCreateInfo* kernel_create_info{};
+    const auto status = cpu_kernel_registry->TryFindKernel(
+        kCpuExecutionProvider, nhwc_gavgpool_fp32.op_type_, nhwc_gavgpool_fp32.domain_,
+        nhwc_gavgpool_fp32.version_, nhwc_gavgpool_fp32.type_constraints_, &kernel_create_info);
+    if (status.IsOK() && kernel_create_info != nullptr) {
+      kernel_create_info = nullptr;
+      conv_table_.emplace(
+          OpIdInfo("GlobalAveragePool", kOnnxDomain, api::DataType::FLOAT),
+          OpTransformInfo{nhwc_gavgpool_fp32.op_type_, nhwc_gavgpool_fp32.domain_, nhwc_gavgpool_fp32.version_, false});
+    }
+  }
 };
 
 Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
@@ -200,6 +277,14 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       continue;
     }
 
+    // Skip MaxPool using the optional index tensor, which the NHWC kernels do not compute
+    if (node->OpType() == "MaxPool") {
+      const auto outputs = node->Outputs();
+      if (outputs.size() > 1 && !outputs[1].empty()) {
+        continue;
+      }
+    }
+
     // Skip if unknown rank
     auto shape = NodeFromApiNode(*node).InputDefs()[0]->Shape();
     if (shape == nullptr) {
@@ -213,7 +298,14 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     size_t rank = shape->dim_size();
     std::vector<int64_t> input_perm = ChannelFirstToLastPerm(rank);
     std::vector<int64_t> output_perm = ChannelLastToFirstPerm(rank);
-    WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
+    std::vector<const std::vector<int64_t>*> input_perms{&input_perm};
+    const auto inputs = node->Inputs();
+    if (node->OpType() == "FusedConv" && inputs.size() > 3 && !inputs[3].empty()) {
+      // The Sum input of FusedConv is in the layout of the output.
+      input_perms.resize(4, nullptr);
+      input_perms[3] = &input_perm;
+    }
+    WrapTransposesAroundNode(*api_graph, *node, input_perms, {&output_perm});
 
     // Replace the operator if needed
     if (node->Domain() != transform->domain_ ||
@@ -75,7 +75,13 @@ and inserts nodes to transpose tensors as needed.
 class NhwcTransformer : public GraphTransformer {
  private:
  public:
-  explicit NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry) noexcept;
+  /**
+   * @param cpu_allocator        allocator of the transposed initializers
+   * @param cpu_kernel_registry  registry of the cpu EP, used to check that the NHWC kernels exist
+   * @param enable_fp32          whether fp32 Conv and pooling operators are transformed too
+   */
+  explicit NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry,
+                           bool enable_fp32 = false) noexcept;
 
   /**
    * @brief Usually called right after constructor, it shows whether
@@ -175,8 +175,8 @@ class Env {
 
   /**
    * Maps the content of the file into memory.
-   * This is a copy-on-write mapping, so any changes are not written to the
-   * actual file.
+   * This is a read-only mapping, so processes that map the same file share the
+   * pages of the file cache.
    * @param file_path The path to the file.
    * @param offset The file offset from which to start the mapping.
    * @param length The length in bytes of the mapping.
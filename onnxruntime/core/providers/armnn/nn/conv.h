@@ -30,6 +30,14 @@ class Conv : public onnxruntime::Conv<T> {
     Conv::convLayers.erase(this);
   }
 
+  // The filter is read by the provider, so is kept unpacked.
+  Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, AllocatorPtr /*alloc*/,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* /*prepacked_weights*/) override {
+    is_packed = false;
+    return Status::OK();
+  }
+
   Status Compute(OpKernelContext* context) const override;
 
   static armnn::IRuntimePtr initRuntime() {
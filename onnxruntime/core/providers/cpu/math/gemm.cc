@@ -6,6 +6,7 @@
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
+#include "core/providers/cpu/tunable/sgemm_tunable.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
@@ -100,6 +101,16 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
     Gemm<MLFloat16>);
 
+size_t GemmPackBSizeFp32(const TensorShape& b_shape, bool trans_b) {
+  if (b_shape.NumDimensions() != 2) {
+    return 0;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+  return MlasGemmPackBSize(N, K);
+}
+
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
                    bool trans_b,
@@ -189,7 +200,7 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
 #if defined(__GNUC__) && defined(HAS_CLASS_MEMACCESS)
 #pragma GCC diagnostic pop
 #endif
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+#ifdef MLAS_F16GEMM_SUPPORTED
   bool support_mlas = false;
   if (c_shape == nullptr) {
     support_mlas = true;
@@ -284,6 +295,33 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+template <typename T>
+Status Gemm<T>::UseCachedPrePackedBuffers(const Tensor& /*tensor*/,
+                                          std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                          const std::vector<size_t>& /*prepacked_buffer_sizes*/,
+                                          int /*input_idx*/,
+                                          /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                              std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              const std::vector<size_t>& prepacked_buffer_sizes,
+                                              int input_idx,
+                                              /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  if (input_idx == 1 && prepacked_buffers.size() == 1 &&
+      prepacked_buffer_sizes[0] == GemmPackBSizeFp32(tensor.Shape(), trans_B_ != CblasNoTrans)) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -408,28 +446,66 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
-  if (B) {
-    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
-                c_data, c_shape, y_data, thread_pool);
+  // The optional residual input of FusedGemm is added after the activation.
+  const Tensor* R = context->InputCount() > 3 ? context->Input<Tensor>(3) : nullptr;
+  if (R != nullptr) {
+    ORT_RETURN_IF_NOT(R->Shape() == TensorShape({M, N}),
+                      "Residual input must have the shape of the output. Got: ", R->Shape());
+  }
+
+  // The bias of a single row, the MLAS activation and the residual are applied by the epilogue of the
+  // MLAS GEMM to each tile of the output while it is still in cache, instead of in separate passes over
+  // the output.
+  MLAS_GEMM_EPILOGUE epilogue;
+  float beta = c_data != nullptr ? beta_ : 0.0f;
+
+  if (c_data != nullptr && beta_ == 1.0f && c_shape->NumDimensions() >= 1 && c_shape->Size() == N &&
+      (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1)) {
+    epilogue.Bias = c_data;
+    beta = 0.0f;
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    MlasGemm(
-        trans_A_,
-        static_cast<size_t>(M),
-        static_cast<size_t>(N),
-        static_cast<size_t>(K),
-        alpha_,
-        A->Data<float>(),
-        static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-        packed_b_.get(),
-        c_data != nullptr ? beta_ : 0.0f,
-        y_data,
-        static_cast<size_t>(N),
-        thread_pool);
   }
 
+  if (activation_ == nullptr) {
+    epilogue.Activation = mlas_activation_;
+    if (R != nullptr) {
+      epilogue.Residual = R->Data<float>();
+      epilogue.ldr = static_cast<size_t>(N);
+    }
+  }
+
+  MLAS_GEMM_EPILOGUE_PROCESSOR epilogue_processor(epilogue);
+
+  MLAS_SGEMM_DATA_PARAMS data;
+  data.A = A->Data<float>();
+  data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+  if (B) {
+    data.B = B->Data<float>();
+    data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+  } else {
+    data.B = static_cast<const float*>(packed_b_.get());
+    data.BIsPacked = true;
+  }
+  data.C = y_data;
+  data.ldc = static_cast<size_t>(N);
+  data.alpha = alpha_;
+  data.beta = beta;
+  if (epilogue.Bias != nullptr || epilogue.Activation.ActivationKind != MlasIdentityActivation ||
+      epilogue.Residual != nullptr) {
+    data.OutputProcessor = &epilogue_processor;
+  }
+
+  ORT_RETURN_IF_ERROR(cpu::tunable::SgemmBatch(tuning_ctx_, trans_A_, trans_B_, static_cast<size_t>(M),
+                                               static_cast<size_t>(N), static_cast<size_t>(K), &data, 1,
+                                               thread_pool));
+
   ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
 
+  if (R != nullptr && activation_ != nullptr) {
+    EigenMatrixMapRowMajor<float>(y_data, M, N) += ConstEigenMatrixMapRowMajor<float>(R->Data<float>(), M, N);
+  }
+
   return Status::OK();
 }
 
@@ -8,14 +8,17 @@
 #include "core/framework/op_kernel.h"
 #include "core/common/common.h"
 #include "core/util/math.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
 
 namespace onnxruntime {
 
 template <typename T>
 class Gemm : protected GemmBase, public OpKernel {
  public:
-  Gemm(const OpKernelInfo& info) : GemmBase(info), OpKernel(info) {
+  Gemm(const OpKernelInfo& info)
+      : GemmBase(info), OpKernel(info), tuning_ctx_(cpu::tunable::GetCpuTuningContext(info)) {
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -28,6 +31,12 @@ class Gemm : protected GemmBase, public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor,
+                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   const std::vector<size_t>& prepacked_buffer_sizes,
+                                   int input_idx,
+                                   /*out*/ bool& used_cached_buffers) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
                           T alpha,
@@ -44,6 +53,12 @@ class Gemm : protected GemmBase, public OpKernel {
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
 
+  // For fused gemm + activation applied by the epilogue of the MLAS GEMM, used when activation_ is not set
+  MLAS_ACTIVATION mlas_activation_{MlasIdentityActivation, {}};
+
+  // Selects the tuned blocking and threading parameters of the MLAS GEMM
+  cpu::tunable::CpuTuningContext* tuning_ctx_;
+
   void ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const;
 };
 
@@ -7,6 +7,10 @@
 
 namespace onnxruntime {
 
+// Returns the size of the buffer GemmPackBFp32 packs the weight matrix of the given shape into, or 0 if the
+// weight matrix is not packed.
+size_t GemmPackBSizeFp32(const TensorShape& b_shape, bool trans_b);
+
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
                    bool trans_b,
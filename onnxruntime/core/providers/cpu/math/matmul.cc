@@ -4,6 +4,7 @@
 #include "core/providers/cpu/math/matmul.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cpu/tunable/sgemm_tunable.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
@@ -89,6 +90,38 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
         .TypeConstraint("T", BuildKernelDefConstraints<int64_t, uint64_t>()),
     MatMul<int64_t>);
 
+// opset 13 adds BFloat16 support
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    MatMul<BFloat16>);
+
+#ifdef MLAS_F16GEMM_SUPPORTED
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+#endif
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -157,6 +190,23 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+Status MatMul<float>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                                std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                const std::vector<size_t>& prepacked_buffer_sizes,
+                                                int input_idx,
+                                                /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  if (input_idx == 1 && prepacked_buffers.size() == 1 &&
+      prepacked_buffer_sizes[0] == GemmPackBSizeFp32(tensor.Shape(), trans_b_attr_ != 0)) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -199,10 +249,130 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
     data[i].alpha = alpha_attr_;
     data[i].beta = 0.0f;
   }
-  MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
-                M, N, K, data.data(), max_len, thread_pool);
+  return cpu::tunable::SgemmBatch(tuning_ctx_, trans_a ? CblasTrans : CblasNoTrans,
+                                  trans_b ? CblasTrans : CblasNoTrans, M, N, K, data.data(), max_len, thread_pool);
+}
+
+Status MatMul<BFloat16>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
+                                 /*out*/ bool& is_packed,
+                                 /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack a 2D matrix B
+  if (input_idx != 1 || tensor.Shape().NumDimensions() != 2) {
+    return Status::OK();
+  }
+
+  b_shape_ = tensor.Shape();
+  const size_t K = static_cast<size_t>(b_shape_[0]);
+  const size_t N = static_cast<size_t>(b_shape_[1]);
+
+  const size_t packed_b_size = MlasBf16GemmPackBSize(N, K);
+  packed_b_ = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  MlasBf16GemmPackB(N, K, tensor.Data<BFloat16>(), N, packed_b_.get());
+  is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+  return Status::OK();
+}
+
+Status MatMul<BFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                   int input_idx,
+                                                   /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMul<BFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  const auto& b_shape = b ? b->Shape() : b_shape_;
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const auto* a_data = a->Data<BFloat16>();
+  const auto* b_data = b ? b->Data<BFloat16>() : nullptr;
+  auto* y_data = y->MutableData<BFloat16>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  std::vector<MLAS_BF16_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    if (packed_b_) {
+      data[i].B = packed_b_.get();
+      data[i].ldb = 0;
+    } else {
+      data[i].B = b_data + helper.RightOffsets()[i];
+      data[i].ldb = N;
+    }
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+    data[i].CIsBf16 = true;
+  }
+  MlasBf16GemmBatch(M, N, K, max_len, data.data(), thread_pool);
+
+  return Status::OK();
+}
+
+#ifdef MLAS_F16GEMM_SUPPORTED
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const auto* a_data = a->Data<MLFloat16>();
+  const auto* b_data = b->Data<MLFloat16>();
+  auto* y_data = y->MutableData<MLFloat16>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = b_data + helper.RightOffsets()[i];
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  MlasHalfGemmBatch(M, N, K, max_len, data.data(), thread_pool);
 
   return Status::OK();
 }
+#endif
 
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
 
 namespace onnxruntime {
 
@@ -18,7 +19,7 @@ class MatMul final : public OpKernel {
 template <>
 class MatMul<float> final : public OpKernel {
  public:
-  MatMul(const OpKernelInfo& info) : OpKernel(info) {
+  MatMul(const OpKernelInfo& info) : OpKernel(info), tuning_ctx_(cpu::tunable::GetCpuTuningContext(info)) {
     info.GetAttrOrDefault<int64_t>("transA", &trans_a_attr_, 0);
     info.GetAttrOrDefault<int64_t>("transB", &trans_b_attr_, 0);
     info.GetAttrOrDefault<float>("alpha", &alpha_attr_, 1.0);
@@ -36,6 +37,10 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   const std::vector<size_t>& prepacked_buffer_sizes,
+                                   int input_idx, /*out*/ bool& used_cached_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
@@ -48,6 +53,40 @@ class MatMul<float> final : public OpKernel {
   int64_t trans_b_attr_;
   bool trans_batch_a_;
   bool trans_batch_b_;
+
+  // Selects the tuned blocking and threading parameters of the MLAS GEMM
+  cpu::tunable::CpuTuningContext* tuning_ctx_;
+};
+
+// The products are accumulated in fp32 by the MLAS bfloat16 GEMM, which uses the AVX512-BF16 or AMX-BF16
+// instructions when the CPU supports them.
+template <>
+class MatMul<BFloat16> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  TensorShape b_shape_;
+  IAllocatorUniquePtr<void> packed_b_;
+};
+
+// Runs on the MLAS half precision GEMM. It is only registered when MlasFp16AccelerationSupported() reports
+// fp16 kernels for the CPU: NEON on ARM64, F16C or AVX512-FP16 on x64.
+template <>
+class MatMul<MLFloat16> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
 };
 
 }  // namespace onnxruntime
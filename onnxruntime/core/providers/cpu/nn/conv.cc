@@ -153,20 +153,95 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack the filter of the convolutions computed by the Winograd algorithm. At the default optimization level,
+  // the NchwcTransformer replaces these convolutions on platforms with a NCHWc block size, so the Winograd algorithm
+  // is used on the other platforms (e.g. ARM64) and when the layout optimizations are disabled.
+  if (input_idx != 1 || tensor.Shape().NumDimensions() != 4) {
+    return Status::OK();
+  }
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(tensor.Shape(), kernel_shape));
+
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  if (kernel_shape.size() != 2 || dilations.size() != 2 || strides.size() != 2) {
+    return Status::OK();
+  }
+
+  const size_t group = narrow<size_t>(conv_attrs_.group);
+  const size_t input_channels = narrow<size_t>(tensor.Shape()[1]);
+  const size_t filter_count = narrow<size_t>(tensor.Shape()[0]);
+
+  if (!MlasConvWinogradIsSupported(2, group, input_channels, filter_count,
+                                   kernel_shape.data(), dilations.data(), strides.data())) {
+    return Status::OK();
+  }
+
+  filter_shape_ = tensor.Shape();
+
+  const size_t packed_filter_size = MlasConvWinogradPackFilterSize(input_channels, filter_count);
+  auto* packed_filter_data = alloc->Alloc(packed_filter_size);
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_filter_data, 0, packed_filter_size);
+
+  packed_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
+
+  MlasConvWinogradPackFilter(input_channels, filter_count, tensor.Data<float>(), packed_filter_data);
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(packed_filter_));
+    prepacked_weights->buffer_sizes_.push_back(packed_filter_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_filter_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* W = packed_filter_ ? nullptr : context->Input<Tensor>(1);
+  const TensorShape& W_shape = W ? W->Shape() : filter_shape_;
   const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
   const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   // kernel_shape is an optional attribute and has to be inferred from W if not provided
   TensorShapeVector kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   ConvPadVector pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -213,7 +288,35 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const size_t kernel_rank = kernel_shape.size();
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
-  if (kernel_rank >= 1 && kernel_rank <= 3) {
+  if (packed_filter_) {
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+    MlasConvPrepare(&Parameters,
+                    kernel_rank,
+                    narrow<size_t>(N),
+                    narrow<size_t>(conv_attrs_.group),
+                    narrow<size_t>(C / conv_attrs_.group),
+                    input_shape.GetDims().data(),
+                    kernel_shape.data(),
+                    dilations.data(),
+                    pads.data(),
+                    strides.data(),
+                    output_shape.GetDims().data(),
+                    narrow<size_t>(M / conv_attrs_.group),
+                    &activation_,
+                    &WorkingBufferSize,
+                    Beta,
+                    thread_pool);
+
+    // The Winograd convolution buffers its tiles per thread and does not use
+    // the working buffer.
+    MlasConvWinograd(&Parameters,
+                     Xdata.data(),
+                     packed_filter_.get(),
+                     Bdata,
+                     Ydata.data(),
+                     thread_pool);
+  } else if (kernel_rank >= 1 && kernel_rank <= 3) {
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
     MlasConvPrepare(&Parameters,
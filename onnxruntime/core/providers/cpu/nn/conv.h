@@ -28,12 +28,25 @@ class Conv<float> : public OpKernel {
     activation_.ActivationKind = MlasIdentityActivation;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // for pre-packing usage: the filter transformed for the Winograd convolution
+  TensorShape filter_shape_;
+  BufferUniquePtr packed_filter_;
 };
 
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -74,47 +75,93 @@ Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, boo
     inv_std_dev_data = inv_std_dev->MutableData<U>();
   }
 
-  concurrency::ThreadPool::TryBatchParallelFor(
-      p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
-      [&](ptrdiff_t task_idx) {
-        const T* p_input = X_data + task_idx * norm_size;
-        T* p_output = Y_data + task_idx * norm_size;
+  if constexpr (std::is_same_v<T, double>) {
+    concurrency::ThreadPool::TryBatchParallelFor(
+        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
+        [&](ptrdiff_t task_idx) {
+          const T* p_input = X_data + task_idx * norm_size;
+          T* p_output = Y_data + task_idx * norm_size;
 
-        T mean = 0;
-        T mean_square = 0;
+          T mean = 0;
+          T mean_square = 0;
 
-        for (int64_t h = 0; h < norm_size; h++) {
-          mean += p_input[h];
-          mean_square += p_input[h] * p_input[h];
-        }
-
-        mean = mean / norm_size;
-        if (simplified) {
-          mean_square = sqrt(mean_square / norm_size + epsilon);
-        } else {
-          mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
-        }
+          for (int64_t h = 0; h < norm_size; h++) {
+            mean += p_input[h];
+            mean_square += p_input[h] * p_input[h];
+          }
 
-        for (int64_t h = 0; h < norm_size; h++) {
+          mean = mean / norm_size;
           if (simplified) {
-            p_output[h] = p_input[h] / mean_square * scale_data[h];
-          } else if (nullptr == bias) {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+            mean_square = sqrt(mean_square / norm_size + epsilon);
           } else {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+            mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
           }
-        }
 
+          for (int64_t h = 0; h < norm_size; h++) {
+            if (simplified) {
+              p_output[h] = p_input[h] / mean_square * scale_data[h];
+            } else if (nullptr == bias) {
+              p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+            } else {
+              p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+            }
+          }
+
+          if (mean_data != nullptr) {
+            // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
+            mean_data[task_idx] = gsl::narrow_cast<U>(mean);
+          }
+
+          if (inv_std_dev_data != nullptr) {
+            inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
+          }
+        },
+        0);
+
+  } else {
+    // float and MLFloat16 rows are normalized by MLAS, which computes the mean and inverse standard deviation in float.
+    MLAS_NORM_PARAMS<T> params;
+    params.Input = X_data;
+    params.Scale = scale_data;
+    params.Bias = bias_data;
+    params.Output = Y_data;
+    params.Rows = onnxruntime::narrow<size_t>(norm_count);
+    params.D = onnxruntime::narrow<size_t>(norm_size);
+    params.Epsilon = epsilon;
+
+    IAllocatorUniquePtr<float> mean_buffer;
+    IAllocatorUniquePtr<float> inv_std_dev_buffer;
+    if constexpr (std::is_same_v<U, float>) {
+      params.Mean = mean_data;
+      params.InvStdDev = inv_std_dev_data;
+    } else {
+      if (mean_data != nullptr) {
+        mean_buffer = IAllocator::MakeUniquePtr<float>(alloc, params.Rows);
+        params.Mean = mean_buffer.get();
+      }
+      if (inv_std_dev_data != nullptr) {
+        inv_std_dev_buffer = IAllocator::MakeUniquePtr<float>(alloc, params.Rows);
+        params.InvStdDev = inv_std_dev_buffer.get();
+      }
+    }
+
+    if (simplified) {
+      MlasRmsNorm(&params, p_ctx->GetOperatorThreadPool());
+    } else {
+      MlasLayerNorm(&params, p_ctx->GetOperatorThreadPool());
+    }
+
+    if constexpr (!std::is_same_v<U, float>) {
+      for (size_t i = 0; i < params.Rows; i++) {
         if (mean_data != nullptr) {
-          // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-          mean_data[task_idx] = gsl::narrow_cast<U>(mean);
+          mean_data[i] = static_cast<U>(params.Mean[i]);
         }
-
         if (inv_std_dev_data != nullptr) {
-          inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
+          inv_std_dev_data[i] = static_cast<U>(params.InvStdDev[i]);
         }
-      },
-      0);
+      }
+    }
+  }
 
   return Status::OK();
 }
@@ -141,7 +188,7 @@ struct SrcDispatcher {
 Status LayerNormImpl::Compute(OpKernelContext* p_ctx) const {
   const auto elem_type = p_ctx->Input<Tensor>(0)->GetElementType();
 
-  using SupportedTypeList = boost::mp11::mp_list<float, double>;
+  using SupportedTypeList = boost::mp11::mp_list<float, double, MLFloat16>;
 
   utils::MLTypeCallDispatcherFromTypeList<SupportedTypeList> t_disp(elem_type);
   return t_disp.InvokeRet<Status, SrcDispatcher>(p_ctx, axis_, epsilon_, simplified_, contrib_op_);
@@ -32,6 +32,12 @@ class QLinearConv : public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor,
+                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   const std::vector<size_t>& prepacked_buffer_sizes,
+                                   int input_idx,
+                                   /*out*/ bool& used_cached_buffers) override;
+
  private:
   enum InputTensors : int {
     IN_X = 0,
@@ -511,6 +517,57 @@ Status QLinearConv<ActType>::UseSharedPrePackedBuffers(std::vector<BufferUniqueP
   return Status::OK();
 }
 
+template <typename ActType>
+Status QLinearConv<ActType>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                                       std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                       const std::vector<size_t>& prepacked_buffer_sizes,
+                                                       int input_idx,
+                                                       /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  if (input_idx != InputTensors::IN_W) {
+    return Status::OK();
+  }
+
+  // Cached buffers are only produced by the generic packing paths of PrePack(), so the tensor
+  // is known to have passed its shape checks.
+  const auto& shape = tensor.Shape().GetDims();
+  const size_t rank = shape.size();
+  if (rank <= 2 || shape[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  is_W_signed_ = tensor.IsDataType<int8_t>();
+
+  if (prepacked_buffers.size() == 1) {  // This means that only packed_W_ exists
+    const size_t group_output_channels = static_cast<size_t>(shape[0] / conv_attrs_.group);
+    const size_t kernel_dim = static_cast<size_t>(
+        std::accumulate(shape.data() + 1, shape.data() + rank, 1LL, std::multiplies<int64_t>()));
+    packed_W_size_ = MlasGemmPackBSize(group_output_channels,
+                                       kernel_dim,
+                                       std::is_same<ActType, int8_t>::value,
+                                       is_W_signed_);
+    // The buffer must have been packed with the layout of the packing kernel selected on this machine.
+    if (packed_W_size_ == 0 ||
+        prepacked_buffer_sizes[0] != SafeInt<size_t>(conv_attrs_.group) * packed_W_size_) {
+      return Status::OK();
+    }
+    packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  } else if (prepacked_buffers.size() == 2 && prepacked_buffers[0].get() == nullptr) {
+    if (prepacked_buffer_sizes[1] != static_cast<size_t>(tensor.Shape().Size())) {
+      return Status::OK();
+    }
+    reordered_W_buffer_ = std::move(prepacked_buffers[1]);
+  } else {
+    return Status::OK();
+  }
+
+  W_shape_ = shape;
+  is_W_packed_ = true;
+  used_cached_buffers = true;
+  return Status::OK();
+}
+
 template <typename ActType>
 Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
   const Tensor* X = context->Input<Tensor>(InputTensors::IN_X);
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/op_kernel_info.h"
+#include "core/framework/tuning_context.h"
+#define TUNING_CONTEXT_IMPL
+#include "core/framework/tuning_context_impl.h"
+#undef TUNING_CONTEXT_IMPL
+#include "core/providers/cpu/cpu_execution_provider.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+static std::string GetCpuModel() {
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  std::ostringstream oss;
+#if defined(CPUIDINFO_ARCH_X86)
+  oss << cpuid_info.GetX86Vendor() << "-0x" << std::hex << std::setw(8) << std::setfill('0')
+      << cpuid_info.GetX86FamilyModel();
+#elif defined(CPUIDINFO_ARCH_ARM)
+  // The micro-architecture of each distinct kind of core, in the order of the cores.
+  oss << "ARM";
+  int32_t last_uarch = -1;
+  for (uint32_t core = 0; cpuid_info.GetCoreUarch(core) != -1; core++) {
+    const int32_t uarch = cpuid_info.GetCoreUarch(core);
+    if (uarch != last_uarch) {
+      oss << "-0x" << std::hex << std::setw(8) << std::setfill('0') << uarch;
+      last_uarch = uarch;
+    }
+  }
+#else
+  ORT_UNUSED_PARAMETER(cpuid_info);
+  oss << "UNKNOWN";
+#endif
+  return oss.str();
+}
+
+static Status ValidateCpuModel(const std::string& value) {
+  auto current = GetCpuModel();
+  ORT_RETURN_IF(current != value, "CPU model mismatch: tuning results produced with CPU ", value,
+                ", onnxruntime currently run with CPU ", current);
+  return Status::OK();
+}
+
+CpuTuningResultsValidator::CpuTuningResultsValidator() {
+  RegisterValidator("CPU_MODEL", GetCpuModel, ValidateCpuModel);
+}
+
+CpuTuningContext::CpuTuningContext(CPUExecutionProvider* ep) : ITuningContext(ep) {}
+
+void CpuTuningContext::EnableTunableOp() {
+  LOGS_DEFAULT(INFO) << "Enable TunableOp for CPU Execution Provider";
+  enable_ = true;
+}
+
+void CpuTuningContext::DisableTunableOp() {
+  LOGS_DEFAULT(INFO) << "Disable TunableOp for CPU Execution Provider";
+  enable_ = false;
+}
+
+bool CpuTuningContext::IsTunableOpEnabled() const {
+  return enable_;
+}
+
+void CpuTuningContext::EnableTuning() {
+  LOGS_DEFAULT(INFO) << "Enable TunableOp tuning for CPU Execution Provider";
+  tuning_enable_ = true;
+}
+
+void CpuTuningContext::DisableTuning() {
+  LOGS_DEFAULT(INFO) << "Disable TunableOp tuning for CPU Execution Provider";
+  tuning_enable_ = false;
+}
+
+bool CpuTuningContext::IsTuningEnabled() const {
+  return tuning_enable_;
+}
+
+void CpuTuningContext::SetMaxTuningDurationMs(int max_duration_ms) {
+  max_tuning_duration_ms_ = max_duration_ms;
+}
+
+int CpuTuningContext::GetMaxTuningDurationMs() const {
+  return max_tuning_duration_ms_ > 0 ? max_tuning_duration_ms_ : std::numeric_limits<int>::max();
+}
+
+TuningResultsManager& CpuTuningContext::GetTuningResultsManager() {
+  return manager_;
+}
+
+const TuningResultsManager& CpuTuningContext::GetTuningResultsManager() const {
+  return manager_;
+}
+
+const TuningResultsValidator& CpuTuningContext::GetTuningResultsValidator() const {
+  return validator_;
+}
+
+CpuTuningContext* GetCpuTuningContext(const OpKernelInfo& info) {
+  const auto* ep = info.GetExecutionProvider();
+  if (ep == nullptr || ep->Type() != kCpuExecutionProvider) {
+    return nullptr;
+  }
+  return static_cast<CpuTuningContext*>(ep->GetTuningContext());
+}
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
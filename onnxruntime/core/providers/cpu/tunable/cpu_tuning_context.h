@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/tuning_context.h"
+
+namespace onnxruntime {
+
+class CPUExecutionProvider;
+class OpKernelInfo;
+
+namespace cpu {
+namespace tunable {
+
+// Tuning results of the CPU execution provider are only valid on the processor they were produced on, because the
+// fastest blocking and threading of a kernel depends on the cache hierarchy and the vector units of the
+// microarchitecture.
+class CpuTuningResultsValidator : public TuningResultsValidator {
+ public:
+  CpuTuningResultsValidator();
+};
+
+class CpuTuningContext : public ITuningContext {
+ public:
+  explicit CpuTuningContext(CPUExecutionProvider* ep);
+
+  void EnableTunableOp() override;
+  void DisableTunableOp() override;
+  bool IsTunableOpEnabled() const override;
+
+  void EnableTuning() override;
+  void DisableTuning() override;
+  bool IsTuningEnabled() const override;
+
+  void SetMaxTuningDurationMs(int max_duration_ms) override;
+  int GetMaxTuningDurationMs() const override;
+
+  TuningResultsManager& GetTuningResultsManager() override;
+  const TuningResultsManager& GetTuningResultsManager() const override;
+
+  const TuningResultsValidator& GetTuningResultsValidator() const override;
+
+ private:
+  bool enable_{false};
+  bool tuning_enable_{false};
+  int max_tuning_duration_ms_{};
+  TuningResultsManager manager_;
+  CpuTuningResultsValidator validator_;
+};
+
+// Returns the tuning context of the CPU execution provider of the kernel, or nullptr if the kernel is assigned to
+// another execution provider.
+CpuTuningContext* GetCpuTuningContext(const OpKernelInfo& info);
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/sgemm_tunable.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+namespace {
+
+size_t Bucket(size_t dim) {
+  size_t bucket = 1;
+  while (bucket < dim) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
+
+// When beta is not zero, C is an input as well as the output, and the runs of the tuning would accumulate into it.
+// The tuning then computes into scratch buffers instead.
+bool IsCInput(const SgemmParams* params) {
+  for (size_t i = 0; i < params->batch; i++) {
+    if (params->data[i].beta != 0.0f) {
+      return true;
+    }
+  }
+  return false;
+}
+
+struct SgemmProxyParams : SgemmParams {
+  std::vector<MLAS_SGEMM_DATA_PARAMS> proxy_data;
+  std::vector<float> proxy_c;
+};
+
+}  // namespace
+
+std::string SgemmParams::Signature() const {
+  return MakeString(trans_a == CblasNoTrans ? "N" : "T", trans_b == CblasNoTrans ? "N" : "T",
+                    "_M", Bucket(m), "_N", Bucket(n), "_K", Bucket(k), "_B", Bucket(batch),
+                    data[0].BIsPacked ? "_P" : "");
+}
+
+SgemmTunableOp::SgemmTunableOp() {
+  size_t candidate_count;
+  const MLAS_SGEMM_TUNING_PARAMETERS* candidates = MlasSgemmTuningCandidates(&candidate_count);
+
+  for (size_t i = 0; i < candidate_count; i++) {
+    const MLAS_SGEMM_TUNING_PARAMETERS* tuning_parameters = &candidates[i];
+    this->RegisterOp([tuning_parameters](const SgemmParams* params) {
+      MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k,
+                    params->data, params->batch, params->thread_pool, tuning_parameters);
+      return Status::OK();
+    });
+  }
+
+  // the first candidate is the built-in heuristic of MLAS
+  this->SetDefaultId(0);
+}
+
+const SgemmParams* SgemmTunableOp::PreTuning(const SgemmParams* params) {
+  if (!IsCInput(params)) {
+    return params;
+  }
+
+  auto* proxy = new SgemmProxyParams();
+  static_cast<SgemmParams&>(*proxy) = *params;
+  proxy->proxy_data.assign(params->data, params->data + params->batch);
+
+  size_t c_size = 0;
+  for (size_t i = 0; i < params->batch; i++) {
+    c_size = std::max(c_size, params->m * params->data[i].ldc);
+  }
+  proxy->proxy_c.resize(c_size * params->batch);
+  for (size_t i = 0; i < params->batch; i++) {
+    proxy->proxy_data[i].C = proxy->proxy_c.data() + i * c_size;
+  }
+  proxy->data = proxy->proxy_data.data();
+  return proxy;
+}
+
+void SgemmTunableOp::PostTuning(const SgemmParams* params) {
+  if (IsCInput(params)) {
+    delete static_cast<const SgemmProxyParams*>(params);
+  }
+}
+
+Status SgemmBatch(CpuTuningContext* tuning_ctx,
+                  CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                  size_t m, size_t n, size_t k,
+                  const MLAS_SGEMM_DATA_PARAMS* data, size_t batch,
+                  concurrency::ThreadPool* thread_pool) {
+  if (tuning_ctx == nullptr || !tuning_ctx->IsTunableOpEnabled() || batch == 0) {
+    MlasGemmBatch(trans_a, trans_b, m, n, k, data, batch, thread_pool);
+    return Status::OK();
+  }
+
+  static SgemmTunableOp op;
+
+  SgemmParams params;
+  params.tuning_ctx = tuning_ctx;
+  params.trans_a = trans_a;
+  params.trans_b = trans_b;
+  params.m = m;
+  params.n = n;
+  params.k = k;
+  params.data = data;
+  params.batch = batch;
+  params.thread_pool = thread_pool;
+  return op(&params);
+}
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
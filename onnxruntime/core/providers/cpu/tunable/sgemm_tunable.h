@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tunable/cpu_tunable.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+// Parameters of a batched single precision GEMM computed by MlasGemmBatch.
+//
+// The signature buckets each dimension to the next power of two, so that the parameters tuned for the first shape
+// seen in a bucket are used by all the shapes of the bucket, e.g. the varying sequence lengths of a model.
+struct SgemmParams : OpParams {
+  std::string Signature() const override;
+
+  CBLAS_TRANSPOSE trans_a;
+  CBLAS_TRANSPOSE trans_b;
+  size_t m;
+  size_t n;
+  size_t k;
+  const MLAS_SGEMM_DATA_PARAMS* data;
+  size_t batch;
+  concurrency::ThreadPool* thread_pool;
+};
+
+// Selects the MLAS SGEMM blocking and threading parameters, the candidates are MlasSgemmTuningCandidates.
+class SgemmTunableOp : public TunableOp<SgemmParams> {
+ public:
+  SgemmTunableOp();
+
+  const SgemmParams* PreTuning(const SgemmParams* params) override;
+  void PostTuning(const SgemmParams* params) override;
+};
+
+// Computes the batched single precision GEMM with MlasGemmBatch. If TunableOp is enabled for the CPU execution
+// provider, the blocking and threading parameters tuned for the shape are used, and they are tuned on first use of
+// the shape if tuning is enabled as well.
+Status SgemmBatch(CpuTuningContext* tuning_ctx,
+                  CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                  size_t m, size_t n, size_t k,
+                  const MLAS_SGEMM_DATA_PARAMS* data, size_t batch,
+                  concurrency::ThreadPool* thread_pool);
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
@@ -94,10 +94,13 @@ common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue
     output_names_.push_back(name);
     outputs_.push_back(ml_value);
     outputs_device_info_.push_back(device);
+    output_buffers_.emplace_back();
   } else {
     outputs_[index] = ml_value;
     outputs_device_info_[index] = device;
+    output_buffers_[index] = {};
   }
+  output_buffers_[index].bound_to_device = !ml_value.IsAllocated();
   ORT_ENFORCE(mapped_output_names_.size() == output_names_.size(), "Size mismatch", mapped_output_names_.size(), "!=", output_names_.size());
 
   return Status::OK();
@@ -108,6 +111,97 @@ void IOBinding::ClearOutputs() {
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  output_buffers_.clear();
+}
+
+void IOBinding::RecycleOutputBuffers(bool enable) {
+  recycle_output_buffers_ = enable;
+  if (!enable) {
+    // release the buffers. the outputs of the last Run() keep theirs.
+    for (auto& buffer : output_buffers_) {
+      buffer.data.reset();
+      buffer.size = 0;
+      buffer.allocator.reset();
+    }
+  }
+}
+
+common::Status IOBinding::PrepareRecycledOutputs(
+    std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  if (!recycle_output_buffers_) {
+    return Status::OK();
+  }
+
+  const auto* execution_plan = session_state_.GetExecutionPlan();
+  ORT_RETURN_IF(execution_plan == nullptr, "Recycling output buffers requires an execution plan.");
+
+  for (size_t i = 0, end = output_names_.size(); i < end; ++i) {
+    if (!output_buffers_[i].bound_to_device) {
+      continue;
+    }
+
+    // the output of the previous Run() would otherwise be used as a pre-allocated output, which requires the shape
+    // of the output to stay the same
+    outputs_[i] = OrtValue();
+
+    int ort_value_idx;
+    ORT_RETURN_IF_ERROR(session_state_.GetOrtValueNameIdxMap().GetIdx(output_names_[i], ort_value_idx));
+    const auto* value_type = execution_plan->allocation_plan[ort_value_idx].value_type;
+    if (value_type == nullptr || !value_type->IsTensorType()) {
+      continue;
+    }
+
+    const auto* element_type = static_cast<const TensorTypeBase*>(value_type)->GetElementType();
+    if (utils::IsDataTypeString(element_type)) {
+      // string tensors own the strings in their buffer
+      continue;
+    }
+
+    fetch_allocators[i] = [this, i, element_type](const TensorShape& shape, const OrtDevice& device,
+                                                   OrtValue& ort_value, bool& allocated) {
+      return AllocateRecycledOutput(i, element_type, shape, device, ort_value, allocated);
+    };
+  }
+
+  return Status::OK();
+}
+
+common::Status IOBinding::AllocateRecycledOutput(size_t index, MLDataType element_type, const TensorShape& shape,
+                                                 const OrtDevice& device, OrtValue& ort_value, bool& allocated) {
+  const size_t size = Tensor::CalculateTensorStorageSize(element_type, shape);
+  if (size == 0) {
+    return Status::OK();
+  }
+
+  const OrtDevice& bound_device = outputs_device_info_[index];
+  auto& buffer = output_buffers_[index];
+  if (buffer.data == nullptr || buffer.size < size) {
+    auto allocator = session_state_.GetAllocator(bound_device);
+    ORT_RETURN_IF(allocator == nullptr, "Failed to find allocator for device ", bound_device.ToString());
+
+    // release the smaller buffer first so an arena can reuse its memory
+    buffer.data.reset();
+    buffer.data = IAllocator::MakeUniquePtr<void>(allocator, size);
+    buffer.size = size;
+    buffer.allocator = std::move(allocator);
+  }
+
+  // the value keeps the buffer alive if it is replaced by a larger one while the value is still in use
+  auto tensor = std::make_unique<Tensor>(element_type, shape, buffer.data.get(), buffer.allocator->Info());
+  OrtValue value;
+  value.Init(tensor.release(), DataTypeImpl::GetType<Tensor>(),
+             [data = buffer.data](void* p) { delete static_cast<Tensor*>(p); });
+
+  if (bound_device == device) {
+    ort_value = std::move(value);
+    allocated = true;
+  } else {
+    // the output is produced on another device. the execution frame allocates it there, and it is copied into the
+    // recycled buffer after the execution.
+    outputs_[index] = std::move(value);
+  }
+
+  return Status::OK();
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
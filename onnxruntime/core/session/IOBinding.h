@@ -2,11 +2,14 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
+#include "core/framework/allocator.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/iexecutor.h"
 #include "core/common/status.h"
 #include "core/graph/basic_types.h"
 #include "core/framework/ort_value.h"
@@ -71,6 +74,17 @@ class IOBinding {
    */
   common::Status BindOutput(const std::string& name, OrtDevice device = {});
 
+  /**
+   * Recycle the output buffers allocated by Run() for the outputs that are bound to a device.
+   * When enabled, Run() writes an output into the buffer it was allocated in by the previous Run() if the buffer is
+   * large enough, and replaces the buffer with a larger one if it is not. Once the largest output shapes have been
+   * seen, Run() does not allocate the outputs anymore.
+   * The output values of a Run() share their buffers with the next Run(), which overwrites their data.
+   * Only outputs that are produced on the device they are bound to are written directly into the recycled buffers.
+   * Outputs that are produced on a different device are copied into them.
+   */
+  void RecycleOutputBuffers(bool enable);
+
   /**
    * This simply collects the outputs obtained after calling Run() inside the @param outputs.
    */
@@ -107,6 +121,17 @@ class IOBinding {
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
 
+  // The buffer of an output that is bound to a device, which is reused by the next Run() if recycling is enabled.
+  struct OutputBuffer {
+    bool bound_to_device{false};
+    std::shared_ptr<void> data;
+    size_t size{0};
+    AllocatorPtr allocator;
+  };
+
+  bool recycle_output_buffers_{false};
+  std::vector<OutputBuffer> output_buffers_;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
   // device info for all outputs. only used by InferenceSession if the output is not pre-allocated.
@@ -114,5 +139,13 @@ class IOBinding {
 
   // The implementation for the BindOutput() overloads
   common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device);
+
+  // Resets the outputs that are bound to a device and returns the allocators that place them in their recycled
+  // buffers. Does nothing unless recycling is enabled.
+  common::Status PrepareRecycledOutputs(std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // The allocator for the output at `index` if recycling is enabled.
+  common::Status AllocateRecycledOutput(size_t index, MLDataType element_type, const TensorShape& shape,
+                                        const OrtDevice& device, OrtValue& ort_value, bool& allocated);
 };
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <list>
@@ -417,6 +418,9 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   }
 
   session_profiler_.Initialize(session_logger_);
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingHardwareCounters, "0") == "1") {
+    session_profiler_.EnableHardwareCounters();
+  }
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
@@ -520,6 +524,19 @@ InferenceSession::~InferenceSession() {
     }
   }
 
+  if (session_state_ != nullptr) {
+    const auto unmaterialized_initializers = session_state_->GetUnmaterializedInitializerNames();
+    if (!unmaterialized_initializers.empty()) {
+      std::ostringstream oss;
+      for (const auto& name : unmaterialized_initializers) {
+        oss << (oss.tellp() > 0 ? ", " : "") << name;
+      }
+      LOGS(*session_logger_, INFO) << unmaterialized_initializers.size()
+                                   << " initializers were never loaded as the graphs using them were not executed: "
+                                   << oss.str();
+    }
+  }
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   if (session_activity_started_)
     TraceLoggingWriteStop(session_activity, "OrtInferenceSessionActivity");
@@ -1470,6 +1487,24 @@ common::Status InferenceSession::Initialize() {
         session_options_,
         prepacked_weights_container_);
 
+    const std::string prepacked_weights_cache_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrepackedWeightsCacheFile, "");
+    if (!prepacked_weights_cache_file.empty() &&
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0") != "1") {
+      prepacked_weights_file_cache_ =
+          std::make_unique<PrepackedWeightsFileCache>(ToPathString(prepacked_weights_cache_file));
+      ORT_RETURN_IF_ERROR_SESSIONID_(prepacked_weights_file_cache_->Load(*session_logger_));
+      session_state_->SetPrepackedWeightsFileCache(prepacked_weights_file_cache_.get());
+    }
+
+    const std::string shared_weight_store_directory =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSharedWeightStoreDirectory, "");
+    if (!shared_weight_store_directory.empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(
+          SharedWeightStore::Open(ToPathString(shared_weight_store_directory), shared_weight_store_));
+      session_state_->SetSharedWeightStore(shared_weight_store_.get());
+    }
+
     bool use_env_allocators =
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1";
     if (use_env_allocators) {
@@ -1484,6 +1519,19 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    if (auto* cpu_ep = execution_providers_.Get(kCpuExecutionProvider); cpu_ep != nullptr) {
+      auto* tuning_ctx = cpu_ep->GetTuningContext();
+      const auto& config_options = session_options_.config_options;
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuTunableOpEnable, "0") == "1") {
+        tuning_ctx->EnableTunableOp();
+      }
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuTunableOpTuningEnable, "0") == "1") {
+        tuning_ctx->EnableTuning();
+      }
+      tuning_ctx->SetMaxTuningDurationMs(ParseStringWithClassicLocale<int>(
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuTunableOpMaxTuningDurationMs, "0")));
+    }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // Don't want to pollute SessionState constructor since memory profile is enabled optionally.
     session_state_->SetMemoryProfiler(&memory_profiler_);
@@ -1717,6 +1765,15 @@ common::Status InferenceSession::Initialize() {
                                              !saving_model,
                                              saving_ort_format));
 
+    if (prepacked_weights_file_cache_ != nullptr) {
+      // Failing to update the cache file only costs pre-packing time in later sessions.
+      auto status = prepacked_weights_file_cache_->Save(*session_logger_);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Failed to save the pre-packed weights cache file: "
+                                        << status.ErrorMessage();
+      }
+    }
+
 #if !defined(ORT_MINIMAL_BUILD)
     if (saving_model) {
       if (session_state_->GetFuncMgr().NumFuncs() > 0) {
@@ -1838,6 +1895,10 @@ const SessionOptions& InferenceSession::GetSessionOptions() const {
   return session_options_;
 }
 
+int InferenceSession::GetIntraOpDegreeOfParallelism() const {
+  return concurrency::ThreadPool::DegreeOfParallelism(GetIntraOpThreadPoolToUse());
+}
+
 const DataTransferManager& InferenceSession::GetDataTransferManager() const {
   return data_transfer_mgr_;
 }
@@ -2125,7 +2186,8 @@ struct ThreadPoolSpinningSwitch {
 Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
-                             const std::vector<OrtDevice>* p_fetches_device_info) {
+                             const std::vector<OrtDevice>* p_fetches_device_info,
+                             const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -2240,6 +2302,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
       DeviceStreamCollectionHolder device_stream_collection_holder(session_state_.get());
 #endif
 
+      const std::unordered_map<size_t, IExecutor::CustomAllocator> no_fetch_allocators;
       if (retval.IsOK()) {
         retval = utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
                                      session_options_.execution_mode,
@@ -2247,7 +2310,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #ifdef ORT_ENABLE_STREAM
                                      device_stream_collection_holder,
 #endif
-                                     run_logger);
+                                     run_logger,
+                                     p_fetch_allocators ? *p_fetch_allocators : no_fetch_allocators);
       }
 
       // info all execution providers InferenceSession:Run ended
@@ -2449,6 +2513,150 @@ common::Status InferenceSession::Run(const RunOptions& run_options, const NameML
   return Run(run_options, feed_names, feeds, output_names, p_fetches, nullptr);
 }
 
+common::Status InferenceSession::WarmUp(const RunOptions& run_options,
+                                        gsl::span<const InlinedHashMap<std::string, TensorShape>> input_shapes,
+                                        std::vector<std::chrono::microseconds>* durations) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  auto [inputs_status, input_defs] = GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs_status);
+  auto [outputs_status, output_defs] = GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs_status);
+
+  std::vector<std::string> output_names;
+  output_names.reserve(output_defs->size());
+  for (const auto* output_def : *output_defs) {
+    output_names.push_back(output_def->Name());
+  }
+
+  // arena shrinkage would release the memory that the warm-up runs are meant to reserve
+  RunOptions warm_up_run_options = run_options;
+  warm_up_run_options.config_options.configurations.erase(kOrtRunOptionsConfigEnableMemoryArenaShrinkage);
+  if (warm_up_run_options.run_tag.empty()) {
+    warm_up_run_options.run_tag = "warm-up";
+  }
+
+  AllocatorPtr cpu_allocator = session_state_->GetAllocator(OrtDevice());
+
+  if (durations != nullptr) {
+    durations->clear();
+    durations->reserve(input_shapes.size());
+  }
+
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    const auto& shapes = input_shapes[i];
+    for (const auto& entry : shapes) {
+      ORT_RETURN_IF(std::none_of(input_defs->begin(), input_defs->end(),
+                                 [&entry](const NodeArg* input_def) { return input_def->Name() == entry.first; }),
+                    "Invalid input name for warm-up run ", i, ": ", entry.first);
+    }
+
+    NameMLValMap feeds;
+    for (const auto* input_def : *input_defs) {
+      const std::string& name = input_def->Name();
+      const auto* type_proto = input_def->TypeAsProto();
+      ORT_RETURN_IF(type_proto == nullptr || !utils::HasTensorType(*type_proto),
+                    "Warm-up only supports tensor inputs. Input ", name, " is not a tensor.");
+
+      TensorShape shape;
+      if (auto it = shapes.find(name); it != shapes.end()) {
+        shape = it->second;
+      } else {
+        const auto* shape_proto = input_def->Shape();
+        ORT_RETURN_IF(shape_proto == nullptr, "The shape of input ", name, " must be provided for warm-up run ", i,
+                      " as the model does not define it.");
+        shape = utils::GetTensorShapeFromTensorShapeProto(*shape_proto);
+      }
+      ORT_RETURN_IF(shape.Size() < 0, "The shape of input ", name, " for warm-up run ", i,
+                    " is not fully defined: ", shape);
+
+      const auto* element_type = DataTypeImpl::TensorTypeFromONNXEnum(
+                                     type_proto->tensor_type().elem_type())
+                                     ->GetElementType();
+      OrtValue value;
+      Tensor::InitOrtValue(element_type, shape, cpu_allocator, value);
+      auto* tensor = value.GetMutable<Tensor>();
+      if (!tensor->IsDataTypeString()) {
+        memset(tensor->MutableDataRaw(), 0, tensor->SizeInBytes());
+      }
+      feeds.emplace(name, std::move(value));
+    }
+
+    std::vector<OrtValue> fetches;
+    const auto start = std::chrono::steady_clock::now();
+    ORT_RETURN_IF_ERROR(Run(warm_up_run_options, feeds, output_names, &fetches));
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    LOGS(*session_logger_, INFO) << "Warm-up run " << i << " took " << duration.count() << " us";
+    if (durations != nullptr) {
+      durations->push_back(duration);
+    }
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::Clone(std::unique_ptr<InferenceSession>& clone) const {
+  std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  auto session = std::make_unique<InferenceSession>(session_options_, environment_);
+
+  // share the loaded and optimized model
+  session->model_ = model_;
+  session->model_location_ = model_location_;
+  ORT_RETURN_IF_ERROR_SESSIONID_(session->SaveModelMetadata(*model_));
+  session->is_concurrent_run_supported_ = is_concurrent_run_supported_;
+
+  // share the execution provider instances as the kernels were created by them
+  const auto& provider_ids = execution_providers_.GetIds();
+  size_t provider_idx = 0;
+  for (const auto& provider : execution_providers_) {
+    auto data_transfer = provider->GetDataTransfer();
+    if (data_transfer) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(session->data_transfer_mgr_.RegisterDataTransfer(std::move(data_transfer)));
+    }
+    ORT_RETURN_IF_ERROR_SESSIONID_(session->execution_providers_.Add(provider_ids[provider_idx++], provider));
+  }
+  session->execution_providers_.SetCpuProviderWasImplicitlyAdded(
+      execution_providers_.GetCpuProviderWasImplicitlyAdded());
+
+  // share the kernels, initializers and execution plan
+  ORT_RETURN_IF_ERROR_SESSIONID_(session_state_->Clone(session->execution_providers_,
+                                                       session->GetIntraOpThreadPoolToUse(),
+                                                       session->GetInterOpThreadPoolToUse(),
+                                                       session->data_transfer_mgr_,
+                                                       *session->session_logger_,
+                                                       session->session_profiler_,
+                                                       session->session_options_,
+                                                       session->session_state_));
+
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1") {
+    session->session_state_->UpdateAllocatorsWithEnvAllocators(environment_.GetRegisteredSharedAllocators());
+  }
+
+#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
+  session->session_state_->SetMemoryProfiler(&session->memory_profiler_);
+#endif
+
+  session->is_model_loaded_ = true;
+  session->is_inited_ = true;
+
+  LOGS(*session_logger_, INFO) << "Session " << session_id_ << " cloned to session " << session->session_id_;
+  clone = std::move(session);
+  return Status::OK();
+}
+
 std::pair<common::Status, const ModelMetadata*> InferenceSession::GetModelMetadata() const {
   {
     std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
@@ -2515,8 +2723,10 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  ORT_RETURN_IF_ERROR_SESSIONID_(io_binding.PrepareRecycledOutputs(fetch_allocators));
   return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo(), &fetch_allocators);
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
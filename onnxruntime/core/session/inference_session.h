@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 
@@ -303,7 +304,9 @@ class InferenceSession {
   [[nodiscard]] common::Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
                                    gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
                                    std::vector<OrtValue>* p_fetches,
-                                   const std::vector<OrtDevice>* p_fetches_device_info = nullptr);
+                                   const std::vector<OrtDevice>* p_fetches_device_info = nullptr,
+                                   const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators =
+                                       nullptr);
 
   [[nodiscard]] common::Status Run(const RunOptions& run_options,
                                    gsl::span<const char* const> feed_names,
@@ -351,6 +354,35 @@ class InferenceSession {
   [[nodiscard]] virtual common::Status Run(const RunOptions& run_options, IOBinding& io_binding);
   [[nodiscard]] common::Status Run(IOBinding& io_binding);
 
+  /**
+   * Warms up the session by running it once for each of the provided sets of input shapes with zero valued inputs.
+   * This populates the state that is created on the first Run for a set of input shapes, such as the memory
+   * patterns, tuned kernels and kernel scratch buffers, and grows the arenas to the peak usage of these runs.
+   * Arena shrinkage requested in the run options is not applied, so the memory is kept for the next Run.
+   * The model must only have tensor inputs, and must accept zero valued inputs.
+   * This API is thread-safe.
+   * @param run_options run options for the warm-up runs.
+   * @param input_shapes the input shapes of each warm-up run. Inputs that are not listed must have a fully defined
+   *        shape in the model.
+   * @param durations optional. receives the duration of each warm-up run.
+   * @return OK if success.
+   */
+  [[nodiscard]] common::Status WarmUp(const RunOptions& run_options,
+                                      gsl::span<const InlinedHashMap<std::string, TensorShape>> input_shapes,
+                                      std::vector<std::chrono::microseconds>* durations = nullptr);
+
+  /**
+   * Creates a session that shares the optimized graph, the initializers, the pre-packed weights and the kernels of
+   * this session, and has its own thread pools, allocators, memory patterns and profiler.
+   * The clone uses the session options of this session. Creating it does not load, optimize or pre-pack the model.
+   * This session must be initialized, and must outlive the clone. If this session is itself a clone, the session it
+   * was cloned from must outlive the new clone as well.
+   * This API is thread-safe.
+   * @param clone receives the new session.
+   * @return OK if success.
+   */
+  [[nodiscard]] common::Status Clone(std::unique_ptr<InferenceSession>& clone) const;
+
 #ifdef ENABLE_TRAINING
   /**
    * Partially run a pre-loaded and pre-intialized model.
@@ -420,6 +452,11 @@ class InferenceSession {
    */
   const SessionOptions& GetSessionOptions() const;
 
+  /*
+   * Get the number of threads, including the calling thread, that run the operators of this session in parallel.
+   */
+  int GetIntraOpDegreeOfParallelism() const;
+
   /*
    * Get the DataTransferManager associated with this session
    */
@@ -691,6 +728,12 @@ class InferenceSession {
   MemoryProfiler memory_profiler_;
 #endif
 
+  // File backed cache of pre-packed weights. Declared before session_state_ as the kernels may use its buffers.
+  std::unique_ptr<PrepackedWeightsFileCache> prepacked_weights_file_cache_;
+
+  // Store of weights shared with other processes. Declared before session_state_ as the weights are mapped by it.
+  std::unique_ptr<SharedWeightStore> shared_weight_store_;
+
   // Immutable state for each op in the model. Shared by all executors.
   // It has a dependency on execution_providers_.
   std::unique_ptr<SessionState> session_state_;
@@ -33,6 +33,7 @@
 #include "core/session/inference_session.h"
 #include "core/session/ort_apis.h"
 #include "core/session/ort_env.h"
+#include "core/session/request_batcher.h"
 #include "core/framework/data_types.h"
 #include "abi_session_options_impl.h"
 #include "core/framework/TensorSeq.h"
@@ -241,6 +242,37 @@ ORT_API_STATUS_IMPL(OrtApis::CreateTensorWithDataAsOrtValue, _In_ const OrtMemor
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateTensorView, _In_ const OrtValue* value, size_t element_offset,
+                    _In_ const int64_t* shape, size_t shape_len, _Outptr_ OrtValue** out) {
+  TENSOR_READ_API_BEGIN
+  TensorShape view_shape(shape, shape_len);
+  for (size_t i = 0; i != shape_len; ++i) {
+    if (shape[i] < 0) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "tried creating a tensor view with a negative dimension");
+    }
+  }
+#ifdef ENABLE_STRIDED_TENSORS
+  if (!tensor.IsContiguous()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "tried creating a tensor view of a non-contiguous tensor");
+  }
+#endif
+  const size_t num_elements = narrow<size_t>(tensor.Shape().Size());
+  if (element_offset > num_elements || narrow<size_t>(view_shape.Size()) > num_elements - element_offset) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "tensor view exceeds the elements of the tensor");
+  }
+
+  // The view refers to the buffer of the tensor, which it keeps alive by holding a reference to its OrtValue.
+  auto view = std::make_unique<Tensor>(tensor.DataType(), view_shape, const_cast<void*>(tensor.DataRaw()),
+                                       tensor.Location(),
+                                       narrow<ptrdiff_t>(element_offset * tensor.DataType()->Size()));
+  auto view_value = std::make_unique<OrtValue>();
+  view_value->Init(view.release(), DataTypeImpl::GetType<Tensor>(),
+                   [buffer_owner = *v](void* p) { delete static_cast<Tensor*>(p); });
+  *out = view_value.release();
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::CreateTensorAsOrtValue, _Inout_ OrtAllocator* allocator,
                     _In_ const int64_t* shape, size_t shape_len, ONNXTensorElementDataType type,
                     _Outptr_ OrtValue** out) {
@@ -870,6 +902,91 @@ ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionWarmUp, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_names_len) const char* const* input_names, size_t input_names_len,
+                    _In_reads_(num_warm_up_runs* input_names_len) const int64_t* const* input_shapes,
+                    _In_reads_(num_warm_up_runs* input_names_len) const size_t* input_shape_lens,
+                    size_t num_warm_up_runs, _Out_writes_opt_(num_warm_up_runs) int64_t* durations_us) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<InlinedHashMap<std::string, TensorShape>> warm_up_input_shapes(num_warm_up_runs);
+  for (size_t i = 0; i < num_warm_up_runs; ++i) {
+    for (size_t j = 0; j < input_names_len; ++j) {
+      const size_t shape_idx = i * input_names_len + j;
+      warm_up_input_shapes[i].emplace(input_names[j],
+                                      TensorShape(gsl::make_span(input_shapes[shape_idx], input_shape_lens[shape_idx])));
+    }
+  }
+
+  std::vector<std::chrono::microseconds> durations;
+  const RunOptions default_run_options;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->WarmUp(run_options != nullptr ? *run_options : default_run_options,
+                                                  warm_up_input_shapes, &durations));
+
+  if (durations_us != nullptr) {
+    for (size_t i = 0; i < durations.size(); ++i) {
+      durations_us[i] = durations[i].count();
+    }
+  }
+
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateRequestBatcher, _Inout_ OrtSession* sess, size_t max_batch_size,
+                    int64_t max_wait_us, _Outptr_ OrtRequestBatcher** out) {
+  API_IMPL_BEGIN
+  if (max_batch_size == 0 || max_wait_us < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "max_batch_size must be greater than zero and max_wait_us must not be negative");
+  }
+
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  RequestBatcherOptions options;
+  options.max_batch_size = max_batch_size;
+  options.max_wait = std::chrono::microseconds(max_wait_us);
+  auto batcher = std::make_unique<RequestBatcher>(*session, options);
+  *out = reinterpret_cast<OrtRequestBatcher*>(batcher.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RequestBatcherSubmit, _Inout_ OrtRequestBatcher* batcher,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  gsl::span<const char* const> input_names_span(input_names, input_len);
+  gsl::span<const OrtValue* const> input_span(input, input_len);
+  gsl::span<const char* const> output_name_span(output_names, output_names_len);
+  gsl::span<OrtValue*> output_span(output, output_names_len);
+
+  return ToOrtStatus(reinterpret_cast<RequestBatcher*>(batcher)->Submit(input_names_span,
+                                                                        input_span,
+                                                                        output_name_span,
+                                                                        output_span,
+                                                                        run_async_callback,
+                                                                        user_data));
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseRequestBatcher, _Frees_ptr_opt_ OrtRequestBatcher* batcher) {
+  delete reinterpret_cast<RequestBatcher*>(batcher);
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CloneSession, _In_ const OrtSession* sess, _Outptr_ OrtSession** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::unique_ptr<::onnxruntime::InferenceSession> clone;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->Clone(clone));
+  *out = reinterpret_cast<OrtSession*>(clone.release());
+  return nullptr;
+  API_IMPL_END
+}
+
 struct OrtIoBinding {
   std::unique_ptr<::onnxruntime::IOBinding> binding_;
   explicit OrtIoBinding(std::unique_ptr<::onnxruntime::IOBinding>&& binding) : binding_(std::move(binding)) {}
@@ -1053,6 +1170,13 @@ ORT_API_STATUS_IMPL(OrtApis::SynchronizeBoundOutputs, _Inout_ OrtIoBinding* bind
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RecycleBoundOutputBuffers, _Inout_ OrtIoBinding* binding_ptr, int recycle) {
+  API_IMPL_BEGIN
+  binding_ptr->binding_->RecycleOutputBuffers(recycle != 0);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::IsTensor, _In_ const OrtValue* value, _Out_ int* out) {
   auto v = reinterpret_cast<const ::OrtValue*>(value);
   *out = v->IsTensor() ? 1 : 0;
@@ -2397,7 +2521,7 @@ Second example, if we wanted to add and remove some members, we'd do this:
     In GetApi we now make it return ort_api_3 for version 3.
 */
 
-static constexpr OrtApi ort_api_1_to_16 = {
+static constexpr OrtApi ort_api_1_to_17 = {
     // NOTE: The ordering of these fields MUST not change after that version has shipped since existing binaries depend on this ordering.
 
     // Shipped as version 1 - DO NOT MODIFY (see above text for more information)
@@ -2713,6 +2837,15 @@ static constexpr OrtApi ort_api_1_to_16 = {
     &OrtApis::GetCUDAProviderOptionsByName,
     &OrtApis::KernelContext_GetResource,
     // End of Version 16 - DO NOT MODIFY ABOVE (see above text for more information)
+
+    &OrtApis::SessionWarmUp,
+    &OrtApis::CreateRequestBatcher,
+    &OrtApis::RequestBatcherSubmit,
+    &OrtApis::ReleaseRequestBatcher,
+    &OrtApis::CloneSession,
+    &OrtApis::RecycleBoundOutputBuffers,
+    &OrtApis::RunOptionsSetDeadline,
+    &OrtApis::CreateTensorView,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
@@ -2747,13 +2880,13 @@ static_assert(offsetof(OrtApi, KernelContext_GetResource) / sizeof(void*) == 265
 static_assert(std::string_view(ORT_VERSION) == "1.16.3",
               "ORT_Version change detected, please follow below steps to ensure OrtApi is updated properly");
 // 1. Update the hardcoded version string in above static_assert to silence it
-// 2. If there were any APIs added to ort_api_1_to_16 above:
+// 2. If there were any APIs added to ort_api_1_to_17 above:
 //    a. Add the 'End of version #' markers (pattern above should be obvious)
 //    b. Add a static_assert in the directly above list of version sizes to ensure nobody adds any more functions to the just shipped API version
 
 ORT_API(const OrtApi*, OrtApis::GetApi, uint32_t version) {
   if (version >= 1 && version <= ORT_API_VERSION)
-    return &ort_api_1_to_16;
+    return &ort_api_1_to_17;
 
   fprintf(stderr,
           "The requested API version [%u] is not available, only API versions [1, %u] are supported in this build."
@@ -491,4 +491,25 @@ ORT_API_STATUS_IMPL(GetTensorRTProviderOptionsByName, _In_ const OrtTensorRTProv
 ORT_API_STATUS_IMPL(UpdateCUDAProviderOptionsWithValue, _Inout_ OrtCUDAProviderOptionsV2* cuda_options, _In_ const char* key, _In_ void* value);
 ORT_API_STATUS_IMPL(GetCUDAProviderOptionsByName, _In_ const OrtCUDAProviderOptionsV2* cuda_options, _In_ const char* key, _Outptr_ void** ptr);
 ORT_API_STATUS_IMPL(KernelContext_GetResource, _In_ const OrtKernelContext* context, _In_ int resource_version, _In_ int resource_id, _Outptr_ void** stream);
+
+ORT_API_STATUS_IMPL(SessionWarmUp, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_names_len) const char* const* input_names, size_t input_names_len,
+                    _In_reads_(num_warm_up_runs* input_names_len) const int64_t* const* input_shapes,
+                    _In_reads_(num_warm_up_runs* input_names_len) const size_t* input_shape_lens,
+                    size_t num_warm_up_runs, _Out_writes_opt_(num_warm_up_runs) int64_t* durations_us);
+
+ORT_API_STATUS_IMPL(CreateRequestBatcher, _Inout_ OrtSession* session, size_t max_batch_size, int64_t max_wait_us,
+                    _Outptr_ OrtRequestBatcher** out);
+ORT_API_STATUS_IMPL(RequestBatcherSubmit, _Inout_ OrtRequestBatcher* batcher,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+ORT_API(void, ReleaseRequestBatcher, _Frees_ptr_opt_ OrtRequestBatcher*);
+ORT_API_STATUS_IMPL(CloneSession, _In_ const OrtSession* session, _Outptr_ OrtSession** out);
+ORT_API_STATUS_IMPL(RecycleBoundOutputBuffers, _Inout_ OrtIoBinding* binding_ptr, int recycle);
+ORT_API_STATUS_IMPL(RunOptionsSetDeadline, _Inout_ OrtRunOptions* options, int64_t timeout_us);
+ORT_API_STATUS_IMPL(CreateTensorView, _In_ const OrtValue* value, size_t element_offset, _In_ const int64_t* shape,
+                    size_t shape_len, _Outptr_ OrtValue** out);
 }  // namespace OrtApis
@@ -0,0 +1,385 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/request_batcher.h"
+
+#include <cstring>
+#include <string>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/error_code_helper.h"
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+struct RequestBatcher::Request {
+  gsl::span<const char* const> feed_names;
+  gsl::span<const OrtValue* const> feeds;
+  gsl::span<const char* const> fetch_names;
+  gsl::span<OrtValue*> fetches;
+  RunAsyncCallbackFn callback;
+  void* user_data;
+  // Size of the first dimension of all the feeds, or -1 if the request cannot be batched with other requests.
+  int64_t batch_size;
+  std::chrono::steady_clock::time_point enqueue_time;
+};
+
+namespace {
+
+bool IsBatchableTensor(const OrtValue& value) {
+  if (!value.IsAllocated() || !value.IsTensor()) {
+    return false;
+  }
+
+  const auto& tensor = value.Get<Tensor>();
+  return tensor.Location().device.Type() == OrtDevice::CPU &&
+         !tensor.IsDataTypeString() &&
+         tensor.Shape().NumDimensions() > 0;
+}
+
+int64_t GetBatchSize(gsl::span<const OrtValue* const> feeds) {
+  int64_t batch_size = -1;
+  for (const auto* feed : feeds) {
+    if (feed == nullptr || !IsBatchableTensor(*feed)) {
+      return -1;
+    }
+
+    const int64_t dim = feed->Get<Tensor>().Shape()[0];
+    if (dim <= 0 || (batch_size != -1 && dim != batch_size)) {
+      return -1;
+    }
+
+    batch_size = dim;
+  }
+
+  return batch_size;
+}
+
+// Returns true if the first dimension of every input and output of the model is the same symbolic dimension, which is
+// then taken to be the batch dimension. A model whose first dimension is not the batch, e.g. a sequence-first model,
+// could otherwise be fed inputs concatenated along another axis and have its outputs split along it.
+bool HasSymbolicBatchDimension(const InferenceSession& session, std::string& reason) {
+  const auto inputs = session.GetModelInputs();
+  const auto outputs = session.GetModelOutputs();
+  if (!inputs.first.IsOK() || !outputs.first.IsOK()) {
+    reason = "the inputs and outputs of the model are not known";
+    return false;
+  }
+
+  std::string batch_dim_param;
+  auto check = [&](const NodeArg& arg) {
+    const auto* shape = arg.Shape();
+    if (shape == nullptr || shape->dim_size() == 0) {
+      reason = MakeString("'", arg.Name(), "' does not have a first dimension");
+      return false;
+    }
+
+    const auto& dim = shape->dim(0);
+    if (dim.has_dim_value()) {
+      reason = MakeString("the first dimension of '", arg.Name(), "' is fixed to ", dim.dim_value());
+      return false;
+    }
+
+    if (dim.has_dim_param()) {
+      if (batch_dim_param.empty()) {
+        batch_dim_param = dim.dim_param();
+      } else if (dim.dim_param() != batch_dim_param) {
+        reason = MakeString("the first dimension of '", arg.Name(), "' is '", dim.dim_param(), "' instead of '",
+                            batch_dim_param, "'");
+        return false;
+      }
+    }
+
+    return true;
+  };
+
+  for (const auto* arg : *inputs.second) {
+    if (!check(*arg)) {
+      return false;
+    }
+  }
+
+  for (const auto* arg : *outputs.second) {
+    if (!check(*arg)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool SameNames(gsl::span<const char* const> names, gsl::span<const char* const> other) {
+  if (names.size() != other.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (std::strcmp(names[i], other[i]) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Creates a tensor over rows [row, row + num_rows) of a batched output without copying.
+// The returned OrtValue keeps the batched output alive.
+OrtValue SliceRows(const OrtValue& batch_value, int64_t row, int64_t num_rows) {
+  const auto& batch_tensor = batch_value.Get<Tensor>();
+  const auto& batch_shape = batch_tensor.Shape();
+  const size_t row_size = batch_tensor.SizeInBytes() / narrow<size_t>(batch_shape[0]);
+
+  TensorShapeVector dims = batch_shape.AsShapeVector();
+  dims[0] = num_rows;
+
+  auto* data = static_cast<char*>(const_cast<void*>(batch_tensor.DataRaw())) + narrow<size_t>(row) * row_size;
+  auto tensor = std::make_unique<Tensor>(batch_tensor.DataType(), TensorShape(dims), data, batch_tensor.Location());
+
+  OrtValue slice;
+  slice.Init(tensor.release(), DataTypeImpl::GetType<Tensor>(),
+             [batch_value](void* p) { delete static_cast<Tensor*>(p); });
+  return slice;
+}
+
+}  // namespace
+
+RequestBatcher::RequestBatcher(InferenceSession& session, const RequestBatcherOptions& options)
+    : session_(session),
+      options_(options),
+      allocator_(std::make_shared<CPUAllocator>()) {
+  ORT_ENFORCE(options_.max_batch_size > 0, "max_batch_size must be greater than zero");
+  ORT_ENFORCE(options_.num_workers > 0, "num_workers must be greater than zero");
+
+  std::string reason;
+  if (!HasSymbolicBatchDimension(session_, reason)) {
+    LOGS_DEFAULT(WARNING) << "Requests are not batched as the model does not have a batch dimension: " << reason;
+    batching_disabled_ = true;
+  }
+
+  workers_.reserve(options_.num_workers);
+  for (size_t i = 0; i < options_.num_workers; ++i) {
+    workers_.emplace_back([this]() { ProcessRequests(); });
+  }
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    shutdown_ = true;
+  }
+
+  requests_available_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+Status RequestBatcher::Submit(gsl::span<const char* const> feed_names,
+                              gsl::span<const OrtValue* const> feeds,
+                              gsl::span<const char* const> fetch_names,
+                              gsl::span<OrtValue*> fetches,
+                              RunAsyncCallbackFn callback,
+                              void* user_data) {
+  ORT_RETURN_IF_NOT(feed_names.size() == feeds.size(), "The number of feed names and feeds must match");
+  ORT_RETURN_IF_NOT(fetch_names.size() == fetches.size(), "The number of fetch names and fetches must match");
+  ORT_RETURN_IF_NOT(callback != nullptr, "A callback is required");
+
+  auto request = std::make_unique<Request>();
+  request->feed_names = feed_names;
+  request->feeds = feeds;
+  request->fetch_names = fetch_names;
+  request->fetches = fetches;
+  request->callback = callback;
+  request->user_data = user_data;
+  request->batch_size = batching_disabled_ ? -1 : GetBatchSize(feeds);
+  if (request->batch_size > static_cast<int64_t>(options_.max_batch_size)) {
+    request->batch_size = -1;
+  }
+
+  request->enqueue_time = std::chrono::steady_clock::now();
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    ORT_RETURN_IF(shutdown_, "The request batcher is shutting down");
+    requests_.push_back(std::move(request));
+  }
+
+  // wake the worker that is forming a batch as well as an idle one
+  requests_available_.notify_all();
+  return Status::OK();
+}
+
+bool RequestBatcher::CanBatch(const Request& request, const Request& other) {
+  if (other.batch_size == -1 ||
+      !SameNames(request.feed_names, other.feed_names) ||
+      !SameNames(request.fetch_names, other.fetch_names)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < request.feeds.size(); ++i) {
+    const auto& tensor = request.feeds[i]->Get<Tensor>();
+    const auto& other_tensor = other.feeds[i]->Get<Tensor>();
+    if (tensor.DataType() != other_tensor.DataType() ||
+        tensor.Shape().Slice(1) != other_tensor.Shape().Slice(1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void RequestBatcher::ProcessRequests() {
+  const size_t max_batch_size = options_.max_batch_size;
+
+  std::unique_lock<OrtMutex> lock(mutex_);
+  for (;;) {
+    requests_available_.wait(lock, [this]() { return !forming_batch_ && (shutdown_ || !requests_.empty()); });
+    if (requests_.empty()) {
+      // shutting down and all the pending requests have been run
+      return;
+    }
+
+    forming_batch_ = true;
+    std::vector<std::unique_ptr<Request>> batch;
+    batch.push_back(std::move(requests_.front()));
+    requests_.pop_front();
+
+    const Request& first = *batch.front();
+    if (first.batch_size != -1) {
+      size_t num_rows = narrow<size_t>(first.batch_size);
+      const auto deadline = first.enqueue_time + options_.max_wait;
+
+      for (;;) {
+        for (auto it = requests_.begin(); it != requests_.end() && num_rows < max_batch_size;) {
+          if (CanBatch(first, **it) && num_rows + narrow<size_t>((*it)->batch_size) <= max_batch_size) {
+            num_rows += narrow<size_t>((*it)->batch_size);
+            batch.push_back(std::move(*it));
+            it = requests_.erase(it);
+          } else {
+            ++it;
+          }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (num_rows >= max_batch_size || shutdown_ || now >= deadline) {
+          break;
+        }
+
+        requests_available_.wait_for(lock, deadline - now);
+      }
+    }
+
+    // let another worker form the next batch while this one runs
+    forming_batch_ = false;
+    requests_available_.notify_all();
+
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+  }
+}
+
+Status RequestBatcher::RunRequest(Request& request) {
+  return session_.Run(run_options_, request.feed_names, request.feeds, request.fetch_names, request.fetches);
+}
+
+void RequestBatcher::RunBatch(std::vector<std::unique_ptr<Request>>& batch) {
+  std::vector<Status> statuses(batch.size());
+
+  ORT_TRY {
+    if (batch.size() == 1) {
+      statuses[0] = RunRequest(*batch.front());
+    } else {
+      const Request& first = *batch.front();
+      int64_t num_rows = 0;
+      for (const auto& request : batch) {
+        num_rows += request->batch_size;
+      }
+
+      // concatenate the feeds along the batch dimension
+      std::vector<std::string> feed_names(first.feed_names.begin(), first.feed_names.end());
+      std::vector<OrtValue> feeds(first.feeds.size());
+      for (size_t i = 0; i < feeds.size(); ++i) {
+        const auto& first_tensor = first.feeds[i]->Get<Tensor>();
+        TensorShapeVector dims = first_tensor.Shape().AsShapeVector();
+        dims[0] = num_rows;
+        Tensor::InitOrtValue(first_tensor.DataType(), TensorShape(dims), allocator_, feeds[i]);
+
+        auto* dst = static_cast<char*>(feeds[i].GetMutable<Tensor>()->MutableDataRaw());
+        for (const auto& request : batch) {
+          const auto& tensor = request->feeds[i]->Get<Tensor>();
+          memcpy(dst, tensor.DataRaw(), tensor.SizeInBytes());
+          dst += tensor.SizeInBytes();
+        }
+      }
+
+      std::vector<std::string> fetch_names(first.fetch_names.begin(), first.fetch_names.end());
+      std::vector<OrtValue> fetches;
+      Status status = session_.Run(run_options_, feed_names, feeds, fetch_names, &fetches);
+
+      bool has_batch_dimension = true;
+      for (size_t i = 0; status.IsOK() && i < fetches.size(); ++i) {
+        if (!IsBatchableTensor(fetches[i]) || fetches[i].Get<Tensor>().Shape()[0] != num_rows) {
+          if (!batching_disabled_.exchange(true)) {
+            LOGS_DEFAULT(WARNING) << "Output '" << fetch_names[i] << "' of a batched run is not a CPU tensor with a "
+                                  << "batch dimension of " << num_rows << ". Requests are no longer batched.";
+          }
+          has_batch_dimension = false;
+          break;
+        }
+      }
+
+      // split the outputs along the batch dimension, or run the requests on their own if that is not possible
+      int64_t row = 0;
+      for (size_t r = 0; r < batch.size(); ++r) {
+        if (!has_batch_dimension) {
+          statuses[r] = RunRequest(*batch[r]);
+          continue;
+        }
+
+        auto& request = *batch[r];
+        statuses[r] = status;
+        for (size_t i = 0; statuses[r].IsOK() && i < fetches.size(); ++i) {
+          OrtValue slice = SliceRows(fetches[i], row, request.batch_size);
+          OrtValue*& fetch = request.fetches[i];
+          if (fetch == nullptr) {
+            fetch = new OrtValue(std::move(slice));
+            continue;
+          }
+
+          const auto& src = slice.Get<Tensor>();
+          if (!fetch->IsTensor() ||
+              fetch->Get<Tensor>().Location().device.Type() != OrtDevice::CPU ||
+              fetch->Get<Tensor>().DataType() != src.DataType() ||
+              fetch->Get<Tensor>().Shape() != src.Shape()) {
+            statuses[r] = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Preallocated output '", fetch_names[i],
+                                          "' must be a CPU tensor of type ", DataTypeImpl::ToString(src.DataType()),
+                                          " and shape ", src.Shape());
+            break;
+          }
+
+          memcpy(fetch->GetMutable<Tensor>()->MutableDataRaw(), src.DataRaw(), src.SizeInBytes());
+        }
+
+        row += request.batch_size;
+      }
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      std::fill(statuses.begin(), statuses.end(), ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what()));
+    });
+  }
+  ORT_CATCH(...) {
+    std::fill(statuses.begin(), statuses.end(), ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception"));
+  }
+
+  for (size_t r = 0; r < batch.size(); ++r) {
+    auto& request = *batch[r];
+    request.callback(request.user_data, request.fetches.data(),
+                     statuses[r].IsOK() ? request.fetches.size() : 0, ToOrtStatus(statuses[r]));
+  }
+}
+
+}  // namespace onnxruntime
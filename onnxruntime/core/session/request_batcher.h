@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+struct RequestBatcherOptions {
+  // Maximum number of rows in the batch dimension of a batch. Requests with more rows are run on their own.
+  size_t max_batch_size = 8;
+  // Maximum time the oldest request of a batch waits for more requests before the batch is run.
+  std::chrono::microseconds max_wait{1000};
+  // Number of threads that run batches. Batches are formed one at a time, so with more than one thread the next
+  // batch is formed and run while the previous ones are still running.
+  size_t num_workers = 2;
+};
+
+/**
+ * Combines the requests that are submitted concurrently for a session into batches.
+ *
+ * The inputs of the requests in a batch are concatenated along their first (batch) dimension and run with a single
+ * InferenceSession::Run call on one of the threads owned by the batcher. The outputs are split along their first
+ * dimension and returned to the callback of each request, in the same way as InferenceSession::RunAsync.
+ *
+ * Requests are batched together if they have the same input and output names, and their inputs are non-string CPU
+ * tensors with the same element types and the same shapes apart from the first dimension, which must be the same
+ * for all the inputs of a request. Other requests are run on their own.
+ * Requests are only batched if the first dimension of every input and output of the model is declared as the same
+ * symbolic dimension, which is taken to be the batch dimension.
+ * As a second safeguard, if an output of a batched run is not a CPU tensor whose first dimension is the sum of the first dimensions of the
+ * batched inputs, the model cannot be batched: the requests of the batch are run on their own, and batching is
+ * disabled for the later requests.
+ *
+ * The session must outlive the batcher.
+ */
+class RequestBatcher {
+ public:
+  RequestBatcher(InferenceSession& session, const RequestBatcherOptions& options);
+
+  // Runs the pending requests and stops the batching threads.
+  ~RequestBatcher();
+
+  /**
+   * Queues a request. The arguments have the same meaning as the arguments of InferenceSession::RunAsync:
+   * the arrays must stay valid until the callback is called, and the entries of fetches can be nullptr
+   * or preallocated OrtValues that the outputs are copied to.
+   */
+  Status Submit(gsl::span<const char* const> feed_names,
+                gsl::span<const OrtValue* const> feeds,
+                gsl::span<const char* const> fetch_names,
+                gsl::span<OrtValue*> fetches,
+                RunAsyncCallbackFn callback,
+                void* user_data = nullptr);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RequestBatcher);
+
+ private:
+  struct Request;
+
+  static bool CanBatch(const Request& request, const Request& other);
+
+  void ProcessRequests();
+  void RunBatch(std::vector<std::unique_ptr<Request>>& batch);
+  Status RunRequest(Request& request);
+
+  InferenceSession& session_;
+  const RequestBatcherOptions options_;
+  const RunOptions run_options_;
+  AllocatorPtr allocator_;
+
+  OrtMutex mutex_;
+  OrtCondVar requests_available_;
+  std::deque<std::unique_ptr<Request>> requests_;
+  bool shutdown_{false};
+  // set while a worker collects the requests of a batch, so that the other workers don't start competing batches
+  bool forming_batch_{false};
+  // set if the model does not declare a batch dimension, or once a batched run produced an output without one
+  std::atomic<bool> batching_disabled_{false};
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace onnxruntime
@@ -199,25 +199,36 @@ class Session:
                 f"Required inputs ({missing_input_names}) are missing from input feed ({feed_input_names})."
             )
 
-    def run(self, output_names, input_feed, run_options=None):
+    def run(self, output_names, input_feed, run_options=None, outputs=None):
         """
         Compute the predictions.
 
         :param output_names: name of the outputs
         :param input_feed: dictionary ``{ input_name: input_value }``
         :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param outputs: optional dictionary ``{ output_name: numpy_array }`` of preallocated, writeable,
+            C contiguous arrays the outputs are written into without copies. The dtype of each array must match
+            the element type of its output and its shape the shape of the output.
+            The preallocated arrays are returned in the list of results.
         :return: list of results, every result is either a numpy array,
             a sparse tensor, a list or a dictionary.
 
         ::
 
             sess.run([output_name], {input_name: x})
+            sess.run([output_name], {input_name: x}, outputs={output_name: y})
         """
         self._validate_input(list(input_feed.keys()))
         if not output_names:
             output_names = [output.name for output in self._outputs_meta]
+
+        def invoke(sess):
+            if outputs:
+                return sess.run(output_names, input_feed, run_options, outputs)
+            return sess.run(output_names, input_feed, run_options)
+
         try:
-            return self._sess.run(output_names, input_feed, run_options)
+            return invoke(self._sess)
         except C.EPFail as err:
             if self._enable_fallback:
                 print(f"EP Error: {err!s} using {self._providers}")
@@ -225,7 +236,7 @@ class Session:
                 self.set_providers(self._fallback_providers)
                 # Fallback only once.
                 self.disable_fallback()
-                return self._sess.run(output_names, input_feed, run_options)
+                return invoke(self._sess)
             raise
 
     def run_async(self, output_names, input_feed, callback, user_data, run_options=None):
@@ -258,6 +269,53 @@ class Session:
             output_names = [output.name for output in self._outputs_meta]
         return self._sess.run_async(output_names, input_feed, callback, user_data, run_options)
 
+    def run_many(self, output_names, input_feeds, run_options=None, max_concurrency=0, return_future=False):
+        """
+        Compute the predictions of a batch of requests.
+
+        The inputs of all the requests are converted first, then the requests are run concurrently
+        with the GIL released once for the whole batch.
+
+        :param output_names: name of the outputs, the same for every request
+        :param input_feeds: list of dictionaries ``{ input_name: input_value }``, one per request
+        :param run_options: See :class:`onnxruntime.RunOptions`. Used for every request.
+        :param max_concurrency: maximum number of requests that run at the same time,
+            0 to run as many as the hardware threads allow given the intra-op threads of each run.
+            The requests run on a thread pool of the session that is kept between calls.
+        :param return_future: if True, the batch is run in a background thread and a
+            :class:`concurrent.futures.Future` of the results is returned instead.
+        :return: list of results, one per request, each like the results of :meth:`run`.
+            If a request fails, an exception is raised for the first one that failed.
+
+        ::
+
+            sess.run_many([output_name], [{input_name: x0}, {input_name: x1}])
+        """
+        input_feeds = list(input_feeds)
+        for input_feed in input_feeds:
+            self._validate_input(list(input_feed.keys()))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+
+        if not return_future:
+            return self._sess.run_many(output_names, input_feeds, run_options, max_concurrency)
+
+        import concurrent.futures
+        import threading
+
+        future = concurrent.futures.Future()
+
+        def run_batch():
+            if not future.set_running_or_notify_cancel():
+                return
+            try:
+                future.set_result(self._sess.run_many(output_names, input_feeds, run_options, max_concurrency))
+            except Exception as err:
+                future.set_exception(err)
+
+        threading.Thread(target=run_batch, daemon=True).start()
+        return future
+
     def run_with_ort_values(self, output_names, input_dict_ort_values, run_options=None):
         """
         Compute the predictions.
@@ -625,6 +683,41 @@ class IOBinding:
         self._iobinding.clear_binding_outputs()
 
 
+class RequestBatcher:
+    """
+    This class combines the requests submitted for a session into batches, and runs each batch with a single run.
+
+    The inputs of the requests in a batch are concatenated along their first dimension, and the outputs are split
+    along their first dimension. Requests are batched together if they have the same inputs and outputs, and their
+    inputs are CPU tensors (other than strings) whose shapes only differ in the first dimension, which must be the
+    same for all the inputs of a request. Other requests are run on their own.
+    """
+
+    def __init__(self, session: Session, max_batch_size: int = 8, max_wait_us: int = 1000):
+        """
+        :param session: the session to run the requests with
+        :param max_batch_size: maximum sum of the first dimensions of the inputs of the requests in a batch
+        :param max_wait_us: maximum time in microseconds that a request waits for other requests to batch with
+        """
+        self._session = session
+        self._batcher = C.RequestBatcher(session._sess, max_batch_size, max_wait_us)
+
+    def submit(self, output_names, input_feed, callback, user_data=None):
+        """
+        Submit a request. The arguments have the same meaning as the arguments of
+        :meth:`onnxruntime.InferenceSession.run_async`, and the callback is invoked by a thread owned by the batcher.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param callback: python function that accept array of results, user data, and a status string on error.
+        :param user_data: object passed to the callback
+        """
+        self._session._validate_input(list(input_feed.keys()))
+        if not output_names:
+            output_names = [output.name for output in self._session._outputs_meta]
+        self._batcher.submit(output_names, input_feed, callback, user_data)
+
+
 class OrtValue:
     """
     A data structure that supports all ONNX data formats (tensors and non-tensors) that allows users
@@ -767,13 +860,17 @@ class OrtValue:
         """
         return self._ortvalue.is_tensor_sequence()
 
-    def numpy(self):
+    def numpy(self, copy=True):
         """
         Returns a Numpy object from the OrtValue.
         Valid only for OrtValues holding Tensors. Throws for OrtValues holding non-Tensors.
         Use accessors to gain a reference to non-Tensor objects such as SparseTensor
+
+        :param copy: if False, the Numpy object is a view of the data of a CPU tensor instead of a copy.
+            The view keeps the tensor alive and can be exported without copies via DLPack,
+            e.g. ``torch.from_dlpack(ort_value.numpy(copy=False))``.
         """
-        return self._ortvalue.numpy()
+        return self._ortvalue.numpy(copy)
 
     def update_inplace(self, np_arr):
         """
@@ -299,11 +299,28 @@ void addOrtValueMethods(pybind11::module& m) {
         return ort_value->IsTensorSequence();
       })
       // Converts Tensor into a numpy array
-      .def("numpy", [](const OrtValue* ml_value) -> py::object {
+      .def("numpy", [](const OrtValue* ml_value, bool copy) -> py::object {
         ORT_ENFORCE(ml_value->IsTensor(), "Only OrtValues that are Tensors are convertible to Numpy objects");
 
         py::object obj;
 
+        if (!copy) {
+          // The numpy array is a view of the tensor data. It holds a reference to the tensor, so it stays valid
+          // after the OrtValue is released. Numpy arrays support DLPack, so the data can be handed on without copies.
+          const Tensor& tensor = ml_value->Get<Tensor>();
+          ORT_ENFORCE(tensor.Location().device.Type() == OrtDevice::CPU && !tensor.IsDataTypeString(),
+                      "Only CPU tensors of numeric types can be converted to Numpy objects without a copy");
+
+          const TensorShape& shape = tensor.Shape();
+          std::vector<npy_intp> npy_dims(shape.GetDims().begin(), shape.GetDims().end());
+          py::object base = py::cast(*ml_value);
+          obj = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+              static_cast<int>(npy_dims.size()), npy_dims.data(), OnnxRuntimeTensorToNumpyType(tensor.DataType()),
+              const_cast<void*>(tensor.DataRaw())));
+          PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), base.release().ptr());
+          return obj;
+        }
+
 #ifdef USE_CUDA
         GetPyObjFromTensor(ml_value->Get<Tensor>(), obj, nullptr, GetCudaToHostMemCpyFunction());
 #elif USE_ROCM
@@ -316,7 +333,9 @@ void addOrtValueMethods(pybind11::module& m) {
         GetPyObjFromTensor(ml_value->Get<Tensor>(), obj, nullptr, nullptr);
 #endif
         return obj;
-      })
+      },
+           py::arg("copy") = true,
+           "Returns a numpy array of the tensor. With copy=False the array is a view of the data of a CPU tensor.")
 #ifdef ENABLE_TRAINING
       .def(
           "to_dlpack", [](OrtValue* ort_value) -> py::object {
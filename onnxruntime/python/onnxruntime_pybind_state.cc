@@ -24,6 +24,7 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/TensorSeq.h"
 #include "core/graph/graph_viewer.h"
+#include "core/platform/Barrier.h"
 #include "core/platform/env.h"
 #include "core/providers/get_execution_providers.h"
 #include "core/providers/tensorrt/tensorrt_provider_options.h"
@@ -31,6 +32,7 @@
 #include "core/session/abi_session_options_impl.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/provider_bridge_ort.h"
+#include "core/session/request_batcher.h"
 
 #ifdef ENABLE_ATEN
 #include "contrib_ops/cpu/aten_ops/aten_op_executor.h"
@@ -54,6 +56,8 @@ namespace onnxruntime {
 
 #include <iterator>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4267 4996 4503 4003)
@@ -163,6 +167,165 @@ void AsyncCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtS
   }
 }
 
+// Holds the session of a RequestBatcher, which is used to convert the feeds of the submitted requests.
+struct PyRequestBatcher {
+  PyRequestBatcher(PyInferenceSession* session, const RequestBatcherOptions& options)
+      : sess(session), batcher(std::make_unique<RequestBatcher>(*session->GetSessionHandle(), options)) {}
+
+  ~PyRequestBatcher() {
+    // the batcher runs the pending requests on destruction, and their callbacks acquire the GIL
+    py::gil_scoped_release release;
+    batcher.reset();
+  }
+
+  PyInferenceSession* sess;
+  std::unique_ptr<RequestBatcher> batcher;
+};
+
+// Converts the feeds and output names of an asynchronous request. The returned resource is passed to AsyncCallback.
+std::unique_ptr<AsyncResource> CreateAsyncResource(PyInferenceSession* sess,
+                                                   const std::vector<std::string>& output_names,
+                                                   const std::map<std::string, py::object>& pyfeeds,
+                                                   const PyCallback& callback, const py::object& user_data) {
+  std::unique_ptr<AsyncResource> async_resource = std::make_unique<AsyncResource>();
+  async_resource->callback = callback;
+  async_resource->user_data = user_data;
+  // prepare feeds
+  async_resource->ReserveFeeds(pyfeeds.size());
+  for (const auto& feed : pyfeeds) {
+    if (!feed.second.is(py::none())) {
+      OrtValue ml_value;
+      auto px = sess->GetSessionHandle()->GetModelInputs();
+      if (!px.first.IsOK() || !px.second) {
+        throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+      }
+      CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+      ThrowIfPyErrOccured();
+      async_resource->feeds.push_back(ml_value);
+      async_resource->feeds_raw.push_back(&async_resource->feeds.back());
+      async_resource->feed_names.push_back(feed.first);
+      async_resource->feed_names_raw.push_back(async_resource->feed_names.back().c_str());
+    }
+  }
+  // prepare fetches
+  async_resource->ReserveFetches(output_names.size());
+  for (auto& output_name : output_names) {
+    async_resource->fetch_names.push_back(output_name);
+    async_resource->fetch_names_raw.push_back(async_resource->fetch_names.back().c_str());
+    async_resource->fetches_raw.push_back({});
+  }
+  return async_resource;
+}
+
+// Converts the feeds of a request. 'None' feeds are skipped, so ORT handles them as missing optional inputs.
+static NameMLValMap CreateFeeds(PyInferenceSession* sess, const std::map<std::string, py::object>& pyfeeds) {
+  NameMLValMap feeds;
+  for (const auto& feed : pyfeeds) {
+    if (!feed.second.is(py::none())) {
+      OrtValue ml_value;
+      auto px = sess->GetSessionHandle()->GetModelInputs();
+      if (!px.first.IsOK() || !px.second) {
+        throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+      }
+      CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+      ThrowIfPyErrOccured();
+      feeds.insert(std::make_pair(feed.first, ml_value));
+    }
+  }
+  return feeds;
+}
+
+// Wraps the preallocated numpy arrays of `pyoutputs` in the fetches of a request, so ORT writes the outputs into them.
+// The arrays must be writeable, C contiguous and match the element type and the known dimensions of the outputs.
+static std::vector<OrtValue> CreatePreallocatedFetches(PyInferenceSession* sess,
+                                                       const std::vector<std::string>& output_names,
+                                                       const std::map<std::string, py::object>& pyoutputs) {
+  if (pyoutputs.empty()) {
+    return {};
+  }
+
+  auto px = sess->GetSessionHandle()->GetModelOutputs();
+  if (!px.first.IsOK() || !px.second) {
+    throw std::runtime_error("Either failed to get model outputs from the session object or the output def list was null");
+  }
+
+  std::vector<OrtValue> fetches(output_names.size());
+  for (const auto& output : pyoutputs) {
+    const std::string& name = output.first;
+    auto name_it = std::find(output_names.begin(), output_names.end(), name);
+    if (name_it == output_names.end()) {
+      throw std::invalid_argument("Preallocated output '" + name + "' is not one of the requested outputs.");
+    }
+    auto def_it = std::find_if(px.second->begin(), px.second->end(),
+                               [&name](const NodeArg* def) { return def->Name() == name; });
+    if (def_it == px.second->end()) {
+      throw std::invalid_argument("Preallocated output '" + name + "' is not an output of the model.");
+    }
+    const auto* type_proto = (*def_it)->TypeAsProto();
+    if (type_proto == nullptr || type_proto->value_case() != ONNX_NAMESPACE::TypeProto::kTensorType) {
+      throw std::invalid_argument("Output '" + name + "' is not a tensor and cannot be preallocated.");
+    }
+
+    if (!IsNumericNumpyArray(output.second)) {
+      throw std::invalid_argument("Preallocated output '" + name + "' must be a numeric numpy array.");
+    }
+    auto* arr = reinterpret_cast<PyArrayObject*>(output.second.ptr());
+    if (!PyArray_IS_C_CONTIGUOUS(arr) || !PyArray_ISWRITEABLE(arr)) {
+      throw std::invalid_argument("Preallocated output '" + name + "' must be a writeable C contiguous array.");
+    }
+
+    MLDataType element_type = NumpyTypeToOnnxRuntimeTensorType(PyArray_TYPE(arr));
+    if (element_type != DataTypeImpl::TensorTypeFromONNXEnum(type_proto->tensor_type().elem_type())->GetElementType()) {
+      throw std::invalid_argument("The dtype of preallocated output '" + name +
+                                  "' does not match the element type of the output.");
+    }
+
+    TensorShape shape = GetShape(py::reinterpret_borrow<py::array>(output.second));
+    const auto* shape_proto = (*def_it)->Shape();
+    if (shape_proto != nullptr) {
+      bool shape_matches = static_cast<size_t>(shape_proto->dim_size()) == shape.NumDimensions();
+      for (int i = 0; shape_matches && i < shape_proto->dim_size(); ++i) {
+        const auto& dim = shape_proto->dim(i);
+        shape_matches = !dim.has_dim_value() || dim.dim_value() == shape[i];
+      }
+      if (!shape_matches) {
+        throw std::invalid_argument("The shape " + shape.ToString() + " of preallocated output '" + name +
+                                    "' does not match the shape of the output.");
+      }
+    }
+
+    Tensor::InitOrtValue(element_type, shape, PyArray_DATA(arr), GetAllocator()->Info(),
+                         fetches[name_it - output_names.begin()]);
+  }
+
+  return fetches;
+}
+
+// Converts the fetch at position `pos` of a request to a python object. An empty fetch is returned as 'None'.
+static py::object CreatePyFetch(size_t pos, const OrtValue& fet) {
+  if (fet.IsAllocated()) {
+    if (fet.IsTensor()) {
+      return AddTensorAsPyObj(fet, nullptr, nullptr);
+    } else if (fet.IsSparseTensor()) {
+      return GetPyObjectFromSparseTensor(pos, fet, nullptr);
+    } else {
+      return AddNonTensorAsPyObj(fet, nullptr, nullptr);
+    }
+  }
+  // Send back None because the corresponding OrtValue was empty
+  return py::none();
+}
+
+// Converts the fetches of a request to python objects.
+static std::vector<py::object> CreatePyFetches(const std::vector<OrtValue>& fetches) {
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  for (size_t pos = 0; pos < fetches.size(); ++pos) {
+    rfetch.push_back(CreatePyFetch(pos, fetches[pos]));
+  }
+  return rfetch;
+}
+
 template <typename T>
 static py::object AddNonTensor(const OrtValue& val,
                                const DataTransferManager* /*data_transfer_manager*/,
@@ -1567,6 +1730,18 @@ RunOptions instance. The individual calls will exit gracefully and return an err
 #endif
       .def_readwrite("only_execute_path_to_fetches", &RunOptions::only_execute_path_to_fetches,
                      R"pbdoc(Only execute the nodes needed by fetch list)pbdoc")
+      .def(
+          "set_deadline",
+          [](RunOptions* options, int64_t timeout_us) -> void {
+            if (timeout_us < 0) {
+              options->deadline.reset();
+            } else {
+              options->deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+            }
+          },
+          R"pbdoc(Set the deadline of the calls that use this RunOptions instance to timeout_us microseconds from now.
+A call raises DeadlineExceeded once the deadline has passed, or as soon as the recorded execution time of its
+remaining nodes predicts that it cannot finish in time. A negative value clears the deadline.)pbdoc")
       .def(
           "add_run_config_entry",
           [](RunOptions* options, const char* config_key, const char* config_value) -> void {
@@ -1712,26 +1887,28 @@ including arg name, arg type (contains both type and shape).)pbdoc")
            [](PyInferenceSession* sess, std::vector<std::string> output_names,
               std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
                -> std::vector<py::object> {
-             NameMLValMap feeds;
-             for (auto feed : pyfeeds) {
-               // No need to process 'None's sent in by the user
-               // to feed Optional inputs in the graph.
-               // We just won't include anything in the feed and ORT
-               // will handle such implicit 'None's internally.
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 feeds.insert(std::make_pair(feed.first, ml_value));
+             NameMLValMap feeds = CreateFeeds(sess, pyfeeds);
+
+             std::vector<OrtValue> fetches;
+
+             {
+               // release GIL to allow multiple python threads to invoke Run() in parallel.
+               py::gil_scoped_release release;
+               if (run_options != nullptr) {
+                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
+               } else {
+                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
                }
              }
 
-             std::vector<OrtValue> fetches;
-             common::Status status;
+             return CreatePyFetches(fetches);
+           })
+      .def("run",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::map<std::string, py::object> pyfeeds, RunOptions* run_options,
+              std::map<std::string, py::object> pyoutputs) -> std::vector<py::object> {
+             NameMLValMap feeds = CreateFeeds(sess, pyfeeds);
+             std::vector<OrtValue> fetches = CreatePreallocatedFetches(sess, output_names, pyoutputs);
 
              {
                // release GIL to allow multiple python threads to invoke Run() in parallel.
@@ -1743,25 +1920,94 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                }
              }
 
+             // the preallocated arrays are returned as is, the outputs were written into them.
              std::vector<py::object> rfetch;
              rfetch.reserve(fetches.size());
-             size_t pos = 0;
-             for (auto fet : fetches) {
-               if (fet.IsAllocated()) {
-                 if (fet.IsTensor()) {
-                   rfetch.push_back(AddTensorAsPyObj(fet, nullptr, nullptr));
-                 } else if (fet.IsSparseTensor()) {
-                   rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
-                 } else {
-                   rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
-                 }
-               } else {  // Send back None because the corresponding OrtValue was empty
-                 rfetch.push_back(py::none());
+             for (size_t i = 0; i < fetches.size(); ++i) {
+               auto output = pyoutputs.find(output_names[i]);
+               if (output == pyoutputs.end()) {
+                 rfetch.push_back(CreatePyFetch(i, fetches[i]));
+                 continue;
+               }
+               auto* arr = reinterpret_cast<PyArrayObject*>(output->second.ptr());
+               const Tensor& tensor = fetches[i].Get<Tensor>();
+               if (tensor.DataRaw() != PyArray_DATA(arr)) {
+                 // an execution provider replaced the fetch, so its data is copied into the preallocated array.
+                 ORT_ENFORCE(tensor.Location().device.Type() == OrtDevice::CPU &&
+                                 tensor.SizeInBytes() == static_cast<size_t>(PyArray_NBYTES(arr)),
+                             "Output '", output_names[i], "' could not be written into its preallocated array.");
+                 memcpy(PyArray_DATA(arr), tensor.DataRaw(), tensor.SizeInBytes());
                }
-               ++pos;
+               rfetch.push_back(output->second);
              }
              return rfetch;
            })
+      .def("run_many",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::vector<std::map<std::string, py::object>> pyfeeds_list, RunOptions* run_options = nullptr,
+              size_t max_concurrency = 0) -> std::vector<std::vector<py::object>> {
+             const size_t num_requests = pyfeeds_list.size();
+             std::vector<NameMLValMap> feeds_list;
+             feeds_list.reserve(num_requests);
+             for (const auto& pyfeeds : pyfeeds_list) {
+               feeds_list.push_back(CreateFeeds(sess, pyfeeds));
+             }
+
+             std::vector<std::vector<OrtValue>> fetches_list(num_requests);
+             std::vector<common::Status> statuses(num_requests);
+
+             {
+               // release GIL for the whole batch. the requests are run concurrently by this thread and by tasks
+               // scheduled on the run_many thread pool of the session, which each take the next request that has not
+               // been run yet. the tasks are scheduled rather than run in a parallel section of the pool, as each
+               // request runs its own parallel sections in the intra-op thread pool.
+               py::gil_scoped_release release;
+               RunOptions default_run_options;
+               const RunOptions& batch_run_options = run_options != nullptr ? *run_options : default_run_options;
+               std::atomic<size_t> next_request{0};
+               auto run_requests = [&]() {
+                 for (size_t i = next_request++; i < num_requests; i = next_request++) {
+                   statuses[i] = sess->GetSessionHandle()->Run(batch_run_options, feeds_list[i], output_names,
+                                                               &fetches_list[i]);
+                 }
+               };
+
+               // each request uses the intra-op threads of the session, so by default only as many requests run
+               // at the same time as there are sets of intra-op threads in the hardware threads.
+               size_t num_tasks = max_concurrency;
+               if (num_tasks == 0) {
+                 const size_t intra_op_threads =
+                     static_cast<size_t>(std::max(sess->GetSessionHandle()->GetIntraOpDegreeOfParallelism(), 1));
+                 num_tasks = static_cast<size_t>(std::thread::hardware_concurrency()) / intra_op_threads;
+               }
+               num_tasks = std::min(std::max<size_t>(num_tasks, 1), std::max<size_t>(num_requests, 1));
+               concurrency::ThreadPool* thread_pool = num_tasks > 1 ? sess->GetRunManyThreadPool() : nullptr;
+               Barrier tasks_done(static_cast<unsigned int>(num_tasks - 1));
+               for (size_t i = 1; i < num_tasks; ++i) {
+                 concurrency::ThreadPool::Schedule(thread_pool, [&]() {
+                   run_requests();
+                   tasks_done.Notify();
+                 });
+               }
+               run_requests();
+               tasks_done.Wait();
+             }
+
+             for (size_t i = 0; i < num_requests; ++i) {
+               if (!statuses[i].IsOK()) {
+                 OrtPybindThrowIfError(common::Status(statuses[i].Category(), statuses[i].Code(),
+                                                      MakeString("Request ", i, " failed: ",
+                                                                 statuses[i].ErrorMessage())));
+               }
+             }
+
+             std::vector<std::vector<py::object>> results;
+             results.reserve(num_requests);
+             for (const auto& fetches : fetches_list) {
+               results.push_back(CreatePyFetches(fetches));
+             }
+             return results;
+           })
       .def("run_async",
            [](PyInferenceSession* sess,
               std::vector<std::string> output_names,
@@ -1769,33 +2015,8 @@ including arg name, arg type (contains both type and shape).)pbdoc")
               PyCallback callback, py::object user_data = {},
               RunOptions* run_options = nullptr)
                -> void {
-             std::unique_ptr<AsyncResource> async_resource = std::make_unique<AsyncResource>();
-             async_resource->callback = callback;
-             async_resource->user_data = user_data;
-             // prepare feeds
-             async_resource->ReserveFeeds(pyfeeds.size());
-             for (auto feed : pyfeeds) {
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 async_resource->feeds.push_back(ml_value);
-                 async_resource->feeds_raw.push_back(&async_resource->feeds.back());
-                 async_resource->feed_names.push_back(feed.first);
-                 async_resource->feed_names_raw.push_back(async_resource->feed_names.back().c_str());
-               }
-             }
-             // prepare fetches
-             async_resource->ReserveFetches(output_names.size());
-             for (auto& output_name : output_names) {
-               async_resource->fetch_names.push_back(output_name);
-               async_resource->fetch_names_raw.push_back(async_resource->fetch_names.back().c_str());
-               async_resource->fetches_raw.push_back({});
-             }
+             std::unique_ptr<AsyncResource> async_resource = CreateAsyncResource(sess, output_names, pyfeeds,
+                                                                                 callback, user_data);
              const RunOptions* run_async_option = run_options ? run_options : &async_resource->default_run_option;
              common::Status status = sess->GetSessionHandle()->RunAsync(run_async_option,
                                                                         gsl::span(async_resource->feed_names_raw.data(), async_resource->feed_names_raw.size()),
@@ -1953,6 +2174,38 @@ including arg name, arg type (contains both type and shape).)pbdoc")
 #endif
       });
 
+  py::class_<PyRequestBatcher>(m, "RequestBatcher", R"pbdoc(Combines the requests submitted for a session into batches.)pbdoc")
+      .def(py::init([](PyInferenceSession* sess, size_t max_batch_size, int64_t max_wait_us) {
+             if (max_batch_size == 0 || max_wait_us < 0) {
+               throw std::runtime_error("max_batch_size must be greater than zero and max_wait_us must not be negative");
+             }
+             RequestBatcherOptions options;
+             options.max_batch_size = max_batch_size;
+             options.max_wait = std::chrono::microseconds(max_wait_us);
+             return std::make_unique<PyRequestBatcher>(sess, options);
+           }),
+           py::keep_alive<1, 2>(), py::arg("session"), py::arg("max_batch_size"), py::arg("max_wait_us"))
+      .def(
+          "submit",
+          [](PyRequestBatcher* py_batcher,
+             std::vector<std::string> output_names,
+             std::map<std::string, py::object> pyfeeds,
+             PyCallback callback, py::object user_data = {}) -> void {
+            std::unique_ptr<AsyncResource> async_resource = CreateAsyncResource(py_batcher->sess, output_names, pyfeeds,
+                                                                                callback, user_data);
+            common::Status status = py_batcher->batcher->Submit(gsl::span(async_resource->feed_names_raw.data(), async_resource->feed_names_raw.size()),
+                                                                gsl::span(async_resource->feeds_raw.data(), async_resource->feeds_raw.size()),
+                                                                gsl::span(async_resource->fetch_names_raw.data(), async_resource->fetch_names_raw.size()),
+                                                                gsl::span(async_resource->fetches_raw.data(), async_resource->fetches_raw.size()),
+                                                                AsyncCallback,
+                                                                async_resource.get());
+            if (status.IsOK()) {
+              async_resource.release();
+            }
+            OrtPybindThrowIfError(status);
+          },
+          R"pbdoc(Submits a request. The callback is invoked with the outputs of the request once its batch has run.)pbdoc");
+
   py::enum_<onnxruntime::ArenaExtendStrategy>(m, "ArenaExtendStrategy", py::arithmetic())
       .value("kNextPowerOfTwo", onnxruntime::ArenaExtendStrategy::kNextPowerOfTwo)
       .value("kSameAsRequested", onnxruntime::ArenaExtendStrategy::kSameAsRequested)
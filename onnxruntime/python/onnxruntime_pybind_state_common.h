@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <thread>
+
 #include "core/common/logging/logging.h"
 #include "core/common/logging/sinks/cerr_sink.h"
 #include "core/common/optional.h"
@@ -11,6 +14,7 @@
 #include "core/session/environment.h"
 #include "core/session/abi_session_options_impl.h"
 #include "core/session/inference_session.h"
+#include "core/util/thread_utils.h"
 #ifdef ENABLE_TRAINING
 #include "core/dlpack/dlpack_converter.h"
 #endif
@@ -247,6 +251,22 @@ struct PyInferenceSession {
 
   InferenceSession* GetSessionHandle() const { return sess_.get(); }
 
+  // Returns the thread pool that runs the requests of run_many, which is created on first use and kept for the
+  // lifetime of the session. It has a thread per hardware thread, as the number of requests run at the same time
+  // is chosen per call. It is nullptr if there is a single hardware thread.
+  concurrency::ThreadPool* GetRunManyThreadPool() {
+    std::call_once(run_many_thread_pool_once_, [this]() {
+      OrtThreadPoolParams to;
+      to.thread_pool_size = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+      to.name = ORT_TSTR("run-many");
+      // the threads are idle between batches and run requests that use the intra-op threads, so they don't spin
+      to.allow_spinning = false;
+      run_many_thread_pool_ = concurrency::CreateThreadPool(&Env::Default(), to,
+                                                            concurrency::ThreadPoolType::INTER_OP);
+    });
+    return run_many_thread_pool_.get();
+  }
+
   virtual ~PyInferenceSession() = default;
 
  protected:
@@ -257,6 +277,8 @@ struct PyInferenceSession {
  private:
   std::shared_ptr<Environment> env_;
   std::unique_ptr<InferenceSession> sess_;
+  std::once_flag run_many_thread_pool_once_;
+  std::unique_ptr<concurrency::ThreadPool> run_many_thread_pool_;
 };
 
 inline const PySessionOptions& GetDefaultCPUSessionOptions() {
@@ -3,6 +3,7 @@
 
 import argparse
 import copy
+import itertools
 import json
 import sys
 from collections import OrderedDict
@@ -45,6 +46,66 @@ def embed(model: onnx.ModelProto, tuning_results: List[TuningResults], overwrite
     return model
 
 
+def tune_cpu(model_path: str, dims: Dict[str, List[int]], max_tuning_duration_ms=0) -> List[TuningResults]:
+    """Tune the CPU execution provider for the model on this machine.
+
+    The model is run on random inputs once for each combination of the values of its symbolic input dimensions, with
+    the tuning of the TunableOp of the CPU execution provider enabled. The tuning results are only valid on the
+    processor model they are produced on.
+    """
+    import numpy as np
+
+    import onnxruntime as ort
+
+    sess_options = ort.SessionOptions()
+    sess_options.add_session_config_entry("session.cpu_tunable_op_enable", "1")
+    sess_options.add_session_config_entry("session.cpu_tunable_op_tuning_enable", "1")
+    sess_options.add_session_config_entry("session.cpu_tunable_op_max_tuning_duration_ms", str(max_tuning_duration_ms))
+    sess = ort.InferenceSession(model_path, sess_options, providers=["CPUExecutionProvider"])
+
+    input_types = {
+        "tensor(float)": np.float32,
+        "tensor(float16)": np.float16,
+        "tensor(double)": np.float64,
+        "tensor(int64)": np.int64,
+        "tensor(int32)": np.int32,
+        "tensor(int8)": np.int8,
+        "tensor(uint8)": np.uint8,
+        "tensor(bool)": np.bool_,
+    }
+
+    inputs = sess.get_inputs()
+    for node_arg in inputs:
+        assert node_arg.type in input_types, f"input {node_arg.name} of type {node_arg.type} is not supported"
+        for dim in node_arg.shape:
+            assert isinstance(dim, int) or dim in dims, f"the value of the dimension {dim} must be supplied"
+
+    rng = np.random.default_rng(0)
+    dim_names = list(dims.keys())
+    for dim_values in itertools.product(*[dims[name] for name in dim_names]):
+        dim_map = dict(zip(dim_names, dim_values))
+        feeds = {}
+        for node_arg in inputs:
+            shape = [dim if isinstance(dim, int) else dim_map[dim] for dim in node_arg.shape]
+            dtype = input_types[node_arg.type]
+            if np.issubdtype(dtype, np.floating):
+                feeds[node_arg.name] = rng.standard_normal(shape).astype(dtype)
+            else:
+                # zeros are valid indices and masks
+                feeds[node_arg.name] = np.zeros(shape, dtype=dtype)
+        sess.run(None, feeds)
+
+    return [trs for trs in sess.get_tuning_results() if trs["ep"] == "CPUExecutionProvider"]
+
+
+def _parse_dims(dims: List[str]) -> Dict[str, List[int]]:
+    parsed = {}
+    for dim in dims:
+        name, _, values = dim.partition("=")
+        parsed[name] = [int(value) for value in values.split(",")]
+    return parsed
+
+
 class Merger:
     class EpAndValidators:
         def __init__(self, ep: str, validators: Dict[str, str]):
@@ -110,6 +171,21 @@ def parse_args():
     pprint_parser = sub_parsers.add_parser("pprint", help="Pretty print the tuning results.")
     pprint_parser.add_argument("json_or_onnx", help="A tuning results json file or an onnx file.")
 
+    tune_parser = sub_parsers.add_parser(
+        "tune", help="Tune the CPU execution provider for an onnx file on this machine, to be embedded into it."
+    )
+    tune_parser.add_argument(
+        "--dim",
+        action="append",
+        default=[],
+        help="Values of a symbolic input dimension as NAME=VALUE[,VALUE...], the model is run for each combination.",
+    )
+    tune_parser.add_argument(
+        "--max-tuning-duration-ms", type=int, default=0, help="Maximum duration to time each candidate, 0 for no limit."
+    )
+    tune_parser.add_argument("input_onnx", help="Path of the onnx file to tune.")
+    tune_parser.add_argument("output_json", help="Path of the output tuning results file.")
+
     args = parser.parse_args()
     if len(vars(args)) == 0:
         parser.print_help()
@@ -160,6 +236,10 @@ def main():
             sys.exit(-1)
 
         pprint(tuning_results)
+    elif args.cmd == "tune":
+        tuning_results = tune_cpu(args.input_onnx, _parse_dims(args.dim), args.max_tuning_duration_ms)
+        with open(args.output_json, "w") as f:
+            json.dump(tuning_results, f)
     else:
         # invalid choice will be handled by the parser
         pass
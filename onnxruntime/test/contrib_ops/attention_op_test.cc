@@ -246,9 +246,16 @@ static void RunAttentionTest(
     }
 
     if (enable_cpu) {
-      std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
-      execution_providers.push_back(DefaultCpuExecutionProvider());
-      tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+      // Run both the unfused kernel and the fused attention, which is otherwise only used for long sequences.
+      for (bool use_cpu_flash_attention : {false, true}) {
+        ScopedEnvironmentVariables scoped_env_vars{
+            EnvVarMap{
+                {onnxruntime::contrib::attention::kDisableCpuFlashAttention, use_cpu_flash_attention ? "0" : "1"},
+                {onnxruntime::contrib::attention::kMinSeqLenForCpuFlashAttention, "1"}}};
+        std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+        execution_providers.push_back(DefaultCpuExecutionProvider());
+        tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+      }
     }
 
     if (enable_dml) {
@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/common/random_generator.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+struct FusedGemmTestCase {
+  int64_t M;
+  int64_t N;
+  int64_t K;
+  bool trans_b = false;
+  float alpha = 1.0f;
+  float beta = 1.0f;
+  std::vector<int64_t> c_dims;  // empty if there is no C
+  bool has_residual = false;
+  std::string activation;
+  std::vector<std::pair<std::string, float>> activation_attrs;
+  std::function<float(float)> reference_activation;
+};
+
+void RunFusedGemmTest(const FusedGemmTestCase& test_case) {
+  const int64_t M = test_case.M;
+  const int64_t N = test_case.N;
+  const int64_t K = test_case.K;
+
+  RandomValueGenerator random{1234};
+  const std::vector<float> a = random.Uniform<float>(std::vector<int64_t>{M, K}, -1.0f, 1.0f);
+  const std::vector<float> b = random.Uniform<float>(std::vector<int64_t>{K, N}, -1.0f, 1.0f);
+  const std::vector<float> c = test_case.c_dims.empty()
+                                   ? std::vector<float>{}
+                                   : random.Uniform<float>(test_case.c_dims, -1.0f, 1.0f);
+  const std::vector<float> r = test_case.has_residual ? random.Uniform<float>(std::vector<int64_t>{M, N}, -1.0f, 1.0f)
+                                                      : std::vector<float>{};
+
+  // B is supplied transposed if trans_b is set.
+  std::vector<float> b_input(b.size());
+  for (int64_t k = 0; k < K; k++) {
+    for (int64_t n = 0; n < N; n++) {
+      b_input[test_case.trans_b ? n * K + k : k * N + n] = b[k * N + n];
+    }
+  }
+
+  std::vector<float> y(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a[m * K + k] * b[k * N + n];
+      }
+      sum *= test_case.alpha;
+      if (!c.empty()) {
+        // C is (N), (1, N), (M, 1) or (M, N).
+        const size_t c_index = (c.size() == static_cast<size_t>(M * N)) ? m * N + n
+                               : (test_case.c_dims.back() == N) ? n
+                                                                 : m;
+        sum += test_case.beta * c[c_index];
+      }
+      sum = test_case.reference_activation(sum);
+      if (!r.empty()) {
+        sum += r[m * N + n];
+      }
+      y[m * N + n] = sum;
+    }
+  }
+
+  OpTester tester("FusedGemm", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("transA", 0);
+  tester.AddAttribute<int64_t>("transB", test_case.trans_b ? 1 : 0);
+  tester.AddAttribute("alpha", test_case.alpha);
+  tester.AddAttribute("beta", test_case.beta);
+  tester.AddAttribute("activation", test_case.activation);
+  for (const auto& attr : test_case.activation_attrs) {
+    tester.AddAttribute(attr.first, attr.second);
+  }
+
+  tester.AddInput<float>("A", {M, K}, a);
+  tester.AddInput<float>("B", test_case.trans_b ? std::vector<int64_t>{N, K} : std::vector<int64_t>{K, N}, b_input);
+  if (!c.empty()) {
+    tester.AddInput<float>("C", test_case.c_dims, c);
+  } else if (test_case.has_residual) {
+    tester.AddOptionalInputEdge<float>();
+  }
+  if (test_case.has_residual) {
+    tester.AddInput<float>("R", {M, N}, r);
+  }
+  tester.AddOutput<float>("Y", {M, N}, y);
+  tester.SetOutputAbsErr("Y", 1e-4f);
+  tester.Run();
+}
+
+float Relu(float x) { return std::max(x, 0.0f); }
+
+}  // namespace
+
+TEST(FusedGemmTest, ReluBias) {
+  FusedGemmTestCase test_case{5, 33, 17};
+  test_case.c_dims = {33};
+  test_case.activation = "Relu";
+  test_case.reference_activation = Relu;
+  RunFusedGemmTest(test_case);
+}
+
+TEST(FusedGemmTest, ReluBiasScaledByBeta) {
+  FusedGemmTestCase test_case{5, 33, 17};
+  test_case.beta = 0.5f;
+  test_case.c_dims = {1, 33};
+  test_case.activation = "Relu";
+  test_case.reference_activation = Relu;
+  RunFusedGemmTest(test_case);
+}
+
+TEST(FusedGemmTest, LeakyReluBiasPerRow) {
+  FusedGemmTestCase test_case{7, 20, 9};
+  test_case.c_dims = {7, 1};
+  test_case.activation = "LeakyRelu";
+  test_case.activation_attrs = {{"activation_alpha", 0.2f}};
+  test_case.reference_activation = [](float x) { return x >= 0.0f ? x : 0.2f * x; };
+  RunFusedGemmTest(test_case);
+}
+
+TEST(FusedGemmTest, GeluResidual) {
+  FusedGemmTestCase test_case{13, 70, 40};
+  test_case.trans_b = true;
+  test_case.c_dims = {70};
+  test_case.has_residual = true;
+  test_case.activation = "Gelu";
+  test_case.reference_activation = [](float x) { return 0.5f * x * (1.0f + std::erf(x * 0.70710678f)); };
+  RunFusedGemmTest(test_case);
+}
+
+TEST(FusedGemmTest, FastGeluResidualWithoutBias) {
+  FusedGemmTestCase test_case{1, 45, 31};
+  test_case.has_residual = true;
+  test_case.activation = "FastGelu";
+  test_case.reference_activation = [](float x) {
+    return 0.5f * x * (1.0f + std::tanh(0.7978845608f * (x + 0.044715f * x * x * x)));
+  };
+  RunFusedGemmTest(test_case);
+}
+
+TEST(FusedGemmTest, SigmoidBiasMatrixResidual) {
+  FusedGemmTestCase test_case{6, 10, 3};
+  test_case.alpha = 2.0f;
+  test_case.c_dims = {6, 10};
+  test_case.has_residual = true;
+  test_case.activation = "Sigmoid";
+  test_case.reference_activation = [](float x) { return 1.0f / (1.0f + std::exp(-x)); };
+  RunFusedGemmTest(test_case);
+}
+
+// Elu is not implemented by MLAS, the activation and the residual are applied after the GEMM.
+TEST(FusedGemmTest, EluResidual) {
+  FusedGemmTestCase test_case{4, 9, 5};
+  test_case.c_dims = {9};
+  test_case.has_residual = true;
+  test_case.activation = "Elu";
+  test_case.activation_attrs = {{"activation_alpha", 0.5f}};
+  test_case.reference_activation = [](float x) { return x >= 0.0f ? x : 0.5f * (std::exp(x) - 1.0f); };
+  RunFusedGemmTest(test_case);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -209,6 +209,23 @@ TEST(LayerNormTest, LayerNorm17_double) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kDnnlExecutionProvider});
 }
 
+TEST(LayerNormTest, LayerNorm17_Float16_MeanInvStdDev) {
+  OpTester test("LayerNormalization", 17);
+  test.AddAttribute<float>("epsilon", 1e-05f);
+
+  std::vector<int64_t> dims{1, 2, 3};
+  test.AddInput<MLFloat16>("x", dims, ToFloat16({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}));
+  test.AddInput<MLFloat16>("gamma", {3}, ToFloat16({1.0f, 1.0f, 1.0f}));
+  test.AddInput<MLFloat16>("bias", {3}, ToFloat16({0.5f, 0.0f, -0.5f}));
+  test.AddOutput<MLFloat16>("output", dims, ToFloat16({-0.7247f, 0.0f, 0.7247f, -0.7247f, 0.0f, 0.7247f}));
+  test.AddOutput<float>("mean", {1, 2, 1}, {2.0f, 5.0f});
+  test.AddOutput<float>("inv_std_dev", {1, 2, 1}, {1.2247f, 1.2247f});
+  // TRT, DNNL, OpenVINO and NNAPI, CoreML don't support this combination of datatypes
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "",
+           {kTensorrtExecutionProvider, kDnnlExecutionProvider, kOpenVINOExecutionProvider,
+            kNnapiExecutionProvider, kQnnExecutionProvider, kCoreMLExecutionProvider});
+}
+
 TEST(LayerNormTest, LayerNorm_InvalidScaleBias) {
   OpTester test("LayerNormalization");
   test.AddAttribute<float>("epsilon", 1e-05f);
@@ -298,13 +298,16 @@ static void RunMultiHeadAttentionKernel(
     bool disable_rocm = DISABLE_ROCM,
     bool disable_dml = false) {
   if (kernel_type == AttentionKernelType::AttentionKernel_Default) {
+    // The CPU kernel uses the fused attention for any sequence length here.
     ScopedEnvironmentVariables scoped_env_vars{
         EnvVarMap{
             {onnxruntime::contrib::attention::kDisableFlashAttention, "0"},
             {onnxruntime::contrib::attention::kDisableTrtFlashAttention, "0"},
             {onnxruntime::contrib::attention::kDisableFusedSelfAttention, "0"},
             {onnxruntime::contrib::attention::kDisableFusedCrossAttention, "0"},
-            {onnxruntime::contrib::attention::kDisableMemoryEfficientAttention, "0"}}};
+            {onnxruntime::contrib::attention::kDisableMemoryEfficientAttention, "0"},
+            {onnxruntime::contrib::attention::kDisableCpuFlashAttention, "0"},
+            {onnxruntime::contrib::attention::kMinSeqLenForCpuFlashAttention, "1"}}};
     RunMultiHeadAttentionTest(
         query_data, key_data, value_data, kv_data, qkv_data, bias_data, rel_pos_bias_data,
         past_key_data, past_value_data, present_key_data, present_value_data, key_padding_mask_data,
@@ -320,7 +323,8 @@ static void RunMultiHeadAttentionKernel(
             {onnxruntime::contrib::attention::kDisableTrtFlashAttention, "1"},
             {onnxruntime::contrib::attention::kDisableFusedSelfAttention, "1"},
             {onnxruntime::contrib::attention::kDisableFusedCrossAttention, "1"},
-            {onnxruntime::contrib::attention::kDisableMemoryEfficientAttention, "1"}}};
+            {onnxruntime::contrib::attention::kDisableMemoryEfficientAttention, "1"},
+            {onnxruntime::contrib::attention::kDisableCpuFlashAttention, "1"}}};
     RunMultiHeadAttentionTest(
         query_data, key_data, value_data, kv_data, qkv_data, bias_data, rel_pos_bias_data,
         past_key_data, past_value_data, present_key_data, present_value_data, key_padding_mask_data,
@@ -566,6 +570,18 @@ TEST(MultiHeadAttentionTest, CrossAttention_DiffSequenceLengths) {
   RunMultiHeadAttentionTests(data, /*disable_cpu=*/false, /*disable_cuda=*/true);
 }
 
+TEST(MultiHeadAttentionTest, CrossAttention_DiffSequenceLengths_SinglePresent) {
+  // Only one of present_key and present_value is requested
+  AttentionTestData data;
+  GetCrossAttentionData_DiffSequenceLengths(data);
+  data.present_value_data.clear();
+  RunMultiHeadAttentionTests(data, /*disable_cpu=*/false, /*disable_cuda=*/true);
+
+  GetCrossAttentionData_DiffSequenceLengths(data);
+  data.present_key_data.clear();
+  RunMultiHeadAttentionTests(data, /*disable_cpu=*/false, /*disable_cuda=*/true);
+}
+
 TEST(MultiHeadAttentionTest, SelfAttention_WithPastAndPresent_NoMask_NoRelPosBias) {
   // Whisper decoder self attention with past_kv and present_kv
   AttentionTestData data;
@@ -397,6 +397,45 @@ TEST(InferenceSessionTests, NoTimeout) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, RunWithDeadline) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunWithDeadline";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // a run that finishes in time records the cost of its steps
+  RunOptions run_options;
+  run_options.deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+  RunModel(session_object, run_options);
+
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+
+  run_options.deadline = std::chrono::steady_clock::now();
+  Status status = session_object.Run(run_options, feeds, output_names, &fetches);
+  ASSERT_EQ(status.Code(), common::DEADLINE_EXCEEDED) << status.ErrorMessage();
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("The deadline of the run was exceeded. Executed 0 of"));
+
+  // the run is aborted before it starts if the recorded cost of its steps exceeds the time that is left
+  auto* step_cost_history = session_object.GetSessionState().GetStepCostHistory();
+  ASSERT_NE(step_cost_history, nullptr);
+  step_cost_history->Record(0, 0, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::hours(1)).count());
+  run_options.deadline = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+  status = session_object.Run(run_options, feeds, output_names, &fetches);
+  ASSERT_EQ(status.Code(), common::DEADLINE_EXCEEDED) << status.ErrorMessage();
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("The run cannot finish before its deadline."));
+
+  run_options.deadline.reset();
+  RunModel(session_object, run_options);
+}
+
 TEST(InferenceSessionTests, OnlyExecutePathToFetches) {
   SessionOptions so;
 
@@ -770,6 +809,46 @@ TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
     count++;
   }
 }
+
+#if defined(__linux__)
+TEST(InferenceSessionTests, CheckRunProfilerWithHardwareCounters) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerWithHardwareCounters";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_hw_counters_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilingHardwareCounters, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  const bool has_hardware_counters = session_object.GetProfiling().GetHardwareCounters() != nullptr;
+  std::string profile_file = session_object.EndProfiling();
+  if (!has_hardware_counters) {
+    GTEST_SKIP() << "Hardware performance counters are not accessible on this machine.";
+  }
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_hw_counters_event = false;
+  while (std::getline(profile, line)) {
+    if (line.find("mul_1_hw_counters") != string::npos) {
+      has_hw_counters_event = true;
+      for (const char* name : profiling::kHardwareCounterNames) {
+        ASSERT_TRUE(line.find(name) != string::npos);
+      }
+    }
+  }
+
+  ASSERT_TRUE(has_hw_counters_event);
+}
+#endif  // __linux__
 #endif  // __wasm__
 
 TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
@@ -836,6 +915,87 @@ TEST(InferenceSessionTests, PreAllocateOutputVector) {
   RunModel(session_object, run_options, is_preallocate_output_vec);
 }
 
+TEST(InferenceSessionTests, WarmUp) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.WarmUp";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+
+  RunOptions run_options;
+  run_options.run_tag = "InferenceSessionTests.WarmUp";
+  std::vector<InlinedHashMap<std::string, TensorShape>> input_shapes(2);
+  // the model defines the shape of X, so it is optional
+  input_shapes[1]["X"] = TensorShape({3, 2});
+
+  // the session must be initialized first
+  ASSERT_FALSE(session_object.WarmUp(run_options, input_shapes).IsOK());
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::vector<std::chrono::microseconds> durations;
+  ASSERT_STATUS_OK(session_object.WarmUp(run_options, input_shapes, &durations));
+  ASSERT_EQ(durations.size(), input_shapes.size());
+
+  // unknown input names are rejected
+  input_shapes[1]["Z"] = TensorShape({3, 2});
+  auto status = session_object.WarmUp(run_options, input_shapes);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("Invalid input name for warm-up run 1: Z"));
+
+  // the session can be run as usual after the warm-up
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, Clone) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.Clone";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+
+  // the session must be initialized first
+  std::unique_ptr<InferenceSession> clone;
+  ASSERT_FALSE(session_object.Clone(clone).IsOK());
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_STATUS_OK(session_object.Clone(clone));
+
+  // the kernels and the initializers are shared
+  const SessionState& session_state = session_object.GetSessionState();
+  const SessionState& clone_session_state = clone->GetSessionState();
+  const auto& nodes = session_state.GetGraphViewer().Nodes();
+  ASSERT_FALSE(nodes.empty());
+  for (const auto& node : nodes) {
+    ASSERT_NE(session_state.GetKernel(node.Index()), nullptr);
+    EXPECT_EQ(session_state.GetKernel(node.Index()), clone_session_state.GetKernel(node.Index()));
+  }
+
+  const auto& initializers = session_state.GetInitializedTensors();
+  const auto& clone_initializers = clone_session_state.GetInitializedTensors();
+  ASSERT_EQ(initializers.size(), clone_initializers.size());
+  for (const auto& [idx, value] : initializers) {
+    auto it = clone_initializers.find(idx);
+    ASSERT_NE(it, clone_initializers.end());
+    EXPECT_EQ(value.Get<Tensor>().DataRaw(), it->second.Get<Tensor>().DataRaw());
+  }
+
+  EXPECT_EQ(session_state.GetExecutionPlan(), clone_session_state.GetExecutionPlan());
+
+  // the allocators are not shared
+  const auto& allocators = session_state.GetAllocators();
+  for (const auto& [device, allocator] : clone_session_state.GetAllocators()) {
+    auto it = allocators.find(device);
+    ASSERT_NE(it, allocators.end());
+    EXPECT_NE(it->second.get(), allocator.get());
+  }
+
+  RunOptions run_options;
+  run_options.run_tag = "InferenceSessionTests.Clone";
+  RunModel(*clone, run_options);
+  RunModel(session_object, run_options);
+}
+
 TEST(InferenceSessionTests, ConfigureVerbosityLevel) {
   SessionOptions so;
 
@@ -1020,6 +1180,55 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestIOBindingRecycleOutputBuffers) {
+  SessionOptions so;
+  InferenceSession session_object(so, GetEnvironment());
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+  io_binding->RecycleOutputBuffers(true);
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y"));
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  auto run = [&](const std::vector<int64_t>& dims_a, const std::vector<float>& values_a,
+                 const std::vector<int64_t>& dims_b, const std::vector<float>& values_b,
+                 const std::vector<int64_t>& expected_dims, const std::vector<float>& expected_values) {
+    OrtValue a, b;
+    CreateMLValue<float>(allocator, dims_a, values_a, &a);
+    CreateMLValue<float>(allocator, dims_b, values_b, &b);
+    ASSERT_STATUS_OK(io_binding->BindInput("A", a));
+    ASSERT_STATUS_OK(io_binding->BindInput("B", b));
+    ASSERT_STATUS_OK(session_object.Run(*io_binding));
+    ASSERT_EQ(io_binding->GetOutputs().size(), 1u);
+    VerifyOutputs(io_binding->GetOutputs()[0].Get<Tensor>(), expected_dims, expected_values);
+  };
+  auto output_data = [&]() { return io_binding->GetOutputs()[0].Get<Tensor>().DataRaw(); };
+
+  run({2, 2}, {1.f, 2.f, 3.f, 4.f}, {2, 2}, {1.f, 0.f, 0.f, 1.f}, {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  const void* buffer = output_data();
+
+  // the buffer of the previous run is reused for outputs of the same or a smaller size
+  run({2, 2}, {1.f, 1.f, 1.f, 1.f}, {2, 2}, {1.f, 2.f, 3.f, 4.f}, {2, 2}, {4.f, 6.f, 4.f, 6.f});
+  ASSERT_EQ(output_data(), buffer);
+  run({1, 2}, {1.f, 2.f}, {2, 2}, {1.f, 2.f, 3.f, 4.f}, {1, 2}, {7.f, 10.f});
+  ASSERT_EQ(output_data(), buffer);
+
+  // a larger output replaces the buffer, without affecting the output of the previous run
+  OrtValue previous_output = io_binding->GetOutputs()[0];
+  run({3, 1}, {1.f, 2.f, 3.f}, {1, 3}, {1.f, 2.f, 3.f}, {3, 3}, {1.f, 2.f, 3.f, 2.f, 4.f, 6.f, 3.f, 6.f, 9.f});
+  VerifyOutputs(previous_output.Get<Tensor>(), {1, 2}, {7.f, 10.f});
+  buffer = output_data();
+  run({1, 1}, {2.f}, {1, 1}, {3.f}, {1, 1}, {6.f});
+  ASSERT_EQ(output_data(), buffer);
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -1,25 +1,38 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 #include "asserts.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights_file_cache.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/endian.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_weight_store.h"
 #include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
+#include "core/platform/path_lib.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/thread_utils.h"
 #include "gtest/gtest.h"
 #include "test/test_environment.h"
 #include "test/util/include/default_providers.h"
+#include "test/util/include/temp_dir.h"
 #include "core/optimizer/layout_transformation/layout_transformation.h"
 
 using namespace ONNX_NAMESPACE;
@@ -337,6 +350,158 @@ TEST(SessionStateTest, TestInitializerMemoryAllocatedUsingNonArenaMemory) {
 
 #endif
 
+// Creates a graph with the float initializers "W_aligned" and "W_misaligned" that are stored in an external data
+// file in `dir`. The data of "W_aligned" starts at offset 0 and the data of "W_misaligned" at offset 17 of the file.
+// Each initializer is added to the graph input "X" by an Add node.
+static void CreateGraphWithExternalInitializers(Graph& graph, const PathString& dir,
+                                                const std::vector<float>& values) {
+  const size_t values_len = values.size() * sizeof(float);
+  constexpr int64_t misaligned_offset = 17;
+  const PathString ext_data_file = ORT_TSTR("external_initializers.bin");
+  {
+    std::ofstream ofs(ConcatPathComponent(dir, ext_data_file), std::ios::binary);
+    ofs.write(reinterpret_cast<const char*>(values.data()), values_len);
+    const std::vector<char> padding(misaligned_offset - values_len, 0);
+    ofs.write(padding.data(), padding.size());
+    ofs.write(reinterpret_cast<const char*>(values.data()), values_len);
+    ASSERT_TRUE(ofs.good());
+  }
+
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(static_cast<int64_t>(values.size()));
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &type);
+  for (const auto& [name, offset] : {std::pair<std::string, int64_t>{"W_aligned", 0},
+                                     std::pair<std::string, int64_t>{"W_misaligned", misaligned_offset}}) {
+    TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+    tensor_proto.add_dims(static_cast<int64_t>(values.size()));
+    tensor_proto.set_data_location(TensorProto_DataLocation_EXTERNAL);
+    auto* location = tensor_proto.add_external_data();
+    location->set_key("location");
+    location->set_value(ToUTF8String(ext_data_file));
+    auto* offset_entry = tensor_proto.add_external_data();
+    offset_entry->set_key("offset");
+    offset_entry->set_value(std::to_string(offset));
+    auto* length = tensor_proto.add_external_data();
+    length->set_key("length");
+    length->set_value(std::to_string(values_len));
+    graph.AddInitializedTensor(tensor_proto);
+
+    auto& weight_arg = graph.GetOrCreateNodeArg(name, &type);
+    auto& output_arg = graph.GetOrCreateNodeArg("Y_" + name, &type);
+    graph.AddNode("add_" + name, "Add", "", {&input_arg, &weight_arg}, {&output_arg});
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+}
+
+#if defined(__linux__)
+// Returns true if `p` points into a memory mapping of a file whose path ends with `file_name`.
+static bool IsInFileMapping(const void* p, const std::string& file_name) {
+  const auto address = reinterpret_cast<uintptr_t>(p);
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  while (std::getline(maps, line)) {
+    // each line starts with "<start>-<end>" in hex and ends with the path of the mapped file, if any
+    std::istringstream iss(line);
+    uintptr_t start = 0;
+    uintptr_t end = 0;
+    char dash = 0;
+    if (!(iss >> std::hex >> start >> dash >> end) || address < start || address >= end) {
+      continue;
+    }
+    return line.size() >= file_name.size() &&
+           line.compare(line.size() - file_name.size(), file_name.size(), file_name) == 0;
+  }
+  return false;
+}
+#endif
+
+static void CheckExternalInitializers(const SessionState& session_state, const std::vector<float>& values) {
+  const auto& initialized_tensors = session_state.GetInitializedTensors();
+  for (const std::string name : {"W_aligned", "W_misaligned"}) {
+    int idx;
+    ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx(name, idx));
+    auto it = initialized_tensors.find(idx);
+    ASSERT_NE(it, initialized_tensors.end()) << name;
+
+    const auto& tensor = it->second.Get<Tensor>();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(tensor.DataRaw()) % sizeof(float), 0u) << name;
+#if defined(__linux__)
+    // the aligned data is used without a copy, directly from the mapped external data file
+    const bool expect_mapped = name == "W_aligned" && endian::native == endian::little;
+    EXPECT_EQ(IsInFileMapping(tensor.DataRaw(), "external_initializers.bin"), expect_mapped) << name;
+#endif
+    auto data = tensor.DataAsSpan<float>();
+    EXPECT_EQ(std::vector<float>(data.begin(), data.end()), values) << name;
+  }
+}
+
+// Test that external initializers used on CPU are read in place from the mapped file when their data is aligned,
+// and are copied into an aligned buffer otherwise.
+// With lazy initializer materialization they are only loaded when the graph is executed.
+class SessionStateExternalInitializersTest : public testing::TestWithParam<bool> {};
+
+TEST_P(SessionStateExternalInitializersTest, TestExternalInitializers) {
+  const bool lazy_initialization = GetParam();
+  const std::vector<float> values{1.f, 2.f, 3.f, 4.f};
+  TemporaryDirectory tmp_dir{ORT_TSTR("session_state_test_external_initializers")};
+
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 11;
+  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  ASSERT_NO_FATAL_FAILURE(CreateGraphWithExternalInitializers(graph, tmp_dir.Path(), values));
+
+  ExecutionProviders execution_providers;
+  auto cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider, std::move(cpu_execution_provider)));
+
+  KernelRegistryManager krm;
+  ASSERT_STATUS_OK(krm.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = false;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigLazyInitializerMaterialization] =
+      lazy_initialization ? "1" : "0";
+
+  SessionState session_state(graph, execution_providers, nullptr, nullptr, dtm,
+                             DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  // the external data file is located relative to the model path
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("model.onnx")),
+                                                      krm));
+
+  if (lazy_initialization) {
+    EXPECT_TRUE(session_state.GetInitializedTensors().empty());
+    auto unmaterialized_names = session_state.GetUnmaterializedInitializerNames();
+    std::sort(unmaterialized_names.begin(), unmaterialized_names.end());
+    EXPECT_EQ(unmaterialized_names, (std::vector<std::string>{"W_aligned", "W_misaligned"}));
+
+    // the execution frame does this before the graph is executed
+    ASSERT_STATUS_OK(session_state.MaterializeLazyInitializedTensors());
+  }
+
+  EXPECT_TRUE(session_state.GetUnmaterializedInitializerNames().empty());
+  CheckExternalInitializers(session_state, values);
+}
+
+INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateExternalInitializersTest, testing::Bool());
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateTestP, testing::ValuesIn(param_list));
 
 #ifndef ENABLE_TRAINING_CORE
@@ -359,13 +524,27 @@ class PrePackingTestOpKernel : public OpKernel {
     return Status::OK();
   }
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   const std::vector<size_t>& prepacked_buffer_sizes, int input_idx,
+                                   /*out*/ bool& used_cached_buffers) override {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(prepacked_buffer_sizes);
+    ORT_UNUSED_PARAMETER(input_idx);
+
+    weight_packed_ = std::move(prepacked_buffers[0]);
+    used_cached_buffers = true;
+    ++use_cached_pre_packed_weight_calls_count;
+    return Status::OK();
+  }
+
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                  /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
-    ORT_UNUSED_PARAMETER(tensor);
     ORT_UNUSED_PARAMETER(input_idx);
 
-    size_t weight_packed_len = 8;
+    // The packed weight is as large as the tensor so that large weights can be placed in a SharedWeightStore.
+    size_t weight_packed_len = std::max<size_t>(8, tensor.SizeInBytes());
     weight_packed_ = IAllocator::MakeUniquePtr<void>(alloc, weight_packed_len, true);
+    memset(weight_packed_.get(), 0, weight_packed_len);
     float* data_weights_packed = reinterpret_cast<float*>(weight_packed_.get());
     data_weights_packed[0] = 1.2345f;
     data_weights_packed[1] = data_weights_packed[0] * 2.f;
@@ -382,18 +561,23 @@ class PrePackingTestOpKernel : public OpKernel {
 
   int prepack_calls_count = 0;
   int store_pre_packed_weight_calls_count = 0;
+  int use_cached_pre_packed_weight_calls_count = 0;
   IAllocatorUniquePtr<void> weight_packed_;
 };
 
-static void CreateSimpleGraph(Graph& graph) {
+static void CreateSimpleGraph(Graph& graph, int64_t initializer_size = 1) {
   // node creation and placement
   TypeProto type;
   type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
   type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
 
+  TypeProto initializer_type;
+  initializer_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  initializer_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(initializer_size);
+
   std::vector<onnxruntime::NodeArg*> inputs;
   onnxruntime::NodeArg input_0_arg("node_0_input_0", &type);
-  onnxruntime::NodeArg input_1_arg("node_0_input_1", &type);
+  onnxruntime::NodeArg input_1_arg("node_0_input_1", &initializer_type);
   inputs.push_back(&input_0_arg);
   inputs.push_back(&input_1_arg);
 
@@ -405,8 +589,9 @@ static void CreateSimpleGraph(Graph& graph) {
 
   // add an initializer
   ONNX_NAMESPACE::TensorProto tensor;
-  tensor.add_dims(1);
-  tensor.add_float_data(1.0f);
+  const std::vector<float> values(static_cast<size_t>(initializer_size), 1.0f);
+  tensor.add_dims(initializer_size);
+  tensor.set_raw_data(values.data(), values.size() * sizeof(float));
   tensor.set_data_type(TensorProto_DataType_FLOAT);
   tensor.set_name("node_0_input_1");
   graph.AddInitializedTensor(tensor);
@@ -517,6 +702,7 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool test_parallel_initialization = false;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -558,6 +744,8 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   sess_options.enable_mem_reuse = true;
   sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] =
       test_param.test_prepacking ? "0" : "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigParallelInitialization] =
+      test_param.test_parallel_initialization ? "1" : "0";
 
   SessionState session_state(model.MainGraph(),
                              execution_providers,
@@ -850,12 +1038,369 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test3) {
   ASSERT_EQ(session_state_2.GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(1));
 }
 
+// Pre-packing enabled + pre-packed weights file cache = pre-packed weights are reused by a later session
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test4) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  // Enable pre-packing
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+
+  const PathString cache_file_path = ORT_TSTR("session_state_test_prepacked_weights.cache");
+  std::filesystem::remove(cache_file_path);
+
+  {
+    // First session/model creates the cache file
+    PrepackedWeightsFileCache prepacked_weights_file_cache(cache_file_path);
+    ASSERT_STATUS_OK(prepacked_weights_file_cache.Load(DefaultLoggingManager().DefaultLogger()));
+    ASSERT_EQ(prepacked_weights_file_cache.GetNumberOfElements(), static_cast<size_t>(0));
+
+    Model model_1("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                  domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                  DefaultLoggingManager().DefaultLogger());
+
+    CreateSimpleGraph(model_1.MainGraph());
+    PlaceAllNodesToCPUEP(model_1.MainGraph());
+    SessionState session_state_1(model_1.MainGraph(),
+                                 execution_providers,
+                                 tp.get(),
+                                 nullptr, /*inter_op_thread_pool*/
+                                 dtm,
+                                 DefaultLoggingManager().DefaultLogger(),
+                                 profiler,
+                                 sess_options);
+    session_state_1.SetPrepackedWeightsFileCache(&prepacked_weights_file_cache);
+
+    ASSERT_STATUS_OK(session_state_1.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                          kernel_registry_manager));
+
+    const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state_1.GetKernel(0));
+    // Assert that the weight was pre-packed and handed back to the kernel from the cache
+    ASSERT_EQ(session_state_1.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(kernel->prepack_calls_count, 1);
+    ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1);
+    ASSERT_EQ(kernel->use_cached_pre_packed_weight_calls_count, 0);
+    ASSERT_EQ(session_state_1.GetUsedCachedPrePackedWeightCounter(), static_cast<size_t>(0));
+    ASSERT_EQ(prepacked_weights_file_cache.GetNumberOfElements(), static_cast<size_t>(1));
+
+    ASSERT_STATUS_OK(prepacked_weights_file_cache.Save(DefaultLoggingManager().DefaultLogger()));
+  }
+
+  {
+    // Second session/model loads the pre-packed weight from the cache file
+    PrepackedWeightsFileCache prepacked_weights_file_cache(cache_file_path);
+    ASSERT_STATUS_OK(prepacked_weights_file_cache.Load(DefaultLoggingManager().DefaultLogger()));
+    ASSERT_EQ(prepacked_weights_file_cache.GetNumberOfElements(), static_cast<size_t>(1));
+
+    Model model_2("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                  domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                  DefaultLoggingManager().DefaultLogger());
+
+    CreateSimpleGraph(model_2.MainGraph());
+    PlaceAllNodesToCPUEP(model_2.MainGraph());
+    SessionState session_state_2(model_2.MainGraph(),
+                                 execution_providers,
+                                 tp.get(),
+                                 nullptr, /*inter_op_thread_pool*/
+                                 dtm,
+                                 DefaultLoggingManager().DefaultLogger(),
+                                 profiler,
+                                 sess_options);
+    session_state_2.SetPrepackedWeightsFileCache(&prepacked_weights_file_cache);
+
+    ASSERT_STATUS_OK(session_state_2.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                          kernel_registry_manager));
+
+    const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state_2.GetKernel(0));
+    // Assert that PrePack() was skipped in favour of the cached pre-packed weight
+    ASSERT_EQ(session_state_2.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(kernel->prepack_calls_count, 0);
+    ASSERT_EQ(kernel->use_cached_pre_packed_weight_calls_count, 1);
+    ASSERT_EQ(session_state_2.GetUsedCachedPrePackedWeightCounter(), static_cast<size_t>(1));
+
+    const float* data_weights_packed = reinterpret_cast<const float*>(kernel->weight_packed_.get());
+    ASSERT_EQ(data_weights_packed[0], 1.2345f);
+    ASSERT_EQ(data_weights_packed[1], 1.2345f * 2.f);
+  }
+
+  std::filesystem::remove(cache_file_path);
+}
+
+// Pre-packing enabled + lazy initializer materialization = the initializer with external data is pre-packed when it
+// is materialized, and released as its only user pre-packed it
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test6) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  // Enable pre-packing
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigLazyInitializerMaterialization] = "1";
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("session_state_test_lazy_prepacking")};
+  const PathString ext_data_file = ORT_TSTR("prepacking_test_weight.bin");
+  const float value = 1.0f;
+  {
+    std::ofstream ofs(ConcatPathComponent(tmp_dir.Path(), ext_data_file), std::ios::binary);
+    ofs.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    ASSERT_TRUE(ofs.good());
+  }
+
+  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& input_0_arg = graph.GetOrCreateNodeArg("node_0_input_0", &type);
+  auto& input_1_arg = graph.GetOrCreateNodeArg("node_0_input_1", &type);
+  auto& output_arg = graph.GetOrCreateNodeArg("node_0_output_0", &type);
+  graph.AddNode("node_0", "PrePackingTest", "node 0", {&input_0_arg, &input_1_arg}, {&output_arg});
+
+  ONNX_NAMESPACE::TensorProto tensor;
+  tensor.add_dims(1);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  tensor.set_name("node_0_input_1");
+  tensor.set_data_location(TensorProto_DataLocation_EXTERNAL);
+  auto* location = tensor.add_external_data();
+  location->set_key("location");
+  location->set_value(ToUTF8String(ext_data_file));
+  graph.AddInitializedTensor(tensor);
+  ASSERT_STATUS_OK(graph.Resolve());
+  PlaceAllNodesToCPUEP(graph);
+
+  SessionState session_state(graph,
+                             execution_providers,
+                             tp.get(),
+                             nullptr, /*inter_op_thread_pool*/
+                             dtm,
+                             DefaultLoggingManager().DefaultLogger(),
+                             profiler,
+                             sess_options);
+
+  // the external data file is located relative to the model path
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("model.onnx")),
+                                                      kernel_registry_manager));
+
+  const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+  // Assert that the weight was not loaded or pre-packed yet
+  ASSERT_EQ(kernel->prepack_calls_count, 0);
+  ASSERT_EQ(session_state.GetUnmaterializedInitializerNames(), std::vector<std::string>{"node_0_input_1"});
+
+  // the execution frame does this before the graph is executed
+  ASSERT_STATUS_OK(session_state.MaterializeLazyInitializedTensors());
+
+  // Assert that the weight was pre-packed and then released
+  ASSERT_EQ(kernel->prepack_calls_count, 1);
+  ASSERT_TRUE(session_state.GetUnmaterializedInitializerNames().empty());
+  ASSERT_TRUE(session_state.GetInitializedTensors().empty());
+
+  // Materializing again is a no-op
+  ASSERT_STATUS_OK(session_state.MaterializeLazyInitializedTensors());
+  ASSERT_EQ(kernel->prepack_calls_count, 1);
+}
+
+#if !defined(_WIN32)
+// Pre-packing enabled + shared weight store = initializers and pre-packed weights are shared between sessions
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test5) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  // Enable pre-packing
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("session_state_test_shared_weight_store")};
+  // The initializer and the weight pre-packed from it are large enough to be placed in the store
+  const int64_t initializer_size = SharedWeightStore::kMinBufferSize / sizeof(float);
+
+  auto count_buffer_files = [&tmp_dir]() {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(tmp_dir.Path())) {
+      count += entry.path().extension() == ".weights" ? 1 : 0;
+    }
+    return count;
+  };
+
+  {
+    // Each session opens its own store, as the sessions of different processes would
+    std::unique_ptr<SharedWeightStore> shared_weight_store_1;
+    std::unique_ptr<SharedWeightStore> shared_weight_store_2;
+    ASSERT_STATUS_OK(SharedWeightStore::Open(tmp_dir.Path(), shared_weight_store_1));
+    ASSERT_STATUS_OK(SharedWeightStore::Open(tmp_dir.Path(), shared_weight_store_2));
+
+    // First session/model creates the shared weights
+    Model model_1("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                  domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                  DefaultLoggingManager().DefaultLogger());
+
+    CreateSimpleGraph(model_1.MainGraph(), initializer_size);
+    PlaceAllNodesToCPUEP(model_1.MainGraph());
+    SessionState session_state_1(model_1.MainGraph(),
+                                 execution_providers,
+                                 tp.get(),
+                                 nullptr, /*inter_op_thread_pool*/
+                                 dtm,
+                                 DefaultLoggingManager().DefaultLogger(),
+                                 profiler,
+                                 sess_options);
+    session_state_1.SetSharedWeightStore(shared_weight_store_1.get());
+
+    ASSERT_STATUS_OK(session_state_1.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                          kernel_registry_manager));
+
+    const auto* kernel_1 = reinterpret_cast<const PrePackingTestOpKernel*>(session_state_1.GetKernel(0));
+    // Assert that the weight was pre-packed and handed back to the kernel from the store
+    ASSERT_EQ(session_state_1.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(kernel_1->prepack_calls_count, 1);
+    ASSERT_EQ(kernel_1->store_pre_packed_weight_calls_count, 1);
+    ASSERT_EQ(shared_weight_store_1->GetNumberOfBuffers(), static_cast<size_t>(2));
+    ASSERT_EQ(count_buffer_files(), static_cast<size_t>(2));
+
+    // Second session/model attaches to the same weights
+    Model model_2("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                  domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                  DefaultLoggingManager().DefaultLogger());
+
+    CreateSimpleGraph(model_2.MainGraph(), initializer_size);
+    PlaceAllNodesToCPUEP(model_2.MainGraph());
+    SessionState session_state_2(model_2.MainGraph(),
+                                 execution_providers,
+                                 tp.get(),
+                                 nullptr, /*inter_op_thread_pool*/
+                                 dtm,
+                                 DefaultLoggingManager().DefaultLogger(),
+                                 profiler,
+                                 sess_options);
+    session_state_2.SetSharedWeightStore(shared_weight_store_2.get());
+
+    ASSERT_STATUS_OK(session_state_2.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                          kernel_registry_manager));
+
+    const auto* kernel_2 = reinterpret_cast<const PrePackingTestOpKernel*>(session_state_2.GetKernel(0));
+    ASSERT_EQ(kernel_2->store_pre_packed_weight_calls_count, 1);
+    ASSERT_EQ(shared_weight_store_2->GetNumberOfBuffers(), static_cast<size_t>(2));
+    ASSERT_EQ(count_buffer_files(), static_cast<size_t>(2));
+
+    const float* data_weights_packed = reinterpret_cast<const float*>(kernel_2->weight_packed_.get());
+    ASSERT_EQ(data_weights_packed[0], 1.2345f);
+    ASSERT_EQ(data_weights_packed[1], 1.2345f * 2.f);
+
+    // The weights cannot be removed while the store is in use
+    bool in_use = false;
+    size_t num_removed = 0;
+    ASSERT_STATUS_OK(SharedWeightStore::RemoveUnused(tmp_dir.Path(), in_use, num_removed));
+    ASSERT_TRUE(in_use);
+    ASSERT_EQ(num_removed, static_cast<size_t>(0));
+  }
+
+  bool in_use = true;
+  size_t num_removed = 0;
+  ASSERT_STATUS_OK(SharedWeightStore::RemoveUnused(tmp_dir.Path(), in_use, num_removed));
+  ASSERT_FALSE(in_use);
+  ASSERT_EQ(num_removed, static_cast<size_t>(2));
+  ASSERT_EQ(count_buffer_files(), static_cast<size_t>(0));
+}
+
+// Shared weight store opened by two processes = the weights written by one process are mapped by the other, and the
+// weights are not removed while either process has the store open
+TEST(SessionStateTest, SharedWeightStoreAcrossProcesses) {
+  TemporaryDirectory tmp_dir{ORT_TSTR("session_state_test_shared_weight_store_processes")};
+  std::vector<float> weights(SharedWeightStore::kMinBufferSize / sizeof(float));
+  for (size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = static_cast<float>(i);
+  }
+  const size_t weights_size = weights.size() * sizeof(float);
+
+  auto count_buffer_files = [&tmp_dir]() {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(tmp_dir.Path())) {
+      count += entry.path().extension() == ".weights" ? 1 : 0;
+    }
+    return count;
+  };
+
+  // The child signals through `ready` that it added the weights, and waits on `done` until the parent is finished.
+  int ready[2];
+  int done[2];
+  ASSERT_EQ(pipe(ready), 0);
+  ASSERT_EQ(pipe(done), 0);
+
+  const pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    close(ready[0]);
+    close(done[1]);
+    int exit_code = 1;
+    {
+      std::unique_ptr<SharedWeightStore> store;
+      const void* shared_data = nullptr;
+      if (SharedWeightStore::Open(tmp_dir.Path(), store).IsOK() &&
+          store->GetOrCreate(weights.data(), weights_size, shared_data).IsOK() && shared_data != nullptr) {
+        exit_code = 0;
+      }
+      char signal = 0;
+      if (write(ready[1], &signal, 1) != 1 || read(done[0], &signal, 1) != 0) {
+        exit_code = 1;
+      }
+    }
+    // Exit without running the destructors of the parent's objects, e.g. the one removing the temporary directory.
+    _exit(exit_code);
+  }
+
+  close(ready[1]);
+  close(done[0]);
+  char signal = 0;
+  ASSERT_EQ(read(ready[0], &signal, 1), 1);
+  close(ready[0]);
+  ASSERT_EQ(count_buffer_files(), static_cast<size_t>(1));
+
+  {
+    // The parent maps the weights written by the child
+    std::unique_ptr<SharedWeightStore> store;
+    ASSERT_STATUS_OK(SharedWeightStore::Open(tmp_dir.Path(), store));
+    const void* shared_data = nullptr;
+    ASSERT_STATUS_OK(store->GetOrCreate(weights.data(), weights_size, shared_data));
+    ASSERT_NE(shared_data, nullptr);
+    ASSERT_EQ(memcmp(shared_data, weights.data(), weights_size), 0);
+    ASSERT_EQ(count_buffer_files(), static_cast<size_t>(1));
+  }
+
+  // The weights cannot be removed while the child has the store open
+  bool in_use = false;
+  size_t num_removed = 0;
+  ASSERT_STATUS_OK(SharedWeightStore::RemoveUnused(tmp_dir.Path(), in_use, num_removed));
+  ASSERT_TRUE(in_use);
+  ASSERT_EQ(num_removed, static_cast<size_t>(0));
+
+  close(done[1]);
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+
+  ASSERT_STATUS_OK(SharedWeightStore::RemoveUnused(tmp_dir.Path(), in_use, num_removed));
+  ASSERT_FALSE(in_use);
+  ASSERT_EQ(num_removed, static_cast<size_t>(1));
+  ASSERT_EQ(count_buffer_files(), static_cast<size_t>(0));
+}
+#endif
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
                          testing::Values(PrepackingTestParam{false, false},
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                                         PrepackingTestParam{true, true},
+                                         PrepackingTestParam{false, true, true},
+                                         PrepackingTestParam{true, true, true}));
 #endif
 
 }  // namespace test
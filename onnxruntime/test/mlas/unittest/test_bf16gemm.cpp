@@ -0,0 +1,184 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_bf16gemm.cpp
+
+Abstract:
+
+    Tests for MLAS bfloat16 GEMM.
+
+--*/
+
+#include "test_util.h"
+
+template <bool Packed, bool Threaded>
+class MlasBf16GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint16_t> BufferA;
+  MatrixGuardBuffer<uint16_t> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<uint16_t> BufferCBf16;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  static float Bf16ToFloat(uint16_t v) {
+    uint32_t bits = uint32_t(v) << 16;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+  }
+
+  void InitializeBf16(uint16_t* buffer, size_t count, int seed) {
+    // Small integers and halves are exact in bfloat16 and keep the products exact.
+    for (size_t i = 0; i < count; i++) {
+      const float f = float(int((i * 7 + seed * 13) % 23) - 11) * 0.5f;
+      uint32_t bits;
+      std::memcpy(&bits, &f, sizeof(bits));
+      buffer[i] = uint16_t(bits >> 16);
+    }
+  }
+
+  void ReferenceGemm(size_t M, size_t N, size_t K, size_t BatchSize,
+                     const uint16_t* A, const uint16_t* B, const float* Bias, float* C) {
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          float sum = (Bias != nullptr) ? Bias[n] : 0.0f;
+          for (size_t k = 0; k < K; k++) {
+            sum += Bf16ToFloat(A[m * K + k]) * Bf16ToFloat(B[k * N + n]);
+          }
+          C[m * N + n] = sum;
+        }
+      }
+      A += M * K;
+      B += K * N;
+      C += M * N;
+    }
+  }
+
+ public:
+  MlasBf16GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static std::string suite_name = std::string("Bf16Gemm") +
+                                    (Packed ? "_Packed" : "_NoPack") +
+                                    (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void Test(size_t M, size_t N, size_t K, size_t BatchSize, bool withBias, bool outputBf16) {
+    uint16_t* A = BufferA.GetBuffer(K * M * BatchSize);
+    uint16_t* B = BufferB.GetBuffer(N * K * BatchSize);
+    float* Bias = nullptr;
+    if (withBias) {
+      Bias = BufferBias.GetBuffer(N);
+      for (size_t n = 0; n < N; n++) {
+        Bias[n] = float(int(n % 9) - 4);
+      }
+    }
+    float* C = BufferC.GetBuffer(N * M * BatchSize, true);
+    uint16_t* CBf16 = BufferCBf16.GetBuffer(N * M * BatchSize, true);
+    float* CReference = BufferCReference.GetBuffer(N * M * BatchSize);
+
+    InitializeBf16(A, K * M * BatchSize, 1);
+    InitializeBf16(B, N * K * BatchSize, 2);
+
+    uint8_t* PackedB = nullptr;
+    const size_t PackedBSize = MlasBf16GemmPackBSize(N, K);
+    if (Packed) {
+      PackedB = BufferBPacked.GetBuffer(PackedBSize * BatchSize);
+      for (size_t batch = 0; batch < BatchSize; batch++) {
+        MlasBf16GemmPackB(N, K, reinterpret_cast<const MLAS_BF16*>(B + K * N * batch), N,
+                          PackedB + PackedBSize * batch);
+      }
+    }
+
+    std::vector<MLAS_BF16_GEMM_DATA_PARAMS> GemmParameters(BatchSize);
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      auto& params = GemmParameters[batch];
+      params.A = reinterpret_cast<const MLAS_BF16*>(A + M * K * batch);
+      params.lda = K;
+      if (Packed) {
+        params.B = PackedB + PackedBSize * batch;
+        params.ldb = 0;
+      } else {
+        params.B = B + K * N * batch;
+        params.ldb = N;
+      }
+      params.Bias = Bias;
+      params.ldc = N;
+      params.CIsBf16 = outputBf16;
+      if (outputBf16) {
+        params.C = CBf16 + M * N * batch;
+      } else {
+        params.C = C + M * N * batch;
+      }
+    }
+
+    MlasBf16GemmBatch(M, N, K, BatchSize, GemmParameters.data(), threadpool_);
+
+    ReferenceGemm(M, N, K, BatchSize, A, B, Bias, CReference);
+
+    for (size_t i = 0, f = M * N * BatchSize; i < f; i++) {
+      if (outputBf16) {
+        // Rounding to bfloat16 keeps 8 significant bits.
+        const float actual = Bf16ToFloat(CBf16[i]);
+        ASSERT_LE(std::abs(actual - CReference[i]), std::abs(CReference[i]) / 256.0f)
+            << " @[" << i / N << "," << i % N << "], total:" << f
+            << ", M=" << M << ", N=" << N << ", K=" << K;
+      } else {
+        ASSERT_EQ(C[i], CReference[i]) << " @[" << i / N << "," << i % N << "], total:" << f
+                                       << ", M=" << M << ", N=" << N << ", K=" << K;
+      }
+    }
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t b = 1; b < 20; b++) {
+      Test(b, b, b, 1, false, false);
+      Test(b, b, b, 1, true, true);
+    }
+    for (size_t b = 16; b <= 256; b <<= 1) {
+      Test(b, b, b, 1, true, false);
+      Test(b, b, b, 1, false, true);
+    }
+    for (size_t b = 1; b < 70; b += 3) {
+      Test(1, b, 64, 1, true, false);
+      Test(1, 64, b, 1, false, false);
+      Test(33, b, b, 1, true, false);
+      Test(35, 47, b, 2, true, true);
+    }
+    Test(43, 500, 401, 1, true, false);
+    Test(96, 320, 129, 3, true, false);
+    Test(43, 500, 401, 2, false, true);
+  }
+};
+
+template <>
+MlasBf16GemmTest<false, false>* MlasTestFixture<MlasBf16GemmTest<false, false>>::mlas_tester(nullptr);
+template <>
+MlasBf16GemmTest<true, false>* MlasTestFixture<MlasBf16GemmTest<true, false>>::mlas_tester(nullptr);
+template <>
+MlasBf16GemmTest<false, true>* MlasTestFixture<MlasBf16GemmTest<false, true>>::mlas_tester(nullptr);
+template <>
+MlasBf16GemmTest<true, true>* MlasTestFixture<MlasBf16GemmTest<true, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasBf16GemmTest<false, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasBf16GemmTest<true, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasBf16GemmTest<false, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasBf16GemmTest<true, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
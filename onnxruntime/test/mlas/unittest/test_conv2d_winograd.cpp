@@ -0,0 +1,125 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_conv2d_winograd.cpp
+
+Abstract:
+
+    Tests for the MLAS Winograd convolution against the GEMM convolution.
+
+--*/
+
+#include "test_util.h"
+
+#include <random>
+
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<uint8_t> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWorking;
+  std::mt19937 Generator{1234};
+
+  void Fill(float* Buffer, size_t Count) {
+    std::uniform_real_distribution<float> Distribution(-1.0f, 1.0f);
+    for (size_t i = 0; i < Count; i++) {
+      Buffer[i] = Distribution(Generator);
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Conv2dWinograd");
+    return suite_name.c_str();
+  }
+
+  void Test(size_t BatchCount, size_t InputChannels, size_t InputHeight, size_t InputWidth,
+            size_t FilterCount, size_t PaddingTop, size_t PaddingLeft, size_t PaddingBottom, size_t PaddingRight,
+            bool WithSum, MLAS_THREADPOOL* ThreadPool) {
+    const size_t OutputHeight = InputHeight + PaddingTop + PaddingBottom - 2;
+    const size_t OutputWidth = InputWidth + PaddingLeft + PaddingRight - 2;
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t Padding[] = {int64_t(PaddingTop), int64_t(PaddingLeft), int64_t(PaddingBottom), int64_t(PaddingRight)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    ASSERT_TRUE(MlasConvWinogradIsSupported(2, 1, InputChannels, FilterCount, KernelShape, DilationShape, StrideShape));
+
+    const size_t InputElements = BatchCount * InputChannels * InputHeight * InputWidth;
+    const size_t FilterElements = FilterCount * InputChannels * 9;
+    const size_t OutputElements = BatchCount * FilterCount * OutputHeight * OutputWidth;
+
+    float* Input = BufferInput.GetBuffer(InputElements);
+    float* Filter = BufferFilter.GetBuffer(FilterElements);
+    float* Bias = BufferBias.GetBuffer(FilterCount);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+    Fill(Input, InputElements);
+    Fill(Filter, FilterElements);
+    Fill(Bias, FilterCount);
+
+    // The output is accumulated to the existing values for the Conv/Sum fusion.
+    Fill(Output, OutputElements);
+    std::copy_n(Output, OutputElements, OutputReference);
+    const float Beta = WithSum ? 1.0f : 0.0f;
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasReluActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+    MlasConvPrepare(&Parameters, 2, BatchCount, 1, InputChannels, InputShape, KernelShape, DilationShape,
+                    Padding, StrideShape, OutputShape, FilterCount, &Activation, &WorkingBufferSize, Beta, ThreadPool);
+
+    MlasConv(&Parameters, Input, Filter, Bias, BufferWorking.GetBuffer(WorkingBufferSize), OutputReference, ThreadPool);
+
+    void* PackedFilter = BufferPackedFilter.GetBuffer(MlasConvWinogradPackFilterSize(InputChannels, FilterCount));
+    MlasConvWinogradPackFilter(InputChannels, FilterCount, Filter, PackedFilter);
+
+    MlasConvWinograd(&Parameters, Input, PackedFilter, Bias, Output, ThreadPool);
+
+    // The transforms of F(4x4, 3x3) lose a few bits of precision.
+    const float Tolerance = 1e-5f * float(InputChannels * 9);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_LE(std::abs(Output[i] - OutputReference[i]), Tolerance)
+          << "Expected: " << OutputReference[i] << " Actual: " << Output[i] << " @" << i
+          << ", B=" << BatchCount << ", C=" << InputChannels << ", H=" << InputHeight << ", W=" << InputWidth
+          << ", F=" << FilterCount << ", Pad=" << PaddingTop << "," << PaddingLeft << "," << PaddingBottom << ","
+          << PaddingRight << ", Sum=" << WithSum;
+    }
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_THREADPOOL* ThreadPool : {static_cast<MLAS_THREADPOOL*>(nullptr), GetMlasThreadPool()}) {
+      for (size_t Pad : {0, 1}) {
+        for (size_t H : {3, 4, 7, 13, 28}) {
+          Test(1, 16, H, H, 16, Pad, Pad, Pad, Pad, false, ThreadPool);
+        }
+        Test(2, 32, 17, 9, 48, Pad, Pad, Pad, Pad, false, ThreadPool);
+        Test(1, 64, 56, 56, 64, Pad, Pad, Pad, Pad, true, ThreadPool);
+      }
+      Test(3, 24, 10, 21, 40, 1, 0, 0, 1, false, ThreadPool);
+      Test(1, 128, 14, 14, 256, 2, 2, 2, 2, true, ThreadPool);
+    }
+  }
+};
+
+template <>
+MlasConv2DWinogradTest* MlasTestFixture<MlasConv2DWinogradTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasConv2DWinogradTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,245 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_conv_nhwc.cpp
+
+Abstract:
+
+    Tests for the MLAS single precision NHWC convolution and pooling.
+
+--*/
+
+#include "test_util.h"
+
+#include <random>
+
+class MlasConvNhwcTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferReorderedFilter;
+  MatrixGuardBuffer<uint8_t> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  std::vector<const float*> Indirection;
+  std::vector<float> Zeroes;
+  std::mt19937 Generator{1234};
+
+  void Fill(float* Buffer, size_t Count) {
+    std::uniform_real_distribution<float> Distribution(-1.0f, 1.0f);
+    for (size_t i = 0; i < Count; i++) {
+      Buffer[i] = Distribution(Generator);
+    }
+  }
+
+  //
+  // Build the indirection buffer of a 2D NHWC image, with Padding addressed
+  // for the pixels outside of the image.
+  //
+
+  void BuildIndirection(const float* Input, size_t Channels, size_t InputHeight, size_t InputWidth,
+                        size_t OutputHeight, size_t OutputWidth, size_t KernelHeight, size_t KernelWidth,
+                        size_t Stride, size_t Dilation, size_t Pad, const float* Padding) {
+    Indirection.clear();
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+      for (size_t ow = 0; ow < OutputWidth; ow++) {
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+          for (size_t kw = 0; kw < KernelWidth; kw++) {
+            const ptrdiff_t ih = ptrdiff_t(oh * Stride + kh * Dilation) - ptrdiff_t(Pad);
+            const ptrdiff_t iw = ptrdiff_t(ow * Stride + kw * Dilation) - ptrdiff_t(Pad);
+            const bool Valid = ih >= 0 && iw >= 0 && size_t(ih) < InputHeight && size_t(iw) < InputWidth;
+            Indirection.push_back(Valid ? Input + (size_t(ih) * InputWidth + size_t(iw)) * Channels : Padding);
+          }
+        }
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("ConvNhwc");
+    return suite_name.c_str();
+  }
+
+  void TestConv(size_t GroupCount, size_t InputChannels, size_t FilterCount, size_t InputHeight, size_t InputWidth,
+                size_t KernelSize, size_t Stride, size_t Dilation, size_t Pad, bool WithSum) {
+    const size_t Channels = GroupCount * InputChannels;
+    const size_t OutputChannels = GroupCount * FilterCount;
+    const size_t OutputHeight = (InputHeight + 2 * Pad - Dilation * (KernelSize - 1) - 1) / Stride + 1;
+    const size_t OutputWidth = (InputWidth + 2 * Pad - Dilation * (KernelSize - 1) - 1) / Stride + 1;
+    const size_t OutputCount = OutputHeight * OutputWidth;
+    const size_t KernelElements = KernelSize * KernelSize;
+    const size_t K = KernelElements * InputChannels;
+
+    float* Input = BufferInput.GetBuffer(InputHeight * InputWidth * Channels);
+    float* Filter = BufferFilter.GetBuffer(OutputChannels * K);
+    float* Bias = BufferBias.GetBuffer(OutputChannels);
+    float* Output = BufferOutput.GetBuffer(OutputCount * OutputChannels);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputCount * OutputChannels);
+    Fill(Input, InputHeight * InputWidth * Channels);
+    Fill(Filter, OutputChannels * K);
+    Fill(Bias, OutputChannels);
+    Fill(Output, OutputCount * OutputChannels);
+    std::copy_n(Output, OutputCount * OutputChannels, OutputReference);
+
+    Zeroes.assign(Channels, 0.0f);
+    BuildIndirection(Input, Channels, InputHeight, InputWidth, OutputHeight, OutputWidth, KernelSize, KernelSize,
+                     Stride, Dilation, Pad, Zeroes.data());
+
+    //
+    // Compute the reference result: Relu(Sum + Conv + Bias).
+    //
+
+    const float Beta = WithSum ? 1.0f : 0.0f;
+
+    for (size_t p = 0; p < OutputCount; p++) {
+      for (size_t g = 0; g < GroupCount; g++) {
+        for (size_t f = 0; f < FilterCount; f++) {
+          const size_t oc = g * FilterCount + f;
+          float Sum = Beta * OutputReference[p * OutputChannels + oc] + Bias[oc];
+          for (size_t k = 0; k < KernelElements; k++) {
+            const float* in = Indirection[p * KernelElements + k] + g * InputChannels;
+            for (size_t c = 0; c < InputChannels; c++) {
+              Sum += in[c] * Filter[(oc * InputChannels + c) * KernelElements + k];
+            }
+          }
+          OutputReference[p * OutputChannels + oc] = std::max(Sum, 0.0f);
+        }
+      }
+    }
+
+    MLAS_GEMM_EPILOGUE Epilogue;
+    Epilogue.Activation.ActivationKind = MlasReluActivation;
+
+    if (InputChannels == 1 && FilterCount == 1) {
+      float* ReorderedFilter = BufferReorderedFilter.GetBuffer(OutputChannels * KernelElements);
+      for (size_t k = 0; k < KernelElements; k++) {
+        for (size_t c = 0; c < OutputChannels; c++) {
+          ReorderedFilter[k * OutputChannels + c] = Filter[c * KernelElements + k];
+        }
+      }
+      Epilogue.Bias = Bias;
+      MLAS_GEMM_EPILOGUE_PROCESSOR Processor(Epilogue);
+
+      //
+      // Split the output pixels in ranges like the threads of the caller.
+      //
+
+      for (size_t p = 0; p < OutputCount; p += 7) {
+        const size_t Count = std::min(OutputCount - p, size_t(7));
+        MlasConvDepthwise(Indirection.data() + p * KernelElements, ReorderedFilter, Output + p * OutputChannels,
+                          OutputChannels, Count, KernelElements, Beta, &Processor);
+      }
+    } else {
+      const size_t PackedSize = MlasGemmPackBSize(FilterCount, K);
+      uint8_t* PackedFilter = BufferPackedFilter.GetBuffer(GroupCount * PackedSize);
+      float* ReorderedFilter = BufferReorderedFilter.GetBuffer(K * FilterCount);
+
+      for (size_t g = 0; g < GroupCount; g++) {
+        for (size_t k = 0; k < KernelElements; k++) {
+          for (size_t c = 0; c < InputChannels; c++) {
+            for (size_t f = 0; f < FilterCount; f++) {
+              ReorderedFilter[(k * InputChannels + c) * FilterCount + f] =
+                  Filter[((g * FilterCount + f) * InputChannels + c) * KernelElements + k];
+            }
+          }
+        }
+        MlasGemmPackB(CblasNoTrans, FilterCount, K, ReorderedFilter, FilterCount, PackedFilter + g * PackedSize);
+      }
+
+      for (size_t p = 0; p < OutputCount; p += 40) {
+        const size_t Count = std::min(OutputCount - p, size_t(40));
+        for (size_t g = 0; g < GroupCount; g++) {
+          Epilogue.Bias = Bias + g * FilterCount;
+          MLAS_GEMM_EPILOGUE_PROCESSOR Processor(Epilogue);
+          MlasConvIndirect(Indirection.data() + p * KernelElements, g * InputChannels, InputChannels, KernelElements,
+                           Count, PackedFilter + g * PackedSize, FilterCount,
+                           Output + p * OutputChannels + g * FilterCount, OutputChannels, Beta, &Processor);
+        }
+      }
+    }
+
+    for (size_t i = 0; i < OutputCount * OutputChannels; i++) {
+      ASSERT_NEAR(Output[i], OutputReference[i], 1e-5f * float(K + 1))
+          << " @" << i << ", Group=" << GroupCount << ", C=" << InputChannels << ", F=" << FilterCount
+          << ", H=" << InputHeight << ", W=" << InputWidth << ", Kernel=" << KernelSize << ", Stride=" << Stride
+          << ", Dilation=" << Dilation << ", Pad=" << Pad << ", Sum=" << WithSum;
+    }
+  }
+
+  void TestPool(size_t Channels, size_t InputHeight, size_t InputWidth, size_t KernelSize, size_t Stride,
+                size_t Pad, bool MaxPool, bool CountIncludePad) {
+    const size_t OutputHeight = (InputHeight + 2 * Pad - KernelSize) / Stride + 1;
+    const size_t OutputWidth = (InputWidth + 2 * Pad - KernelSize) / Stride + 1;
+    const size_t OutputCount = OutputHeight * OutputWidth;
+    const size_t KernelElements = KernelSize * KernelSize;
+
+    float* Input = BufferInput.GetBuffer(InputHeight * InputWidth * Channels);
+    float* Output = BufferOutput.GetBuffer(OutputCount * Channels);
+    Fill(Input, InputHeight * InputWidth * Channels);
+
+    Zeroes.assign(Channels, 0.0f);
+    BuildIndirection(Input, Channels, InputHeight, InputWidth, OutputHeight, OutputWidth, KernelSize, KernelSize,
+                     Stride, 1, Pad, (!MaxPool && CountIncludePad) ? Zeroes.data() : nullptr);
+
+    if (MaxPool) {
+      MlasNhwcMaxPool(Indirection.data(), Output, Channels, OutputCount, KernelElements);
+    } else {
+      MlasNhwcAvgPool(Indirection.data(), Output, Channels, OutputCount, KernelElements);
+    }
+
+    for (size_t p = 0; p < OutputCount; p++) {
+      for (size_t c = 0; c < Channels; c++) {
+        float Reference = MaxPool ? std::numeric_limits<float>::lowest() : 0.0f;
+        size_t Count = 0;
+        for (size_t k = 0; k < KernelElements; k++) {
+          const float* in = Indirection[p * KernelElements + k];
+          if (in != nullptr) {
+            Reference = MaxPool ? std::max(Reference, in[c]) : Reference + in[c];
+            Count++;
+          }
+        }
+        if (!MaxPool) {
+          Reference /= float(Count);
+        }
+        ASSERT_NEAR(Output[p * Channels + c], Reference, 1e-6f)
+            << " @" << p << "," << c << ", C=" << Channels << ", H=" << InputHeight << ", W=" << InputWidth
+            << ", Kernel=" << KernelSize << ", Stride=" << Stride << ", Pad=" << Pad << ", MaxPool=" << MaxPool;
+      }
+    }
+  }
+
+  void ExecuteShort(void) override {
+    for (bool WithSum : {false, true}) {
+      TestConv(1, 3, 16, 11, 13, 3, 1, 1, 1, WithSum);
+      TestConv(1, 32, 24, 9, 9, 3, 2, 1, 1, WithSum);
+      TestConv(1, 17, 33, 8, 10, 5, 1, 2, 2, WithSum);
+      TestConv(1, 64, 64, 7, 7, 1, 1, 1, 0, WithSum);
+      TestConv(1, 320, 20, 5, 6, 3, 1, 1, 1, WithSum);
+      TestConv(2, 8, 12, 10, 10, 3, 1, 1, 1, WithSum);
+      TestConv(30, 1, 1, 12, 9, 3, 1, 1, 1, WithSum);
+      TestConv(67, 1, 1, 9, 9, 5, 2, 1, 2, WithSum);
+    }
+
+    for (bool MaxPool : {false, true}) {
+      for (bool CountIncludePad : {false, true}) {
+        TestPool(3, 9, 9, 3, 2, 1, MaxPool, CountIncludePad);
+        TestPool(37, 12, 10, 2, 2, 0, MaxPool, CountIncludePad);
+        TestPool(64, 7, 7, 3, 1, 1, MaxPool, CountIncludePad);
+      }
+    }
+  }
+};
+
+template <>
+MlasConvNhwcTest* MlasTestFixture<MlasConvNhwcTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasConvNhwcTest>::RegisterShortExecute() : 0;
+});
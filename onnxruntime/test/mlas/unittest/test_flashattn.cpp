@@ -0,0 +1,181 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_flashattn.cpp
+
+Abstract:
+
+    Tests for the MLAS fused multi-head attention.
+
+--*/
+
+#include "test_util.h"
+
+#include <random>
+
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferQuery;
+  MatrixGuardBuffer<float> BufferKey;
+  MatrixGuardBuffer<float> BufferValue;
+  MatrixGuardBuffer<float> BufferMask;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<double> BufferOutputReference;
+  MatrixGuardBuffer<double> BufferScores;
+  std::mt19937 Generator{1234};
+
+  void Fill(float* Buffer, size_t Count, float Range) {
+    std::uniform_real_distribution<float> Distribution(-Range, Range);
+    for (size_t i = 0; i < Count; i++) {
+      Buffer[i] = Distribution(Generator);
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("FlashAttention");
+    return suite_name.c_str();
+  }
+
+  void Test(size_t B, size_t N, size_t S, size_t T, size_t H, size_t Hv,
+            bool WithMask, bool MaskPerRow, bool WithBias, bool Causal, MLAS_THREADPOOL* ThreadPool) {
+    MLAS_FLASH_ATTENTION_PARAMS Params;
+    Params.BatchSize = B;
+    Params.NumHeads = N;
+    Params.SequenceLength = S;
+    Params.KvSequenceLength = T;
+    Params.QkHeadSize = H;
+    Params.VHeadSize = Hv;
+    Params.Scale = 1.0f / std::sqrt(float(H));
+
+    float* Query = BufferQuery.GetBuffer(B * N * S * H);
+    float* Key = BufferKey.GetBuffer(B * N * T * H);
+    float* Value = BufferValue.GetBuffer(B * N * T * Hv);
+    Fill(Query, B * N * S * H, 2.0f);
+    Fill(Key, B * N * T * H, 2.0f);
+    Fill(Value, B * N * T * Hv, 1.0f);
+    Params.Query = Query;
+    Params.Key = Key;
+    Params.Value = Value;
+
+    //
+    // The mask hides a random tail of the keys of each batch, like the mask
+    // built from key padding.
+    //
+
+    if (WithMask) {
+      const size_t MaskRows = MaskPerRow ? S : 1;
+      float* Mask = BufferMask.GetBuffer(B * MaskRows * T);
+      std::uniform_int_distribution<size_t> Length(1, T);
+      for (size_t b = 0; b < B; b++) {
+        for (size_t s = 0; s < MaskRows; s++) {
+          const size_t ValidKv = Length(Generator);
+          for (size_t j = 0; j < T; j++) {
+            Mask[(b * MaskRows + s) * T + j] = (j < ValidKv) ? 0.0f : -10000.0f;
+          }
+        }
+      }
+      Params.Mask = Mask;
+      Params.MaskBatchStride = MaskRows * T;
+      Params.MaskRowStride = MaskPerRow ? T : 0;
+    }
+
+    if (WithBias) {
+      float* Bias = BufferBias.GetBuffer(B * N * S * T);
+      Fill(Bias, B * N * S * T, 1.0f);
+      Params.Bias = Bias;
+    }
+
+    Params.Causal = Causal;
+    Params.CausalOffset = T - S;
+
+    float* Output = BufferOutput.GetBuffer(B * S * N * Hv, true);
+    Params.Output = Output;
+
+    MlasFlashAttention(&Params, ThreadPool);
+
+    //
+    // Compute the reference result in double precision.
+    //
+
+    double* OutputReference = BufferOutputReference.GetBuffer(B * S * N * Hv);
+    double* Scores = BufferScores.GetBuffer(T);
+
+    for (size_t b = 0; b < B; b++) {
+      for (size_t n = 0; n < N; n++) {
+        const size_t bn = b * N + n;
+        for (size_t s = 0; s < S; s++) {
+          const size_t Limit = Causal ? std::min(T, s + T - S + 1) : T;
+          double Maximum = -std::numeric_limits<double>::infinity();
+          for (size_t j = 0; j < Limit; j++) {
+            double Sum = 0.0;
+            for (size_t h = 0; h < H; h++) {
+              Sum += double(Query[(bn * S + s) * H + h]) * double(Key[(bn * T + j) * H + h]);
+            }
+            Sum *= Params.Scale;
+            if (Params.Bias != nullptr) {
+              Sum += Params.Bias[(bn * S + s) * T + j];
+            }
+            if (Params.Mask != nullptr) {
+              Sum += Params.Mask[b * Params.MaskBatchStride + s * Params.MaskRowStride + j];
+            }
+            Scores[j] = Sum;
+            Maximum = std::max(Maximum, Sum);
+          }
+          double Total = 0.0;
+          for (size_t j = 0; j < Limit; j++) {
+            Scores[j] = std::exp(Scores[j] - Maximum);
+            Total += Scores[j];
+          }
+          for (size_t h = 0; h < Hv; h++) {
+            double Sum = 0.0;
+            for (size_t j = 0; j < Limit; j++) {
+              Sum += Scores[j] * double(Value[(bn * T + j) * Hv + h]);
+            }
+            OutputReference[((b * S + s) * N + n) * Hv + h] = Sum / Total;
+          }
+        }
+      }
+    }
+
+    for (size_t i = 0; i < B * S * N * Hv; i++) {
+      ASSERT_LE(std::abs(double(Output[i]) - OutputReference[i]), 1e-4)
+          << "Expected: " << OutputReference[i] << " Actual: " << Output[i]
+          << " @" << i << ", B=" << B << ", N=" << N << ", S=" << S << ", T=" << T
+          << ", H=" << H << ", Hv=" << Hv << ", Mask=" << WithMask << ", MaskPerRow=" << MaskPerRow
+          << ", Bias=" << WithBias << ", Causal=" << Causal;
+    }
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_THREADPOOL* ThreadPool : {static_cast<MLAS_THREADPOOL*>(nullptr), GetMlasThreadPool()}) {
+      for (bool Causal : {false, true}) {
+        for (size_t S : {1, 7, 64, 150}) {
+          for (size_t T : {1, 31, 128, 300}) {
+            if (Causal && T < S) {
+              continue;
+            }
+            Test(2, 3, S, T, 16, 16, false, false, false, Causal, ThreadPool);
+            Test(1, 2, S, T, 24, 40, true, false, false, Causal, ThreadPool);
+          }
+        }
+        Test(2, 2, 70, 260, 32, 32, true, true, false, Causal, ThreadPool);
+        Test(1, 4, 33, 129, 8, 24, true, false, true, Causal, ThreadPool);
+        Test(3, 1, 130, 130, 64, 64, false, false, true, Causal, ThreadPool);
+      }
+    }
+  }
+};
+
+template <>
+MlasFlashAttentionTest* MlasTestFixture<MlasFlashAttentionTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasFlashAttentionTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasComputeGeluSiluTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+
+  static double Reference(MLAS_ACTIVATION_KIND Kind, double x, double Alpha) {
+    switch (Kind) {
+      case MlasGeluErfActivation:
+        return 0.5 * x * (1.0 + std::erf(x / std::sqrt(2.0)));
+      case MlasGeluTanhActivation:
+        return 0.5 * x * (1.0 + std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x)));
+      default:
+        return x / (1.0 + std::exp(-Alpha * x));
+    }
+  }
+
+  void Test(MLAS_ACTIVATION_KIND Kind, size_t N, bool WithBias, bool InPlace, float Alpha) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Bias = WithBias ? BufferBias.GetBuffer(N) : nullptr;
+    float* Output = InPlace ? Input : BufferOutput.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-8.0f, 8.0f);
+
+    std::vector<double> OutputReference(N);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = distribution(generator);
+      if (WithBias) {
+        Bias[n] = distribution(generator) * 0.25f;
+      }
+      const double x = double(Input[n]) + (WithBias ? double(Bias[n]) : 0.0);
+      OutputReference[n] = Reference(Kind, x, Alpha);
+    }
+
+    MlasComputeGeluSilu(Kind, Input, Bias, Output, N, Alpha);
+
+    constexpr double AbsoluteTolerance = 5e-6;
+    constexpr double RelativeTolerance = 1e-5;
+
+    for (size_t n = 0; n < N; n++) {
+      const double diff = std::fabs(Output[n] - OutputReference[n]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[n]) * RelativeTolerance)
+          << " @" << n << " of " << N << ", Kind=" << int(Kind) << ", Bias=" << WithBias << ", Alpha=" << Alpha
+          << ", got: " << Output[n] << ", expecting: " << OutputReference[n];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("GeluSilu");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (auto Kind : {MlasGeluErfActivation, MlasGeluTanhActivation, MlasSiluActivation}) {
+      for (size_t n = 1; n < 80; n++) {
+        Test(Kind, n, false, false, 1.0f);
+        Test(Kind, n, true, n % 2 == 0, 1.0f);
+      }
+      Test(Kind, 4096 + 3, true, false, 1.0f);
+    }
+
+    for (size_t n : {1, 15, 33, 1000}) {
+      Test(MlasSiluActivation, n, false, true, 1.702f);
+      Test(MlasSiluActivation, n, true, false, 1.702f);
+    }
+  }
+};
+
+template <>
+MlasComputeGeluSiluTest* MlasTestFixture<MlasComputeGeluSiluTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasComputeGeluSiluTest>::RegisterShortExecute() : 0;
+});
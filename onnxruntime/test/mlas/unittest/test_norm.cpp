@@ -0,0 +1,174 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_norm.cpp
+
+Abstract:
+
+    Tests for the MLAS layer and RMS normalization.
+
+--*/
+
+#include "test_fp16.h"
+
+#include <random>
+
+template <typename T>
+class MlasNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<T> BufferInput;
+  MatrixGuardBuffer<T> BufferSkip;
+  MatrixGuardBuffer<T> BufferSkipBias;
+  MatrixGuardBuffer<T> BufferScale;
+  MatrixGuardBuffer<T> BufferBias;
+  MatrixGuardBuffer<T> BufferOutput;
+  MatrixGuardBuffer<T> BufferSkipOutput;
+  MatrixGuardBuffer<float> BufferMean;
+  MatrixGuardBuffer<float> BufferInvStdDev;
+  std::mt19937 Generator{1234};
+
+  static constexpr bool IsHalf = std::is_same<T, MLFp16>::value;
+
+  using MlasType = typename std::conditional<IsHalf, MLAS_FP16, float>::type;
+
+  const T* Fill(MatrixGuardBuffer<T>& Buffer, size_t Count, float Offset) {
+    T* p = Buffer.GetBuffer(Count);
+    std::uniform_real_distribution<float> Distribution(-1.0f, 1.0f);
+    for (size_t i = 0; i < Count; i++) {
+      p[i] = T(Distribution(Generator) + Offset);
+    }
+    return p;
+  }
+
+  static const MlasType* Cast(const T* p) { return reinterpret_cast<const MlasType*>(p); }
+
+  static MlasType* Cast(T* p) { return reinterpret_cast<MlasType*>(p); }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(IsHalf ? "NormFp16" : "Norm");
+    return suite_name.c_str();
+  }
+
+  void Test(size_t Rows, size_t D, bool Simplified, bool WithSkip, size_t SkipRows,
+            bool WithSkipBias, bool WithBias, MLAS_THREADPOOL* ThreadPool) {
+    // The offset of the input checks the precision of the variance.
+    const T* Input = Fill(BufferInput, Rows * D, 4.0f);
+    const T* Skip = WithSkip ? Fill(BufferSkip, SkipRows * D, 0.0f) : nullptr;
+    const T* SkipBias = WithSkipBias ? Fill(BufferSkipBias, D, 0.0f) : nullptr;
+    const T* Scale = Fill(BufferScale, D, 1.0f);
+    const T* Bias = WithBias ? Fill(BufferBias, D, 0.0f) : nullptr;
+    T* Output = BufferOutput.GetBuffer(Rows * D, true);
+    T* SkipOutput = WithSkip ? BufferSkipOutput.GetBuffer(Rows * D, true) : nullptr;
+    float* Mean = BufferMean.GetBuffer(Rows, true);
+    float* InvStdDev = BufferInvStdDev.GetBuffer(Rows, true);
+
+    MLAS_NORM_PARAMS<MlasType> Params;
+    Params.Input = Cast(Input);
+    Params.Skip = Cast(Skip);
+    Params.SkipRows = SkipRows;
+    Params.SkipBias = Cast(SkipBias);
+    Params.Scale = Cast(Scale);
+    Params.Bias = Cast(Bias);
+    Params.Output = Cast(Output);
+    Params.SkipOutput = Cast(SkipOutput);
+    Params.Mean = Mean;
+    Params.InvStdDev = InvStdDev;
+    Params.Rows = Rows;
+    Params.D = D;
+    Params.Epsilon = 1e-5f;
+
+    if (Simplified) {
+      MlasRmsNorm(&Params, ThreadPool);
+    } else {
+      MlasLayerNorm(&Params, ThreadPool);
+    }
+
+    //
+    // Compute the reference result in double precision.
+    //
+
+    const double Tolerance = IsHalf ? 2e-2 : 1e-4;
+    std::vector<double> x(D);
+
+    for (size_t r = 0; r < Rows; r++) {
+      double Sum = 0.0;
+      for (size_t d = 0; d < D; d++) {
+        x[d] = double(float(Input[r * D + d]));
+        if (Skip != nullptr) {
+          x[d] += double(float(Skip[(r % SkipRows) * D + d]));
+        }
+        if (SkipBias != nullptr) {
+          x[d] += double(float(SkipBias[d]));
+        }
+        Sum += Simplified ? x[d] * x[d] : x[d];
+      }
+      double ExpectedMean = 0.0;
+      double Variance = Sum / double(D);
+      if (!Simplified) {
+        ExpectedMean = Variance;
+        Variance = 0.0;
+        for (size_t d = 0; d < D; d++) {
+          Variance += (x[d] - ExpectedMean) * (x[d] - ExpectedMean);
+        }
+        Variance /= double(D);
+      }
+      const double ExpectedInvStdDev = 1.0 / std::sqrt(Variance + 1e-5);
+
+      if (!Simplified) {
+        ASSERT_LE(std::abs(Mean[r] - ExpectedMean), Tolerance) << "Mean @" << r << ", D=" << D;
+      }
+      ASSERT_LE(std::abs(InvStdDev[r] - ExpectedInvStdDev), Tolerance * ExpectedInvStdDev)
+          << "InvStdDev @" << r << ", D=" << D;
+
+      for (size_t d = 0; d < D; d++) {
+        double y = (x[d] - ExpectedMean) * ExpectedInvStdDev * double(float(Scale[d]));
+        if (Bias != nullptr && !Simplified) {
+          y += double(float(Bias[d]));
+        }
+        ASSERT_LE(std::abs(double(float(Output[r * D + d])) - y), Tolerance)
+            << "Expected: " << y << " Actual: " << float(Output[r * D + d]) << " @[" << r << "," << d
+            << "], Rows=" << Rows << ", D=" << D << ", Simplified=" << Simplified << ", Skip=" << WithSkip
+            << ", SkipBias=" << WithSkipBias << ", Bias=" << WithBias;
+        if (SkipOutput != nullptr) {
+          ASSERT_LE(std::abs(double(float(SkipOutput[r * D + d])) - x[d]), Tolerance)
+              << "SkipOutput @[" << r << "," << d << "], D=" << D;
+        }
+      }
+    }
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_THREADPOOL* ThreadPool : {static_cast<MLAS_THREADPOOL*>(nullptr), GetMlasThreadPool()}) {
+      for (bool Simplified : {false, true}) {
+        for (size_t D : {1, 3, 8, 15, 16, 33, 64, 127, 768, 1030}) {
+          Test(5, D, Simplified, false, 0, false, false, ThreadPool);
+          Test(3, D, Simplified, false, 0, false, true, ThreadPool);
+          Test(7, D, Simplified, true, 7, true, true, ThreadPool);
+        }
+        // The skip is broadcast across the batch.
+        Test(12, 96, Simplified, true, 4, false, true, ThreadPool);
+        Test(64, 1024, Simplified, true, 64, true, true, ThreadPool);
+      }
+    }
+  }
+};
+
+template <>
+MlasNormTest<float>* MlasTestFixture<MlasNormTest<float>>::mlas_tester(nullptr);
+template <>
+MlasNormTest<MLFp16>* MlasTestFixture<MlasNormTest<MLFp16>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasNormTest<float>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasNormTest<MLFp16>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,192 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sgemm_epilogue.cpp
+
+Abstract:
+
+    Tests for the fused epilogue of the MLAS single precision GEMM.
+
+--*/
+
+#include "test_util.h"
+
+#include <random>
+
+class MlasSgemmEpilogueTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferResidual;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<uint8_t> BufferQuantOutput;
+  MatrixGuardBuffer<double> BufferCReference;
+  std::mt19937 Generator{1234};
+
+  static double ReferenceActivation(MLAS_ACTIVATION_KIND Kind, double x) {
+    switch (Kind) {
+      case MlasReluActivation:
+        return std::max(x, 0.0);
+      case MlasGeluErfActivation:
+        return 0.5 * x * (1.0 + std::erf(x / std::sqrt(2.0)));
+      case MlasGeluTanhActivation:
+        return 0.5 * x * (1.0 + std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x)));
+      case MlasSiluActivation:
+        return x / (1.0 + std::exp(-x));
+      default:
+        return x;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SgemmEpilogue");
+    return suite_name.c_str();
+  }
+
+  void Test(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, bool PackB,
+            size_t M, size_t N, size_t K, MLAS_ACTIVATION_KIND Kind,
+            bool WithBias, bool WithResidual, bool WithQuantOutput, MLAS_THREADPOOL* ThreadPool) {
+    std::uniform_real_distribution<float> Distribution(-1.0f, 1.0f);
+
+    float* A = BufferA.GetBuffer(M * K);
+    for (size_t i = 0; i < M * K; i++) {
+      A[i] = Distribution(Generator);
+    }
+
+    float* B = BufferB.GetBuffer(K * N);
+    for (size_t i = 0; i < K * N; i++) {
+      B[i] = Distribution(Generator);
+    }
+
+    float* Bias = nullptr;
+    if (WithBias) {
+      Bias = BufferBias.GetBuffer(N);
+      for (size_t n = 0; n < N; n++) {
+        Bias[n] = Distribution(Generator);
+      }
+    }
+
+    float* Residual = nullptr;
+    if (WithResidual) {
+      Residual = BufferResidual.GetBuffer(M * N);
+      for (size_t i = 0; i < M * N; i++) {
+        Residual[i] = Distribution(Generator);
+      }
+    }
+
+    //
+    // Compute the reference result in double precision.
+    //
+
+    double* CReference = BufferCReference.GetBuffer(M * N);
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = (Bias != nullptr) ? Bias[n] : 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const float av = (TransA == CblasNoTrans) ? A[m * K + k] : A[k * M + m];
+          const float bv = (TransB == CblasNoTrans) ? B[k * N + n] : B[n * K + k];
+          sum += double(av) * double(bv);
+        }
+        sum = ReferenceActivation(Kind, sum);
+        if (Residual != nullptr) {
+          sum += Residual[m * N + n];
+        }
+        CReference[m * N + n] = sum;
+      }
+    }
+
+    MLAS_GEMM_EPILOGUE Epilogue;
+    Epilogue.Bias = Bias;
+    Epilogue.Activation.ActivationKind = Kind;
+    Epilogue.Residual = Residual;
+    Epilogue.ldr = N;
+
+    const float QuantScale = 0.02f;
+    const int32_t QuantZeroPoint = 128;
+    uint8_t* QuantOutput = nullptr;
+    if (WithQuantOutput) {
+      QuantOutput = BufferQuantOutput.GetBuffer(M * N);
+      Epilogue.QuantOutput = QuantOutput;
+      Epilogue.ldq = N;
+      Epilogue.QuantScale = QuantScale;
+      Epilogue.QuantZeroPoint = QuantZeroPoint;
+    }
+
+    MLAS_GEMM_EPILOGUE_PROCESSOR Processor(Epilogue);
+
+    float* C = BufferC.GetBuffer(M * N, true);
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = (TransA == CblasNoTrans) ? K : M;
+    Data.C = C;
+    Data.ldc = N;
+    Data.OutputProcessor = &Processor;
+
+    if (PackB) {
+      void* PackedB = BufferPackedB.GetBuffer(MlasGemmPackBSize(N, K), true);
+      MlasGemmPackB(TransB, N, K, B, (TransB == CblasNoTrans) ? N : K, PackedB);
+      Data.B = static_cast<const float*>(PackedB);
+      Data.BIsPacked = true;
+    } else {
+      Data.B = B;
+      Data.ldb = (TransB == CblasNoTrans) ? N : K;
+    }
+
+    MlasGemmBatch(TransA, TransB, M, N, K, &Data, 1, ThreadPool);
+
+    for (size_t i = 0; i < M * N; i++) {
+      ASSERT_LE(std::abs(double(C[i]) - CReference[i]), std::abs(CReference[i]) * 1e-5 + 1e-4)
+          << "Expected: " << CReference[i] << " Actual: " << C[i]
+          << " @[" << i / N << "," << i % N << "], "
+          << "M=" << M << ", N=" << N << ", K=" << K << ", Kind=" << int(Kind)
+          << ", TransA=" << int(TransA) << ", TransB=" << int(TransB) << ", PackB=" << PackB
+          << ", Bias=" << WithBias << ", Residual=" << WithResidual;
+    }
+
+    if (WithQuantOutput) {
+      for (size_t i = 0; i < M * N; i++) {
+        const float Expected = std::min(std::max(std::nearbyint(C[i] / QuantScale) + QuantZeroPoint, 0.0f), 255.0f);
+        ASSERT_LE(std::abs(float(QuantOutput[i]) - Expected), 1.0f)
+            << "Expected: " << Expected << " Actual: " << int(QuantOutput[i])
+            << " @[" << i / N << "," << i % N << "], M=" << M << ", N=" << N << ", K=" << K;
+      }
+    }
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_THREADPOOL* ThreadPool : {static_cast<MLAS_THREADPOOL*>(nullptr), GetMlasThreadPool()}) {
+      for (auto Kind : {MlasIdentityActivation, MlasReluActivation, MlasGeluErfActivation,
+                        MlasGeluTanhActivation, MlasSiluActivation}) {
+        for (size_t M : {1, 13, 40}) {
+          for (size_t N : {1, 7, 33, 300}) {
+            for (size_t K : {0, 5, 129}) {
+              Test(CblasNoTrans, CblasNoTrans, false, M, N, K, Kind, true, true, false, ThreadPool);
+            }
+          }
+        }
+        Test(CblasTrans, CblasNoTrans, false, 29, 67, 40, Kind, true, false, false, ThreadPool);
+        Test(CblasNoTrans, CblasTrans, false, 1, 67, 40, Kind, false, true, false, ThreadPool);
+        Test(CblasNoTrans, CblasTrans, false, 33, 1, 40, Kind, true, true, false, ThreadPool);
+        Test(CblasNoTrans, CblasNoTrans, true, 37, 300, 400, Kind, true, true, false, ThreadPool);
+        Test(CblasTrans, CblasTrans, true, 19, 70, 33, Kind, true, false, false, ThreadPool);
+        Test(CblasNoTrans, CblasNoTrans, false, 50, 520, 300, Kind, true, true, true, ThreadPool);
+      }
+    }
+  }
+};
+
+template <>
+MlasSgemmEpilogueTest* MlasTestFixture<MlasSgemmEpilogueTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasSgemmEpilogueTest>::RegisterShortExecute() : 0;
+});
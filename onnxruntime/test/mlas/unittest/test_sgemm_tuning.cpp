@@ -0,0 +1,143 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sgemm_tuning.cpp
+
+Abstract:
+
+    Tests for the tuned blocking and threading parameters of the MLAS single
+    precision GEMM.
+
+--*/
+
+#include "test_util.h"
+
+#include <random>
+
+class MlasSgemmTuningTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<double> BufferCReference;
+  std::mt19937 Generator{1234};
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SgemmTuning");
+    return suite_name.c_str();
+  }
+
+  void Test(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, bool PackB, size_t M, size_t N, size_t K,
+            const MLAS_SGEMM_TUNING_PARAMETERS& Parameters, MLAS_THREADPOOL* ThreadPool) {
+    std::uniform_real_distribution<float> Distribution(-1.0f, 1.0f);
+
+    float* A = BufferA.GetBuffer(M * K);
+    for (size_t i = 0; i < M * K; i++) {
+      A[i] = Distribution(Generator);
+    }
+
+    float* B = BufferB.GetBuffer(K * N);
+    for (size_t i = 0; i < K * N; i++) {
+      B[i] = Distribution(Generator);
+    }
+
+    float* C = BufferC.GetBuffer(M * N, true);
+    for (size_t i = 0; i < M * N; i++) {
+      C[i] = Distribution(Generator);
+    }
+
+    const float alpha = 0.75f;
+    const float beta = 0.5f;
+
+    double* CReference = BufferCReference.GetBuffer(M * N);
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const float av = (TransA == CblasNoTrans) ? A[m * K + k] : A[k * M + m];
+          const float bv = (TransB == CblasNoTrans) ? B[k * N + n] : B[n * K + k];
+          sum += double(av) * double(bv);
+        }
+        CReference[m * N + n] = alpha * sum + beta * double(C[m * N + n]);
+      }
+    }
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = (TransA == CblasNoTrans) ? K : M;
+    Data.C = C;
+    Data.ldc = N;
+    Data.alpha = alpha;
+    Data.beta = beta;
+
+    if (PackB) {
+      void* PackedB = BufferPackedB.GetBuffer(MlasGemmPackBSize(N, K), true);
+      MlasGemmPackB(TransB, N, K, B, (TransB == CblasNoTrans) ? N : K, PackedB);
+      Data.B = static_cast<const float*>(PackedB);
+      Data.BIsPacked = true;
+    } else {
+      Data.B = B;
+      Data.ldb = (TransB == CblasNoTrans) ? N : K;
+    }
+
+    MlasGemmBatch(TransA, TransB, M, N, K, &Data, 1, ThreadPool, &Parameters);
+
+    for (size_t i = 0; i < M * N; i++) {
+      ASSERT_LE(std::abs(double(C[i]) - CReference[i]), std::abs(CReference[i]) * 1e-5 + 1e-4)
+          << "Expected: " << CReference[i] << " Actual: " << C[i]
+          << " @[" << i / N << "," << i % N << "], "
+          << "M=" << M << ", N=" << N << ", K=" << K
+          << ", TransA=" << int(TransA) << ", TransB=" << int(TransB) << ", PackB=" << PackB
+          << ", StrideN=" << Parameters.StrideN << ", StrideK=" << Parameters.StrideK
+          << ", ThreadComplexity=" << Parameters.ThreadComplexity << ", Partition=" << int(Parameters.Partition);
+    }
+  }
+
+  void ExecuteShort(void) override {
+    size_t CandidateCount;
+    const MLAS_SGEMM_TUNING_PARAMETERS* Candidates = MlasSgemmTuningCandidates(&CandidateCount);
+
+    ASSERT_GT(CandidateCount, size_t(1));
+    ASSERT_EQ(Candidates[0].StrideN, size_t(0));
+    ASSERT_EQ(Candidates[0].ThreadComplexity, size_t(0));
+    ASSERT_EQ(Candidates[0].Partition, MlasSgemmPartitionDefault);
+
+    //
+    // Every candidate and some parameters that do not fit the panel buffers,
+    // which fall back to the heuristic, must produce the same result.
+    //
+
+    std::vector<MLAS_SGEMM_TUNING_PARAMETERS> ParametersList(Candidates, Candidates + CandidateCount);
+    ParametersList.push_back({1024, 128, 0, MlasSgemmPartitionDefault});
+    ParametersList.push_back({24, 256, 1, MlasSgemmPartitionN});
+
+    for (MLAS_THREADPOOL* ThreadPool : {static_cast<MLAS_THREADPOOL*>(nullptr), GetMlasThreadPool()}) {
+      for (const auto& Parameters : ParametersList) {
+        for (size_t M : {1, 13, 64}) {
+          for (size_t N : {7, 33, 300}) {
+            for (size_t K : {5, 129, 600}) {
+              Test(CblasNoTrans, CblasNoTrans, false, M, N, K, Parameters, ThreadPool);
+            }
+          }
+        }
+        Test(CblasTrans, CblasNoTrans, false, 29, 67, 300, Parameters, ThreadPool);
+        Test(CblasNoTrans, CblasTrans, false, 40, 520, 70, Parameters, ThreadPool);
+        Test(CblasTrans, CblasTrans, true, 19, 70, 333, Parameters, ThreadPool);
+      }
+    }
+  }
+};
+
+template <>
+MlasSgemmTuningTest* MlasTestFixture<MlasSgemmTuningTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasSgemmTuningTest>::RegisterShortExecute() : 0;
+});
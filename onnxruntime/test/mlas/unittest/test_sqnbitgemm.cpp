@@ -0,0 +1,278 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sqnbitgemm.cpp
+
+Abstract:
+
+    Tests for MLAS GEMM for blockwise n-bit quantization.
+
+--*/
+
+#ifndef ORT_MINIMAL_BUILD
+
+#include "test_util.h"
+#include "mlas_qnbit.h"
+
+#include <random>
+
+template <size_t BlkBitWidth, size_t BlkLen>
+class MlasSQNBitGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<uint8_t> BufferQuantBData;
+  MatrixGuardBuffer<float> BufferQuantBScale;
+  MatrixGuardBuffer<uint8_t> BufferQuantBZeroPoint;
+  MatrixGuardBuffer<float> BufferDequantB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<double> BufferCReference;
+  MatrixGuardBuffer<double> BufferCTolerance;
+  MatrixGuardBuffer<uint8_t> BufferWorkspace;
+  std::mt19937 Generator{1234};
+
+  static uint8_t QuantBValue(const uint8_t* BlkData, size_t i) {
+    switch (BlkBitWidth) {
+      case 2:
+        return (BlkData[i / 4] >> (2 * (i % 4))) & 0x03;
+      case 3:
+        return ((BlkData[BlkLen / 8 + i / 4] >> (2 * (i % 4))) & 0x03) |
+               (((BlkData[i / 8] >> (i % 8)) & 0x01) << 2);
+      case 4:
+        return (BlkData[i / 2] >> (4 * (i % 2))) & 0x0F;
+      default:
+        return BlkData[i];
+    }
+  }
+
+  static uint8_t QuantBZeroPointValue(const uint8_t* QuantBZeroPoint, size_t BlockIndex) {
+    if (QuantBZeroPoint == nullptr) {
+      return uint8_t(1u << (BlkBitWidth - 1));
+    }
+    if (BlkBitWidth > 4) {
+      return QuantBZeroPoint[BlockIndex];
+    }
+    return (QuantBZeroPoint[BlockIndex / 2] >> (4 * (BlockIndex % 2))) & 0x0F;
+  }
+
+  // Dequantizes B to a K x N matrix.
+  void DequantizeB(size_t N, size_t K, const uint8_t* QuantBData, const float* QuantBScale,
+                   const uint8_t* QuantBZeroPoint, float* B) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t BlkDataSize = BlkLen * BlkBitWidth / 8;
+
+    for (size_t n = 0; n < N; n++) {
+      for (size_t k = 0; k < K; k++) {
+        const size_t BlockIndex = n * BlockCountK + k / BlkLen;
+        const uint8_t q = QuantBValue(QuantBData + BlockIndex * BlkDataSize, k % BlkLen);
+        const int32_t ZeroPoint = QuantBZeroPointValue(QuantBZeroPoint, BlockIndex);
+        B[k * N + n] = float(int32_t(q) - ZeroPoint) * QuantBScale[BlockIndex];
+      }
+    }
+  }
+
+  // Applies the quantization of A used by CompInt8 to a row: the values of
+  // each block are replaced with their quantized values times the scale.
+  static void QuantizeARow(const float* A, size_t K, double* QuantizedA) {
+    for (size_t k = 0; k < K; k += BlkLen) {
+      const size_t CountK = std::min(K - k, BlkLen);
+
+      float AbsMax = 0.0f;
+      for (size_t i = 0; i < CountK; i++) {
+        AbsMax = std::max(AbsMax, std::fabs(A[k + i]));
+      }
+
+      const float Scale = AbsMax / 127.0f;
+      const float ReciprocalScale = (Scale != 0.0f) ? 1.0f / Scale : 0.0f;
+
+      for (size_t i = 0; i < CountK; i++) {
+        const int32_t q = std::min(std::max(int32_t(std::nearbyintf(A[k + i] * ReciprocalScale)), -127), 127);
+        QuantizedA[k + i] = double(q) * double(Scale);
+      }
+    }
+  }
+
+  void ReferenceGemm(size_t M, size_t N, size_t K, MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType,
+                     const float* A, const float* B, const float* Bias,
+                     double* C, double* CTolerance) {
+    std::vector<double> RowA(K);
+
+    for (size_t m = 0; m < M; m++) {
+      if (ComputeType == CompInt8) {
+        QuantizeARow(A + m * K, K, RowA.data());
+      } else {
+        std::copy_n(A + m * K, K, RowA.begin());
+      }
+
+      for (size_t n = 0; n < N; n++) {
+        double sum = (Bias != nullptr) ? Bias[n] : 0.0;
+        double sum_abs = (Bias != nullptr) ? std::abs(Bias[n]) : 0.0;
+        for (size_t k = 0; k < K; k++) {
+          sum += RowA[k] * B[k * N + n];
+          sum_abs += std::abs(RowA[k] * B[k * N + n]);
+        }
+        C[m * N + n] = sum;
+        // The kernels accumulate in fp32 with their own order of summation.
+        CTolerance[m * N + n] = sum_abs * 2e-5 + 1e-5;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static std::string suite_name = std::string("SQNBitGemm") +
+                                    "BlkBitWidth" + std::to_string(BlkBitWidth) +
+                                    "BlkLen" + std::to_string(BlkLen);
+    return suite_name.c_str();
+  }
+
+  void Test(size_t M, size_t N, size_t K, MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType,
+            bool WithZeroPoint, bool WithBias, MLAS_THREADPOOL* ThreadPool) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t QuantBDataSize = N * BlockCountK * (BlkLen * BlkBitWidth / 8);
+    const size_t QuantBZeroPointSize = (BlkBitWidth > 4) ? N * BlockCountK : (N * BlockCountK + 1) / 2;
+
+    std::uniform_real_distribution<float> ADistribution(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> ScaleDistribution(0.01f, 0.1f);
+    std::uniform_int_distribution<int> ByteDistribution(0, 255);
+
+    float* A = BufferA.GetBuffer(M * K);
+    for (size_t i = 0; i < M * K; i++) {
+      A[i] = ADistribution(Generator);
+    }
+
+    uint8_t* QuantBData = BufferQuantBData.GetBuffer(QuantBDataSize);
+    for (size_t i = 0; i < QuantBDataSize; i++) {
+      QuantBData[i] = uint8_t(ByteDistribution(Generator));
+    }
+
+    float* QuantBScale = BufferQuantBScale.GetBuffer(N * BlockCountK);
+    for (size_t i = 0; i < N * BlockCountK; i++) {
+      QuantBScale[i] = ScaleDistribution(Generator);
+    }
+
+    uint8_t* QuantBZeroPoint = nullptr;
+    if (WithZeroPoint) {
+      QuantBZeroPoint = BufferQuantBZeroPoint.GetBuffer(QuantBZeroPointSize);
+      for (size_t i = 0; i < QuantBZeroPointSize; i++) {
+        QuantBZeroPoint[i] = uint8_t(ByteDistribution(Generator));
+        if (BlkBitWidth < 4) {
+          // Zero points are stored in nibbles, but must fit the bit width.
+          const uint8_t Mask = uint8_t((1u << BlkBitWidth) - 1);
+          QuantBZeroPoint[i] &= uint8_t(Mask | (Mask << 4));
+        }
+      }
+    }
+
+    float* Bias = nullptr;
+    if (WithBias) {
+      Bias = BufferBias.GetBuffer(N);
+      for (size_t n = 0; n < N; n++) {
+        Bias[n] = ADistribution(Generator);
+      }
+    }
+
+    float* B = BufferDequantB.GetBuffer(K * N);
+    DequantizeB(N, K, QuantBData, QuantBScale, QuantBZeroPoint, B);
+
+    double* CReference = BufferCReference.GetBuffer(M * N);
+    double* CTolerance = BufferCTolerance.GetBuffer(M * N);
+    ReferenceGemm(M, N, K, ComputeType, A, B, Bias, CReference, CTolerance);
+
+    float* C = BufferC.GetBuffer(M * N, true);
+
+    MLAS_SQNBIT_GEMM_DATA_PARAMS Params;
+    Params.A = A;
+    Params.lda = K;
+    Params.QuantBData = QuantBData;
+    Params.QuantBScale = QuantBScale;
+    Params.QuantBZeroPoint = QuantBZeroPoint;
+    Params.Bias = Bias;
+    Params.C = C;
+    Params.ldc = N;
+
+    const size_t WorkspaceSize = MlasSQNBitGemmBatchWorkspaceSize(M, N, K, 1, BlkBitWidth, BlkLen, ComputeType);
+    void* Workspace = (WorkspaceSize > 0) ? BufferWorkspace.GetBuffer(WorkspaceSize) : nullptr;
+
+    MlasSQNBitGemmBatch(M, N, K, 1, BlkBitWidth, BlkLen, ComputeType, &Params, Workspace, ThreadPool);
+
+    for (size_t i = 0; i < M * N; i++) {
+      ASSERT_LE(std::abs(double(C[i]) - CReference[i]), CTolerance[i])
+          << "Expected: " << CReference[i] << " Actual: " << C[i]
+          << " @[" << i / N << "," << i % N << "], "
+          << "M=" << M << ", N=" << N << ", K=" << K
+          << ", ComputeType=" << int(ComputeType) << ", ZeroPoint=" << WithZeroPoint
+          << ", Bias=" << WithBias << ", Threaded=" << (ThreadPool != nullptr);
+    }
+  }
+
+  void ExecuteShort(void) override {
+    for (auto ComputeType : {CompFp32, CompInt8}) {
+      if (!MlasIsSQNBitGemmAvailable(BlkBitWidth, BlkLen, ComputeType)) {
+        continue;
+      }
+
+      for (MLAS_THREADPOOL* ThreadPool : {static_cast<MLAS_THREADPOOL*>(nullptr), GetMlasThreadPool()}) {
+        for (size_t M : {1, 2, 17}) {
+          for (size_t N : {1, 7, 32, 67}) {
+            for (size_t K : {size_t(1), size_t(15), BlkLen, BlkLen * 2 + 3, size_t(300)}) {
+              Test(M, N, K, ComputeType, false, false, ThreadPool);
+              Test(M, N, K, ComputeType, true, true, ThreadPool);
+            }
+          }
+        }
+        Test(43, 500, 401, ComputeType, true, true, ThreadPool);
+        Test(1, 1024, 1024, ComputeType, true, false, ThreadPool);
+        Test(160, 288, 544, ComputeType, false, true, ThreadPool);
+      }
+    }
+  }
+};
+
+template <>
+MlasSQNBitGemmTest<2, 16>* MlasTestFixture<MlasSQNBitGemmTest<2, 16>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<2, 64>* MlasTestFixture<MlasSQNBitGemmTest<2, 64>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<3, 32>* MlasTestFixture<MlasSQNBitGemmTest<3, 32>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<3, 128>* MlasTestFixture<MlasSQNBitGemmTest<3, 128>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<4, 16>* MlasTestFixture<MlasSQNBitGemmTest<4, 16>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<4, 32>* MlasTestFixture<MlasSQNBitGemmTest<4, 32>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<4, 64>* MlasTestFixture<MlasSQNBitGemmTest<4, 64>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<4, 128>* MlasTestFixture<MlasSQNBitGemmTest<4, 128>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<4, 256>* MlasTestFixture<MlasSQNBitGemmTest<4, 256>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<8, 32>* MlasTestFixture<MlasSQNBitGemmTest<8, 32>>::mlas_tester(nullptr);
+template <>
+MlasSQNBitGemmTest<8, 256>* MlasTestFixture<MlasSQNBitGemmTest<8, 256>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute && MlasIsSQNBitGemmAvailable(4, 32, CompFp32)) {
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<2, 16>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<2, 64>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<3, 32>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<3, 128>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<4, 16>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<4, 32>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<4, 64>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<4, 128>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<4, 256>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<8, 32>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSQNBitGemmTest<8, 256>>::RegisterShortExecute();
+  }
+  return count;
+});
+
+#endif  // ORT_MINIMAL_BUILD
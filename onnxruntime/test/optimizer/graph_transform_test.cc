@@ -1335,6 +1335,48 @@ TEST_F(GraphTransformationTests, FuseConvActivationPreservingAttributes) {
   check_ints_attr("pads", AsSpan<int64_t>({1, 1, 1, 1}));
   check_ints_attr("kernel_shape", AsSpan<int64_t>({3, 3}));
 }
+
+// Gelu, FastGelu and QuickGelu with alpha 1 (SiLU) are fused into the float FusedConv of the CPU EP.
+TEST_F(GraphTransformationTests, FuseConvGeluSiluActivation) {
+  struct TestCase {
+    const char* op_type;
+    float alpha;
+    bool fused;
+  };
+
+  for (const auto& test_case : {TestCase{"Gelu", 0.0f, true}, TestCase{"FastGelu", 0.0f, true},
+                                TestCase{"QuickGelu", 1.0f, true}, TestCase{"QuickGelu", 1.702f, false}}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({{1, 3, 8, 8}});
+      auto* weight_arg = builder.MakeInitializer<float>({4, 3, 3, 3}, -1.0f, 1.0f);
+      auto* conv_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Conv", {input_arg, weight_arg}, {conv_out});
+      auto& activation_node = builder.AddNode(test_case.op_type, {conv_out}, {output_arg}, kMSDomain);
+      if (test_case.alpha != 0.0f) {
+        activation_node.AddAttribute("alpha", test_case.alpha);
+      }
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["Conv"] == (test_case.fused ? 0 : 1));
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedConv"] == (test_case.fused ? 1 : 0));
+      for (const auto& node : graph.Nodes()) {
+        if (node.OpType() == "FusedConv") {
+          const auto& attrs = node.GetAttributes();
+          TEST_RETURN_IF_NOT(attrs.at("activation").s() == test_case.op_type);
+          TEST_RETURN_IF_NOT((attrs.find("activation_params") != attrs.end()) == (test_case.alpha != 0.0f));
+        }
+      }
+      return Status::OK();
+    };
+
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<ConvActivationFusion>(),
+                                          TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+  }
+}
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 TEST_F(GraphTransformationTests, FuseConvMulNoBias) {
@@ -1797,6 +1839,43 @@ TEST_F(GraphTransformationTests, Gemm_LeakyRelu_Fusion) {
   ASSERT_TRUE(op_to_count["Gemm"] == 0);
   ASSERT_TRUE(op_to_count["com.microsoft.FusedGemm"] == 1);
 }
+
+TEST_F(GraphTransformationTests, Gemm_Gelu_Residual_Fusion) {
+  // The Add is fused as the residual input only if the other input has the shape of the output.
+  for (bool broadcast_residual : {false, true}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({{4, 8}});
+      auto* residual_arg = broadcast_residual ? builder.MakeInput<float>({{16}}) : builder.MakeInput<float>({{4, 16}});
+      auto* weight_arg = builder.MakeInitializer<float>({8, 16}, -1.0f, 1.0f);
+      auto* bias_arg = builder.MakeInitializer<float>({16}, -1.0f, 1.0f);
+      auto* gemm_out = builder.MakeIntermediate();
+      auto* gelu_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Gemm", {input_arg, weight_arg, bias_arg}, {gemm_out});
+      builder.AddNode("Gelu", {gemm_out}, {gelu_out}, kMSDomain);
+      builder.AddNode("Add", {residual_arg, gelu_out}, {output_arg});
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["Gemm"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.Gelu"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedGemm"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["Add"] == (broadcast_residual ? 1 : 0));
+      for (const auto& node : graph.Nodes()) {
+        if (node.OpType() == "FusedGemm") {
+          TEST_RETURN_IF_NOT(node.GetAttributes().at("activation").s() == "Gelu");
+          TEST_RETURN_IF_NOT(node.InputDefs().size() == (broadcast_residual ? 3u : 4u));
+        }
+      }
+      return Status::OK();
+    };
+
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<GemmActivationFusion>(),
+                                          TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+  }
+}
 #endif
 
 // (A')'B' = AB'
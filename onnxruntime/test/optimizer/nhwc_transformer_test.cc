@@ -8,6 +8,8 @@
 #include "graph_transform_test_builder.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -677,6 +679,171 @@ TEST(NhwcTransformerTests, ConvAveragePoolFp16) {
 
 #endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
 
+static void EnableNhwcFp32(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableNhwcFp32Conv, "1"));
+}
+
+TEST(NhwcTransformerTests, ConvFp32) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
+                       int64_t group, bool relu) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.5f, 1.5f);
+      auto* output_arg = builder.MakeOutput();
+      auto* weight_arg = builder.MakeInitializer<float>(weights_shape, -1.5f, 1.5f);
+      auto* bias_arg = builder.MakeInitializer<float>({weights_shape[0]}, -1.5f, 1.5f);
+
+      if (relu) {
+        auto* conv_output_arg = builder.MakeIntermediate();
+        Node& conv_node = builder.AddNode("Conv", {input_arg, weight_arg, bias_arg}, {conv_output_arg});
+        conv_node.AddAttribute("group", group);
+        builder.AddNode("Relu", {conv_output_arg}, {output_arg});
+      } else {
+        Node& conv_node = builder.AddNode("Conv", {input_arg, weight_arg, bias_arg}, {output_arg});
+        conv_node.AddAttribute("group", group);
+      }
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 1);
+      EXPECT_EQ(op_to_count["Transpose"], 2);
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12,
+                      1e-4,
+                      1e-4,
+                      nullptr,
+                      EnableNhwcFp32);
+  };
+
+  // Test the basic case of a single 1D/2D/3D convolution, a pointwise, a
+  // grouped and a depthwise convolution.
+  test_case({1, 12, 37}, {32, 12, 5}, 1, false);
+  test_case({1, 23, 13, 13}, {30, 23, 3, 3}, 1, true);
+  test_case({1, 22, 11, 13, 15}, {30, 22, 5, 3, 3}, 1, false);
+  test_case({2, 64, 9, 9}, {48, 64, 1, 1}, 1, true);
+  test_case({1, 16, 11, 11}, {24, 8, 3, 3}, 2, true);
+  test_case({1, 40, 14, 14}, {40, 1, 3, 3}, 40, true);
+}
+
+TEST(NhwcTransformerTests, ConvPoolFp32) {
+  auto test_case = [&](const std::string& pool_type) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({1, 23, 13, 13}, -1.5f, 1.5f);
+      auto* conv_output_arg = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+      auto* conv_weight_arg = builder.MakeInitializer<float>({30, 23, 3, 3}, -1.5f, 1.5f);
+
+      builder.AddConvNode(input_arg, conv_weight_arg, conv_output_arg);
+      Node& pool_node = builder.AddNode(pool_type, {conv_output_arg}, {output_arg});
+      if (pool_type != "GlobalAveragePool") {
+        pool_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+        pool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+        pool_node.AddAttribute("strides", std::vector<int64_t>{2, 2});
+      }
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 1);
+      EXPECT_EQ(op_to_count["com.ms.internal.nhwc." + pool_type], 1);
+      EXPECT_EQ(op_to_count["Transpose"], 2);
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12,
+                      1e-4,
+                      1e-4,
+                      nullptr,
+                      EnableNhwcFp32);
+  };
+
+  test_case("MaxPool");
+  test_case("AveragePool");
+  test_case("GlobalAveragePool");
+}
+
+TEST(NhwcTransformerTests, ConvMaxPoolIndexTensorFp32) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 16, 17, 17}, -1.5f, 1.5f);
+    auto* conv_output_arg = builder.MakeIntermediate();
+    auto* index_output_arg = builder.MakeOutput();
+    auto* output_arg = builder.MakeOutput();
+    auto* conv_weight_arg = builder.MakeInitializer<float>({16, 16, 3, 3}, -1.5f, 1.5f);
+
+    builder.AddConvNode(input_arg, conv_weight_arg, conv_output_arg);
+    Node& pool_node = builder.AddNode("MaxPool", {conv_output_arg}, {output_arg, index_output_arg});
+    pool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 1);
+    EXPECT_EQ(op_to_count["MaxPool"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  // Test that MaxPool using the optional index tensor is not converted to the NHWC MaxPool.
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12,
+                    1e-4,
+                    1e-4,
+                    nullptr,
+                    EnableNhwcFp32);
+}
+
+TEST(NhwcTransformerTests, FusedConvSumFp32) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 23, 13, 13}, -1.5f, 1.5f);
+    auto* sum_arg = builder.MakeInput<float>({1, 30, 13, 13}, -1.5f, 1.5f);
+    auto* output_arg = builder.MakeOutput();
+    auto* weight_arg = builder.MakeInitializer<float>({30, 23, 3, 3}, -1.5f, 1.5f);
+    auto* bias_arg = builder.MakeInitializer<float>({30}, -1.5f, 1.5f);
+
+    Node& conv_node = builder.AddNode("FusedConv", {input_arg, weight_arg, bias_arg, sum_arg}, {output_arg},
+                                      kMSDomain);
+    conv_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    conv_node.AddAttribute("activation", "Relu");
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    const Graph& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 3);
+
+    // The Sum input is transposed to the layout of the output
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "NhwcFusedConv") {
+        ASSERT_EQ(node.InputDefs().size(), 4u);
+        const Node* sum_producer = graph.GetProducerNode(node.InputDefs()[3]->Name());
+        ASSERT_NE(sum_producer, nullptr);
+        EXPECT_EQ(sum_producer->OpType(), "Transpose");
+      }
+    }
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12,
+                    1e-4,
+                    1e-4,
+                    nullptr,
+                    EnableNhwcFp32);
+}
+
 #endif  // DISABLE_CONTRIB_OPS
 
 }  // namespace test
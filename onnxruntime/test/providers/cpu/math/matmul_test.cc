@@ -7,6 +7,7 @@
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
+#include "core/mlas/inc/mlas.h"
 #include "default_providers.h"
 
 namespace onnxruntime {
@@ -292,6 +293,75 @@ TEST(MathOpTest, MatMul_bfloat16) {
 }
 #endif
 
+TEST(MathOpTest, MatMul_bfloat16_cpu) {
+  // Small integers are exact in bfloat16, so are the products and their sums.
+  std::vector<float> a_values(2 * 3 * 37);
+  std::vector<float> b_values(37 * 20);
+  for (size_t i = 0; i < a_values.size(); i++) {
+    a_values[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+  for (size_t i = 0; i < b_values.size(); i++) {
+    b_values[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  }
+
+  std::vector<float> y_values(2 * 3 * 20, 0.0f);
+  for (size_t m = 0; m < 6; m++) {
+    for (size_t n = 0; n < 20; n++) {
+      for (size_t k = 0; k < 37; k++) {
+        y_values[m * 20 + n] += a_values[m * 37 + k] * b_values[k * 20 + n];
+      }
+    }
+  }
+
+  // B as an input and as a pre-packed initializer.
+  for (bool is_initializer : {false, true}) {
+    OpTester test("MatMul", 13);
+    test.AddInput<BFloat16>("A", {2, 3, 37}, FloatsToBFloat16s(a_values));
+    test.AddInput<BFloat16>("B", {37, 20}, FloatsToBFloat16s(b_values), is_initializer);
+    test.AddOutput<BFloat16>("Y", {2, 3, 20}, FloatsToBFloat16s(y_values));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.emplace_back(DefaultCpuExecutionProvider());
+    test.ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
+#ifdef MLAS_F16GEMM_SUPPORTED
+TEST(MathOpTest, MatMul_Float16_cpu) {
+  if (!MlasFp16AccelerationSupported()) {
+    GTEST_SKIP() << "The CPU has no fp16 GEMM kernels";
+  }
+
+  // Small integers are exact in fp16, so are the products and their sums.
+  std::vector<float> a_values(2 * 3 * 37);
+  std::vector<float> b_values(37 * 20);
+  for (size_t i = 0; i < a_values.size(); i++) {
+    a_values[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+  for (size_t i = 0; i < b_values.size(); i++) {
+    b_values[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  }
+
+  std::vector<float> y_values(2 * 3 * 20, 0.0f);
+  for (size_t m = 0; m < 6; m++) {
+    for (size_t n = 0; n < 20; n++) {
+      for (size_t k = 0; k < 37; k++) {
+        y_values[m * 20 + n] += a_values[m * 37 + k] * b_values[k * 20 + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul", 13);
+  test.AddInput<MLFloat16>("A", {2, 3, 37}, FloatsToMLFloat16s(a_values));
+  test.AddInput<MLFloat16>("B", {37, 20}, FloatsToMLFloat16s(b_values));
+  test.AddOutput<MLFloat16>("Y", {2, 3, 20}, FloatsToMLFloat16s(y_values));
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+#endif
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
@@ -736,5 +736,58 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// A 3x3 convolution of 16 or more channels with the weight as initializer, which
+// the CPU EP packs and computes with the Winograd algorithm.
+TEST(ConvTest, Conv2D_Winograd) {
+  constexpr int64_t N = 2, C = 24, H = 9, W_in = 11, M = 32;
+
+  vector<float> X(static_cast<size_t>(N * C * H * W_in));
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>(static_cast<int64_t>(i % 7) - 3) * 0.25f;
+  }
+  vector<float> W(static_cast<size_t>(M * C * 3 * 3));
+  for (size_t i = 0; i < W.size(); i++) {
+    W[i] = static_cast<float>(static_cast<int64_t>(i % 5) - 2) * 0.125f;
+  }
+  vector<float> B(static_cast<size_t>(M));
+  for (size_t i = 0; i < B.size(); i++) {
+    B[i] = static_cast<float>(i) * 0.5f;
+  }
+
+  // pads of 1 keep the spatial size of the input
+  vector<float> Y(static_cast<size_t>(N * M * H * W_in));
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t oh = 0; oh < H; oh++) {
+        for (int64_t ow = 0; ow < W_in; ow++) {
+          float sum = B[m];
+          for (int64_t c = 0; c < C; c++) {
+            for (int64_t kh = 0; kh < 3; kh++) {
+              for (int64_t kw = 0; kw < 3; kw++) {
+                const int64_t ih = oh + kh - 1;
+                const int64_t iw = ow + kw - 1;
+                if (ih >= 0 && ih < H && iw >= 0 && iw < W_in) {
+                  sum += X[((n * C + c) * H + ih) * W_in + iw] * W[((m * C + c) * 3 + kh) * 3 + kw];
+                }
+              }
+            }
+          }
+          Y[((n * M + m) * H + oh) * W_in + ow] = sum;
+        }
+      }
+    }
+  }
+
+  OpTester test("Conv", 11);
+  test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+  test.AddInput<float>("X", {N, C, H, W_in}, X);
+  test.AddInput<float>("W", {M, C, 3, 3}, W, true);
+  test.AddInput<float>("B", {M}, B, true);
+  test.AddOutput<float>("Y", {N, M, H, W_in}, Y);
+  test.SetOutputAbsErr("Y", 1e-4f);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kQnnExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
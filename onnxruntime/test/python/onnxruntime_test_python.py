@@ -617,6 +617,8 @@ class TestInferenceSession(unittest.TestCase):
             sess.set_tuning_results([loadable], error_on_invalid=True)
             assert_tuning_results_loaded(sess, ep)
 
+        do_test_get_and_set_tuning_results("CPUExecutionProvider")
+
         if "CUDAExecutionProvider" in onnxrt.get_available_providers():
             do_test_get_and_set_tuning_results("CUDAExecutionProvider")
 
@@ -669,6 +671,79 @@ class TestInferenceSession(unittest.TestCase):
         event.wait(10)  # timeout in 10 sec
         self.assertTrue(event.is_set())
 
+    def test_run_with_preallocated_outputs(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+
+        y = np.zeros((3, 2), dtype=np.float32)
+        res = sess.run(["Y"], {"X": x}, outputs={"Y": y})
+        self.assertIs(res[0], y)
+        np.testing.assert_allclose(output_expected, y, rtol=1e-05, atol=1e-08)
+
+        with self.assertRaises(ValueError):
+            sess.run(["Y"], {"X": x}, outputs={"Y": np.zeros((3, 2), dtype=np.float64)})
+        with self.assertRaises(ValueError):
+            sess.run(["Y"], {"X": x}, outputs={"Y": np.zeros((2, 3), dtype=np.float32)})
+        with self.assertRaises(ValueError):
+            sess.run(["Y"], {"X": x}, outputs={"Y": np.zeros((2, 3), dtype=np.float32).T})
+
+    def test_ort_value_numpy_without_copy(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        ort_value = sess.run_with_ort_values(["Y"], {"X": onnxrt.OrtValue.ortvalue_from_numpy(x)})[0]
+        y = ort_value.numpy(copy=False)
+        # the view points to the data of the OrtValue, a copy does not
+        self.assertEqual(y.__array_interface__["data"][0], ort_value.data_ptr())
+        self.assertNotEqual(ort_value.numpy().__array_interface__["data"][0], ort_value.data_ptr())
+        # the view stays valid after the OrtValue is released
+        del ort_value
+        np.testing.assert_allclose(x * x, y, rtol=1e-05, atol=1e-08)
+
+    def test_run_many(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=available_providers)
+        inputs = [np.full((3, 2), i, dtype=np.float32) for i in range(5)]
+
+        results = sess.run_many(["Y"], [{"X": x} for x in inputs], max_concurrency=2)
+        self.assertEqual(len(results), len(inputs))
+        for x, res in zip(inputs, results):
+            np.testing.assert_allclose(x * x, res[0], rtol=1e-05, atol=1e-08)
+
+        future = sess.run_many([], [{"X": x} for x in inputs], return_future=True)
+        results = future.result(timeout=10)
+        self.assertEqual(len(results), len(inputs))
+        for x, res in zip(inputs, results):
+            np.testing.assert_allclose(x * x, res[0], rtol=1e-05, atol=1e-08)
+
+        self.assertEqual(sess.run_many(["Y"], []), [])
+
+        with self.assertRaises(Exception) as context:
+            sess.run_many(["Y"], [{"X": inputs[0]}, {"X": np.zeros((2, 2), dtype=np.float32)}])
+        self.assertIn("Request 1 failed", str(context.exception))
+
+    def test_request_batcher(self):
+        sess = onnxrt.InferenceSession(
+            get_name("matmul_with_dynamic_input_shape.onnx"), providers=onnxrt.get_available_providers()
+        )
+        b = np.arange(8, dtype=np.float32).reshape(2, 4)
+        results = {}
+
+        def callback(res, request_id, err: str) -> None:
+            self.assertEqual(len(err), 0)
+            results[request_id] = res[0]
+
+        inputs = [np.array([[i, 1.0]], dtype=np.float32) for i in range(6)]
+        # a long wait so that the requests are batched
+        batcher = onnxrt.RequestBatcher(sess, max_batch_size=4, max_wait_us=1000000)
+        for i, a in enumerate(inputs):
+            batcher.submit(["Y"], {"A": a}, callback, i)
+        # releasing the batcher runs the pending requests
+        del batcher
+
+        self.assertEqual(len(results), len(inputs))
+        for i, a in enumerate(inputs):
+            np.testing.assert_allclose(np.matmul(a, b), results[i], rtol=1e-05, atol=1e-08)
+
     def test_run_model_from_bytes(self):
         with open(get_name("mul_1.onnx"), "rb") as f:
             content = f.read()
@@ -2167,6 +2167,47 @@ TEST(CApiTest, access_tensor_data_elements) {
   }
 }
 
+TEST(CApiTest, create_tensor_view) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<int64_t> shape = {3, 2, 2};
+  Ort::Value view{nullptr};
+  Ort::Value slice{nullptr};
+  {
+    Ort::Value tensor = Ort::Value::CreateTensor<float>(allocator, shape.data(), shape.size());
+    float* data = tensor.GetTensorMutableData<float>();
+    for (int i = 0; i < 12; i++) {
+      data[i] = static_cast<float>(i);
+    }
+
+    std::vector<int64_t> view_shape = {2, 3};
+    view = Ort::Value::CreateTensorView(tensor.GetConst(), 4, view_shape.data(), view_shape.size());
+    ASSERT_EQ(view.GetTensorTypeAndShapeInfo().GetShape(), view_shape);
+    ASSERT_EQ(view.GetTensorData<float>(), data + 4);
+
+    slice = Ort::Value::CreateTensorSlice(tensor.GetConst(), 1, 3);
+    ASSERT_EQ(slice.GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{2, 2, 2}));
+    ASSERT_EQ(slice.GetTensorData<float>(), data + 4);
+
+    // the view must fit in the tensor
+    std::vector<int64_t> too_large_shape = {9};
+    OrtValue* out = nullptr;
+    Ort::Status status{Ort::GetApi().CreateTensorView(tensor, 4, too_large_shape.data(), too_large_shape.size(), &out)};
+    ASSERT_FALSE(status.IsOK());
+    ASSERT_EQ(status.GetErrorCode(), ORT_INVALID_ARGUMENT);
+    ASSERT_THROW(Ort::Value::CreateTensorSlice(tensor.GetConst(), 2, 4), Ort::Exception);
+  }
+
+  // the views keep the buffer alive after the tensor is released
+  const float* view_data = view.GetTensorData<float>();
+  const float* slice_data = slice.GetTensorData<float>();
+  for (int i = 0; i < 6; i++) {
+    ASSERT_EQ(view_data[i], static_cast<float>(4 + i));
+  }
+  for (int i = 0; i < 8; i++) {
+    ASSERT_EQ(slice_data[i], static_cast<float>(4 + i));
+  }
+}
+
 TEST(CApiTest, override_initializer) {
   Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
   auto allocator = std::make_unique<MockedOrtAllocator>();
@@ -3426,6 +3467,124 @@ TEST(CApiTest, RunAsync) {
   EXPECT_EQ(atomic_wait.load(), true);
 }
 
+struct RequestBatcherTestRequest {
+  float a_value[2];
+  int64_t a_dim[2] = {1, 2};
+  Ort::Value inputs[1] = {Ort::Value{nullptr}};
+  Ort::Value outputs[1] = {Ort::Value{nullptr}};
+  std::atomic<int>* num_completed;
+};
+
+void RequestBatcherCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status_ptr) {
+  auto* request = reinterpret_cast<RequestBatcherTestRequest*>(user_data);
+  Ort::Status status(status_ptr);
+  EXPECT_TRUE(status.IsOK()) << status.GetErrorMessage();
+  EXPECT_EQ(num_outputs, 1UL);
+
+  // Y = A * [[0, 1, 2, 3], [4, 5, 6, 7]]
+  const float a0 = request->a_value[0];
+  const float a1 = request->a_value[1];
+  const std::vector<float> expected{4 * a1, a0 + 5 * a1, 2 * a0 + 6 * a1, 3 * a0 + 7 * a1};
+  Ort::UnownedValue output(outputs[0]);
+  EXPECT_EQ(output.GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{1, 4}));
+  const float* output_data = output.GetTensorData<float>();
+  EXPECT_EQ(std::vector<float>(output_data, output_data + 4), expected);
+
+  ++*request->num_completed;
+}
+
+TEST(CApiTest, RequestBatcher) {
+  Ort::Session session(*ort_env, TSTR("testdata/matmul_with_dynamic_input_shape.onnx"), Ort::SessionOptions{});
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+
+  Ort::AllocatorWithDefaultOptions allocator;
+
+  const char* input_names[] = {"A"};
+  const char* output_names[] = {"Y"};
+  constexpr int num_requests = 6;
+  std::atomic<int> num_completed{0};
+  std::vector<RequestBatcherTestRequest> requests(num_requests);
+
+  {
+    // a long wait so that the requests are batched
+    Ort::RequestBatcher batcher(session, 4, 1000000);
+    for (int i = 0; i < num_requests; ++i) {
+      auto& request = requests[i];
+      request.a_value[0] = static_cast<float>(i);
+      request.a_value[1] = 1.0f;
+      request.num_completed = &num_completed;
+      request.inputs[0] = Ort::Value::CreateTensor<float>(memory_info, request.a_value, 2, request.a_dim, 2);
+      if (i % 2 == 1) {
+        // preallocated output
+        const int64_t y_dim[] = {1, 4};
+        request.outputs[0] = Ort::Value::CreateTensor<float>(allocator, y_dim, 2);
+      }
+
+      batcher.Submit(input_names, request.inputs, 1, output_names, request.outputs, 1,
+                     RequestBatcherCallback, &request);
+    }
+    // releasing the batcher runs the pending requests
+  }
+
+  EXPECT_EQ(num_completed.load(), num_requests);
+}
+
+struct RequestBatcherTransposeTestRequest {
+  float a_value[5];
+  int64_t a_dim[2] = {1, 5};
+  Ort::Value inputs[1] = {Ort::Value{nullptr}};
+  Ort::Value outputs[1] = {Ort::Value{nullptr}};
+  std::atomic<int>* num_completed;
+};
+
+void RequestBatcherTransposeCallback(void* user_data, OrtValue** outputs, size_t num_outputs,
+                                     OrtStatusPtr status_ptr) {
+  auto* request = reinterpret_cast<RequestBatcherTransposeTestRequest*>(user_data);
+  Ort::Status status(status_ptr);
+  EXPECT_TRUE(status.IsOK()) << status.GetErrorMessage();
+  EXPECT_EQ(num_outputs, 1UL);
+
+  // Y = transpose(A)
+  Ort::UnownedValue output(outputs[0]);
+  EXPECT_EQ(output.GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{5, 1}));
+  const float* output_data = output.GetTensorData<float>();
+  EXPECT_EQ(std::vector<float>(output_data, output_data + 5),
+            std::vector<float>(request->a_value, request->a_value + 5));
+
+  ++*request->num_completed;
+}
+
+// The output of the model has no batch dimension, so the requests are not batched.
+TEST(CApiTest, RequestBatcherOutputWithoutBatchDimension) {
+  Ort::Session session(*ort_env, TSTR("testdata/transpose_with_dynamic_input_shape.onnx"), Ort::SessionOptions{});
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+
+  const char* input_names[] = {"A"};
+  const char* output_names[] = {"Y"};
+  constexpr int num_requests = 6;
+  std::atomic<int> num_completed{0};
+  std::vector<RequestBatcherTransposeTestRequest> requests(num_requests);
+
+  {
+    // a long wait so that the requests are batched
+    Ort::RequestBatcher batcher(session, 4, 1000000);
+    for (int i = 0; i < num_requests; ++i) {
+      auto& request = requests[i];
+      for (int j = 0; j < 5; ++j) {
+        request.a_value[j] = static_cast<float>(i * 5 + j);
+      }
+      request.num_completed = &num_completed;
+      request.inputs[0] = Ort::Value::CreateTensor<float>(memory_info, request.a_value, 5, request.a_dim, 2);
+
+      batcher.Submit(input_names, request.inputs, 1, output_names, request.outputs, 1,
+                     RequestBatcherTransposeCallback, &request);
+    }
+    // releasing the batcher runs the pending requests
+  }
+
+  EXPECT_EQ(num_completed.load(), num_requests);
+}
+
 void CallbackFail(void*, OrtValue**, size_t, OrtStatusPtr) {
   EXPECT_TRUE(false);  // the callback is not supposed to be invoked
 }
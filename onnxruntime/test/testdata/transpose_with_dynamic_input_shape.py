@@ -0,0 +1,30 @@
+from pathlib import Path
+
+import onnx
+from onnx import TensorProto, helper
+
+# This model contains a Transpose where:
+# - A has shape [M, N] and `M` is a dynamic dimension.
+# - The output Y has shape [N, M], so its first dimension is not the batch dimension of A.
+#   - This is used to test that the RequestBatcher does not batch the requests of a model without a batch dimension.
+
+# M is dynamic
+M = "M"
+N = 5
+
+graph = helper.make_graph(
+    [  # nodes
+        helper.make_node("Transpose", ["A"], ["Y"], "Transpose"),
+    ],
+    "TransposeWithDynamicInputShape",  # name
+    [  # inputs
+        helper.make_tensor_value_info("A", TensorProto.FLOAT, [M, N]),
+    ],
+    [  # outputs
+        helper.make_tensor_value_info("Y", TensorProto.FLOAT, [N, M]),
+    ],
+)
+
+opset_imports = [helper.make_operatorsetid("", 19)]
+model = helper.make_model(graph, opset_imports=opset_imports)
+onnx.save(model, str(Path(__file__).parent / "transpose_with_dynamic_input_shape.onnx"))
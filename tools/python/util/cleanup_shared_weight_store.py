@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+import argparse
+import os
+import pathlib
+import sys
+
+# Must match onnxruntime/core/framework/shared_weight_store.cc
+_LOCK_FILE_NAME = "store.lock"
+_BUFFER_FILE_EXTENSION = ".weights"
+_TEMP_FILE_PREFIX = "tmp-"
+
+
+def _is_store_file(path: pathlib.Path):
+    return path.is_file() and (path.name.startswith(_TEMP_FILE_PREFIX) or path.suffix == _BUFFER_FILE_EXTENSION)
+
+
+def list_shared_weights(directory: pathlib.Path):
+    """
+    Returns the paths of the shared weights in the store directory, together with their total size in bytes.
+    """
+    paths = sorted(path for path in directory.iterdir() if _is_store_file(path))
+    return paths, sum(path.stat().st_size for path in paths)
+
+
+def cleanup_shared_weight_store(directory: pathlib.Path):
+    """
+    Removes the shared weights in the store directory if no process has the store open.
+    A session has the store open from its initialization until it is released.
+    :param directory: Directory that was set as the 'session.shared_weight_store_directory' session option.
+    :return: The number of files removed, or None if the store is in use.
+    """
+    import fcntl
+
+    lock_path = directory / _LOCK_FILE_NAME
+    if not lock_path.exists():
+        return 0
+
+    # Every open store holds a shared lock on the lock file, so an exclusive lock means that the store is not in use.
+    # The lock file is kept as a session that is being initialized may have opened it already.
+    fd = os.open(lock_path, os.O_RDONLY)
+    try:
+        try:
+            fcntl.flock(fd, fcntl.LOCK_EX | fcntl.LOCK_NB)
+        except BlockingIOError:
+            return None
+
+        paths, _ = list_shared_weights(directory)
+        for path in paths:
+            path.unlink()
+        return len(paths)
+    finally:
+        os.close(fd)
+
+
+def cleanup_shared_weight_store_helper():
+    parser = argparse.ArgumentParser(
+        f"{os.path.basename(__file__)}:{cleanup_shared_weight_store_helper.__name__}",
+        description="""Removes the weights in a store of weights that ONNX Runtime sessions share between processes
+                    via the 'session.shared_weight_store_directory' session option.
+                    The weights are only removed if no process is using the store.""",
+    )
+
+    parser.add_argument(
+        "--list", action="store_true", help="List the shared weights and their total size instead of removing them."
+    )
+    parser.add_argument("directory", type=pathlib.Path, help="Directory of the shared weight store.")
+
+    args = parser.parse_args()
+
+    if not args.directory.is_dir():
+        print(f"{args.directory} is not a directory.")
+        sys.exit(-1)
+
+    if args.list:
+        paths, total_size = list_shared_weights(args.directory)
+        for path in paths:
+            print(f"{path.name} {path.stat().st_size}")
+        print(f"{len(paths)} files, {total_size} bytes")
+        return
+
+    num_removed = cleanup_shared_weight_store(args.directory)
+    if num_removed is None:
+        print(f"The shared weight store in {args.directory} is in use. Nothing was removed.")
+        sys.exit(1)
+
+    print(f"Removed {num_removed} files from {args.directory}.")
+
+
+if __name__ == "__main__":
+    cleanup_shared_weight_store_helper()